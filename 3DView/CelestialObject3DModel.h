@@ -85,6 +85,15 @@ public:
                          const std::vector<double>& newY,
                          const std::vector<double>& newZ);
 
+    /** @brief Returns the cached X-coordinates, one per object. */
+    const std::vector<double> &getCurrentX() const { return currentX; }
+
+    /** @brief Returns the cached Y-coordinates, one per object. */
+    const std::vector<double> &getCurrentY() const { return currentY; }
+
+    /** @brief Returns the cached Z-coordinates, one per object. */
+    const std::vector<double> &getCurrentZ() const { return currentZ; }
+
     /**
      * @brief Updates the entire list of objects (e.g., after galaxy regeneration).
      * * Resets the model to notify the view that the underlying data set has changed.
@@ -0,0 +1,125 @@
+#include "CelestialObjectInstancing.h"
+#include <QColor>
+#include <QMatrix3x3>
+#include <QQuaternion>
+
+CelestialObjectInstancing::CelestialObjectInstancing(QQuick3DObject *parent) : QQuick3DInstancing(parent) {}
+
+void CelestialObjectInstancing::setModel(QAbstractItemModel *newModel) {
+    auto *objectModel = qobject_cast<CelestialObject3DModel *>(newModel);
+    if (model == objectModel) return;
+    if (model) disconnect(model.data(), nullptr, this, nullptr);
+    model = objectModel;
+    if (model) {
+        connect(model.data(), &QAbstractItemModel::modelReset, this, [this]() {
+            collectObjects();
+            markDirty();
+        });
+        connect(model.data(), &QAbstractItemModel::dataChanged, this, [this]() { markDirty(); });
+    }
+    collectObjects();
+    emit modelChanged();
+    markDirty();
+}
+
+void CelestialObjectInstancing::setObjectType(int type) {
+    if (objectType == type) return;
+    objectType = type;
+    collectObjects();
+    emit objectTypeChanged();
+    markDirty();
+}
+
+void CelestialObjectInstancing::setShape(const QVector3D &newShape) {
+    if (shape == newShape) return;
+    shape = newShape;
+    emit shapeChanged();
+    markDirty();
+}
+
+void CelestialObjectInstancing::collectObjects() {
+    objectIndices.clear();
+    sizes.clear();
+    colors.clear();
+    if (!model) return;
+    for (int i = 0; i < model->rowCount(); ++i) {
+        QModelIndex index = model->index(i);
+        if (model->data(index, ObjectTypeRole).toInt() != objectType) continue;
+
+        QColor color = model->data(index, ObjectColorRole).value<QColor>();
+        if (!color.isValid()) color = Qt::white;
+        objectIndices.push_back(i);
+        sizes.push_back(static_cast<float>(model->data(index, SizeFactorRole).toDouble()));
+        colors.emplace_back(color.redF(), color.greenF(), color.blueF(), color.alphaF());
+    }
+}
+
+int CelestialObjectInstancing::objectIndex(int instance) const {
+    if (instance < 0 || instance >= static_cast<int>(objectIndices.size())) return -1;
+    return objectIndices[instance];
+}
+
+void CelestialObjectInstancing::setScaleFactor(qreal factor) {
+    if (qFuzzyCompare(scaleFactor, factor)) return;
+    scaleFactor = factor;
+    emit scaleFactorChanged();
+    markDirty();
+}
+
+void CelestialObjectInstancing::setSpinAngle(qreal degrees) {
+    if (qFuzzyCompare(spinAngle, degrees)) return;
+    spinAngle = degrees;
+    emit spinAngleChanged();
+    markDirty();
+}
+
+void CelestialObjectInstancing::setSpinAxis(const QVector3D &axis) {
+    if (spinAxis == axis) return;
+    spinAxis = axis;
+    emit spinAxisChanged();
+    markDirty();
+}
+
+void CelestialObjectInstancing::setHighlightedIndex(int index) {
+    if (highlightedIndex == index) return;
+    highlightedIndex = index;
+    emit highlightedIndexChanged();
+    markDirty();
+}
+
+QByteArray CelestialObjectInstancing::getInstanceBuffer(int *instanceCount) {
+    if (!model) {
+        table.clear();
+        if (instanceCount) *instanceCount = 0;
+        return table;
+    }
+    const std::vector<double> &x = model->getCurrentX();
+    const std::vector<double> &y = model->getCurrentY();
+    const std::vector<double> &z = model->getCurrentZ();
+
+    // One rotation for all instances; each row is R * diag(scale) with the position in w.
+    const QMatrix3x3 r = QQuaternion::fromAxisAndAngle(spinAxis, static_cast<float>(spinAngle)).toRotationMatrix();
+    const int count = static_cast<int>(objectIndices.size());
+    table.resize(count * static_cast<int>(sizeof(InstanceTableEntry)));
+    auto *entries = reinterpret_cast<InstanceTableEntry *>(table.data());
+
+    for (int i = 0; i < count; ++i) {
+        const std::size_t object = objectIndices[i];
+        float s = sizes[i] * static_cast<float>(scaleFactor);
+        if (static_cast<int>(object) == highlightedIndex) s *= HIGHLIGHT_SCALE;
+        const float sx = s * shape.x(), sy = s * shape.y(), sz = s * shape.z();
+        const float px = object < x.size() ? static_cast<float>(x[object]) : 0.0f;
+        const float py = object < y.size() ? static_cast<float>(y[object]) : 0.0f;
+        const float pz = object < z.size() ? static_cast<float>(z[object]) : 0.0f;
+
+        InstanceTableEntry &entry = entries[i];
+        entry.row0 = QVector4D(r(0, 0) * sx, r(0, 1) * sy, r(0, 2) * sz, px);
+        entry.row1 = QVector4D(r(1, 0) * sx, r(1, 1) * sy, r(1, 2) * sz, py);
+        entry.row2 = QVector4D(r(2, 0) * sx, r(2, 1) * sy, r(2, 2) * sz, pz);
+        entry.color = colors[i];
+        entry.instanceData = QVector4D(static_cast<float>(object), 0, 0, 0);
+    }
+
+    if (instanceCount) *instanceCount = count;
+    return table;
+}
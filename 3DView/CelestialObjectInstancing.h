@@ -0,0 +1,119 @@
+#ifndef CELESTIALOBJECTINSTANCING_H
+#define CELESTIALOBJECTINSTANCING_H
+
+#include <QtQuick3D/QQuick3DInstancing>
+#include <QPointer>
+#include <QVector3D>
+#include <QVector4D>
+#include <vector>
+#include "CelestialObject3DModel.h"
+
+/**
+ * @file CelestialObjectInstancing.h
+ * @brief Instance table that draws all galaxy objects of one type with a single Model.
+ */
+
+/**
+ * @class CelestialObjectInstancing
+ * @brief Packs the position, scale and colour of every object of one type into one buffer.
+ *
+ * A `Model { instancing: ... }` in QML draws all rows of the table in one draw call,
+ * instead of one scene-graph node (and several Models) per object. The table follows a
+ * CelestialObject3DModel: the objects, their colour and size are read when the model is
+ * reset, and the positions are taken straight from the model's coordinate arrays
+ * whenever they change (i.e., every physics frame).
+ *
+ * The type is registered with QML (import Galaxy3D 1.0) and declared inside the View3D,
+ * so the table belongs to the scene like any other Quick3D object:
+ * @code
+ * CelestialObjectInstancing {
+ *     id: starInstancing
+ *     model: celestialModel
+ *     objectType: 1
+ *     shape: Qt.vector3d(0.5, 0.5, 0.5)
+ * }
+ * @endcode
+ *
+ * Every instance gets the same spin (spinAngle around spinAxis) and scale multiplier
+ * (scaleFactor), so QML animates one plain property per table rather than one per object.
+ */
+class CelestialObjectInstancing : public QQuick3DInstancing {
+    Q_OBJECT
+    Q_PROPERTY(QAbstractItemModel *model READ getModel WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(int objectType READ getObjectType WRITE setObjectType NOTIFY objectTypeChanged)
+    Q_PROPERTY(QVector3D shape READ getShape WRITE setShape NOTIFY shapeChanged)
+    Q_PROPERTY(qreal scaleFactor READ getScaleFactor WRITE setScaleFactor NOTIFY scaleFactorChanged)
+    Q_PROPERTY(qreal spinAngle READ getSpinAngle WRITE setSpinAngle NOTIFY spinAngleChanged)
+    Q_PROPERTY(QVector3D spinAxis READ getSpinAxis WRITE setSpinAxis NOTIFY spinAxisChanged)
+    Q_PROPERTY(int highlightedIndex READ getHighlightedIndex WRITE setHighlightedIndex NOTIFY highlightedIndexChanged)
+
+public:
+    explicit CelestialObjectInstancing(QQuick3DObject *parent = nullptr);
+
+    /**
+     * @brief Maps an instance (e.g., PickResult.instanceIndex) back to the galaxy object index.
+     * @return The object index, or -1 if `instance` is out of range.
+     */
+    Q_INVOKABLE int objectIndex(int instance) const;
+
+    /** @brief The model providing objects and positions; anything but a CelestialObject3DModel is ignored. */
+    QAbstractItemModel *getModel() const { return model; }
+    void setModel(QAbstractItemModel *newModel);
+
+    /** @brief Value of ObjectTypeRole to draw (1 = star system, 2 = nebula). */
+    int getObjectType() const { return objectType; }
+    void setObjectType(int type);
+
+    /** @brief Per-axis scale of an instance, in units of the object's sizeFactor. */
+    QVector3D getShape() const { return shape; }
+    void setShape(const QVector3D &newShape);
+
+    qreal getScaleFactor() const { return scaleFactor; }
+    void setScaleFactor(qreal factor);
+
+    /** @brief Rotation of every instance around spinAxis, in degrees. */
+    qreal getSpinAngle() const { return spinAngle; }
+    void setSpinAngle(qreal degrees);
+
+    QVector3D getSpinAxis() const { return spinAxis; }
+    void setSpinAxis(const QVector3D &axis);
+
+    /** @brief Galaxy index of the object drawn enlarged (hover feedback), or -1. */
+    int getHighlightedIndex() const { return highlightedIndex; }
+    void setHighlightedIndex(int index);
+
+    /// @brief Scale multiplier of the highlighted object.
+    static constexpr float HIGHLIGHT_SCALE = 1.2f;
+
+signals:
+    void modelChanged();
+    void objectTypeChanged();
+    void shapeChanged();
+    void scaleFactorChanged();
+    void spinAngleChanged();
+    void spinAxisChanged();
+    void highlightedIndexChanged();
+
+protected:
+    /** @brief Rebuilds the packed table from the current positions. */
+    QByteArray getInstanceBuffer(int *instanceCount) override;
+
+private:
+    QPointer<CelestialObject3DModel> model;
+    int objectType = 0;
+    QVector3D shape{1.0f, 1.0f, 1.0f};
+    qreal scaleFactor = 1.0;
+    qreal spinAngle = 0.0;
+    QVector3D spinAxis{0.0f, 1.0f, 0.0f};
+    int highlightedIndex = -1;
+
+    std::vector<int> objectIndices;   ///< Galaxy index of each instance.
+    std::vector<float> sizes;         ///< sizeFactor of each instance.
+    std::vector<QVector4D> colors;    ///< Colour of each instance (RGBA, 0..1).
+    QByteArray table;                 ///< Reused between frames.
+
+    /** @brief Re-reads which objects this table draws, with their size and colour. */
+    void collectObjects();
+};
+
+#endif // CELESTIALOBJECTINSTANCING_H
@@ -1,4 +1,5 @@
 #include "PlanetarySystemModel.h"
+#include "PlanetOrbitPropagator.h"
 #include <QDebug>
 #include <cmath>
 #include <limits>
@@ -23,8 +24,8 @@ QVariant PlanetarySystemModel::data(const QModelIndex &index, int role) const {
         case OrbitRadiusRole: return planet.orbitRadius;
         case PlanetSizeRole:  return planet.size;
         case PlanetColorRole: return planet.color;
-        case RotationSpeedRole: return planet.speed;
         case TexturePathRole: return planet.texturePath;
+        case PositionRole: return planet.position;
         default: return QVariant();
     }
 }
@@ -34,8 +35,8 @@ QHash<int, QByteArray> PlanetarySystemModel::roleNames() const {
     roles[OrbitRadiusRole] = "orbitRadius";
     roles[PlanetSizeRole] = "planetSize";
     roles[PlanetColorRole] = "planetColor";
-    roles[RotationSpeedRole] = "rotationSpeed";
     roles[TexturePathRole] = "texturePath";
+    roles[PositionRole] = "planetPosition";
     return roles;
 }
 
@@ -67,7 +68,7 @@ void PlanetarySystemModel::updateSystem(StarSystem* system) {
             data.orbitRadius = baseOrbitStart + (i * orbitSpacing);
             RGBColor c = p->getColor();
             data.color = (c.r == 0 && c.g == 0 && c.b == 0) ? QColor("white") : QColor(c.r, c.g, c.b, c.a);
-            data.speed = 5.0 * std::pow(data.orbitRadius, 1.5);
+            data.position = QVector3D(data.orbitRadius, 0, 0);
 
 
             if (p->getTexturePath().empty()) {
@@ -118,6 +119,21 @@ void PlanetarySystemModel::updateSystem(StarSystem* system) {
     endResetModel();
 }
 
+void PlanetarySystemModel::updatePositions(const PlanetOrbitPropagator &orbits, int object) {
+    const int count = std::min(static_cast<int>(m_planets.size()), orbits.planetCount(object));
+    if (count == 0) return;
+
+    const int first = orbits.firstPlanet(object);
+    for (int i = 0; i < count; ++i) {
+        const int p = first + i;
+        const double a = orbits.semiMajorAxis()[p];
+        if (a <= 0.0) continue;
+        const double scale = m_planets[i].orbitRadius / a;
+        m_planets[i].position = QVector3D(orbits.x()[p] * scale, orbits.y()[p] * scale, orbits.z()[p] * scale);
+    }
+    emit dataChanged(index(0), index(count - 1), {PositionRole});
+}
+
 void PlanetarySystemModel::clear() {
     beginResetModel();
     m_planets.clear();
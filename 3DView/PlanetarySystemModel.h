@@ -3,9 +3,12 @@
 
 #include <QAbstractListModel>
 #include <QColor>
+#include <QVector3D>
 #include <vector>
 #include "StarSystem.h"
 
+class PlanetOrbitPropagator;
+
 /**
  * @file PlanetarySystemModel.h
  * @brief Data model for visualizing planets within a focused star system in 3D.
@@ -17,7 +20,8 @@
  *
  * This class translates the planetary data contained within a `StarSystem` into
  * a format that QML can use to instantiate 3D spheres, apply textures, and
- * animate orbital movements.
+ * place them on their orbits. The positions come from a PlanetOrbitPropagator
+ * shared with the rest of the galaxy (see updatePositions()).
  */
 class PlanetarySystemModel : public QAbstractListModel {
     Q_OBJECT
@@ -30,8 +34,8 @@ public:
         OrbitRadiusRole = Qt::UserRole + 1, ///< Radius of the planet's orbit from the star.
         PlanetSizeRole,                    ///< Calculated size (scale) of the planet model.
         PlanetColorRole,                   ///< Base color of the planet (for fallback or tinting).
-        RotationSpeedRole,                 ///< Orbital velocity for 3D animation.
-        TexturePathRole                    ///< Local path to the planet's surface texture file.
+        TexturePathRole,                   ///< Local path to the planet's surface texture file.
+        PositionRole                       ///< Current position relative to the star.
     };
 
     /**
@@ -65,6 +69,16 @@ public:
      */
     void updateSystem(StarSystem* system);
 
+    /**
+     * @brief Moves the planets to the positions last computed by `orbits`.
+     *
+     * The orbit shapes are scaled so that each planet keeps its display orbit radius.
+     * Only PositionRole changes, so QML updates the transforms without recreating the planets.
+     * @param orbits Propagated orbits of the galaxy.
+     * @param object Galaxy index of the system shown by this model.
+     */
+    void updatePositions(const PlanetOrbitPropagator &orbits, int object);
+
     /**
      * @brief Clears all planetary data from the model.
      * Useful when zooming out from a star system back to the galaxy view.
@@ -80,8 +94,8 @@ private:
         double orbitRadius;    ///< Distance from the system center.
         double size;           ///< Visual scale factor.
         QColor color;          ///< Planet's diffuse color.
-        double speed;          ///< Speed for orbital rotation logic in QML.
         QString texturePath;   ///< Path to the 3D texture resource.
+        QVector3D position;    ///< Position relative to the star.
     };
 
     /** @brief Internal container of processed planetary data. */
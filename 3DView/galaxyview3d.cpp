@@ -1,14 +1,20 @@
 #include "galaxyview3d.h"
 #include "ui_GalaxyView3D.h"
 #include "CelestialObject3DModel.h"
+#include "CelestialObjectInstancing.h"
 #include <QQuickWidget>
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QQuickItem>
 #include <QDebug>
+#include <QDateTime>
 #include <QTimer>
 #include <QVector3D>
+#include <QFileDialog>
+#include <QMessageBox>
 
 #include "GalaxyFactory.h"
+#include "PhysicsCheckpoint.h"
 
 GalaxyView3D::GalaxyView3D(QWidget *parent)
     : QWidget(parent), ui(new Ui::GalaxyView3D) {
@@ -27,6 +33,10 @@ GalaxyView3D::GalaxyView3D(QWidget *parent)
 
     celestialModelPtr = new CelestialObject3DModel(quickWidget, emptyObjects);
 
+    // The instance tables are declared in Galaxy3DView.qml and follow celestialModel.
+    static const int instancingType = qmlRegisterType<CelestialObjectInstancing>("Galaxy3D", 1, 0, "CelestialObjectInstancing");
+    Q_UNUSED(instancingType);
+
     planetModelPtr = new PlanetarySystemModel(this);
     quickWidget->rootContext()->setContextProperty("planetModel", planetModelPtr);
     quickWidget->rootContext()->setContextProperty("celestialModel", celestialModelPtr);
@@ -34,8 +44,7 @@ GalaxyView3D::GalaxyView3D(QWidget *parent)
 
     QQuickItem *rootObject = quickWidget->rootObject();
 
-    simulationTimer = new QTimer(this);
-    connect(simulationTimer, &QTimer::timeout, this, &GalaxyView3D::onPhysicsTimerTick);
+    frameTimer = new QTimer(this);
 
     paramsButton = new QPushButton("Parameters", this);
 
@@ -54,14 +63,18 @@ GalaxyView3D::GalaxyView3D(QWidget *parent)
     infoText->setReadOnly(true);
 
     editButton = new QPushButton("Edit Object", paramsWindow);
+    saveStateButton = new QPushButton("Save Simulation", paramsWindow);
+    loadStateButton = new QPushButton("Load Simulation", paramsWindow);
 
     paramsLayout->addWidget(titleLabel);
     paramsLayout->addWidget(infoText);
     paramsLayout->addWidget(editButton);
+    paramsLayout->addWidget(saveStateButton);
+    paramsLayout->addWidget(loadStateButton);
     paramsWindow->setLayout(paramsLayout);
 
     paramsButton->resize(160, 40);
-    paramsWindow->resize(240, 220);
+    paramsWindow->resize(240, 300);
 
     zoomOutButton = new QPushButton("Back to Galaxy", this);
     zoomOutButton->hide();
@@ -73,7 +86,9 @@ GalaxyView3D::GalaxyView3D(QWidget *parent)
     connect(paramsButton, &QPushButton::clicked, this, &GalaxyView3D::on_paramsButton_clicked);
     connect(zoomOutButton, &QPushButton::clicked, this, &GalaxyView3D::on_zoomOutButton_clicked);
     connect(editButton, &QPushButton::clicked, this, &GalaxyView3D::on_editButton_clicked);
-    connect(simulationTimer, &QTimer::timeout, this, &GalaxyView3D::onPhysicsTimerTick);
+    connect(saveStateButton, &QPushButton::clicked, this, &GalaxyView3D::on_saveStateButton_clicked);
+    connect(loadStateButton, &QPushButton::clicked, this, &GalaxyView3D::on_loadStateButton_clicked);
+    connect(frameTimer, &QTimer::timeout, this, &GalaxyView3D::onFrameTimerTick);
 
     if (rootObject) {
         connect(rootObject, SIGNAL(objectClicked(int)),
@@ -90,6 +105,7 @@ GalaxyView3D::GalaxyView3D(QWidget *parent)
 }
 
 GalaxyView3D::~GalaxyView3D() {
+    delete simulationThread;
     if (galaxy) {
         for (CelestialObject* obj : galaxy->getObject()) {
             delete obj;
@@ -131,12 +147,23 @@ void GalaxyView3D::setupPathInfoWidget() {
     );
     pathDistanceLabel->setAlignment(Qt::AlignCenter);
 
+    nextRouteButton = new QPushButton("Route 1/1", pathInfoWidget);
+    nextRouteButton->setStyleSheet(
+        "QPushButton { background: transparent; border: 1px solid #00aaff; border-radius: 8px;"
+        "  color: #00aaff; font-family: 'Segoe UI'; font-size: 12px; padding: 2px 8px; }"
+        "QPushButton:hover { background-color: rgba(0, 170, 255, 60); }"
+    );
+    nextRouteButton->setCursor(Qt::PointingHandCursor);
+    nextRouteButton->hide();
+    connect(nextRouteButton, &QPushButton::clicked, this, &GalaxyView3D::onNextRouteClicked);
+
     layout->addWidget(pathStatusLabel);
     layout->addWidget(pathDetailsLabel);
     layout->addWidget(pathDistanceLabel);
+    layout->addWidget(nextRouteButton, 0, Qt::AlignCenter);
 
     pathInfoWidget->setLayout(layout);
-    pathInfoWidget->resize(240, 140);
+    pathInfoWidget->resize(240, 170);
     pathInfoWidget->hide();
 }
 
@@ -182,10 +209,12 @@ void GalaxyView3D::generateAndDisplayGalaxy(const nlohmann::json &data, RandomGe
     if (data.contains("Galaxy") && data["Galaxy"].is_array() && !data["Galaxy"].empty()) {
         galaxyNameFile = data["Galaxy"][0].get<std::string>();
     }
+    generationState = rng.saveState();
     std::string randomGalaxyName = rng.getRandomNameFromFile(galaxyNameFile);
 
-    galaxy = new Galaxy<GraphList<CelestialObject *> >(randomGalaxyName);
+    galaxy = new Galaxy<GraphList<CelestialObject *, double> >(randomGalaxyName);
     GalaxyFactory::populateGalaxy(*galaxy, data, rng);
+    galaxy->publishGraph();
 
     this->dataPtr = const_cast<nlohmann::json *>(&data);
     this->rngPtr = &rng;
@@ -238,8 +267,11 @@ void GalaxyView3D::generateAndDisplayGalaxy(const nlohmann::json &data, RandomGe
 
 }
 void GalaxyView3D::initPhysicsSimulation() {
-    if (!simulationTimer) return;
-    simulationTimer->stop();
+    if (!frameTimer) return;
+    frameTimer->stop();
+
+    delete simulationThread;
+    simulationThread = nullptr;
 
 
     for (auto *w : wrappersMap3D) {
@@ -250,11 +282,13 @@ void GalaxyView3D::initPhysicsSimulation() {
     wrappersMap3D.clear();
 
     delete physicsController; physicsController = nullptr;
-    delete physicsEngine; physicsEngine = nullptr;
     delete blackHoleField; blackHoleField = nullptr;
+    delete bodyGravityField; bodyGravityField = nullptr;
 
-    physicsEngine = new PhysicsEngine();
-    physicsController = new GalaxyPhysicsController(physicsEngine);
+    // All forces are central and contacts are disabled, so point masses replace Bullet here.
+    physicsController = new GalaxyPhysicsController(nullptr, PhysicsBackend::Particles);
+    // Bodies near the black hole substep on their own instead of shrinking everybody's step.
+    physicsController->setBlockTimesteps(true);
 
     double realBlackHoleMass = 1.3e12;
     double simBlackHoleMass = realBlackHoleMass * 1.0e-7;
@@ -262,6 +296,9 @@ void GalaxyView3D::initPhysicsSimulation() {
     blackHoleField = new BlackHoleGravityField(simBlackHoleMass, 0, 0, 0);
     physicsController->addGravityField(blackHoleField);
 
+    bodyGravityField = new BarnesHutGravityField(1.0e-7);
+    physicsController->addGravityField(bodyGravityField);
+
 
 if (!galaxy) return;
 
@@ -278,7 +315,7 @@ for (int i = 0; i < nVerticesTotal; ++i) {
     CelestialObject *obj = galaxy->getObject()[i];
     if (galaxy->getGraph().getVertices()[i].getId() == -1) continue;
 
-    auto *wrapper = new CelestialBodyToRigidWrapper(obj, physicsEngine->getWorld());
+    auto *wrapper = new CelestialBodyToRigidWrapper(obj);
     wrappersMap3D[i] = wrapper;
 
     double startX = 0.0, startY = 0.0, startZ = 0.0;
@@ -295,12 +332,7 @@ for (int i = 0; i < nVerticesTotal; ++i) {
     }
 
     wrapper->setPosition(startX, startY, startZ);
-
-    btRigidBody* rb = wrapper->getRigidBody();
-    rb->setActivationState(DISABLE_DEACTIVATION);
-    rb->setDamping(0.0, 0.0);
-    rb->setCollisionFlags(rb->getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
-    rb->setLinearFactor(btVector3(1, 1, 1));
+    wrapper->setDamping(0.0);
 
     double rHoriz = std::sqrt(startX * startX + startZ * startZ);
     if (rHoriz < minRadHoriz) rHoriz = minRadHoriz;
@@ -312,7 +344,6 @@ for (int i = 0; i < nVerticesTotal; ++i) {
     btVector3 tangential(-startZ, 0, startX);
     tangential.normalize();
     tangential *= vMag;
-    rb->setLinearVelocity(tangential);
 
     if (tangential.length2() < 1e-6) {
         tangential = btVector3(1, 0, 0).cross(radial);
@@ -321,21 +352,26 @@ for (int i = 0; i < nVerticesTotal; ++i) {
     tangential.normalize();
     tangential *= vMag;
 
-    rb->setLinearVelocity(tangential);
+    wrapper->setVelocity(tangential.x(), tangential.y(), tangential.z());
 
-    physicsController->addCelestialBody(wrapper);
+    physicsController->addCelestialBody(wrapper, i);
 }
 
-    simulationTimer->start(16);
+    simulationThread = new SimulationThread(physicsController, 1.0 / 60.0, 2.0);
+    simulationThread->start();
+    frameTimer->start(16);
 }
 
-void GalaxyView3D::onPhysicsTimerTick() {
-    if (!physicsController || !celestialModelPtr) return;
+void GalaxyView3D::onFrameTimerTick() {
+    updatePlanetPositions();
+    if (!celestialModelPtr || !simulationThread) return;
 
-    const double dt = 1.0 / 60.0;
-    for (int i = 0; i < 2; ++i) {
-        physicsController->simulateStep(dt);
-    }
+    // The wrappers belong to the simulation thread; positions come from its snapshot,
+    // blended between the last two steps so that motion stays smooth at any step rate.
+    simulationThread->fetchSnapshot();
+    const PhysicsSnapshot &snapshot = simulationThread->snapshot();
+    if (snapshot.step == 0) return;
+    const double alpha = simulationThread->interpolationFactor();
 
     std::vector<double> xPos, yPos, zPos;
     int nObjects = static_cast<int>(galaxy ? galaxy->getObject().size() : 0);
@@ -344,25 +380,24 @@ void GalaxyView3D::onPhysicsTimerTick() {
     yPos.resize(nObjects);
     zPos.resize(nObjects);
 
+    // A remove swaps the last body into the freed index. A snapshot taken before the last
+    // add or remove uses the old indices, so the objects keep their drawn positions until the next one.
+    const bool currentBodies = snapshot.bodiesVersion == physicsController->getBodiesVersion();
+
     for (int i = 0; i < nObjects; ++i) {
         CelestialBodyToRigidWrapper* w = nullptr;
         if (i < static_cast<int>(wrappersMap3D.size())) w = wrappersMap3D[i];
 
-        if (w) {
-            double physX = w->getX();
-            double physY = w->getY();
-            double physZ = w->getZ();
-
-            xPos[i] = physX * viewScale;
-            yPos[i] = physY * viewScale;
-            zPos[i] = physZ * viewScale;
+        int body = w && currentBodies ? w->getParticleIndex() : -1;
+        if (body >= 0 && body < static_cast<int>(snapshot.x.size()) && i < static_cast<int>(vertexPositions3D.size())) {
+            double px, py, pz;
+            snapshot.interpolate(body, alpha, px, py, pz);
+            vertexPositions3D[i] = QVector3D(px, py, pz);
         }
-        else {
-            if (i < static_cast<int>(vertexPositions3D.size())) {
-                xPos[i] = vertexPositions3D[i].x() * viewScale;
-                yPos[i] = vertexPositions3D[i].y() * viewScale;
-                zPos[i] = vertexPositions3D[i].z() * viewScale;
-            }
+        if (i < static_cast<int>(vertexPositions3D.size())) {
+            xPos[i] = vertexPositions3D[i].x() * viewScale;
+            yPos[i] = vertexPositions3D[i].y() * viewScale;
+            zPos[i] = vertexPositions3D[i].z() * viewScale;
         }
     }
 
@@ -372,11 +407,7 @@ void GalaxyView3D::onPhysicsTimerTick() {
     if (detailedVertexId != -1 && quickWidget && quickWidget->rootObject()) {
         double targetX = 0, targetY = 0, targetZ = 0;
 
-        if (detailedVertexId < static_cast<int>(wrappersMap3D.size()) && wrappersMap3D[detailedVertexId]) {
-            targetX = wrappersMap3D[detailedVertexId]->getX() * viewScale;
-            targetY = wrappersMap3D[detailedVertexId]->getY() * viewScale;
-            targetZ = wrappersMap3D[detailedVertexId]->getZ() * viewScale;
-        } else if (detailedVertexId < static_cast<int>(vertexPositions3D.size())) {
+        if (detailedVertexId < static_cast<int>(vertexPositions3D.size())) {
             targetX = vertexPositions3D[detailedVertexId].x() * viewScale;
             targetY = vertexPositions3D[detailedVertexId].y() * viewScale;
             targetZ = vertexPositions3D[detailedVertexId].z() * viewScale;
@@ -392,12 +423,21 @@ void GalaxyView3D::onPhysicsTimerTick() {
             Q_ARG(QVariant, targetY),
             Q_ARG(QVariant, targetZ));
     }
-    if (isPathActive && startNodeId != -1 && endNodeId != -1) {
-        calculateShortestPath();
+    // The routes stay as found; only their segments follow the moving objects.
+    if (isPathActive && !routes.empty()) {
+        drawRoute();
     }
 
 }
 
+void GalaxyView3D::updatePlanetPositions() {
+    if (detailedVertexId < 0 || !planetModelPtr || planetModelPtr->rowCount() == 0) return;
+
+    // Same clock as the 2D view, so both show the planets at the same place.
+    planetOrbits.propagate(QDateTime::currentMSecsSinceEpoch() / 1000.0);
+    planetModelPtr->updatePositions(planetOrbits, detailedVertexId);
+}
+
 void GalaxyView3D::on_vertexDoubleClicked(int vertexId) {
     if (!galaxy || vertexId < 0 || vertexId >= galaxy->getObject().size()) return;
 
@@ -408,11 +448,7 @@ void GalaxyView3D::on_vertexDoubleClicked(int vertexId) {
 
     double targetX = 0, targetY = 0, targetZ = 0;
 
-    if (vertexId < wrappersMap3D.size() && wrappersMap3D[vertexId]) {
-        targetX = wrappersMap3D[vertexId]->getX() * viewScale;
-        targetY = wrappersMap3D[vertexId]->getY() * viewScale;
-        targetZ = wrappersMap3D[vertexId]->getZ() * viewScale;
-    } else if (vertexId < vertexPositions3D.size()) {
+    if (vertexId < vertexPositions3D.size()) {
         targetX = vertexPositions3D[vertexId].x() * viewScale;
         targetY = vertexPositions3D[vertexId].y() * viewScale;
         targetZ = vertexPositions3D[vertexId].z() * viewScale;
@@ -435,7 +471,9 @@ void GalaxyView3D::on_vertexDoubleClicked(int vertexId) {
     if (obj->getType() == "StarSystem") {
         objType = 1;
         StarSystem* system = dynamic_cast<StarSystem*>(obj);
+        planetOrbits.build(galaxy->getObject());
         planetModelPtr->updateSystem(system);
+        updatePlanetPositions();
         objColor = getStarColorByType(system->getStar().getStarType());
         texturePath = "";
 
@@ -569,17 +607,67 @@ void GalaxyView3D::on_editButton_clicked() {
 
     GalaxyEditDialog dlg(galaxy, rngPtr, dataPtr, this);
 
+    connect(&dlg, &GalaxyEditDialog::objectRemoved, this, &GalaxyView3D::removePhysicsBody, Qt::DirectConnection);
     connect(&dlg, &GalaxyEditDialog::galaxyModified, this, [this]() {
         updateParametersWindow();
         checkForNewObjects();
         ui->galaxyNameLabel->setText(QString::fromStdString(galaxy->getName()));
+        if (isPathActive) calculateShortestPath();
     });
 
     if (dlg.exec() == QDialog::Accepted) {
         updateParametersWindow();
         checkForNewObjects();
         ui->galaxyNameLabel->setText(QString::fromStdString(galaxy->getName()));
+        if (isPathActive) calculateShortestPath();
+    }
+}
+
+void GalaxyView3D::on_saveStateButton_clicked() {
+    if (!physicsController || !rngPtr) return;
+    QString path = QFileDialog::getSaveFileName(this, "Save Simulation", QString(), "Galaxy checkpoints (*.chk)");
+    if (path.isEmpty()) return;
+
+    std::string error;
+    bool saved;
+    {
+        std::unique_lock<std::mutex> lock;
+        if (simulationThread) lock = simulationThread->lockController();
+        double time = simulationThread ? simulationThread->snapshot().simulationTime : 0.0;
+        saved = PhysicsCheckpoint::save(path.toStdString(), *physicsController, blackHoleField,
+                                        rngPtr->saveState(), generationState, time, &error);
     }
+    if (!saved) QMessageBox::warning(this, "Save Simulation", QString::fromStdString(error));
+}
+
+void GalaxyView3D::on_loadStateButton_clicked() {
+    if (!dataPtr || !rngPtr) return;
+    QString path = QFileDialog::getOpenFileName(this, "Load Simulation", QString(), "Galaxy checkpoints (*.chk)");
+    if (path.isEmpty()) return;
+
+    PhysicsCheckpoint checkpoint;
+    if (!checkpoint.load(path.toStdString())) {
+        QMessageBox::warning(this, "Load Simulation", QString::fromStdString(checkpoint.errorString()));
+        return;
+    }
+    if (!rngPtr->restoreState(checkpoint.generationState())) {
+        QMessageBox::warning(this, "Load Simulation", "The file does not say which galaxy it was saved from.");
+        return;
+    }
+    // The old galaxy's objects are deleted while regenerating, so its simulation stops first.
+    delete simulationThread;
+    simulationThread = nullptr;
+    if (detailedVertexId != -1) on_zoomOutButton_clicked();
+    resetPathSelection();
+    generateAndDisplayGalaxy(*dataPtr, *rngPtr);
+
+    // Restore with the simulation stopped, then let its clock continue from the saved time.
+    if (simulationThread) simulationThread->stop();
+    const bool restored = checkpoint.restore(*physicsController, blackHoleField);
+    if (restored) rngPtr->restoreState(checkpoint.rngState());
+    if (simulationThread) simulationThread->start(restored ? checkpoint.simulationTime() : 0.0);
+    // Objects added or removed after generation are not regenerated, so the bodies no longer match.
+    if (!restored) QMessageBox::warning(this, "Load Simulation", QString::fromStdString(checkpoint.errorString()));
 }
 
 void GalaxyView3D::checkForNewObjects() {
@@ -591,12 +679,15 @@ void GalaxyView3D::checkForNewObjects() {
     if (totalObjects > knownObjects) {
         qDebug() << "Found new objects in 3D View! Adding physics...";
 
+        std::unique_lock<std::mutex> lock;
+        if (simulationThread) lock = simulationThread->lockController();
+
         wrappersMap3D.resize(totalObjects, nullptr);
 
         for (int i = knownObjects; i < totalObjects; ++i) {
             CelestialObject *obj = galaxy->getObject()[i];
 
-            auto *wrapper = new CelestialBodyToRigidWrapper(obj, physicsEngine->getWorld());
+            auto *wrapper = new CelestialBodyToRigidWrapper(obj);
             wrappersMap3D[i] = wrapper;
 
             const double galaxyRadius = 4000.0;
@@ -613,7 +704,7 @@ void GalaxyView3D::checkForNewObjects() {
 
             setupPhysicsForBody(wrapper, x, y, z);
 
-            physicsController->addCelestialBody(wrapper);
+            physicsController->addCelestialBody(wrapper, i);
 
             vertexPositions3D.emplace_back(x, y, z);
         }
@@ -625,19 +716,46 @@ void GalaxyView3D::checkForNewObjects() {
             zPos.push_back(pos.z());
         }
 
-        celestialModelPtr->updateObjects(galaxy->getObject());
+        std::vector<CelestialObject *> objects = activeObjects();
+        celestialModelPtr->updateObjects(objects);
         celestialModelPtr->updatePositions(xPos, yPos, zPos);
     }
 }
 
+void GalaxyView3D::removePhysicsBody(int index) {
+    if (!physicsController) return;
+
+    {
+        std::unique_lock<std::mutex> lock;
+        if (simulationThread) lock = simulationThread->lockController();
+        delete physicsController->removeCelestialBody(index);
+        if (index >= 0 && index < static_cast<int>(wrappersMap3D.size())) wrappersMap3D[index] = nullptr;
+    }
+
+    if (detailedVertexId == index) detailedVertexId = -1;
+    if (startNodeId == index || endNodeId == index) resetPathSelection();
+    if (celestialModelPtr) {
+        std::vector<CelestialObject *> objects = activeObjects();
+        std::vector<double> xPos = celestialModelPtr->getCurrentX();
+        std::vector<double> yPos = celestialModelPtr->getCurrentY();
+        std::vector<double> zPos = celestialModelPtr->getCurrentZ();
+        celestialModelPtr->updateObjects(objects);
+        celestialModelPtr->updatePositions(xPos, yPos, zPos);
+    }
+}
+
+std::vector<CelestialObject *> GalaxyView3D::activeObjects() const {
+    std::vector<CelestialObject *> objects = galaxy->getObject();
+    const auto &vertices = galaxy->getGraph().getVertices();
+    for (std::size_t i = 0; i < objects.size() && i < vertices.size(); ++i) {
+        if (vertices[i].getId() == -1) objects[i] = nullptr;
+    }
+    return objects;
+}
+
 void GalaxyView3D::setupPhysicsForBody(CelestialBodyToRigidWrapper* wrapper, double x, double y, double z) {
     wrapper->setPosition(x, y, z);
-
-    btRigidBody* rb = wrapper->getRigidBody();
-    rb->setActivationState(DISABLE_DEACTIVATION);
-    rb->setDamping(0.0, 0.0);
-    rb->setCollisionFlags(rb->getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
-    rb->setLinearFactor(btVector3(1, 1, 1));
+    wrapper->setDamping(0.0);
 
     double realBlackHoleMass = 1.3e12;
     double simBlackHoleMass = realBlackHoleMass * 1.0e-7;
@@ -660,7 +778,7 @@ void GalaxyView3D::setupPhysicsForBody(CelestialBodyToRigidWrapper* wrapper, dou
         tangential *= vMag;
     }
 
-    rb->setLinearVelocity(tangential);
+    wrapper->setVelocity(tangential.x(), tangential.y(), tangential.z());
 }
 void GalaxyView3D::on_zoomOutButton_clicked() {
     qDebug() << "Zoom out clicked";
@@ -704,7 +822,9 @@ void GalaxyView3D::editStarSystem(StarSystem* system) {
 
         showObjectParameters(system);
         celestialModelPtr->updateObjects(galaxy->getObject());
+        planetOrbits.build(galaxy->getObject());
         planetModelPtr->updateSystem(system);
+        updatePlanetPositions();
 
         QColor sColor = getStarColorByType(system->getStar().getStarType());
         QString texturePath = "";
@@ -822,13 +942,24 @@ void GalaxyView3D::onVertexClicked(int vertexId) {
     }
 }
 void GalaxyView3D::calculateShortestPath() {
-    DijkstraPathList<CelestialObject*> solver;
-    std::vector<int> pathIndices = solver.findShortestPath(galaxy->getGraph(), startNodeId, endNodeId);
+    auto snapshot = galaxy->getGraphSnapshot();
+    routes = routePlanner.findKShortestPaths(snapshot->graph, startNodeId, endNodeId, MAX_ROUTES);
 
-    if (pathIndices.empty()) {
+    if (routes.empty()) {
         pathStatusLabel->setText("No Path Found");
+        pathDistanceLabel->clear();
+        nextRouteButton->hide();
+        QMetaObject::invokeMethod(quickWidget->rootObject(), "clearPath");
         return;
     }
+    if (currentRoute >= static_cast<int>(routes.size())) currentRoute = 0;
+    nextRouteButton->setVisible(routes.size() > 1);
+    nextRouteButton->setText(QString("Route %1/%2").arg(currentRoute + 1).arg(routes.size()));
+    drawRoute();
+}
+
+void GalaxyView3D::drawRoute() {
+    const std::vector<int> &pathIndices = routes[currentRoute].vertices;
 
     double realTimeDistance = 0.0;
     QVariantList qmlSegments;
@@ -852,10 +983,19 @@ void GalaxyView3D::calculateShortestPath() {
 
     QMetaObject::invokeMethod(quickWidget->rootObject(), "drawPath", Q_ARG(QVariant, qmlSegments));
 }
+void GalaxyView3D::onNextRouteClicked() {
+    if (routes.size() < 2) return;
+    currentRoute = (currentRoute + 1) % static_cast<int>(routes.size());
+    calculateShortestPath();
+}
+
 void GalaxyView3D::resetPathSelection() {
     startNodeId = -1;
     endNodeId = -1;
     isPathActive = false;
+    routes.clear();
+    currentRoute = 0;
+    if (nextRouteButton) nextRouteButton->hide();
     if (pathInfoWidget) pathInfoWidget->hide();
 
     QMetaObject::invokeMethod(quickWidget->rootObject(), "clearPath");
@@ -868,12 +1008,7 @@ void GalaxyView3D::onBackgroundClicked() {
 QVector3D GalaxyView3D::getObjectPosition(int index) {
     double x = 0, y = 0, z = 0;
 
-    if (index < wrappersMap3D.size() && wrappersMap3D[index]) {
-        x = wrappersMap3D[index]->getX();
-        y = wrappersMap3D[index]->getY();
-        z = wrappersMap3D[index]->getZ();
-    }
-    else if (index < vertexPositions3D.size()) {
+    if (index < vertexPositions3D.size()) {
         x = vertexPositions3D[index].x();
         y = vertexPositions3D[index].y();
         z = vertexPositions3D[index].z();
@@ -905,6 +1040,8 @@ void GalaxyView3D::applySpaceStyle() {
 
     paramsButton->setStyleSheet(btnStyle);
     editButton->setStyleSheet(btnStyle);
+    saveStateButton->setStyleSheet(btnStyle);
+    loadStateButton->setStyleSheet(btnStyle);
     zoomOutButton->setStyleSheet(btnStyle);
 
     QString windowStyle =
@@ -8,7 +8,7 @@
 #include <QQuickWidget>
 #include <QPushButton>
 #include <QTextEdit>
-#include "DijkstraPathList.h"
+#include "KShortestPathsList.h"
 #include <QLabel>
 #include "RandomUtilities.h"
 #include "CelestialObject.h"
@@ -18,12 +18,15 @@
 #include "CelestialObject3DModel.h"
 #include "PhysicsEngine.h"
 #include "BlackHoleGravityField.h"
+#include "BarnesHutGravityField.h"
 #include "CelestialBodyToRigidWrapper.h"
 #include "GalaxyPhysicsController.h"
+#include "SimulationThread.h"
 #include "GalaxyEditDialog.h"
 #include "EditStarSystemDialog.h"
 #include "EditNebulaDialog.h"
 #include "PlanetarySystemModel.h"
+#include "PlanetOrbitPropagator.h"
 
 class StarSystem;
 class Nebula;
@@ -59,7 +62,7 @@ public:
     /** @brief Destructor: Ensures proper cleanup of 3D models and physics resources. */
     ~GalaxyView3D() override;
 
-    /** @brief Container for the 3D coordinates of all celestial nodes in the galaxy. */
+    /** @brief Container for the 3D coordinates of all celestial nodes in the galaxy (physics units, updated every frame). */
     std::vector<QVector3D> vertexPositions3D;
 
     /**
@@ -76,6 +79,16 @@ private slots:
     /** @brief Opens the main galaxy settings editor. */
     void on_editButton_clicked();
 
+    /** @brief Writes the physics state to a checkpoint file chosen by the user. */
+    void on_saveStateButton_clicked();
+
+    /**
+     * @brief Regenerates the galaxy a checkpoint was saved from and continues its physics state.
+     * The random generator is reset to the checkpoint's generation state first, so the same
+     * objects are generated and registered under the same keys.
+     */
+    void on_loadStateButton_clicked();
+
     /** @brief Focuses the 3D camera and opens parameters for a specific object. */
     void on_vertexDoubleClicked(int vertexId);
 
@@ -85,8 +98,8 @@ private slots:
     /** @brief Opens the specialized editor for the currently selected StarSystem or Nebula. */
     void on_editObjectButton_clicked();
 
-    /** @brief Core simulation tick: updates physics and notifies the QML layer. */
-    void onPhysicsTimerTick();
+    /** @brief Frame tick: interpolates the newest physics snapshot and notifies the QML layer. */
+    void onFrameTimerTick();
 
     /** @brief Handles single-click selection for pathfinding (start/end nodes). */
     void onVertexClicked(int vertexId);
@@ -94,9 +107,12 @@ private slots:
     /** @brief Resets selections when clicking the void of space. */
     void onBackgroundClicked();
 
+    /** @brief Cycles the drawn route through the alternatives found by calculateShortestPath(). */
+    void onNextRouteClicked();
+
 private:
     Ui::GalaxyView3D *ui;
-    Galaxy<GraphList<CelestialObject *>> *galaxy = nullptr;
+    Galaxy<GraphList<CelestialObject *, double>> *galaxy = nullptr;
 
     // UI Elements
     int detailedVertexId = -1;
@@ -104,11 +120,15 @@ private:
     QWidget *paramsWindow = nullptr;
     QTextEdit *infoText = nullptr;
     QPushButton *editButton = nullptr;
+    QPushButton *saveStateButton = nullptr;
+    QPushButton *loadStateButton = nullptr;
     QPushButton *zoomOutButton = nullptr;
 
     // Data Pointers
     RandomGenerator *rngPtr = nullptr;
     nlohmann::json *dataPtr = nullptr;
+    /** @brief Generator state before the galaxy was generated (see PhysicsCheckpoint). */
+    std::string generationState;
 
     // 3D & QML Integration
     /** @brief The widget that hosts the QML-based 3D scene. */
@@ -117,12 +137,17 @@ private:
     CelestialObject3DModel *celestialModelPtr = nullptr;
     /** @brief Model for representing detailed planetary orbits in 3D. */
     PlanetarySystemModel *planetModelPtr = nullptr;
+    /** @brief Orbits of all planets in the galaxy, rebuilt whenever a system is opened or edited. */
+    PlanetOrbitPropagator planetOrbits;
 
     // Physics System
-    PhysicsEngine *physicsEngine = nullptr;
     GalaxyPhysicsController *physicsController = nullptr;
     BlackHoleGravityField *blackHoleField = nullptr;
-    QTimer *simulationTimer = nullptr;
+    BarnesHutGravityField *bodyGravityField = nullptr;
+    /** @brief Steps the physics off the GUI thread. */
+    SimulationThread *simulationThread = nullptr;
+    /** @brief Shows the latest physics snapshot at the display rate. */
+    QTimer *frameTimer = nullptr;
     /** @brief Maps 3D-specific physics wrappers to galaxy entities. */
     std::vector<CelestialBodyToRigidWrapper *> wrappersMap3D;
     double viewScale = 1.0;
@@ -134,17 +159,29 @@ private:
     QLabel *pathStatusLabel = nullptr;
     QLabel *pathDetailsLabel = nullptr;
     QLabel *pathDistanceLabel = nullptr;
+    QPushButton *nextRouteButton = nullptr;
     bool isPathActive = false;
 
+    static constexpr int MAX_ROUTES = 3; ///< Number of alternative routes offered between two objects.
+    KShortestPathsList<CelestialObject *, double> routePlanner; ///< Yen's k-shortest paths engine (keeps its workspace).
+    std::vector<WeightedPath<double> > routes; ///< Routes from the last calculation, cheapest first.
+    int currentRoute = 0; ///< Index of the drawn route in `routes`.
+
     /** @brief Initializes the floating UI for pathfinding results. */
     void setupPathInfoWidget();
 
     /** @brief Clears Dijkstra selection and removes visual path highlights. */
     void resetPathSelection();
 
-    /** @brief Calculates the shortest path and triggers 3D path visualization. */
+    /**
+     * @brief Calculates up to MAX_ROUTES routes and draws the selected one in 3D.
+     * Runs on selection, route cycling and graph edits only, never per frame.
+     */
     void calculateShortestPath();
 
+    /** @brief Draws routes[currentRoute] and its length at the current object positions (every frame). */
+    void drawRoute();
+
     /** * @brief Sends pathfinding data to the QML layer for rendering as 3D lines.
      * @param pathIndices Vector of vertex IDs forming the path.
      */
@@ -174,6 +211,19 @@ private:
     /** @brief Checks if any new objects were added to sync them with the 3D scene. */
     void checkForNewObjects();
 
+    /**
+     * @brief Removes the physics body and the 3D model of a removed object.
+     * Pauses the simulation thread while the body is taken out.
+     * @param index Index of the object in the galaxy.
+     */
+    void removePhysicsBody(int index);
+
+    /** @brief Returns the galaxy's objects with removed ones replaced by nullptr (not drawn by the model). */
+    std::vector<CelestialObject *> activeObjects() const;
+
+    /** @brief Propagates the planet orbits to the current time and moves the planets of the detailed system. */
+    void updatePlanetPositions();
+
     /** * @brief Internal helper to set initial 3D physics state for a body.
      * @param wrapper The physics wrapper.
      * @param x, y, z Initial coordinates.
@@ -3,7 +3,7 @@
 
 #include "GraphAlgorithms.h"
 #include "GraphList.h"
-#include "Queue.h"
+#include "GraphTraversal.h"
 #include <vector>
 /**
  * @file BFS.h
@@ -15,9 +15,10 @@
  * @brief A strategy class that executes BFS on a GraphList.
  *
  * @tparam T The data type stored in graph vertices.
+ * @tparam W The edge weight type of the graph (int by default).
  */
-template<typename T>
-class BFSListAlgorithm : public GraphAlgorithm<GraphList<T>, T> {
+template<typename T, typename W = int>
+class BFSListAlgorithm : public GraphAlgorithm<GraphList<T, W>, T> {
 public:
     /**
      * @brief Performs a Breadth-First Search (BFS) on a graph
@@ -30,27 +31,13 @@ public:
      *
      * @return Always returns 0.
      */
-    int run(GraphList<T>& g, int startId, int endId = -1) override {
+    int run(GraphList<T, W>& g, int startId, int endId = -1) override {
         int start = g.findIndexById(startId);
         if (start == -1) return 0;
 
-        std::vector<bool> visited(g.getVertices().size(), false);
-        Queue<int> q;
-        q.push(start, 0);
-        visited[start] = true;
-
         std::cout << "BFS order: ";
-        while (!q.empty()) {
-            auto [u, d] = q.popMin();
-
+        for (int u: breadthFirstOrder(g, start)) {
             this->printVertexData(g.getVertices()[u].getData());
-
-            for (auto &[v, w]: g.adjacencyList[u]) {
-                if (!visited[v]) {
-                    visited[v] = true;
-                    q.push(v, 0);
-                }
-            }
         }
         std::cout << std::endl;
         return 0;
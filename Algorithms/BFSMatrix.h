@@ -3,7 +3,7 @@
 
 #include "GraphAlgorithms.h"
 #include "GraphMatrix.h"
-#include "Queue.h"
+#include "GraphTraversal.h"
 #include <vector>
 /**
  * @file BFSMatrix.h
@@ -16,9 +16,10 @@
  * @brief Strategy class executing BFS on a GraphMatrix.
  *
  * @tparam T The data type in graph vertices.
+ * @tparam W The edge weight type of the graph (int by default).
  */
-template<typename T>
-class BFSMatrixAlgorithm : public GraphAlgorithm<GraphMatrix<T>, T> {
+template<typename T, typename W = int>
+class BFSMatrixAlgorithm : public GraphAlgorithm<GraphMatrix<T, W>, T> {
 public:
     /**
        * @brief Performs BFS on a graph represented by an adjacency matrix.
@@ -31,28 +32,13 @@ public:
        *
        * @return Always returns 0.
        */
-    int run(GraphMatrix<T>& g, int startId, int endId = -1) override {
+    int run(GraphMatrix<T, W>& g, int startId, int endId = -1) override {
         int start = g.findIndexById(startId);
         if (start == -1 || g.adjacencyMatrix.empty()) return 0;
 
-        int n = g.adjacencyMatrix.size();
-        std::vector<bool> visited(n, false);
-        Queue<int> q;
-        q.push(start, 0);
-        visited[start] = true;
-
         std::cout << "BFS order: ";
-        while (!q.empty()) {
-            auto [u, _] = q.popMin();
-
+        for (int u: breadthFirstOrder(g, start)) {
             this->printVertexData(g.getVertices()[u].getData());
-
-            for (int v = 0; v < n; ++v) {
-                if (g.adjacencyMatrix[u][v] && !visited[v]) {
-                    visited[v] = true;
-                    q.push(v, 0);
-                }
-            }
         }
         std::cout << std::endl;
         return 0;
@@ -3,6 +3,7 @@
 
 #include "GraphAlgorithms.h"
 #include "GraphList.h"
+#include "GraphTraversal.h"
 #include <vector>
 /**
  * @file DFS.h
@@ -15,9 +16,10 @@
  * @brief A strategy class that executes DFS on a GraphList.
  *
  * @tparam T The type stored in graph vertices.
+ * @tparam W The edge weight type of the graph (int by default).
  */
-template<typename T>
-class DFSListAlgorithm : public GraphAlgorithm<GraphList<T>, T> {
+template<typename T, typename W = int>
+class DFSListAlgorithm : public GraphAlgorithm<GraphList<T, W>, T> {
 public:
     /**
      * @brief Performs iterative DFS on a graph represented by an adjacency list.
@@ -30,27 +32,13 @@ public:
      *
      * @return Always returns 0.
      */
-    int run(GraphList<T>& g, int startId, int endId = -1) override {
+    int run(GraphList<T, W>& g, int startId, int endId = -1) override {
         int start = g.findIndexById(startId);
         if (start == -1) return 0;
 
-        std::vector<bool> visited(g.getVertices().size(), false);
-        std::vector<int> stack;
-        stack.push_back(start);
-
         std::cout << "DFS order: ";
-        while (!stack.empty()) {
-            int v = stack.back();
-            stack.pop_back();
-            if (visited[v]) continue;
-            visited[v] = true;
-
+        for (int v: depthFirstOrder(g, start)) {
             this->printVertexData(g.getVertices()[v].getData());
-
-            for (int i = (int) g.adjacencyList[v].size() - 1; i >= 0; --i) {
-                int neighbor = g.adjacencyList[v][i].first;
-                if (!visited[neighbor]) stack.push_back(neighbor);
-            }
         }
         std::cout << std::endl;
         return 0;
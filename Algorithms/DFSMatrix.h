@@ -3,6 +3,7 @@
 
 #include "GraphAlgorithms.h"
 #include "GraphMatrix.h"
+#include "GraphTraversal.h"
 #include <vector>
 /**
  * @file DFSMatrix.h
@@ -15,9 +16,10 @@
  * @brief Strategy class executing DFS on a GraphMatrix.
  *
  * @tparam T Stored data type.
+ * @tparam W The edge weight type of the graph (int by default).
  */
-template<typename T>
-class DFSMatrixAlgorithm : public GraphAlgorithm<GraphMatrix<T>, T> {
+template<typename T, typename W = int>
+class DFSMatrixAlgorithm : public GraphAlgorithm<GraphMatrix<T, W>, T> {
 public:
     /**
        * @brief Performs iterative DFS on an adjacency-matrix graph.
@@ -30,30 +32,13 @@ public:
        *
        * @return Always returns 0.
        */
-    int run(GraphMatrix<T>& g, int startId, int endId = -1) override {
+    int run(GraphMatrix<T, W>& g, int startId, int endId = -1) override {
         int start = g.findIndexById(startId);
         if (start == -1 || g.adjacencyMatrix.empty()) return 0;
 
-        int n = g.adjacencyMatrix.size();
-        std::vector<bool> visited(n, false);
-        std::vector<int> stack;
-        stack.push_back(start);
-
         std::cout << "DFS (matrix) order: ";
-        while (!stack.empty()) {
-            int v = stack.back();
-            stack.pop_back();
-
-            if (visited[v]) continue;
-            visited[v] = true;
-
+        for (int v: depthFirstOrder(g, start)) {
             this->printVertexData(g.getVertices()[v].getData());
-
-            for (int u = n - 1; u >= 0; --u) {
-                if (g.adjacencyMatrix[v][u] && !visited[u]) {
-                    stack.push_back(u);
-                }
-            }
         }
         std::cout << std::endl;
         return 0;
@@ -0,0 +1,135 @@
+#ifndef DIJKSTRA_DENSE_MATRIX_H
+#define DIJKSTRA_DENSE_MATRIX_H
+
+#include "GraphAlgorithms.h"
+#include "GraphMatrix.h"
+#include "GraphTraversal.h"
+#include "SimdKernels.h"
+#include <limits>
+#include <type_traits>
+#include <vector>
+/**
+ * @file DijkstraDenseMatrix.h
+ * @brief Defines a heap-free Dijkstra for GraphMatrix that relaxes whole
+ * matrix rows at once.
+ */
+
+/**
+ * @brief Relaxes every vertex through u using one contiguous matrix row.
+ *
+ * float and double rows go to the AVX2/SSE4.1 kernels in SimdKernels (chosen at
+ * runtime); other weight types use the same branch-free loop in scalar form.
+ * Settled vertices never change because their distance is already <= du and
+ * weights are non-negative.
+ *
+ * @tparam W The weight type (int, float or double).
+ * @param row Row u of the adjacency matrix (0 = no edge).
+ * @param du The settled distance of u.
+ * @param u The internal index of the settled vertex.
+ * @param dist Tentative distances, updated in place.
+ * @param parent Parents, set to u wherever dist improved.
+ * @param n The row length.
+ */
+template<typename W>
+void relaxMatrixRow(const W *row, W du, int u, W *dist, int *parent, int n) {
+    if constexpr (std::is_same_v<W, float> || std::is_same_v<W, double>) {
+        SimdKernels::relaxRow(row, du, u, dist, parent, n);
+    } else {
+        const W inf = std::numeric_limits<W>::max();
+        for (int v = 0; v < n; ++v) {
+            W w = row[v];
+            W candidate = (w != W{}) ? du + w : inf;
+            bool better = candidate < dist[v];
+            dist[v] = better ? candidate : dist[v];
+            parent[v] = better ? u : parent[v];
+        }
+    }
+}
+
+/**
+ * @brief Dijkstra's algorithm in O(V^2) for dense adjacency matrices.
+ *
+ * Instead of a priority queue, the next vertex is picked by a linear scan and
+ * its row is relaxed with relaxMatrixRow(). For matrix graphs this does the
+ * same asymptotic work as the heap version but with sequential memory access.
+ *
+ * @param g The matrix graph to search.
+ * @param start Internal index of the source vertex.
+ * @param target Optional internal index; the search stops once it is settled (-1 = full search).
+ * @return Distances and parents for every vertex.
+ * @note Works only with non-negative weights.
+ */
+template<typename T, typename W>
+ShortestPathTree<W> denseDijkstraShortestPaths(const GraphMatrix<T, W> &g, int start, int target = -1) {
+    static_assert(std::is_arithmetic_v<W>, "Dense Dijkstra needs an arithmetic weight type");
+    int n = static_cast<int>(g.adjacencyMatrix.size());
+    ShortestPathTree<W> tree{std::vector<W>(n, ShortestPathTree<W>::unreachable), std::vector<int>(n, -1)};
+    if (start < 0 || start >= n) return tree;
+
+    std::vector<char> settled(n, 0);
+    tree.dist[start] = W{};
+
+    for (int round = 0; round < n; ++round) {
+        int u = -1;
+        W best = ShortestPathTree<W>::unreachable;
+        for (int v = 0; v < n; ++v) {
+            if (!settled[v] && tree.dist[v] < best) {
+                best = tree.dist[v];
+                u = v;
+            }
+        }
+        if (u == -1) break;
+        settled[u] = 1;
+        if (u == target) break;
+
+        relaxMatrixRow(g.adjacencyMatrix[u].data(), best, u, tree.dist.data(), tree.parent.data(), n);
+    }
+    return tree;
+}
+
+/**
+ * @class DijkstraDenseMatrixAlgorithm
+ * @brief Strategy class running the row-relaxing Dijkstra on a GraphMatrix.
+ *
+ * @tparam T The data stored in graph vertices.
+ * @tparam W The edge weight type; float or double rows give exact real distances.
+ *
+ * Same contract as DijkstraMatrixAlgorithm, but prefer it for dense graphs.
+ */
+template<typename T, typename W = int>
+class DijkstraDenseMatrixAlgorithm : public GraphAlgorithm<GraphMatrix<T, W>, T> {
+public:
+    /**
+     * @brief Computes and prints the shortest path length between two vertices.
+     * @param g The GraphMatrix object to search.
+     * @param startId The ID of the starting vertex.
+     * @param endId The ID of the destination vertex.
+     * @return The length of the shortest path (rounded), or -1 if no path is found.
+     */
+    int run(GraphMatrix<T, W> &g, int startId, int endId) override {
+        W res = shortestDistance(g, startId, endId);
+        std::cout << "Shortest path weight = " << res << std::endl;
+        return this->toRunResult(res);
+    }
+
+    /**
+     * @brief Computes the shortest path length in the graph's own weight type.
+     * @param g The GraphMatrix object to search (may be an immutable snapshot).
+     * @param startId The ID of the starting vertex.
+     * @param endId The ID of the destination vertex.
+     * @return The length of the shortest path, or -1 if no path is found.
+     */
+    W shortestDistance(const GraphMatrix<T, W> &g, int startId, int endId) const {
+        int start = g.findIndexById(startId);
+        int end = g.findIndexById(endId);
+        if (start == -1 || end == -1) return W(-1);
+
+        ShortestPathTree<W> tree = denseDijkstraShortestPaths(g, start, end);
+        return tree.dist[end] == tree.unreachable ? W(-1) : tree.dist[end];
+    }
+
+    /// @brief Default destructor.
+    ~DijkstraDenseMatrixAlgorithm() = default;
+};
+
+#endif //DIJKSTRA_DENSE_MATRIX_H
@@ -3,9 +3,7 @@
 
 #include "GraphAlgorithms.h"
 #include "GraphList.h"
-#include "Queue.h"
-#include <vector>
-#include <climits>
+#include "GraphTraversal.h"
 /**
  * @file DijkstraList.h
  * @brief Defines the DijkstraAlgorithm class, which implements
@@ -18,14 +16,15 @@
  *        on a graph represented by an adjacency list.
  *
  * @tparam T The data stored in graph vertices.
+ * @tparam W The edge weight type (int, float or double).
  *
  * The algorithm computes the minimum path cost from `startId`
  * to `endId` using a priority queue. Works only with non-negative weights.
  *
  * The result (shortest distance) is returned and also printed to std::cout.
  */
-template<typename T>
-class DijkstraListAlgorithm : public GraphAlgorithm<GraphList<T>, T> {
+template<typename T, typename W = int>
+class DijkstraListAlgorithm : public GraphAlgorithm<GraphList<T, W>, T> {
 public:
     /**
            * @brief Performs Dijkstra's algorithm for a graph
@@ -39,31 +38,32 @@ public:
            * @return The length of the shortest path, or -1 if no path is found.
            * @note Works only with non-negative weights.
            */
-    int run(GraphList<T>& g, int startId, int endId) override {
+    int run(GraphList<T, W>& g, int startId, int endId) override {
+        W res = shortestDistance(g, startId, endId);
+        std::cout << "Shortest path weight = " << res << std::endl;
+        return this->toRunResult(res);
+    }
+
+    /**
+     * @brief Computes the shortest path length in the graph's own weight type.
+     *
+     * Use this instead of run() when the weights are real distances, since
+     * run() has to return an int.
+     *
+     * @param g The GraphList object to search (may be an immutable snapshot).
+     * @param startId The ID of the starting vertex.
+     * @param endId The ID of the destination vertex.
+     * @return The length of the shortest path, or -1 if no path is found.
+     */
+    W shortestDistance(const GraphList<T, W>& g, int startId, int endId) const {
         int start = g.findIndexById(startId);
         int end = g.findIndexById(endId);
-        if (start == -1 || end == -1) return -1;
+        if (start == -1 || end == -1) return W(-1);
 
-        int V = g.getVertices().size();
-        std::vector<int> dist(V, INT_MAX);
-        dist[start] = 0;
-
-        Queue<int> q;
-        q.push(start, 0);
-        while (!q.empty()) {
-            auto [u, d] = q.popMin();
-            for (auto &[v, w]: g.adjacencyList[u]) {
-                if (dist[v] > dist[u] + w) {
-                    dist[v] = dist[u] + w;
-                    q.push(v, dist[v]);
-                }
-            }
-        }
-
-        int res = (dist[end] == INT_MAX) ? -1 : dist[end];
-        std::cout << "Shortest path weight = " << res << std::endl;
-        return res;
+        auto tree = dijkstraShortestPaths(g, start, end);
+        return tree.dist[end] == tree.unreachable ? W(-1) : tree.dist[end];
     }
+
     /// @brief Default destructor.
     ~DijkstraListAlgorithm()= default;
 };
@@ -3,9 +3,7 @@
 
 #include "GraphAlgorithms.h"
 #include "GraphMatrix.h"
-#include "Queue.h"
-#include <vector>
-#include <climits>
+#include "DijkstraDenseMatrix.h"
 /**
  * @file DijkstraMatrix.h
  * @brief Defines the DijkstraMatrixAlgorithm class, which implements
@@ -18,12 +16,15 @@
  *        graphs represented by an adjacency matrix.
  *
  * @tparam T The data stored in graph vertices.
+ * @tparam W The edge weight type (int, float or double).
  *
  * Computes the minimum path cost from `startId` to `endId`.
  * Returns -1 if no path exists. Assumes non-negative weights.
+ * Uses the O(V^2) row-relaxing search from DijkstraDenseMatrix.h, which runs
+ * the SIMD kernels for float/double matrices.
  */
-template< typename T>
-class DijkstraMatrixAlgorithm : public GraphAlgorithm<GraphMatrix<T>, T> {
+template<typename T, typename W = int>
+class DijkstraMatrixAlgorithm : public GraphAlgorithm<GraphMatrix<T, W>, T> {
 public:
     /**
                 * @brief Performs Dijkstra's algorithm for a graph
@@ -36,32 +37,30 @@ public:
                 * @param endId The ID of the destination vertex.
                 * @return The length of the shortest path, or -1 if no path is found.
                 */
-    int run(GraphMatrix<T>& g, int startId, int endId) override {
+    int run(GraphMatrix<T, W>& g, int startId, int endId) override {
+        W res = shortestDistance(g, startId, endId);
+        std::cout << "Shortest path weight = " << res << std::endl;
+        return this->toRunResult(res);
+    }
+
+    /**
+     * @brief Computes the shortest path length in the graph's own weight type.
+     *
+     * Use this instead of run() when the weights are real distances, since
+     * run() has to return an int.
+     *
+     * @param g The GraphMatrix object to search (may be an immutable snapshot).
+     * @param startId The ID of the starting vertex.
+     * @param endId The ID of the destination vertex.
+     * @return The length of the shortest path, or -1 if no path is found.
+     */
+    W shortestDistance(const GraphMatrix<T, W>& g, int startId, int endId) const {
         int start = g.findIndexById(startId);
         int end = g.findIndexById(endId);
-        if (start == -1 || end == -1) return -1;
+        if (start == -1 || end == -1) return W(-1);
 
-        int V = g.getVertices().size();
-        std::vector<int> dist(V, INT_MAX);
-        dist[start] = 0;
-
-        Queue<int> q;
-        q.push(start, 0);
-        while (!q.empty()) {
-            auto [u, d] = q.popMin();
-            int n = g.adjacencyMatrix.size();
-            for (int v = 0; v < n; ++v) {
-                int w = g.adjacencyMatrix[u][v];
-                if (w > 0 && dist[v] > dist[u] + w) {
-                    dist[v] = dist[u] + w;
-                    q.push(v, dist[v]);
-                }
-            }
-        }
-
-        int res = dist[end] == INT_MAX ? -1 : dist[end];
-        std::cout << "Shortest path weight = " << res << std::endl;
-        return res;
+        auto tree = denseDijkstraShortestPaths(g, start, end);
+        return tree.dist[end] == tree.unreachable ? W(-1) : tree.dist[end];
     }
 
     /// @brief Default destructor.
@@ -2,9 +2,8 @@
 #define DIJKSTRAPATHLIST_H
 
 #include "GraphList.h"
-#include "Queue.h"
+#include "GraphTraversal.h"
 #include <vector>
-#include <climits>
 #include <algorithm>
 
 /**
@@ -19,21 +18,22 @@
  * between two vertices in a graph using an adjacency list.
  *
  * @tparam T The data type stored in the graph vertices.
+ * @tparam W The edge weight type of the graph (int by default).
  *
  * Unlike standard implementations that only return the minimum distance,
  * this class reconstructs the full sequence of vertex indices from the
  * source to the destination.
  */
-template<typename T>
+template<typename T, typename W = int>
 class DijkstraPathList {
 public:
     /**
      * @brief Finds the shortest path between two vertices.
      *
-     * This method uses a priority queue and a parent tracking array
-     * to determine the optimal route.
+     * Runs dijkstraShortestPaths() with an early exit at the target and
+     * walks the parent array back from the destination.
      *
-     * @param g The GraphList object to perform the search on.
+     * @param g The GraphList object to perform the search on (may be an immutable snapshot).
      * @param startId The ID of the starting vertex.
      * @param endId The ID of the target vertex.
      * @return std::vector<int> A vector containing the indices of the vertices
@@ -41,38 +41,16 @@ public:
      * or if IDs are invalid.
      * * @note The algorithm assumes non-negative edge weights.
      */
-    std::vector<int> findShortestPath(GraphList<T>& g, int startId, int endId) {
+    std::vector<int> findShortestPath(const GraphList<T, W>& g, int startId, int endId) {
         int start = g.findIndexById(startId);
         int end = g.findIndexById(endId);
         if (start == -1 || end == -1) return {};
 
-        int V = g.getVertices().size();
-        std::vector<int> dist(V, INT_MAX);
-        std::vector<int> parent(V, -1);
-        dist[start] = 0;
-
-        Queue<int> q;
-        q.push(start, 0);
-
-        while (!q.empty()) {
-            auto [u, d] = q.popMin();
-
-            if (d > dist[u]) continue;
-            if (u == end) break;
-
-            for (auto &[v, w]: g.adjacencyList[u]) {
-                if (dist[v] > dist[u] + w) {
-                    dist[v] = dist[u] + w;
-                    parent[v] = u;
-                    q.push(v, dist[v]);
-                }
-            }
-        }
-
-        if (dist[end] == INT_MAX) return {};
+        auto tree = dijkstraShortestPaths(g, start, end);
+        if (tree.dist[end] == tree.unreachable) return {};
 
         std::vector<int> path;
-        for (int cur = end; cur != -1; cur = parent[cur]) {
+        for (int cur = end; cur != -1; cur = tree.parent[cur]) {
             path.push_back(cur);
         }
         std::reverse(path.begin(), path.end());
@@ -0,0 +1,166 @@
+#ifndef FLOYD_WARSHALL_MATRIX_H
+#define FLOYD_WARSHALL_MATRIX_H
+
+#include "GraphAlgorithms.h"
+#include "GraphMatrix.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+/**
+ * @file FloydWarshallMatrix.h
+ * @brief Defines a cache-blocked, vectorized Floyd–Warshall (all-pairs shortest
+ * paths) for GraphMatrix.
+ */
+
+/**
+ * @struct AllPairsDistances
+ * @brief Row-major n x n distance table produced by floydWarshall().
+ * @tparam W The edge weight type.
+ */
+template<typename W>
+struct AllPairsDistances {
+    /// @brief Distance stored for unreachable pairs (INT_MAX for int weights).
+    static constexpr W unreachable = std::numeric_limits<W>::max();
+
+    int n = 0; ///< Number of vertex slots.
+    std::vector<W> dist; ///< dist[i * n + j] is the distance from i to j.
+
+    /**
+     * @brief Returns the distance between two internal indices.
+     */
+    W at(int i, int j) const { return dist[static_cast<std::size_t>(i) * n + j]; }
+};
+
+/**
+ * @brief Relaxes one tile of the distance table through the pivots [k0, k1).
+ *
+ * For every pivot k and row i of the tile, the row segment [j0, j1) is updated
+ * with D[i][j] = min(D[i][j], D[i][k] + D[k][j]); for float/double this is
+ * SimdKernels::minPlusRow().
+ */
+template<typename W>
+void floydWarshallTile(W *d, int n, int i0, int i1, int j0, int j1, int k0, int k1) {
+    const W inf = std::numeric_limits<W>::max();
+    const int width = j1 - j0;
+    for (int k = k0; k < k1; ++k) {
+        const W *rowK = d + static_cast<std::size_t>(k) * n + j0;
+        for (int i = i0; i < i1; ++i) {
+            W *rowI = d + static_cast<std::size_t>(i) * n + j0;
+            W dik = d[static_cast<std::size_t>(i) * n + k];
+            if (dik == inf) continue;
+
+            if constexpr (std::is_same_v<W, float> || std::is_same_v<W, double>) {
+                SimdKernels::minPlusRow(rowK, dik, rowI, width);
+            } else {
+                for (int j = 0; j < width; ++j) {
+                    W via = rowK[j] == inf ? inf : dik + rowK[j];
+                    rowI[j] = std::min(rowI[j], via);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes all-pairs shortest paths with a blocked Floyd–Warshall.
+ *
+ * The table is split into tiles of `blockSize` x `blockSize` so that the three
+ * tiles touched by each update stay in cache. For each pivot block kb the
+ * diagonal tile is finished first, then the tiles in row/column kb, then the
+ * remaining tiles, which is the standard dependency order for blocked
+ * Floyd–Warshall.
+ *
+ * @param g The matrix graph (0 = no edge).
+ * @param blockSize Tile edge length; 64 keeps three double tiles in L2.
+ * @return The n x n distance table.
+ * @note Runs in O(V^3); weights must be non-negative.
+ */
+template<typename T, typename W>
+AllPairsDistances<W> floydWarshall(const GraphMatrix<T, W> &g, int blockSize = 64) {
+    static_assert(std::is_arithmetic_v<W>, "Floyd-Warshall needs an arithmetic weight type");
+    AllPairsDistances<W> result;
+    const int n = static_cast<int>(g.adjacencyMatrix.size());
+    result.n = n;
+    result.dist.assign(static_cast<std::size_t>(n) * n, AllPairsDistances<W>::unreachable);
+
+    for (int i = 0; i < n; ++i) {
+        W *row = result.dist.data() + static_cast<std::size_t>(i) * n;
+        for (int j = 0; j < n; ++j) {
+            W w = g.adjacencyMatrix[i][j];
+            if (w != W{}) row[j] = w;
+        }
+        row[i] = W{};
+    }
+
+    W *d = result.dist.data();
+    const int B = std::max(1, blockSize);
+    for (int kb = 0; kb < n; kb += B) {
+        const int kEnd = std::min(kb + B, n);
+
+        floydWarshallTile(d, n, kb, kEnd, kb, kEnd, kb, kEnd);
+
+        for (int jb = 0; jb < n; jb += B) {
+            if (jb == kb) continue;
+            const int jEnd = std::min(jb + B, n);
+            floydWarshallTile(d, n, kb, kEnd, jb, jEnd, kb, kEnd);
+            floydWarshallTile(d, n, jb, jEnd, kb, kEnd, kb, kEnd);
+        }
+
+        for (int ib = 0; ib < n; ib += B) {
+            if (ib == kb) continue;
+            const int iEnd = std::min(ib + B, n);
+            for (int jb = 0; jb < n; jb += B) {
+                if (jb == kb) continue;
+                floydWarshallTile(d, n, ib, iEnd, jb, std::min(jb + B, n), kb, kEnd);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @class FloydWarshallMatrixAlgorithm
+ * @brief Strategy class that computes all-pairs shortest paths on a GraphMatrix.
+ *
+ * @tparam T The data stored in graph vertices.
+ * @tparam W The edge weight type (int, float or double).
+ *
+ * run() answers a single query from the full table; call allPairs() directly to
+ * reuse the table for many queries.
+ */
+template<typename T, typename W = int>
+class FloydWarshallMatrixAlgorithm : public GraphAlgorithm<GraphMatrix<T, W>, T> {
+public:
+    /**
+     * @brief Computes all pairs and prints the distance between two vertices.
+     * @param g The GraphMatrix object.
+     * @param startId The ID of the starting vertex.
+     * @param endId The ID of the destination vertex.
+     * @return The length of the shortest path (rounded), or -1 if no path is found.
+     */
+    int run(GraphMatrix<T, W> &g, int startId, int endId) override {
+        int start = g.findIndexById(startId);
+        int end = g.findIndexById(endId);
+        if (start == -1 || end == -1) return -1;
+
+        AllPairsDistances<W> table = allPairs(g);
+        W res = table.at(start, end) == table.unreachable ? W(-1) : table.at(start, end);
+        std::cout << "Shortest path weight = " << res << std::endl;
+        return this->toRunResult(res);
+    }
+
+    /**
+     * @brief Computes the all-pairs distance table.
+     * @param g The GraphMatrix object (may be an immutable snapshot).
+     */
+    AllPairsDistances<W> allPairs(const GraphMatrix<T, W> &g) const {
+        return floydWarshall(g);
+    }
+
+    /// @brief Default destructor.
+    ~FloydWarshallMatrixAlgorithm() = default;
+};
+
+#endif //FLOYD_WARSHALL_MATRIX_H
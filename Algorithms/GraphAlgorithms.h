@@ -1,6 +1,7 @@
 #ifndef GRAPHALGORITHM_H
 #define GRAPHALGORITHM_H
 
+#include <cmath>
 #include <iostream>
 #include <type_traits>
 
@@ -46,6 +47,17 @@ protected:
         std::cout << data << " ";
     }
 
+    /**
+     * @brief Converts a weight-typed result to the int returned by run().
+     * Floating-point weights are rounded to the nearest integer instead of truncated.
+     * @param value The result in the graph's weight type.
+     */
+    template <typename W>
+    static int toRunResult(W value) {
+        if constexpr (std::is_floating_point_v<W>) return static_cast<int>(std::lround(value));
+        else return static_cast<int>(value);
+    }
+
 public:
     /**
      * @brief Virtual destructor to ensure proper cleanup of derived classes.
@@ -0,0 +1,159 @@
+#ifndef GRAPH_TRAVERSAL_H
+#define GRAPH_TRAVERSAL_H
+
+#include "GraphConcepts.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/**
+ * @file GraphTraversal.h
+ * @brief Single generic implementations of BFS, DFS, Dijkstra and the
+ * connectivity check for every AdjacencyGraph (GraphList, GraphMatrix, GraphCSR).
+ *
+ * The functions work on internal vertex indices and never print; the strategy
+ * classes (BFSListAlgorithm, DijkstraMatrixAlgorithm, ...) are thin adapters
+ * over them. Because the graph type is a template parameter, `g.neighbors(u)`
+ * is resolved at compile time and the inner loops contain no virtual calls.
+ *
+ * @code
+ * GraphCSR<std::string> csr(list);          // or use the GraphList directly
+ * std::vector<int> order = breadthFirstOrder(csr, csr.findIndexById(1));
+ * ShortestPathTree<int> tree = dijkstraShortestPaths(csr, 0);
+ * @endcode
+ */
+
+/**
+ * @struct ShortestPathTree
+ * @brief Result of a single-source Dijkstra search.
+ * @tparam W The edge weight type of the searched graph.
+ */
+template<typename W = int>
+struct ShortestPathTree {
+    /// @brief Distance stored for unreachable vertices (INT_MAX for int weights).
+    static constexpr W unreachable = std::numeric_limits<W>::max();
+
+    std::vector<W> dist; ///< Distance from the source; `unreachable` if there is no path.
+    std::vector<int> parent; ///< Predecessor on the shortest path; -1 for the source and unreachable vertices.
+};
+
+/**
+ * @brief Breadth-first visitation order starting from an internal index.
+ * @param g The graph to traverse.
+ * @param start Internal index of the starting vertex.
+ * @return Internal indices in the order they are visited (empty if start is invalid).
+ */
+template<AdjacencyGraph G>
+std::vector<int> breadthFirstOrder(const G &g, int start) {
+    int n = g.vertexCount();
+    if (start < 0 || start >= n) return {};
+
+    std::vector<char> visited(n, 0);
+    std::vector<int> order;
+    order.reserve(n);
+    order.push_back(start);
+    visited[start] = 1;
+
+    // The order vector doubles as the FIFO queue: [head, size) are pending vertices.
+    for (std::size_t head = 0; head < order.size(); ++head) {
+        int u = order[head];
+        for (auto [v, w]: g.neighbors(u)) {
+            if (!visited[v]) {
+                visited[v] = 1;
+                order.push_back(v);
+            }
+        }
+    }
+    return order;
+}
+
+/**
+ * @brief Iterative depth-first visitation order starting from an internal index.
+ *
+ * Neighbors are explored in the order the graph yields them (adjacency order for
+ * lists and CSR, ascending column for matrices).
+ *
+ * @param g The graph to traverse.
+ * @param start Internal index of the starting vertex.
+ * @return Internal indices in the order they are visited (empty if start is invalid).
+ */
+template<AdjacencyGraph G>
+std::vector<int> depthFirstOrder(const G &g, int start) {
+    int n = g.vertexCount();
+    if (start < 0 || start >= n) return {};
+
+    std::vector<char> visited(n, 0);
+    std::vector<int> order;
+    std::vector<int> stack;
+    stack.push_back(start);
+
+    while (!stack.empty()) {
+        int v = stack.back();
+        stack.pop_back();
+        if (visited[v]) continue;
+        visited[v] = 1;
+        order.push_back(v);
+
+        std::size_t mark = stack.size();
+        for (auto [u, w]: g.neighbors(v)) {
+            if (!visited[u]) stack.push_back(u);
+        }
+        std::reverse(stack.begin() + mark, stack.end());
+    }
+    return order;
+}
+
+/**
+ * @brief Dijkstra's single-source shortest paths using a binary heap.
+ * @param g The graph to search.
+ * @param start Internal index of the source vertex.
+ * @param target Optional internal index; the search stops once it is settled (-1 = full search).
+ * @return Distances and parents for every vertex, in the graph's weight type.
+ * @note Works only with non-negative weights.
+ */
+template<AdjacencyGraph G>
+ShortestPathTree<graph_weight_t<G> > dijkstraShortestPaths(const G &g, int start, int target = -1) {
+    using W = graph_weight_t<G>;
+    int n = g.vertexCount();
+    ShortestPathTree<W> tree{std::vector<W>(n, ShortestPathTree<W>::unreachable), std::vector<int>(n, -1)};
+    if (start < 0 || start >= n) return tree;
+
+    using Item = std::pair<W, int>; // (distance, vertex)
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item> > heap;
+    tree.dist[start] = W{};
+    heap.push({W{}, start});
+
+    while (!heap.empty()) {
+        auto [d, u] = heap.top();
+        heap.pop();
+        if (d > tree.dist[u]) continue;
+        if (u == target) break;
+
+        for (auto [v, w]: g.neighbors(u)) {
+            W candidate = d + w;
+            if (candidate < tree.dist[v]) {
+                tree.dist[v] = candidate;
+                tree.parent[v] = u;
+                heap.push({candidate, v});
+            }
+        }
+    }
+    return tree;
+}
+
+/**
+ * @brief Checks whether every vertex slot is reachable from vertex 0.
+ * @param g The graph to check.
+ * @return True for empty and single-vertex graphs, or if all vertices are reachable.
+ */
+template<AdjacencyGraph G>
+bool isGraphConnected(const G &g) {
+    int n = g.vertexCount();
+    if (n <= 1) return true;
+    return static_cast<int>(depthFirstOrder(g, 0).size()) == n;
+}
+
+#endif //GRAPH_TRAVERSAL_H
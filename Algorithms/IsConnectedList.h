@@ -2,6 +2,7 @@
 #define ISCONNECTED_LIST_H
 #include "GraphAlgorithms.h"
 #include "GraphList.h"
+#include "GraphTraversal.h"
 /**
  * @file isConnectedList.h
  * @brief Defines the IsConnectedList class, which implements
@@ -12,9 +13,10 @@
  * @class IsConnectedList
  * @brief A strategy class that executes a check for connectivity.
  * @tparam T The data type stored in the graph vertices.
+ * @tparam W The edge weight type of the graph (int by default).
  */
-template<typename T>
-class IsConnectedList : public GraphAlgorithm<GraphList<T>, T> {
+template<typename T, typename W = int>
+class IsConnectedList : public GraphAlgorithm<GraphList<T, W>, T> {
 public:
     /**
          * @brief Performs a connection check algorithm for a graph
@@ -25,41 +27,17 @@ public:
          * @param endId (Unused) Included to match the base class signature.
          * @return Always returns 1 = connected, 0 = not connected.
          */
-    int run(GraphList<T> &g, int startId = 0, int endId = -1) override {
-        int n = g.getVertices().size();
-        if (n == 0) return 1;
-        if (n == 1) return 1;
-
-        int start = -1;
-        for (int i = 0; i < n; ++i) {
-            if (!g.adjacencyList[i].empty()) {
-                start = i;
-                break;
-            }
-        }
-
-        if (start == -1) return 0;
-
-        std::vector<bool> visited(n, false);
-        std::vector<int> stack;
-        stack.push_back(start);
-
-        while (!stack.empty()) {
-            int v = stack.back();
-            stack.pop_back();
-            if (visited[v]) continue;
-            visited[v] = true;
-
-            for (auto &[u, w] : g.adjacencyList[v]) {
-                if (!visited[u]) stack.push_back(u);
-            }
-        }
-
-        for (int i = 0; i < n; ++i) {
-            if (!visited[i]) return 0;
-        }
+    int run(GraphList<T, W> &g, int startId = 0, int endId = -1) override {
+        return isConnected(g);
+    }
 
-        return 1;
+    /**
+         * @brief Read-only connectivity check, usable on immutable graph snapshots.
+         * @param g The GraphList object to traverse.
+         * @return 1 = connected, 0 = not connected.
+         */
+    int isConnected(const GraphList<T, W> &g) const {
+        return isGraphConnected(g) ? 1 : 0;
     }
     /// @brief Default destructor.
     virtual ~IsConnectedList() = default;
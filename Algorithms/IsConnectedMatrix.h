@@ -2,6 +2,7 @@
 #define ISCONNECTED_MATRIX_H
 #include "GraphAlgorithms.h"
 #include "GraphMatrix.h"
+#include "GraphTraversal.h"
 /**
  * @file isConnectedMatrix.h
  * @brief Defines the IsConnectedMatrix class, which implements
@@ -12,9 +13,10 @@
  * @class IsConnectedMatrix
  * @brief A strategy class that executes a check for connectivity.
  * @tparam T The data type stored in the graph vertices.
+ * @tparam W The edge weight type of the graph (int by default).
  */
-template<typename T>
-class IsConnectedMatrix : public GraphAlgorithm<GraphMatrix<T>, T> {
+template<typename T, typename W = int>
+class IsConnectedMatrix : public GraphAlgorithm<GraphMatrix<T, W>, T> {
 public:
     /**
          * @brief Performs a connection check algorithm for a graph
@@ -25,31 +27,17 @@ public:
          * @param endId (Unused) Included to match the base class signature.
          * @return Always returns 1 if true, else 0.
          */
-    int run(GraphMatrix<T> &g, int startId = 0, int endId = -1) override {
-        int n = g.adjacencyMatrix.size();
-        if (n == 0) return 1;
-
-        std::vector<bool> visited(n, false);
-        std::vector<int> stack;
-        stack.push_back(0);
-
-        while (!stack.empty()) {
-            int v = stack.back();
-            stack.pop_back();
-            if (visited[v]) continue;
-            visited[v] = true;
-
-            for (int u = 0; u < n; ++u)
-                if (g.adjacencyMatrix[v][u] && !visited[u])
-                    stack.push_back(u);
-        }
-
-        for (int i = 0; i < n; ++i) {
-            if (!visited[i])
-                return 0;
-        }
+    int run(GraphMatrix<T, W> &g, int startId = 0, int endId = -1) override {
+        return isConnected(g);
+    }
 
-        return 1;
+    /**
+         * @brief Read-only connectivity check, usable on immutable graph snapshots.
+         * @param g The GraphMatrix object to traverse.
+         * @return 1 if connected, else 0.
+         */
+    int isConnected(const GraphMatrix<T, W> &g) const {
+        return isGraphConnected(g) ? 1 : 0;
     }
     /// @brief Default destructor.
     virtual ~IsConnectedMatrix() = default;
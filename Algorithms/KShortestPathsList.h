@@ -0,0 +1,241 @@
+#ifndef KSHORTESTPATHSLIST_H
+#define KSHORTESTPATHSLIST_H
+
+#include "GraphList.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * @file KShortestPathsList.h
+ * @brief Defines the KShortestPathsList class, which finds the k shortest
+ * loopless paths between two vertices (Yen's algorithm).
+ */
+
+/**
+ * @struct WeightedPath
+ * @brief A path through the graph together with its total cost.
+ * @tparam W The edge weight type.
+ */
+template<typename W>
+struct WeightedPath {
+    std::vector<int> vertices; ///< Internal vertex indices from source to destination.
+    W cost{}; ///< Sum of the edge weights along the path.
+};
+
+/**
+ * @class KShortestPathsList
+ * @brief Computes up to k loopless shortest paths on a GraphList using Yen's algorithm.
+ *
+ * The first path is the ordinary Dijkstra path; every further path deviates from
+ * an already accepted one at a "spur" vertex. For each spur vertex, the edges used
+ * by accepted paths with the same root are blocked, the root vertices are blocked,
+ * and a Dijkstra search from the spur vertex completes the candidate.
+ *
+ * The spur searches share one workspace (distance, parent and heap buffers).
+ * Blocked vertices/edges and visited distances are tagged with a generation
+ * number, so starting a new search is O(1) instead of clearing O(V) arrays.
+ * Following Lawler, spur vertices before the deviation point of the previous
+ * path are skipped because they cannot produce new candidates.
+ *
+ * @tparam T The data type stored in the graph vertices.
+ * @tparam W The edge weight type of the graph (int by default).
+ *
+ * @code
+ * KShortestPathsList<CelestialObject*, double> router;
+ * auto routes = router.findKShortestPaths(graph, startId, endId, 3);
+ * for (const auto &route : routes) { ... route.vertices, route.cost ... }
+ * @endcode
+ */
+template<typename T, typename W = int>
+class KShortestPathsList {
+public:
+    /**
+     * @brief Finds up to k loopless paths in order of increasing cost.
+     *
+     * @param g The GraphList object to search (may be an immutable snapshot).
+     * @param startId The ID of the starting vertex.
+     * @param endId The ID of the target vertex.
+     * @param k The maximum number of paths to return.
+     * @return Paths sorted by cost (ties keep discovery order). Fewer than k paths
+     * are returned if the graph has no more loopless routes; empty if IDs are invalid
+     * or the target is unreachable.
+     * @note The algorithm assumes non-negative edge weights.
+     */
+    std::vector<WeightedPath<W> > findKShortestPaths(const GraphList<T, W> &g, int startId, int endId, int k) {
+        int start = g.findIndexById(startId);
+        int end = g.findIndexById(endId);
+        if (start == -1 || end == -1 || k <= 0) return {};
+
+        prepare(g.vertexCount());
+
+        std::vector<Candidate> accepted;
+        Candidate first;
+        if (!spurSearch(g, start, end, first.path.vertices)) return {};
+        first.path.cost = pathCost(g, first.path.vertices, 0, static_cast<int>(first.path.vertices.size()) - 1);
+        accepted.push_back(std::move(first));
+
+        std::vector<Candidate> candidates; // Min-heap ordered by cost.
+        std::set<std::vector<int> > known{accepted.front().path.vertices};
+        std::vector<int> spurPath;
+        std::uint64_t discovered = 0;
+
+        while (static_cast<int>(accepted.size()) < k) {
+            const Candidate &previous = accepted.back();
+            const std::vector<int> &prevVertices = previous.path.vertices;
+            W rootCost{};
+            for (int i = 0; i < previous.deviation; ++i)
+                rootCost += edgeWeight(g, prevVertices[i], prevVertices[i + 1]);
+
+            for (int i = previous.deviation; i + 1 < static_cast<int>(prevVertices.size()); ++i) {
+                int spur = prevVertices[i];
+                ++generation;
+
+                for (const Candidate &a: accepted) {
+                    const auto &av = a.path.vertices;
+                    if (static_cast<int>(av.size()) > i + 1 && std::equal(av.begin(), av.begin() + i + 1, prevVertices.begin()))
+                        blockedEdgeStamp[av[i + 1]] = generation;
+                }
+                for (int r = 0; r < i; ++r) blockedVertexStamp[prevVertices[r]] = generation;
+
+                if (spurSearch(g, spur, end, spurPath)) {
+                    Candidate candidate;
+                    candidate.deviation = i;
+                    candidate.path.vertices.assign(prevVertices.begin(), prevVertices.begin() + i);
+                    candidate.path.vertices.insert(candidate.path.vertices.end(), spurPath.begin(), spurPath.end());
+                    candidate.path.cost = rootCost + distance[end];
+                    candidate.order = discovered++;
+
+                    if (known.insert(candidate.path.vertices).second) {
+                        candidates.push_back(std::move(candidate));
+                        std::push_heap(candidates.begin(), candidates.end(), std::greater<>());
+                    }
+                }
+                rootCost += edgeWeight(g, prevVertices[i], prevVertices[i + 1]);
+            }
+
+            if (candidates.empty()) break;
+            std::pop_heap(candidates.begin(), candidates.end(), std::greater<>());
+            accepted.push_back(std::move(candidates.back()));
+            candidates.pop_back();
+        }
+
+        std::vector<WeightedPath<W> > result;
+        result.reserve(accepted.size());
+        for (auto &a: accepted) result.push_back(std::move(a.path));
+        return result;
+    }
+
+    /// @brief Default destructor.
+    ~KShortestPathsList() = default;
+
+private:
+    /**
+     * @brief An accepted or candidate path plus the index where it left its parent path.
+     */
+    struct Candidate {
+        WeightedPath<W> path;
+        int deviation = 0; ///< Index of the spur vertex; earlier vertices are shared with the parent path.
+        std::uint64_t order = 0; ///< Discovery order, used to break cost ties deterministically.
+
+        bool operator>(const Candidate &other) const {
+            if (path.cost != other.path.cost) return path.cost > other.path.cost;
+            return order > other.order;
+        }
+    };
+
+    // Search workspace, reused by every spur search.
+    std::vector<W> distance; ///< Tentative distances, valid where distanceStamp == generation.
+    std::vector<int> parent; ///< Parents, valid where distanceStamp == generation.
+    std::vector<std::uint64_t> distanceStamp; ///< Generation in which distance[v] was written.
+    std::vector<std::uint64_t> blockedVertexStamp; ///< Vertex v is blocked if its stamp == generation.
+    std::vector<std::uint64_t> blockedEdgeStamp; ///< Edge (spur, v) is blocked if stamp[v] == generation.
+    std::vector<std::pair<W, int> > heap; ///< Binary heap storage (distance, vertex).
+    std::uint64_t generation = 0; ///< Current search generation.
+
+    /**
+     * @brief Sizes the workspace for a graph with n vertex slots.
+     */
+    void prepare(int n) {
+        if (static_cast<int>(distance.size()) != n) {
+            distance.assign(n, W{});
+            parent.assign(n, -1);
+            distanceStamp.assign(n, 0);
+            blockedVertexStamp.assign(n, 0);
+            blockedEdgeStamp.assign(n, 0);
+            generation = 0;
+        }
+        ++generation;
+    }
+
+    /**
+     * @brief Dijkstra from source to target that honors the blocked vertices/edges
+     * of the current generation.
+     * @param path Receives the vertices from source to target on success.
+     * @return True if the target was reached.
+     */
+    bool spurSearch(const GraphList<T, W> &g, int source, int target, std::vector<int> &path) {
+        auto greater = std::greater<std::pair<W, int> >();
+        heap.clear();
+        distance[source] = W{};
+        parent[source] = -1;
+        distanceStamp[source] = generation;
+        heap.push_back({W{}, source});
+
+        bool found = false;
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), greater);
+            auto [d, u] = heap.back();
+            heap.pop_back();
+            if (d > distance[u]) continue;
+            if (u == target) {
+                found = true;
+                break;
+            }
+
+            for (const auto &[v, w]: g.neighbors(u)) {
+                if (blockedVertexStamp[v] == generation) continue;
+                if (u == source && blockedEdgeStamp[v] == generation) continue;
+                W candidate = d + w;
+                if (distanceStamp[v] != generation || candidate < distance[v]) {
+                    distanceStamp[v] = generation;
+                    distance[v] = candidate;
+                    parent[v] = u;
+                    heap.push_back({candidate, v});
+                    std::push_heap(heap.begin(), heap.end(), greater);
+                }
+            }
+        }
+
+        path.clear();
+        if (!found) return false;
+        for (int cur = target; cur != -1; cur = parent[cur]) path.push_back(cur);
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
+
+    /**
+     * @brief Returns the weight of the lightest edge between two adjacent vertices.
+     */
+    static W edgeWeight(const GraphList<T, W> &g, int u, int v) {
+        W best = std::numeric_limits<W>::max();
+        for (const auto &[n, w]: g.neighbors(u))
+            if (n == v) best = std::min(best, w);
+        return best;
+    }
+
+    /**
+     * @brief Sums the edge weights of path[from .. to].
+     */
+    static W pathCost(const GraphList<T, W> &g, const std::vector<int> &path, int from, int to) {
+        W cost{};
+        for (int i = from; i < to; ++i) cost += edgeWeight(g, path[i], path[i + 1]);
+        return cost;
+    }
+};
+
+#endif //KSHORTESTPATHSLIST_H
@@ -0,0 +1,106 @@
+#include "BarnesHutGravityField.h"
+#include <cmath>
+
+BarnesHutGravityField::BarnesHutGravityField(double massScale, double theta, double softening)
+    : massScale_(massScale), theta_(theta), softening_(softening) {}
+
+void BarnesHutGravityField::accumulateAccelerations(ParticleState& state, WorkerPool* pool) {
+    const int n = state.size();
+    if (n < 2) return;
+
+    ax_.resize(n); ay_.resize(n); az_.resize(n);
+    rebuild(state);
+    tree_.computeAccelerations(G, theta_, softening_, ax_.data(), ay_.data(), az_.data(), pool);
+
+    for (int i = 0; i < n; ++i) {
+        state.ax[i] += ax_[i];
+        state.ay[i] += ay_[i];
+        state.az[i] += az_[i];
+    }
+}
+
+void BarnesHutGravityField::rebuild(const ParticleState& state) {
+    const int n = state.size();
+    mass_.resize(n);
+    for (int i = 0; i < n; ++i) mass_[i] = state.gravitationalMass[i] * massScale_;
+    tree_.build(state.x.data(), state.y.data(), state.z.data(), mass_.data(), n);
+}
+
+void BarnesHutGravityField::accumulateActiveAccelerations(ParticleState& state, const std::vector<int>& active,
+                                                          WorkerPool* pool) {
+    const int n = state.size();
+    if (n < 2 || active.empty()) return;
+
+    if (static_cast<int>(active.size()) == n) {
+        accumulateAccelerations(state, pool); // Group walk with a fresh tree.
+        return;
+    }
+    if (tree_.bodyCount() != n) rebuild(state);
+    else tree_.refit(state.x.data(), state.y.data(), state.z.data());
+
+    const double epsSq = softening_ * softening_;
+    auto range = [&](int begin, int end, int) {
+        for (int k = begin; k < end; ++k) {
+            const int i = active[k];
+            const double px = state.x[i], py = state.y[i], pz = state.z[i];
+            double sx = 0, sy = 0, sz = 0;
+            tree_.visit(px, py, pz, theta_, i, [&](double qx, double qy, double qz, double m) {
+                double dx = qx - px, dy = qy - py, dz = qz - pz;
+                double r2 = dx * dx + dy * dy + dz * dz + epsSq;
+                if (r2 <= 0) return;
+                double inv = 1.0 / std::sqrt(r2);
+                double s = m * inv * inv * inv;
+                sx += s * dx;
+                sy += s * dy;
+                sz += s * dz;
+            });
+            state.ax[i] += G * sx;
+            state.ay[i] += G * sy;
+            state.az[i] += G * sz;
+        }
+    };
+    const int count = static_cast<int>(active.size());
+    if (pool) pool->parallelFor(count, range);
+    else range(0, count, 0);
+}
+
+double BarnesHutGravityField::potentialEnergy(const ParticleState& state, WorkerPool* pool) const {
+    const int n = state.size();
+    if (n < 2) return 0.0;
+    if (exactPotential_) return exactPotentialEnergy(state, pool);
+
+    potentialMass_.resize(n);
+    potential_.resize(n);
+    for (int i = 0; i < n; ++i) potentialMass_[i] = state.gravitationalMass[i] * massScale_;
+    potentialTree_.build(state.x.data(), state.y.data(), state.z.data(), potentialMass_.data(), n);
+    potentialTree_.computePotentials(G, theta_, softening_, potential_.data(), pool);
+
+    // Every pair is seen from both ends.
+    double energy = 0;
+    for (int i = 0; i < n; ++i) energy += state.gravitationalMass[i] * potential_[i];
+    return 0.5 * energy;
+}
+
+double BarnesHutGravityField::exactPotentialEnergy(const ParticleState& state, WorkerPool* pool) const {
+    const int n = state.size();
+    const double epsSq = softening_ * softening_;
+
+    // One partial sum per row, added up in order, so the result does not depend on the pool.
+    std::vector<double> rows(n, 0.0);
+    auto range = [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            double sum = 0;
+            for (int j = i + 1; j < n; ++j) {
+                double dx = state.x[j] - state.x[i], dy = state.y[j] - state.y[i], dz = state.z[j] - state.z[i];
+                sum += state.gravitationalMass[j] / std::sqrt(dx * dx + dy * dy + dz * dz + epsSq);
+            }
+            rows[i] = state.gravitationalMass[i] * sum;
+        }
+    };
+    if (pool) pool->parallelFor(n, range);
+    else range(0, n, 0);
+
+    double energy = 0;
+    for (double row: rows) energy += row;
+    return -G * massScale_ * energy;
+}
@@ -0,0 +1,107 @@
+#ifndef BARNESHUTGRAVITYFIELD_H
+#define BARNESHUTGRAVITYFIELD_H
+
+#include "GravityField.h"
+#include "BarnesHutTree.h"
+#include <vector>
+
+/**
+ * @file BarnesHutGravityField.h
+ * @brief Mutual (body-to-body) gravity between all simulated celestial objects.
+ */
+
+/**
+ * @class BarnesHutGravityField
+ * @brief Applies pairwise Newtonian attraction between all bodies in O(N log N).
+ *
+ * Every step a BarnesHutTree is rebuilt from the particle positions and the
+ * resulting accelerations are added to the state. The source mass of a body is its
+ * ParticleState::gravitationalMass (the CelestialObject mass) times `massScale`, so
+ * the field uses the same units as BlackHoleGravityField.
+ *
+ * @code
+ * auto *nBody = new BarnesHutGravityField(PHYSICS_MASS_SCALE);
+ * controller->addGravityField(nBody);
+ * @endcode
+ */
+class BarnesHutGravityField : public GravityField {
+public:
+    /**
+     * @brief Constructs the field.
+     * @param massScale Factor converting CelestialObject masses to simulation masses.
+     * @param theta Opening angle; smaller is more accurate, 0 is the exact O(N^2) sum.
+     * @param softening Plummer softening length that limits forces in close encounters.
+     */
+    explicit BarnesHutGravityField(double massScale = 1.0, double theta = 0.5, double softening = 1.0);
+
+    /**
+     * @brief Rebuilds the octree and adds the mutual gravity of all bodies to their accelerations.
+     * @param state Positions and gravitational masses of all bodies.
+     * @param pool Workers for the tree walk, or nullptr (the build is serial).
+     */
+    void accumulateAccelerations(ParticleState& state, WorkerPool* pool) override;
+
+    /**
+     * @brief Returns the softened pair energy -G * massScale * m_i * m_j / sqrt(r^2 + softening^2).
+     *
+     * By default the sum is taken over a fresh octree with the same opening angle as the
+     * force pass, in O(N log N). With setExactPotential(true) every pair is summed
+     * exactly in O(N^2), which is only affordable for small N (tests, drift checks).
+     */
+    double potentialEnergy(const ParticleState& state, WorkerPool* pool) const override;
+
+    /**
+     * @brief Walks the tree for the listed bodies only.
+     *
+     * When every body is active (once per block of BlockTimestepIntegrator) this is
+     * accumulateAccelerations() with a fresh octree; otherwise the octree is only
+     * refitted to the drifted positions and walked per listed body.
+     */
+    void accumulateActiveAccelerations(ParticleState& state, const std::vector<int>& active, WorkerPool* pool) override;
+
+    /** @brief Sets the opening angle used by the tree walk. */
+    void setOpeningAngle(double theta) { theta_ = theta; }
+
+    /** @brief Returns the current opening angle. */
+    double getOpeningAngle() const { return theta_; }
+
+    /** @brief Selects the exact O(N^2) pair sum for potentialEnergy() instead of the tree. */
+    void setExactPotential(bool exact) { exactPotential_ = exact; }
+
+    /** @brief Returns true if potentialEnergy() sums every pair exactly. */
+    bool getExactPotential() const { return exactPotential_; }
+
+    /** @brief Sets the Plummer softening length. */
+    void setSoftening(double softening) { softening_ = softening; }
+
+    /** @brief Sets the factor that converts CelestialObject masses into simulation masses. */
+    void setMassScale(double massScale) { massScale_ = massScale; }
+
+private:
+    /** * @brief Gravitational constant adjusted for the simulation's scale.
+     * @note Matches BlackHoleGravityField::G.
+     */
+    static constexpr double G = 1.0;
+
+    double massScale_; ///< CelestialObject mass to simulation mass.
+    double theta_;     ///< Opening angle.
+    double softening_; ///< Softening length.
+    bool exactPotential_ = false; ///< potentialEnergy() sums all pairs instead of walking a tree.
+
+    BarnesHutTree tree_; ///< Rebuilt every step; keeps its buffers between steps.
+    std::vector<double> mass_;         ///< Scaled source masses.
+    std::vector<double> ax_, ay_, az_; ///< Accelerations from the tree walk.
+
+    /// @brief Tree and buffers of potentialEnergy(); separate from tree_ so a measurement
+    /// does not replace the octree that accumulateActiveAccelerations() refits.
+    mutable BarnesHutTree potentialTree_;
+    mutable std::vector<double> potentialMass_, potential_;
+
+    /** @brief Rebuilds the octree from the current positions and scaled masses. */
+    void rebuild(const ParticleState& state);
+
+    /** @brief Sums the pair energy over all pairs, one row per body. */
+    double exactPotentialEnergy(const ParticleState& state, WorkerPool* pool) const;
+};
+
+#endif // BARNESHUTGRAVITYFIELD_H
@@ -0,0 +1,265 @@
+#include "BarnesHutTree.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+BarnesHutTree::BarnesHutTree(int leafCapacity)
+    : leafCapacity_(std::max(1, leafCapacity)) {}
+
+void BarnesHutTree::build(const double *x, const double *y, const double *z, const double *mass, int n) {
+    nodes_.clear();
+    order_.resize(std::max(0, n));
+    if (n <= 0) return;
+
+    double minX = x[0], maxX = x[0];
+    double minY = y[0], maxY = y[0];
+    double minZ = z[0], maxZ = z[0];
+    for (int i = 1; i < n; ++i) {
+        minX = std::min(minX, x[i]); maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]); maxY = std::max(maxY, y[i]);
+        minZ = std::min(minZ, z[i]); maxZ = std::max(maxZ, z[i]);
+    }
+    double half = 0.5 * std::max({maxX - minX, maxY - minY, maxZ - minZ});
+    half = half * (1.0 + 1e-9) + 1e-9; // Keep bodies on the max faces strictly inside.
+
+    std::iota(order_.begin(), order_.end(), 0);
+    scratch_.resize(n);
+    octant_.resize(n);
+
+    Node root{};
+    root.centerX = 0.5 * (minX + maxX);
+    root.centerY = 0.5 * (minY + maxY);
+    root.centerZ = 0.5 * (minZ + maxZ);
+    root.halfSize = half;
+    root.begin = 0;
+    root.end = n;
+    root.firstChild = -1;
+    nodes_.push_back(root);
+    subdivide(0, x, y, z, 0);
+
+    sortedX_.resize(n);
+    sortedY_.resize(n);
+    sortedZ_.resize(n);
+    sortedMass_.resize(n);
+    for (int k = 0; k < n; ++k) {
+        int i = order_[k];
+        sortedX_[k] = x[i];
+        sortedY_[k] = y[i];
+        sortedZ_[k] = z[i];
+        sortedMass_[k] = mass[i];
+    }
+
+    // Children are always created after their parent, so a reverse sweep is bottom-up.
+    for (int i = static_cast<int>(nodes_.size()) - 1; i >= 0; --i) summarize(i);
+}
+
+void BarnesHutTree::refit(const double *x, const double *y, const double *z) {
+    const int n = bodyCount();
+    for (int k = 0; k < n; ++k) {
+        int i = order_[k];
+        sortedX_[k] = x[i];
+        sortedY_[k] = y[i];
+        sortedZ_[k] = z[i];
+    }
+    for (int i = static_cast<int>(nodes_.size()) - 1; i >= 0; --i) summarize(i);
+}
+
+void BarnesHutTree::subdivide(int nodeIndex, const double *x, const double *y, const double *z, int depth) {
+    const Node node = nodes_[nodeIndex];
+    if (node.end - node.begin <= leafCapacity_ || depth >= MAX_DEPTH) return;
+
+    int counts[8] = {};
+    for (int k = node.begin; k < node.end; ++k) {
+        int i = order_[k];
+        std::uint8_t oct = (x[i] >= node.centerX ? 1 : 0) | (y[i] >= node.centerY ? 2 : 0) | (z[i] >= node.centerZ ? 4 : 0);
+        octant_[i] = oct;
+        ++counts[oct];
+    }
+
+    int offsets[8];
+    int running = node.begin;
+    for (int o = 0; o < 8; ++o) {
+        offsets[o] = running;
+        running += counts[o];
+    }
+    for (int k = node.begin; k < node.end; ++k) {
+        int i = order_[k];
+        scratch_[offsets[octant_[i]]++] = i;
+    }
+    std::copy(scratch_.begin() + node.begin, scratch_.begin() + node.end, order_.begin() + node.begin);
+
+    const int firstChild = static_cast<int>(nodes_.size());
+    const double quarter = 0.5 * node.halfSize;
+    int begin = node.begin;
+    for (int o = 0; o < 8; ++o) {
+        if (counts[o] == 0) continue;
+        Node child{};
+        child.centerX = node.centerX + ((o & 1) ? quarter : -quarter);
+        child.centerY = node.centerY + ((o & 2) ? quarter : -quarter);
+        child.centerZ = node.centerZ + ((o & 4) ? quarter : -quarter);
+        child.halfSize = quarter;
+        child.begin = begin;
+        child.end = begin + counts[o];
+        child.firstChild = -1;
+        nodes_.push_back(child);
+        begin = child.end;
+    }
+
+    const int childCount = static_cast<int>(nodes_.size()) - firstChild;
+    nodes_[nodeIndex].firstChild = firstChild;
+    nodes_[nodeIndex].childCount = childCount;
+    for (int c = 0; c < childCount; ++c) subdivide(firstChild + c, x, y, z, depth + 1);
+}
+
+void BarnesHutTree::summarize(int nodeIndex) {
+    Node &node = nodes_[nodeIndex];
+    double m = 0, mx = 0, my = 0, mz = 0;
+    if (node.firstChild < 0) {
+        for (int k = node.begin; k < node.end; ++k) {
+            m += sortedMass_[k];
+            mx += sortedMass_[k] * sortedX_[k];
+            my += sortedMass_[k] * sortedY_[k];
+            mz += sortedMass_[k] * sortedZ_[k];
+        }
+    } else {
+        for (int c = 0; c < node.childCount; ++c) {
+            const Node &child = nodes_[node.firstChild + c];
+            m += child.mass;
+            mx += child.mass * child.comX;
+            my += child.mass * child.comY;
+            mz += child.mass * child.comZ;
+        }
+    }
+    node.mass = m;
+    if (m > 0) {
+        node.comX = mx / m;
+        node.comY = my / m;
+        node.comZ = mz / m;
+    } else {
+        node.comX = node.centerX;
+        node.comY = node.centerY;
+        node.comZ = node.centerZ;
+    }
+}
+
+template<typename GroupWork>
+void BarnesHutTree::forEachGroup(WorkerPool *pool, GroupWork &&work) const {
+    std::vector<int> groups;
+    std::vector<int> pending{0};
+    while (!pending.empty()) {
+        int index = pending.back();
+        pending.pop_back();
+        const Node &node = nodes_[index];
+        if (node.firstChild < 0 || node.end - node.begin <= GROUP_SIZE) {
+            groups.push_back(index);
+        } else {
+            for (int c = 0; c < node.childCount; ++c) pending.push_back(node.firstChild + c);
+        }
+    }
+
+    const int groupCount = static_cast<int>(groups.size());
+    const int workers = pool ? pool->threadCount() : 1;
+    std::vector<WalkScratch> scratch(workers);
+    auto walk = [&](int begin, int, int worker) {
+        // Groups are dealt round-robin so that dense and sparse regions mix on every worker.
+        for (int g = begin; g < groupCount; g += workers) work(groups[g], scratch[worker]);
+    };
+    if (pool) pool->parallelFor(workers, walk);
+    else walk(0, 1, 0);
+}
+
+void BarnesHutTree::computeAccelerations(double G, double theta, double softening,
+                                         double *ax, double *ay, double *az, WorkerPool *pool) const {
+    if (nodes_.empty()) return;
+    const double epsSq = softening * softening;
+    const double thetaSq = theta * theta;
+
+    // Bodies of one small subtree ("group") share a single tree walk: a node is
+    // accepted only if it is far enough from the group's bounding box, which is
+    // conservative for every body of the group. The forces are then summed over a
+    // flat interaction list with SimdKernels::gravitySum().
+    forEachGroup(pool, [&](int groupIndex, WalkScratch &scratch) {
+        const Node &group = nodes_[groupIndex];
+        collectInteractions(groupIndex, thetaSq, scratch);
+
+        // The body itself (and, without softening, coincident bodies) is at r^2 == 0
+        // and contributes nothing.
+        const int count = static_cast<int>(scratch.x.size());
+        for (int k = group.begin; k < group.end; ++k) {
+            double sum[3] = {0, 0, 0};
+            SimdKernels::gravitySum(sortedX_[k], sortedY_[k], sortedZ_[k], scratch.x.data(), scratch.y.data(),
+                                    scratch.z.data(), scratch.mass.data(), count, epsSq, sum);
+            const int self = order_[k];
+            ax[self] = G * sum[0];
+            ay[self] = G * sum[1];
+            az[self] = G * sum[2];
+        }
+    });
+}
+
+void BarnesHutTree::computePotentials(double G, double theta, double softening, double *phi,
+                                      WorkerPool *pool) const {
+    if (nodes_.empty()) return;
+    const double epsSq = softening * softening;
+    const double thetaSq = theta * theta;
+
+    forEachGroup(pool, [&](int groupIndex, WalkScratch &scratch) {
+        const Node &group = nodes_[groupIndex];
+        collectInteractions(groupIndex, thetaSq, scratch);
+
+        const int count = static_cast<int>(scratch.x.size());
+        for (int k = group.begin; k < group.end; ++k) {
+            const double px = sortedX_[k], py = sortedY_[k], pz = sortedZ_[k];
+            double sum = 0;
+            for (int j = 0; j < count; ++j) {
+                double dx = scratch.x[j] - px, dy = scratch.y[j] - py, dz = scratch.z[j] - pz;
+                double r2 = dx * dx + dy * dy + dz * dz + epsSq;
+                if (r2 > 0) sum += scratch.mass[j] / std::sqrt(r2);
+            }
+            // The group's own leaves are always opened, so the body met itself exactly once.
+            if (epsSq > 0) sum -= sortedMass_[k] / softening;
+            phi[order_[k]] = -G * sum;
+        }
+    });
+}
+
+void BarnesHutTree::collectInteractions(int groupIndex, double thetaSq, WalkScratch &scratch) const {
+    const Node &group = nodes_[groupIndex];
+    double minX = sortedX_[group.begin], maxX = minX;
+    double minY = sortedY_[group.begin], maxY = minY;
+    double minZ = sortedZ_[group.begin], maxZ = minZ;
+    for (int k = group.begin + 1; k < group.end; ++k) {
+        minX = std::min(minX, sortedX_[k]); maxX = std::max(maxX, sortedX_[k]);
+        minY = std::min(minY, sortedY_[k]); maxY = std::max(maxY, sortedY_[k]);
+        minZ = std::min(minZ, sortedZ_[k]); maxZ = std::max(maxZ, sortedZ_[k]);
+    }
+
+    auto &listX = scratch.x, &listY = scratch.y, &listZ = scratch.z, &listMass = scratch.mass;
+    auto &stack = scratch.stack;
+    listX.clear(); listY.clear(); listZ.clear(); listMass.clear();
+    stack.assign(1, 0);
+    while (!stack.empty()) {
+        const Node &node = nodes_[stack.back()];
+        stack.pop_back();
+
+        double dx = std::max({minX - node.comX, 0.0, node.comX - maxX});
+        double dy = std::max({minY - node.comY, 0.0, node.comY - maxY});
+        double dz = std::max({minZ - node.comZ, 0.0, node.comZ - maxZ});
+        double size = 2.0 * node.halfSize;
+
+        if (size * size < thetaSq * (dx * dx + dy * dy + dz * dz)) {
+            listX.push_back(node.comX);
+            listY.push_back(node.comY);
+            listZ.push_back(node.comZ);
+            listMass.push_back(node.mass);
+        } else if (node.firstChild < 0) {
+            listX.insert(listX.end(), sortedX_.begin() + node.begin, sortedX_.begin() + node.end);
+            listY.insert(listY.end(), sortedY_.begin() + node.begin, sortedY_.begin() + node.end);
+            listZ.insert(listZ.end(), sortedZ_.begin() + node.begin, sortedZ_.begin() + node.end);
+            listMass.insert(listMass.end(), sortedMass_.begin() + node.begin, sortedMass_.begin() + node.end);
+        } else {
+            for (int c = 0; c < node.childCount; ++c) stack.push_back(node.firstChild + c);
+        }
+    }
+}
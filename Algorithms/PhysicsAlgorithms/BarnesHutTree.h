@@ -0,0 +1,198 @@
+#ifndef BARNESHUTTREE_H
+#define BARNESHUTTREE_H
+
+#include "WorkerPool.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file BarnesHutTree.h
+ * @brief Octree that approximates far-away groups of bodies by their center of mass.
+ */
+
+/**
+ * @class BarnesHutTree
+ * @brief Flat-array octree for O(N log N) N-body force evaluation (Barnes–Hut).
+ *
+ * The tree is rebuilt from scratch every step from plain position/mass arrays, so it
+ * has no dependency on Bullet and can be reused by anything that needs long-range
+ * pairwise forces (gravity, graph layout repulsion, ...).
+ *
+ * Bodies are stored in tree order: every node owns a contiguous range
+ * [begin, end) of the sorted body arrays, and the children of a node are stored
+ * next to each other. Leaves hold up to `leafCapacity` bodies; bodies that share
+ * the same position end up together in a leaf at the maximum depth.
+ *
+ * A node is treated as a single point mass when size / distance < theta
+ * (the opening angle). theta = 0 gives the exact O(N^2) sum. computeAccelerations()
+ * measures the distance to a whole group of nearby bodies at once, which is at
+ * least as accurate as the per-body test and much cheaper.
+ */
+class BarnesHutTree {
+public:
+    /**
+     * @struct Node
+     * @brief One cube of the octree.
+     */
+    struct Node {
+        double centerX, centerY, centerZ; ///< Geometric center of the cube.
+        double halfSize;                  ///< Half of the cube's edge length.
+        double comX, comY, comZ;          ///< Center of mass of the contained bodies.
+        double mass;                      ///< Total mass of the contained bodies.
+        int begin, end;                   ///< Range of contained bodies in tree order.
+        int firstChild;                   ///< Index of the first child, -1 for a leaf.
+        int childCount;                   ///< Number of (non-empty) children.
+    };
+
+    /**
+     * @brief Constructs an empty tree.
+     * @param leafCapacity Maximum number of bodies in a leaf before it is split.
+     */
+    explicit BarnesHutTree(int leafCapacity = 8);
+
+    /**
+     * @brief Rebuilds the tree for n bodies.
+     * @param x, y, z Body positions.
+     * @param mass Body masses (non-negative).
+     * @param n Number of bodies.
+     */
+    void build(const double *x, const double *y, const double *z, const double *mass, int n);
+
+    /**
+     * @brief Moves the bodies of the last build to new positions without rebuilding.
+     *
+     * Keeps the cubes and masses and only recomputes the centers of mass, in O(N).
+     * Meant for the small moves between rebuilds (e.g. within one block of
+     * BlockTimestepIntegrator); bodies that leave their cube only cost accuracy.
+     *
+     * @param x, y, z New positions, indexed like the input arrays of build().
+     */
+    void refit(const double *x, const double *y, const double *z);
+
+    /**
+     * @brief Computes the gravitational acceleration of every body.
+     *
+     * a_i = G * sum_j m_j * (r_j - r_i) / (|r_j - r_i|^2 + eps^2)^(3/2),
+     * with far groups replaced by their center of mass. Without softening, bodies at
+     * exactly the same position do not attract each other.
+     *
+     * @param G Gravitational constant.
+     * @param theta Opening angle (0.5 is a common accuracy/speed trade-off).
+     * @param softening Plummer softening length eps; avoids infinite forces in close encounters.
+     * @param ax, ay, az Output arrays of size bodyCount(), indexed like the input arrays of build().
+     * @param pool Workers to share the body groups, or nullptr. Every group is computed
+     * the same way by whichever worker gets it, so the result does not depend on the pool.
+     */
+    void computeAccelerations(double G, double theta, double softening,
+                              double *ax, double *ay, double *az, WorkerPool *pool = nullptr) const;
+
+    /**
+     * @brief Computes the gravitational potential at every body.
+     *
+     * phi_i = -G * sum_{j != i} m_j / sqrt(|r_j - r_i|^2 + eps^2), with far groups
+     * replaced by their center of mass using the same acceptance test as
+     * computeAccelerations(), so the cost is O(N log N) as well.
+     *
+     * @param G Gravitational constant.
+     * @param theta Opening angle; 0 gives the exact sum.
+     * @param softening Plummer softening length eps.
+     * @param phi Output array of size bodyCount(), indexed like the input arrays of build().
+     * @param pool Workers to share the body groups, or nullptr.
+     */
+    void computePotentials(double G, double theta, double softening, double *phi, WorkerPool *pool = nullptr) const;
+
+    /**
+     * @brief Walks the tree for one query point and reports every interaction.
+     *
+     * `interact(x, y, z, mass)` is called once for every accepted node (with its
+     * center of mass) and once for every body of every opened leaf. The body with
+     * input index `self` is skipped.
+     *
+     * @param px, py, pz The query point.
+     * @param theta The opening angle.
+     * @param self Input index of the body at the query point, or -1.
+     * @param interact Callback receiving the position and mass of each source.
+     */
+    template<typename Interact>
+    void visit(double px, double py, double pz, double theta, int self, Interact &&interact) const {
+        if (nodes_.empty()) return;
+        const double thetaSq = theta * theta;
+        int stack[8 * MAX_DEPTH + 8];
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0) {
+            const Node &node = nodes_[stack[--top]];
+            double dx = node.comX - px;
+            double dy = node.comY - py;
+            double dz = node.comZ - pz;
+            double distSq = dx * dx + dy * dy + dz * dz;
+            double size = 2.0 * node.halfSize;
+
+            if (size * size < thetaSq * distSq) {
+                interact(node.comX, node.comY, node.comZ, node.mass);
+            } else if (node.firstChild < 0) {
+                for (int k = node.begin; k < node.end; ++k) {
+                    if (order_[k] == self) continue;
+                    interact(sortedX_[k], sortedY_[k], sortedZ_[k], sortedMass_[k]);
+                }
+            } else {
+                for (int c = 0; c < node.childCount; ++c) stack[top++] = node.firstChild + c;
+            }
+        }
+    }
+
+    /** @brief Returns the number of bodies in the last build. */
+    int bodyCount() const { return static_cast<int>(order_.size()); }
+
+    /** @brief Returns the nodes; nodes()[0] is the root. */
+    const std::vector<Node> &nodes() const { return nodes_; }
+
+    /** @brief Returns the input indices of the bodies in tree order. */
+    const std::vector<int> &order() const { return order_; }
+
+private:
+    /// @brief Depth limit; bodies closer than rootSize / 2^MAX_DEPTH share a leaf.
+    static constexpr int MAX_DEPTH = 32;
+
+    /// @brief Largest subtree whose bodies share one walk in computeAccelerations().
+    static constexpr int GROUP_SIZE = 32;
+
+    int leafCapacity_;
+    std::vector<Node> nodes_;
+    std::vector<int> order_;        ///< Input index of each body in tree order.
+    std::vector<int> scratch_;      ///< Temporary buffer for partitioning.
+    std::vector<std::uint8_t> octant_; ///< Octant of each body (by input index) during the split.
+    std::vector<double> sortedX_, sortedY_, sortedZ_, sortedMass_; ///< Body data in tree order.
+
+    /**
+     * @brief Splits the node's body range into octants and recurses.
+     */
+    void subdivide(int nodeIndex, const double *x, const double *y, const double *z, int depth);
+
+    /**
+     * @brief Fills the mass and center of mass of a node from its children or bodies.
+     */
+    void summarize(int nodeIndex);
+
+    /**
+     * @brief Per-worker buffers of computeAccelerations().
+     */
+    struct WalkScratch {
+        std::vector<double> x, y, z, mass; ///< Interaction list.
+        std::vector<int> stack;            ///< Nodes still to visit.
+    };
+
+    /**
+     * @brief Splits the tree into groups and calls `work(groupIndex, scratch)` for each, spread over the pool.
+     */
+    template<typename GroupWork>
+    void forEachGroup(WorkerPool *pool, GroupWork &&work) const;
+
+    /**
+     * @brief Fills scratch.x/y/z/mass with the interaction list of one group.
+     */
+    void collectInteractions(int groupIndex, double thetaSq, WalkScratch &scratch) const;
+};
+
+#endif // BARNESHUTTREE_H
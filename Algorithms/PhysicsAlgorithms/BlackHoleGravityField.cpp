@@ -1,4 +1,6 @@
 #include "BlackHoleGravityField.h"
+#include "SimdKernels.h"
+#include <algorithm>
 
 BlackHoleGravityField::BlackHoleGravityField(double mass, double x, double y, double z)
     : mass_(mass), posX_(x), posY_(y), posZ_(z) {}
@@ -13,31 +15,41 @@ void BlackHoleGravityField::setMass(double mass) {
     mass_ = mass;
 }
 
-void BlackHoleGravityField::applyGravity(std::vector<CelestialBodyToRigidWrapper*>& bodies, double deltaTime) {
-    for (auto* body : bodies) {
-        applyForce(body, deltaTime);
-    }
+void BlackHoleGravityField::accumulateAccelerations(ParticleState& state, WorkerPool* pool) {
+    auto range = [&](int begin, int end, int) {
+        SimdKernels::centralGravity(state.x.data() + begin, state.y.data() + begin, state.z.data() + begin,
+                                    state.ax.data() + begin, state.ay.data() + begin, state.az.data() + begin,
+                                    end - begin, posX_, posY_, posZ_, G * mass_, CLAMP_RADIUS * CLAMP_RADIUS);
+    };
+    if (pool) pool->parallelFor(state.size(), range);
+    else range(0, state.size(), 0);
 }
-void BlackHoleGravityField::applyForce(CelestialBodyToRigidWrapper* body, double deltaTime) {
-    double dx = posX_ - body->getX();
-    double dy = posY_ - body->getY();
-    double dz = posZ_ - body->getZ();
-
-    double distanceSq = dx*dx + dy*dy + dz*dz;
-
-    if (distanceSq < 100.0) distanceSq = 100.0;
-
-    double distance = std::sqrt(distanceSq);
 
-    double forceMagnitude = (G * mass_ * 1.0) / distanceSq;
-
-    double fx = forceMagnitude * dx / distance;
-    double fy = forceMagnitude * dy / distance;
-    double fz = forceMagnitude * dz / distance;
+void BlackHoleGravityField::accumulateActiveAccelerations(ParticleState& state, const std::vector<int>& active,
+                                                          WorkerPool*) {
+    // Same law as SimdKernels::centralGravity(); the list is usually short.
+    const double gm = G * mass_;
+    for (int i : active) {
+        double dx = posX_ - state.x[i], dy = posY_ - state.y[i], dz = posZ_ - state.z[i];
+        double d2 = std::max(dx * dx + dy * dy + dz * dz, CLAMP_RADIUS * CLAMP_RADIUS);
+        double inv = 1.0 / std::sqrt(d2);
+        double s = gm * inv * inv * inv;
+        state.ax[i] += s * dx;
+        state.ay[i] += s * dy;
+        state.az[i] += s * dz;
+    }
+}
 
-    btRigidBody* rb = body->getRigidBody();
-    if (rb) {
-        rb->activate(true);
-        rb->applyCentralForce(btVector3(fx, fy, fz));
+double BlackHoleGravityField::potentialEnergy(const ParticleState& state, WorkerPool*) const {
+    const double gm = G * mass_;
+    const double r0 = CLAMP_RADIUS;
+    double energy = 0;
+    for (int i = 0; i < state.size(); ++i) {
+        double dx = state.x[i] - posX_, dy = state.y[i] - posY_, dz = state.z[i] - posZ_;
+        double r2 = dx * dx + dy * dy + dz * dz;
+        // Inside r0 the acceleration is the harmonic gm * d / r0^3.
+        double phi = r2 >= r0 * r0 ? -gm / std::sqrt(r2) : gm * (r2 / (2 * r0 * r0 * r0) - 1.5 / r0);
+        energy += state.gravitationalMass[i] * phi;
     }
-}
\ No newline at end of file
+    return energy;
+}
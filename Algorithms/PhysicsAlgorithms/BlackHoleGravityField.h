@@ -1,7 +1,7 @@
 #ifndef BLACKHOLEGRAVITYFIELD_H
 #define BLACKHOLEGRAVITYFIELD_H
 
-#include "CelestialBodyToRigidWrapper.h"
+#include "GravityField.h"
 #include <vector>
 #include <cmath>
 
@@ -20,7 +20,7 @@
  *
  *
  */
-class BlackHoleGravityField {
+class BlackHoleGravityField : public GravityField {
 public:
     /**
      * @brief Constructs a gravity field with a specific mass and spatial coordinates.
@@ -30,11 +30,20 @@ public:
     BlackHoleGravityField(double mass, double x = 0, double y = 0, double z = 0);
 
     /**
-     * @brief Iterates through a list of bodies and applies the calculated gravity vector to each.
-     * @param bodies A vector of wrappers that link celestial data to rigid body physics.
-     * @param deltaTime The time step of the current simulation frame (used for impulse calculation).
+     * @brief Adds the field's acceleration G * M / r^2 (r clamped to 10) to every particle.
+     * @param state Positions of all bodies; accelerations are accumulated.
+     * @param pool Workers to split the bodies over, or nullptr.
      */
-    void applyGravity(std::vector<CelestialBodyToRigidWrapper*>& bodies, double deltaTime);
+    void accumulateAccelerations(ParticleState& state, WorkerPool* pool) override;
+
+    /**
+     * @brief Returns sum(m_i * phi(r_i)) with phi = -G * M / r, continued harmonically inside
+     * the clamp radius so that it matches accumulateAccelerations().
+     */
+    double potentialEnergy(const ParticleState& state, WorkerPool* pool) const override;
+
+    /** @brief Adds the field's acceleration to the listed bodies only. */
+    void accumulateActiveAccelerations(ParticleState& state, const std::vector<int>& active, WorkerPool* pool) override;
 
     /** @brief Updates the center of the gravity field. */
     void setPosition(double x, double y, double z);
@@ -42,6 +51,24 @@ public:
     /** @brief Updates the mass, effectively changing the gravitational pull of the field. */
     void setMass(double mass);
 
+    /** @brief Returns the mass. */
+    double getMass() const { return mass_; }
+
+    /** @brief Returns G * M, the gravitational parameter of the field. */
+    double getGravitationalParameter() const { return G * mass_; }
+
+    /** @brief Returns the X coordinate of the center. */
+    double getX() const { return posX_; }
+
+    /** @brief Returns the Y coordinate of the center. */
+    double getY() const { return posY_; }
+
+    /** @brief Returns the Z coordinate of the center. */
+    double getZ() const { return posZ_; }
+
+    /// @brief Inside this distance the pull no longer grows (the r^2 of the force law is clamped to its square).
+    static constexpr double CLAMP_RADIUS = 10.0;
+
 private:
     double mass_;                ///< Mass of the black hole.
     double posX_, posY_, posZ_;  ///< Spatial coordinates (center of the field).
@@ -50,14 +77,6 @@ private:
      * @note Set to 1.0 for simplified unit calculations.
      */
     static constexpr double G = 1.0;
-
-    /**
-     * @brief Internal helper to calculate and apply force to a single body.
-     * Computes the distance vector, normalization, and the resulting acceleration.
-     * @param body The target body to be influenced.
-     * @param deltaTime The duration of the force application.
-     */
-    void applyForce(CelestialBodyToRigidWrapper* body, double deltaTime);
 };
 
 #endif // BLACKHOLEGRAVITYFIELD_H
\ No newline at end of file
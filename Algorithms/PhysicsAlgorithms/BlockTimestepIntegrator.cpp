@@ -0,0 +1,95 @@
+#include "BlockTimestepIntegrator.h"
+#include "ParticleIntegrator.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+BlockTimestepIntegrator::BlockTimestepIntegrator(const Options &options)
+    : options_(options) {
+    options_.maxLevel = std::clamp(options_.maxLevel, 0, 30);
+}
+
+void BlockTimestepIntegrator::reset() {
+    levels_.clear();
+    ax_.clear();
+    ay_.clear();
+    az_.clear();
+}
+
+void BlockTimestepIntegrator::step(ParticleState &state, double blockStep,
+                                   const ActiveAccelerationFunction &computeAccelerations) {
+    const int n = state.size();
+    if (n == 0 || blockStep <= 0) return;
+    const int maxLevel = options_.maxLevel;
+
+    if (static_cast<int>(levels_.size()) != n) {
+        ax_.resize(n);
+        ay_.resize(n);
+        az_.resize(n);
+        active_.resize(n);
+        std::iota(active_.begin(), active_.end(), 0);
+        evaluate(state, computeAccelerations);
+        levels_.resize(n);
+        for (int i = 0; i < n; ++i) levels_[i] = wantedLevel(i, blockStep);
+    }
+
+    // Time is counted in ticks of the finest possible step; a step of level k lasts 2^(maxLevel - k) ticks.
+    const std::int64_t blockTicks = std::int64_t(1) << maxLevel;
+    auto ticks = [maxLevel](int level) { return std::int64_t(1) << (maxLevel - level); };
+    auto stepLength = [blockStep](int level) { return std::ldexp(blockStep, -level); };
+
+    std::int64_t t = 0;
+    while (t < blockTicks) {
+        // Opening half kicks of all steps that start now.
+        for (int i = 0; i < n; ++i)
+            if (t % ticks(levels_[i]) == 0) halfKick(state, i, stepLength(levels_[i]));
+
+        // Every step boundary coincides with one of the finest level in use.
+        const int finest = *std::max_element(levels_.begin(), levels_.end());
+        const std::int64_t advance = ticks(finest);
+        ParticleIntegrator::drift(state, std::ldexp(blockStep * static_cast<double>(advance), -maxLevel));
+        t += advance;
+
+        active_.clear();
+        for (int i = 0; i < n; ++i)
+            if (t % ticks(levels_[i]) == 0) active_.push_back(i);
+        evaluate(state, computeAccelerations);
+
+        for (int i: active_) {
+            halfKick(state, i, stepLength(levels_[i]));
+
+            // Finer grids always line up with the current time; a coarser one only every other step.
+            int wanted = wantedLevel(i, blockStep);
+            if (wanted > levels_[i]) levels_[i] = wanted;
+            else if (wanted < levels_[i] && t % ticks(levels_[i] - 1) == 0) --levels_[i];
+        }
+    }
+}
+
+void BlockTimestepIntegrator::evaluate(ParticleState &state, const ActiveAccelerationFunction &computeAccelerations) {
+    state.clearAccelerations();
+    if (computeAccelerations) computeAccelerations(state, active_);
+    for (int i: active_) {
+        ax_[i] = state.ax[i];
+        ay_[i] = state.ay[i];
+        az_[i] = state.az[i];
+    }
+    forceEvaluations_ += active_.size();
+}
+
+int BlockTimestepIntegrator::wantedLevel(int i, double blockStep) const {
+    const double a = std::sqrt(ax_[i] * ax_[i] + ay_[i] * ay_[i] + az_[i] * az_[i]);
+    if (a <= 0) return 0;
+    const double dt = std::sqrt(2.0 * options_.accuracy * options_.softening / a);
+    if (dt >= blockStep) return 0;
+    return std::min(options_.maxLevel, static_cast<int>(std::ceil(std::log2(blockStep / dt))));
+}
+
+void BlockTimestepIntegrator::halfKick(ParticleState &state, int i, double dt) const {
+    const double half = 0.5 * dt;
+    // Half of ParticleIntegrator::kick()'s damping per half kick.
+    const double keep = state.damping[i] > 0 ? std::pow(1.0 - state.damping[i], half) : 1.0;
+    state.vx[i] = (state.vx[i] + ax_[i] * half) * keep;
+    state.vy[i] = (state.vy[i] + ay_[i] * half) * keep;
+    state.vz[i] = (state.vz[i] + az_[i] * half) * keep;
+}
@@ -1,4 +1,7 @@
 #include "CelestialBodyToRigidWrapper.h"
+#include "PhysicsEngine.h"
+#include "RigidBodyPool.h"
+#include <cmath>
 
 CelestialBodyToRigidWrapper::CelestialBodyToRigidWrapper(CelestialObject* object,
                                                          btDiscreteDynamicsWorld* world)
@@ -8,9 +11,23 @@ CelestialBodyToRigidWrapper::CelestialBodyToRigidWrapper(CelestialObject* object
     world_->addRigidBody(rigidBody_);
 }
 
+CelestialBodyToRigidWrapper::CelestialBodyToRigidWrapper(CelestialObject* object, PhysicsEngine* engine)
+    : celestial_(object), pool_(&engine->getBodyPool()), world_(engine->getWorld())
+{
+    rigidBody_ = buildRigidBody();
+    world_->addRigidBody(rigidBody_);
+}
+
+CelestialBodyToRigidWrapper::CelestialBodyToRigidWrapper(CelestialObject* object)
+    : celestial_(object) {}
+
 CelestialBodyToRigidWrapper::~CelestialBodyToRigidWrapper() {
     if (rigidBody_) {
         world_->removeRigidBody(rigidBody_);
+        if (pool_) {
+            pool_->destroyBody(rigidBody_);
+            return;
+        }
         delete rigidBody_->getMotionState();
         delete rigidBody_;
     }
@@ -18,10 +35,10 @@ CelestialBodyToRigidWrapper::~CelestialBodyToRigidWrapper() {
 }
 
 btRigidBody* CelestialBodyToRigidWrapper::buildRigidBody() {
-    shape_ = new btSphereShape(btScalar(1.0));
+    shape_ = pool_ ? pool_->sphereShape(BODY_RADIUS) : new btSphereShape(btScalar(BODY_RADIUS));
 
     btVector3 inertia(0, 0, 0);
-    btScalar mass = 1.0;
+    btScalar mass = BODY_MASS;
     if (mass != 0)
         shape_->calculateLocalInertia(mass, inertia);
 
@@ -29,16 +46,32 @@ btRigidBody* CelestialBodyToRigidWrapper::buildRigidBody() {
     transform.setIdentity();
     transform.setOrigin(btVector3(0, 0, 0));
 
-    motionState_ = new btDefaultMotionState(transform);
-
-    btRigidBody::btRigidBodyConstructionInfo info(mass, motionState_, shape_, inertia);
+    btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape_, inertia);
     info.m_friction = 0.5;
     info.m_restitution = 0.1;
 
-    return new btRigidBody(info);
+    btRigidBody* body;
+    if (pool_) {
+        body = pool_->createBody(info, transform);
+        motionState_ = static_cast<btDefaultMotionState*>(body->getMotionState());
+    } else {
+        motionState_ = new btDefaultMotionState(transform);
+        info.m_motionState = motionState_;
+        body = new btRigidBody(info);
+    }
+    return body;
 }
 
 void CelestialBodyToRigidWrapper::updateFromPhysics() {
+    if (!rigidBody_) {
+        if (particles_) {
+            posX_ = particles_->x[particleIndex_];
+            posY_ = particles_->y[particleIndex_];
+            posZ_ = particles_->z[particleIndex_];
+        }
+        return;
+    }
+
     btTransform transform;
     rigidBody_->getMotionState()->getWorldTransform(transform);
 
@@ -49,10 +82,21 @@ void CelestialBodyToRigidWrapper::updateFromPhysics() {
 
 
 void CelestialBodyToRigidWrapper::updateToPhysics() {
+    if (!rigidBody_) {
+        if (particles_) {
+            particles_->x[particleIndex_] = posX_;
+            particles_->y[particleIndex_] = posY_;
+            particles_->z[particleIndex_] = posZ_;
+        }
+        return;
+    }
+
     btTransform transform;
     transform.setIdentity();
     transform.setOrigin(btVector3(posX_, posY_, posZ_));
     rigidBody_->setWorldTransform(transform);
+    // updateFromPhysics() reads the motion state, which Bullet only writes during a step.
+    rigidBody_->getMotionState()->setWorldTransform(transform);
 }
 
 double CelestialBodyToRigidWrapper::getX() const { return posX_; }
@@ -64,4 +108,48 @@ void CelestialBodyToRigidWrapper::setPosition(double x, double y, double z) {
     posY_ = y;
     posZ_ = z;
     updateToPhysics();
-}
\ No newline at end of file
+}
+
+void CelestialBodyToRigidWrapper::setVelocity(double vx, double vy, double vz) {
+    if (rigidBody_) {
+        rigidBody_->setLinearVelocity(btVector3(vx, vy, vz));
+        return;
+    }
+    velX_ = vx;
+    velY_ = vy;
+    velZ_ = vz;
+    if (particles_) {
+        particles_->vx[particleIndex_] = vx;
+        particles_->vy[particleIndex_] = vy;
+        particles_->vz[particleIndex_] = vz;
+    }
+}
+
+void CelestialBodyToRigidWrapper::setDamping(double linearDamping) {
+    if (rigidBody_) {
+        rigidBody_->setDamping(linearDamping, linearDamping);
+        return;
+    }
+    damping_ = linearDamping;
+    if (particles_) particles_->damping[particleIndex_] = linearDamping;
+}
+
+void CelestialBodyToRigidWrapper::attachToParticles(ParticleState* state, int index) {
+    if (rigidBody_ || !state) return;
+    particles_ = state;
+    particleIndex_ = index;
+    updateToPhysics();
+    setVelocity(velX_, velY_, velZ_);
+    setDamping(damping_);
+}
+
+void CelestialBodyToRigidWrapper::detachFromParticles() {
+    if (!particles_) return;
+    updateFromPhysics();
+    velX_ = particles_->vx[particleIndex_];
+    velY_ = particles_->vy[particleIndex_];
+    velZ_ = particles_->vz[particleIndex_];
+    damping_ = particles_->damping[particleIndex_];
+    particles_ = nullptr;
+    particleIndex_ = -1;
+}
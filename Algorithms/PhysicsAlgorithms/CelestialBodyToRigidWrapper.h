@@ -3,6 +3,10 @@
 
 #include <btBulletDynamicsCommon.h>
 #include "../../Entities/CelestialObject.h"
+#include "ParticleState.h"
+
+class PhysicsEngine;
+class RigidBodyPool;
 
 /**
  * @file CelestialBodyToRigidWrapper.h
@@ -17,6 +21,10 @@
  * `CelestialObject`. It ensures that physical forces (like gravity or collisions)
  * calculated by Bullet are reflected back in the celestial object's coordinates
  * and vice versa.
+ *
+ * A wrapper constructed without a world is a lightweight point mass: it has no
+ * rigid body, and once GalaxyPhysicsController attaches it to a ParticleState its
+ * position and velocity live in that state's arrays.
  */
 class CelestialBodyToRigidWrapper {
 public:
@@ -29,6 +37,22 @@ public:
      */
     CelestialBodyToRigidWrapper(CelestialObject* object, btDiscreteDynamicsWorld* world);
 
+    /**
+     * @brief Constructs a physics wrapper whose body comes from the engine's RigidBodyPool.
+     * * The sphere shape is shared with every other pooled body of the same radius, and
+     * the body and motion state live in the pool's blocks instead of separate allocations.
+     * The wrapper must be destroyed before the engine.
+     * @param object Pointer to the CelestialObject to be simulated.
+     * @param engine The engine whose world and pool are used.
+     */
+    CelestialBodyToRigidWrapper(CelestialObject* object, PhysicsEngine* engine);
+
+    /**
+     * @brief Constructs a point-mass wrapper without a Bullet rigid body.
+     * @param object Pointer to the CelestialObject to be simulated.
+     */
+    explicit CelestialBodyToRigidWrapper(CelestialObject* object);
+
     /**
      * @brief Destructor that safely removes the rigid body from the physics world.
      * * Cleans up the motion state, collision shape, and the rigid body instance
@@ -36,9 +60,15 @@ public:
      */
     ~CelestialBodyToRigidWrapper();
 
-    /** @brief Provides access to the underlying Bullet rigid body. */
+    /** @brief Provides access to the underlying Bullet rigid body (nullptr for point masses). */
     btRigidBody* getRigidBody() const { return rigidBody_; }
 
+    /** @brief Returns true if the body is simulated as a particle instead of a rigid body. */
+    bool isPointMass() const { return rigidBody_ == nullptr; }
+
+    /** @brief Returns the inertial mass of the body. */
+    double getMass() const { return BODY_MASS; }
+
     /** @brief Provides access to the associated celestial object data. */
     CelestialObject* getCelestial() const { return celestial_; }
 
@@ -70,16 +100,56 @@ public:
      */
     void setPosition(double x, double y, double z);
 
+    /**
+     * @brief Sets the linear velocity of the body.
+     * @param vx, vy, vz New velocity in world space.
+     */
+    void setVelocity(double vx, double vy, double vz);
+
+    /**
+     * @brief Sets the linear damping (fraction of velocity lost per second, as in Bullet).
+     */
+    void setDamping(double linearDamping);
+
+    /**
+     * @brief Links the wrapper to a particle slot (point masses only).
+     * * Copies the cached position, velocity and damping into the slot; afterwards
+     * the getters and setters read and write the particle arrays.
+     * @param state The particle storage owned by the controller.
+     * @param index The slot of this body.
+     */
+    void attachToParticles(ParticleState* state, int index);
+
+    /**
+     * @brief Unlinks the wrapper from its particle slot, keeping the slot's position,
+     * velocity and damping in the wrapper (point masses only).
+     */
+    void detachFromParticles();
+
+    /** @brief Returns the slot of this body in the controller's ParticleState, or -1. */
+    int getParticleIndex() const { return particleIndex_; }
+
+    /** @brief Records the slot of this body in the controller's ParticleState. */
+    void setParticleIndex(int index) { particleIndex_ = index; }
+
+    /// @brief Inertial mass shared by every body (rigid bodies are built with it too).
+    static constexpr double BODY_MASS = 1.0;
+
 private:
     double posX_ = 0; ///< Internal cache for the X position.
     double posY_ = 0; ///< Internal cache for the Y position.
     double posZ_ = 0; ///< Internal cache for the Z position.
+    double velX_ = 0, velY_ = 0, velZ_ = 0; ///< Velocity of a point mass before it is attached.
+    double damping_ = 0; ///< Damping of a point mass before it is attached.
 
     CelestialObject* celestial_; ///< Pointer to the high-level celestial entity.
-    btRigidBody* rigidBody_;    ///< The actual physical body in the Bullet engine.
-    btCollisionShape* shape_;   ///< The geometric shape used for collision detection.
-    btDefaultMotionState* motionState_; ///< Handles interpolation between physics steps.
-    btDiscreteDynamicsWorld* world_;    ///< Reference to the world containing this body.
+    btRigidBody* rigidBody_ = nullptr;    ///< The actual physical body in the Bullet engine.
+    btCollisionShape* shape_ = nullptr;   ///< The geometric shape used for collision detection (not owned if pooled).
+    RigidBodyPool* pool_ = nullptr;       ///< Owner of the body, motion state and shape, if pooled.
+    btDefaultMotionState* motionState_ = nullptr; ///< Handles interpolation between physics steps.
+    btDiscreteDynamicsWorld* world_ = nullptr;    ///< Reference to the world containing this body.
+    ParticleState* particles_ = nullptr; ///< Particle storage of an attached point mass.
+    int particleIndex_ = -1;             ///< Slot in the controller's ParticleState.
 
     /**
      * @brief Internal factory method to configure the btRigidBody.
@@ -88,6 +158,9 @@ private:
      * @return A fully initialized btRigidBody pointer.
      */
     btRigidBody* buildRigidBody();
+
+    /// @brief Radius of the collision sphere of every body.
+    static constexpr double BODY_RADIUS = 1.0;
 };
 
 #endif // CELESTIALBODYTORIGIDWRAPPER_H
\ No newline at end of file
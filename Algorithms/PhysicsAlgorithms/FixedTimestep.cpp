@@ -0,0 +1,27 @@
+#include "FixedTimestep.h"
+#include <algorithm>
+#include <cmath>
+
+FixedTimestep::FixedTimestep(double stepSize, int maxSubsteps)
+    : stepSize_(stepSize > 0 ? stepSize : 1.0 / 60.0), maxSubsteps_(std::max(1, maxSubsteps)) {}
+
+int FixedTimestep::advance(double elapsed) {
+    if (elapsed > 0) accumulator_ += elapsed;
+
+    int steps = static_cast<int>(std::floor(accumulator_ / stepSize_));
+    if (steps > maxSubsteps_) {
+        // Keep the fractional part so alpha() stays continuous, drop whole steps.
+        double excess = (steps - maxSubsteps_) * stepSize_;
+        dropped_ += excess;
+        accumulator_ -= excess;
+        steps = maxSubsteps_;
+    }
+    accumulator_ -= steps * stepSize_;
+    accumulator_ = std::clamp(accumulator_, 0.0, std::nextafter(stepSize_, 0.0));
+    return steps;
+}
+
+void FixedTimestep::reset() {
+    accumulator_ = 0;
+    dropped_ = 0;
+}
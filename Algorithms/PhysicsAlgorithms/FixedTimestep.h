@@ -0,0 +1,70 @@
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+/**
+ * @file FixedTimestep.h
+ * @brief Converts variable frame times into a whole number of fixed physics steps.
+ */
+
+/**
+ * @class FixedTimestep
+ * @brief Time accumulator for a fixed-step simulation ("fix your timestep").
+ *
+ * advance() adds the elapsed time to an accumulator and returns how many steps of
+ * stepSize() fit into it; the remainder carries over to the next call, so the
+ * simulation advances at exactly real time (times the caller's time scale) no matter
+ * how irregular the calls are, and every step uses the same dt.
+ *
+ * A single call never returns more than maxSubsteps steps. Time beyond that is
+ * discarded (see droppedTime()), so a long stall is not followed by a burst of
+ * catch-up steps that would stall again (the "spiral of death").
+ *
+ * alpha() is the fraction of a step left in the accumulator; renderers blend the
+ * last two physics states with it to get smooth motion between steps.
+ *
+ * @code
+ * FixedTimestep timestep(1.0 / 60.0);
+ * int steps = timestep.advance(frameSeconds);
+ * for (int i = 0; i < steps; ++i) simulate(timestep.stepSize());
+ * draw(lerp(previous, current, timestep.alpha()));
+ * @endcode
+ */
+class FixedTimestep {
+public:
+    /**
+     * @brief Creates an empty accumulator.
+     * @param stepSize Simulated seconds per step (> 0).
+     * @param maxSubsteps Upper limit of steps returned by one advance() (>= 1).
+     */
+    explicit FixedTimestep(double stepSize, int maxSubsteps = 8);
+
+    /**
+     * @brief Adds elapsed time and takes the steps that are due.
+     * @param elapsed Simulated seconds since the last call (negative values count as 0).
+     * @return Number of steps the caller must simulate now, in [0, maxSubsteps].
+     */
+    int advance(double elapsed);
+
+    /** @brief Returns the time left in the accumulator as a fraction of a step, in [0, 1). */
+    double alpha() const { return accumulator_ / stepSize_; }
+
+    /** @brief Returns the simulated seconds per step. */
+    double stepSize() const { return stepSize_; }
+
+    /** @brief Returns the step limit of advance(). */
+    int maxSubsteps() const { return maxSubsteps_; }
+
+    /** @brief Returns the total time discarded by the substep clamp. */
+    double droppedTime() const { return dropped_; }
+
+    /** @brief Empties the accumulator and clears droppedTime(). */
+    void reset();
+
+private:
+    double stepSize_;
+    int maxSubsteps_;
+    double accumulator_ = 0; ///< Simulated time not yet covered by a step.
+    double dropped_ = 0;     ///< Time discarded by the clamp.
+};
+
+#endif // FIXEDTIMESTEP_H
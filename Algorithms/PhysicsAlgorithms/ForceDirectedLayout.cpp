@@ -0,0 +1,153 @@
+#include "ForceDirectedLayout.h"
+#include <algorithm>
+#include <cmath>
+
+ForceDirectedLayout::ForceDirectedLayout(WorkerPool *pool)
+    : pool_(pool) {}
+
+void ForceDirectedLayout::setGraph(int vertexCount, const std::vector<int> &from, const std::vector<int> &to,
+                                   const std::vector<double> &restLength) {
+    const int n = std::max(0, vertexCount);
+    const size_t m = std::min({from.size(), to.size(), restLength.size()});
+    auto valid = [&](size_t e) {
+        return from[e] >= 0 && from[e] < n && to[e] >= 0 && to[e] < n && from[e] != to[e];
+    };
+
+    offset_.assign(n + 1, 0);
+    double restSum = 0;
+    int edgeCount = 0;
+    for (size_t e = 0; e < m; ++e) {
+        if (!valid(e)) continue;
+        ++offset_[from[e] + 1];
+        ++offset_[to[e] + 1];
+        restSum += restLength[e];
+        ++edgeCount;
+    }
+    for (int v = 0; v < n; ++v) offset_[v + 1] += offset_[v];
+
+    neighbor_.resize(offset_[n]);
+    rest_.resize(offset_[n]);
+    std::vector<int> fill(offset_.begin(), offset_.end() - 1);
+    for (size_t e = 0; e < m; ++e) {
+        if (!valid(e)) continue;
+        neighbor_[fill[from[e]]] = to[e];
+        rest_[fill[from[e]]++] = restLength[e];
+        neighbor_[fill[to[e]]] = from[e];
+        rest_[fill[to[e]]++] = restLength[e];
+    }
+
+    charge_.resize(n);
+    for (int v = 0; v < n; ++v) charge_[v] = 1.0 + (offset_[v + 1] - offset_[v]);
+    meanRest_ = edgeCount > 0 && restSum > 0 ? restSum / edgeCount : 1.0;
+}
+
+void ForceDirectedLayout::forRange(int count, const WorkerPool::RangeFunction &body) {
+    if (pool_) pool_->parallelFor(count, body);
+    else if (count > 0) body(0, count, 0);
+}
+
+int ForceDirectedLayout::run(double *x, double *y, double *z, const Options &options) {
+    const int n = vertexCount();
+    if (n < 2) return 0;
+
+    const double L = meanRest_;
+    // Repulsion C / d^2 between unit charges equals `repulsion * L` at d = L.
+    const double repulsionConstant = options.repulsion * L * L * L;
+    const double gravity = options.gravity * L;
+    const double softening = 0.01 * L;
+    const double tolerance = options.tolerance * L;
+
+    ax_.resize(n);
+    ay_.resize(n);
+    az_.resize(n);
+    const int workers = pool_ ? pool_->threadCount() : 1;
+    force2_.resize(n);
+    workerMaxMove_.resize(workers);
+
+    double step = options.initialStep * L;
+    double previousEnergy = -1;
+    int progress = 0;
+    int iteration = 0;
+
+    while (iteration < options.maxIterations) {
+        ++iteration;
+
+        // A negative G turns the tree's attraction into repulsion.
+        tree_.build(x, y, z, charge_.data(), n);
+        tree_.computeAccelerations(-repulsionConstant, options.theta, softening,
+                                   ax_.data(), ay_.data(), az_.data(), pool_);
+
+        std::fill(workerMaxMove_.begin(), workerMaxMove_.end(), 0.0);
+
+        // Jacobi update: forces are computed from the old positions of every vertex,
+        // so the moves are buffered in ax/ay/az and applied afterwards.
+        forRange(n, [&](int begin, int end, int worker) {
+            double maxMove = 0;
+            for (int v = begin; v < end; ++v) {
+                double fx = charge_[v] * ax_[v];
+                double fy = charge_[v] * ay_[v];
+                double fz = charge_[v] * az_[v];
+
+                for (int k = offset_[v]; k < offset_[v + 1]; ++k) {
+                    int u = neighbor_[k];
+                    double dx = x[u] - x[v], dy = y[u] - y[v], dz = z[u] - z[v];
+                    double d = std::sqrt(dx * dx + dy * dy + dz * dz);
+                    if (d <= 0) continue;
+                    double s = (d - rest_[k]) / d;
+                    fx += s * dx;
+                    fy += s * dy;
+                    fz += s * dz;
+                }
+
+                double r = std::sqrt(x[v] * x[v] + y[v] * y[v] + z[v] * z[v]);
+                if (r > 0) {
+                    double g = gravity * charge_[v] / r;
+                    fx -= g * x[v];
+                    fy -= g * y[v];
+                    fz -= g * z[v];
+                }
+                if (options.planar) fz = 0;
+
+                // Dividing by the charge (degree + 1) is a damped Jacobi step for the
+                // springs; moving by the full force would make neighbors overshoot.
+                double f = std::sqrt(fx * fx + fy * fy + fz * fz);
+                force2_[v] = f * f;
+                double move = std::min(f / charge_[v], step);
+                double scale = f > 0 ? move / f : 0.0;
+                ax_[v] = fx * scale;
+                ay_[v] = fy * scale;
+                az_[v] = fz * scale;
+                maxMove = std::max(maxMove, move);
+            }
+            workerMaxMove_[worker] = std::max(workerMaxMove_[worker], maxMove);
+        });
+
+        forRange(n, [&](int begin, int end, int) {
+            for (int v = begin; v < end; ++v) {
+                x[v] += ax_[v];
+                y[v] += ay_[v];
+                z[v] += az_[v];
+            }
+        });
+
+        double maxMove = *std::max_element(workerMaxMove_.begin(), workerMaxMove_.end());
+        // Summed serially so that the cooling schedule does not depend on the thread count.
+        double energy = 0;
+        for (int v = 0; v < n; ++v) energy += force2_[v];
+        if (maxMove < tolerance) break;
+
+        // Adaptive cooling (Hu 2005): shrink the step while the layout gets worse,
+        // grow it again after five improving iterations in a row.
+        if (previousEnergy < 0 || energy < previousEnergy) {
+            if (++progress >= 5) {
+                progress = 0;
+                step /= options.cooling;
+            }
+        } else {
+            progress = 0;
+            step *= options.cooling;
+        }
+        previousEnergy = energy;
+    }
+    return iteration;
+}
@@ -0,0 +1,106 @@
+#ifndef FORCEDIRECTEDLAYOUT_H
+#define FORCEDIRECTEDLAYOUT_H
+
+#include "BarnesHutTree.h"
+#include "WorkerPool.h"
+#include <vector>
+
+/**
+ * @file ForceDirectedLayout.h
+ * @brief Force-directed graph layout with Barnes–Hut repulsion.
+ */
+
+/**
+ * @class ForceDirectedLayout
+ * @brief Places graph vertices so that edges get their preferred length and
+ * unconnected vertices keep apart (spring–electrical model of the Fruchterman–Reingold family).
+ *
+ * Per iteration every vertex feels
+ *  - a spring force k * (d - restLength) towards each neighbor (k = 1),
+ *  - an electrical repulsion C * m_i * m_j / d^2 from every other vertex, evaluated with
+ *    a BarnesHutTree; like ForceAtlas2 the "charge" m is degree + 1, so hubs push harder,
+ *  - a weak constant pull towards the origin that keeps disconnected components together.
+ *
+ * Vertices then move along their force by at most the current step length, which
+ * follows Hu's adaptive cooling: it shrinks while the total force grows and grows
+ * again after several improving iterations. The layout stops as soon as no vertex
+ * moved more than `tolerance * mean rest length`.
+ *
+ * Positions are plain SoA arrays and all per-vertex work (spring sums, moves,
+ * and the tree walk) runs on an optional WorkerPool. Edges are stored as a CSR
+ * adjacency so that every vertex sums its own springs without scattering.
+ *
+ * @code
+ * ForceDirectedLayout layout(&pool);
+ * layout.setGraph(n, from, to, restLength);
+ * int iterations = layout.run(x.data(), y.data(), z.data());
+ * @endcode
+ */
+class ForceDirectedLayout {
+public:
+    /**
+     * @struct Options
+     * @brief Tuning parameters; lengths are relative to the mean rest length.
+     */
+    struct Options {
+        int maxIterations = 500;  ///< Hard limit on iterations.
+        double tolerance = 0.01;  ///< Stop when the largest move is below tolerance * mean rest length.
+        double theta = 1.0;       ///< Barnes–Hut opening angle (layout quality is insensitive to it).
+        double repulsion = 0.005; ///< Repulsion between two unit charges at rest length, relative to a unit spring stretch.
+        double gravity = 0.01;    ///< Pull towards the origin per unit charge, relative to a unit spring stretch.
+        double initialStep = 1.0; ///< First step length.
+        double cooling = 0.9;     ///< Step multiplier after a non-improving iteration.
+        bool planar = false;      ///< Keep every z unchanged (2D layout).
+    };
+
+    /**
+     * @brief Creates an empty layout engine.
+     * @param pool Workers for the per-vertex loops, or nullptr for the calling thread only.
+     */
+    explicit ForceDirectedLayout(WorkerPool *pool = nullptr);
+
+    /**
+     * @brief Sets the graph to lay out. Edges with an invalid endpoint or a self loop are ignored.
+     * @param vertexCount Number of vertices.
+     * @param from, to Edge endpoints (vertex indices); an edge acts in both directions.
+     * @param restLength Preferred length of each edge.
+     */
+    void setGraph(int vertexCount, const std::vector<int> &from, const std::vector<int> &to,
+                  const std::vector<double> &restLength);
+
+    /**
+     * @brief Improves the given positions in place.
+     * @param x, y, z Vertex positions (size vertexCount()); the start layout must not put all vertices at one point.
+     * @param options Tuning parameters.
+     * @return Number of iterations performed.
+     */
+    int run(double *x, double *y, double *z, const Options &options);
+
+    /** @brief Runs with default options. */
+    int run(double *x, double *y, double *z) { return run(x, y, z, Options()); }
+
+    /** @brief Returns the number of vertices of the current graph. */
+    int vertexCount() const { return static_cast<int>(charge_.size()); }
+
+    /** @brief Returns the mean rest length of the edges (1 if there are none). */
+    double meanRestLength() const { return meanRest_; }
+
+private:
+    WorkerPool *pool_;
+    BarnesHutTree tree_;
+
+    // CSR adjacency: the neighbors of v are neighbor_[offset_[v] .. offset_[v + 1]).
+    std::vector<int> offset_, neighbor_;
+    std::vector<double> rest_;
+    std::vector<double> charge_; ///< degree + 1.
+    double meanRest_ = 1.0;
+
+    std::vector<double> ax_, ay_, az_; ///< Repulsive acceleration per unit charge.
+    std::vector<double> force2_;       ///< Squared net force per vertex.
+    std::vector<double> workerMaxMove_;
+
+    /** @brief Runs body over [0, count) on the pool or inline. */
+    void forRange(int count, const WorkerPool::RangeFunction &body);
+};
+
+#endif // FORCEDIRECTEDLAYOUT_H
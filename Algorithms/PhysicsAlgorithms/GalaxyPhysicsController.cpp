@@ -1,73 +1,353 @@
 #include "GalaxyPhysicsController.h"
+#include "ParticleIntegrator.h"
+#include "PhysicsCheckpoint.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
-GalaxyPhysicsController::GalaxyPhysicsController(PhysicsEngine* engine)
-    : engine_(engine) {}
+GalaxyPhysicsController::GalaxyPhysicsController(PhysicsEngine* engine, PhysicsBackend backend, int threadCount)
+    : engine_(engine), backend_(backend), pool_(std::make_unique<WorkerPool>(threadCount)) {}
 
 GalaxyPhysicsController::~GalaxyPhysicsController() {
     bodies_.clear();
     gravityFields_.clear();
 }
 
-void GalaxyPhysicsController::addCelestialBody(CelestialBodyToRigidWrapper* body) {
-    if (body) bodies_.push_back(body);
+void GalaxyPhysicsController::addCelestialBody(CelestialBodyToRigidWrapper* body, int key) {
+    if (!body) return;
+    if (backend_ == PhysicsBackend::Particles && !body->isPointMass()) return;
+
+    CelestialObject* celestial = body->getCelestial();
+    int index = state_.add(body->getX(), body->getY(), body->getZ(), body->getMass(),
+                           celestial ? celestial->getMass() : 0.0);
+    body->setParticleIndex(index);
+    if (backend_ == PhysicsBackend::Particles) body->attachToParticles(&state_, index);
+
+    bodies_.push_back(body);
+    bodyKeys_.push_back(key);
+    if (orbitLod_) orbitLod_->reset();
+    if (key >= 0) {
+        auto [it, inserted] = keyToBody_.try_emplace(key, index);
+        if (!inserted) {
+            bodyKeys_[it->second] = -1;
+            it->second = index;
+        }
+    }
+    ++bodiesVersion_;
+}
+
+CelestialBodyToRigidWrapper* GalaxyPhysicsController::removeCelestialBody(int key) {
+    auto it = keyToBody_.find(key);
+    if (it == keyToBody_.end()) return nullptr;
+    const int index = it->second;
+    keyToBody_.erase(it);
+
+    CelestialBodyToRigidWrapper* removed = bodies_[index];
+    removed->detachFromParticles();
+    removed->setParticleIndex(-1);
+
+    // The particle data of the last body is moved by swapRemove(); its wrapper only needs the new index.
+    const int last = state_.swapRemove(index);
+    springs_.removeBody(index, last);
+    bodies_[index] = bodies_[last];
+    bodyKeys_[index] = bodyKeys_[last];
+    bodies_.pop_back();
+    bodyKeys_.pop_back();
+    if (last != index) {
+        bodies_[index]->setParticleIndex(index);
+        if (bodyKeys_[index] >= 0) keyToBody_[bodyKeys_[index]] = index;
+    }
+    // Stored levels and accelerations are per index; the next block starts afresh.
+    if (blockIntegrator_) blockIntegrator_->reset();
+    if (orbitLod_) orbitLod_->reset();
+    ++bodiesVersion_;
+    return removed;
 }
 
-void GalaxyPhysicsController::addGravityField(BlackHoleGravityField* field) {
+int GalaxyPhysicsController::findBody(int key) const {
+    auto it = keyToBody_.find(key);
+    return it == keyToBody_.end() ? -1 : it->second;
+}
+
+void GalaxyPhysicsController::addGravityField(GravityField* field) {
     if (field) gravityFields_.push_back(field);
 }
 
 void GalaxyPhysicsController::simulateStep(double deltaTime) {
-    for (auto* field : gravityFields_) {
-        field->applyGravity(bodies_, deltaTime);
+    if (!diagnostics_) {
+        stepBodies(deltaTime);
+        return;
+    }
+
+    currentStep_ = StepDiagnostics();
+    {
+        PhaseTimer stepTimer(&currentStep_.totalSeconds);
+        stepBodies(deltaTime);
     }
-    applySpringForces(deltaTime);
-    if (engine_) {
-        engine_->stepSimulation(deltaTime);
+    // Whatever was not spent on forces or copying went to the integrator (or the Bullet step).
+    currentStep_.integrateSeconds = std::max(0.0, currentStep_.totalSeconds - currentStep_.gravitySeconds -
+                                                      currentStep_.springSeconds - currentStep_.syncSeconds);
+    currentStep_.deltaTime = deltaTime;
+    currentStep_.bodies = state_.size();
+    currentStep_.analyticBodies = orbitLod_ && !blockIntegrator_ ? orbitLod_->analyticCount() : 0;
+    measureState(currentStep_, diagnostics_->energyDue());
+    diagnostics_->record(currentStep_);
+}
+
+void GalaxyPhysicsController::stepBodies(double deltaTime) {
+    if (backend_ == PhysicsBackend::Particles) {
+        if (blockIntegrator_) {
+            blockIntegrator_->step(state_, deltaTime, [this](ParticleState& state, const std::vector<int>& active) {
+                computeActiveAccelerations(state, active);
+            });
+        } else if (orbitLod_) {
+            reviewOrbitLod();
+            // Everybody drifts (cheap); forces only for the integrated bodies, then the
+            // analytic ones are put back on their orbits.
+            ParticleIntegrator::step(state_, deltaTime, [this](ParticleState& state) { computeLodAccelerations(state); });
+            WorkerPool* pool = orbitLod_->analyticCount() >= PARALLEL_THRESHOLD ? pool_.get() : nullptr;
+            orbitLod_->advance(state_, deltaTime, pool);
+        } else {
+            ParticleIntegrator::step(state_, deltaTime, [this](ParticleState& state) { computeAccelerations(state); });
+        }
+    } else {
+        {
+            PhaseTimer syncTimer(phaseSink(&StepDiagnostics::syncSeconds));
+            gatherFromRigidBodies();
+        }
+        if (!orbitLod_) {
+            computeAccelerations(state_);
+        } else if (!reviewOrbitLod()) {
+            computeLodAccelerations(state_);
+        }
+        // Applied as impulses (a * m * dt) for the single Bullet step of length deltaTime.
+        for (int i = 0; i < state_.size(); ++i) {
+            if (orbitLod_ && orbitLod_->isAnalytic(i)) continue;
+            btRigidBody* rb = bodies_[i]->getRigidBody();
+            rb->activate(true);
+            rb->applyCentralImpulse(btVector3(state_.ax[i], state_.ay[i], state_.az[i]) * (state_.mass[i] * deltaTime));
+        }
+        if (engine_) {
+            engine_->stepSimulation(deltaTime);
+        }
+        if (orbitLod_) {
+            orbitLod_->advance(state_, deltaTime, nullptr);
+            for (int i = 0; i < state_.size(); ++i) {
+                if (!orbitLod_->isAnalytic(i)) continue;
+                bodies_[i]->setPosition(state_.x[i], state_.y[i], state_.z[i]);
+                bodies_[i]->setVelocity(state_.vx[i], state_.vy[i], state_.vz[i]);
+            }
+        }
     }
 
+    PhaseTimer syncTimer(phaseSink(&StepDiagnostics::syncSeconds));
     for (auto* body : bodies_) {
         body->updateFromPhysics();
     }
 }
 
-void GalaxyPhysicsController::addSpring(CelestialBodyToRigidWrapper* a, CelestialBodyToRigidWrapper* b, double length) {
-    if (!a || !b) return;
+double GalaxyPhysicsController::computeTotalEnergy() {
+    StepDiagnostics record;
+    measureState(record, true);
+    return record.totalEnergy();
+}
 
-    PhysicsSpring spring;
-    spring.bodyA = a;
-    spring.bodyB = b;
-    spring.targetLength = length;
+void GalaxyPhysicsController::refreshState() {
+    if (backend_ != PhysicsBackend::Bullet) return;
+    gatherFromRigidBodies();
+    gatherVelocitiesFromRigidBodies();
+}
 
-    spring.stiffness = 5.0;
+bool GalaxyPhysicsController::restoreState(const PhysicsCheckpoint& checkpoint) {
+    const int n = state_.size();
+    if (!checkpoint.isLoaded() || checkpoint.bodyCount() != n) return false;
 
-    springs_.push_back(spring);
-}
+    // Checkpoint body i becomes body target[i]; empty while both use the same order.
+    const std::int32_t* keys = checkpoint.keys();
+    std::vector<int> target;
+    if (!std::equal(bodyKeys_.begin(), bodyKeys_.end(), keys)) {
+        target.resize(n);
+        std::vector<char> taken(n, 0);
+        for (int i = 0; i < n; ++i) {
+            const int t = keys[i] >= 0 ? findBody(keys[i]) : i;
+            if (t < 0 || taken[t]) return false;
+            taken[t] = 1;
+            target[i] = t;
+        }
+    }
+
+    std::vector<double>* arrays[PhysicsCheckpoint::BODY_ARRAY_COUNT] = {
+        &state_.x, &state_.y, &state_.z, &state_.vx, &state_.vy, &state_.vz,
+        &state_.mass, &state_.gravitationalMass, &state_.damping};
+    for (int a = 0; a < PhysicsCheckpoint::BODY_ARRAY_COUNT; ++a) {
+        const double* source = checkpoint.bodyArray(static_cast<PhysicsCheckpoint::BodyArray>(a));
+        std::vector<double>& destination = *arrays[a];
+        if (target.empty()) std::copy(source, source + n, destination.begin());
+        else for (int i = 0; i < n; ++i) destination[target[i]] = source[i];
+    }
+    state_.clearAccelerations();
 
-void GalaxyPhysicsController::clearSprings() {
     springs_.clear();
+    const std::int32_t* springA = checkpoint.springA();
+    const std::int32_t* springB = checkpoint.springB();
+    for (int s = 0; s < checkpoint.springCount(); ++s) {
+        const int a = target.empty() ? springA[s] : target[springA[s]];
+        const int b = target.empty() ? springB[s] : target[springB[s]];
+        springs_.add(a, b, checkpoint.springRestLength()[s], checkpoint.springStiffness()[s]);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (backend_ == PhysicsBackend::Bullet) {
+            bodies_[i]->setPosition(state_.x[i], state_.y[i], state_.z[i]);
+            bodies_[i]->setVelocity(state_.vx[i], state_.vy[i], state_.vz[i]);
+        }
+        bodies_[i]->updateFromPhysics();
+    }
+    if (blockIntegrator_) blockIntegrator_->reset();
+    if (orbitLod_) orbitLod_->reset();
+    ++bodiesVersion_;
+    return true;
+}
+
+void GalaxyPhysicsController::measureState(StepDiagnostics& record, bool withPotential) {
+    refreshState();
+
+    double kinetic = 0, lx = 0, ly = 0, lz = 0, maxSpeed2 = 0;
+    int nonFinite = 0;
+    for (int i = 0; i < state_.size(); ++i) {
+        const double x = state_.x[i], y = state_.y[i], z = state_.z[i];
+        const double vx = state_.vx[i], vy = state_.vy[i], vz = state_.vz[i];
+        const double m = state_.gravitationalMass[i];
+        double v2 = vx * vx + vy * vy + vz * vz;
+        kinetic += 0.5 * m * v2;
+        lx += m * (y * vz - z * vy);
+        ly += m * (z * vx - x * vz);
+        lz += m * (x * vy - y * vx);
+        if (v2 > maxSpeed2) maxSpeed2 = v2;
+        if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z) || !std::isfinite(v2)) ++nonFinite;
+    }
+    record.kineticEnergy = kinetic;
+    record.angularMomentumX = lx;
+    record.angularMomentumY = ly;
+    record.angularMomentumZ = lz;
+    record.maxSpeed = std::sqrt(maxSpeed2);
+    record.nonFiniteBodies = nonFinite;
+
+    record.potentialEnergy = std::numeric_limits<double>::quiet_NaN();
+    record.springEnergy = std::numeric_limits<double>::quiet_NaN();
+    if (!withPotential) return;
+    WorkerPool* pool = state_.size() >= PARALLEL_THRESHOLD ? pool_.get() : nullptr;
+    double potential = 0;
+    for (auto* field : gravityFields_) {
+        potential += field->potentialEnergy(state_, pool);
+    }
+    record.potentialEnergy = potential;
+    record.springEnergy = springs_.potentialEnergy(state_);
+}
+
+void GalaxyPhysicsController::enableDiagnostics(const PhysicsDiagnostics::Options& options) {
+    // Close the previous file before a new one may truncate the same path.
+    diagnostics_.reset();
+    diagnostics_ = std::make_unique<PhysicsDiagnostics>(options);
+}
+
+void GalaxyPhysicsController::disableDiagnostics() {
+    diagnostics_.reset();
+}
+
+void GalaxyPhysicsController::setBlockTimesteps(bool enabled, const BlockTimestepIntegrator::Options& options) {
+    if (enabled) blockIntegrator_ = std::make_unique<BlockTimestepIntegrator>(options);
+    else blockIntegrator_.reset();
 }
 
-void GalaxyPhysicsController::applySpringForces(double deltaTime) {
-    for (const auto& spring : springs_) {
-        btRigidBody* rbA = spring.bodyA->getRigidBody();
-        btRigidBody* rbB = spring.bodyB->getRigidBody();
+void GalaxyPhysicsController::setOrbitLod(const BlackHoleGravityField* central,
+                                          const OrbitLodScheduler::Options& options) {
+    if (central) orbitLod_ = std::make_unique<OrbitLodScheduler>(central, options);
+    else orbitLod_.reset();
+}
+
+bool GalaxyPhysicsController::reviewOrbitLod() {
+    if (!orbitLod_->reviewDue(state_.size())) return false;
+    if (backend_ == PhysicsBackend::Bullet) gatherVelocitiesFromRigidBodies();
+    computeAccelerations(state_);
+    orbitLod_->review(state_, springs_);
+    return true;
+}
+
+void GalaxyPhysicsController::computeLodAccelerations(ParticleState& state) {
+    const std::vector<int>& integrated = orbitLod_->integratedBodies();
+    // A per-body tree walk costs about three times a body's share of the full group walk.
+    if (static_cast<int>(integrated.size()) * 3 >= state.size()) {
+        computeAccelerations(state);
+        return;
+    }
+    state.clearAccelerations();
+    computeActiveAccelerations(state, integrated);
+}
+
+void GalaxyPhysicsController::setThreadCount(int threadCount) {
+    pool_ = std::make_unique<WorkerPool>(threadCount);
+}
 
-        btVector3 posA = rbA->getWorldTransform().getOrigin();
-        btVector3 posB = rbB->getWorldTransform().getOrigin();
+void GalaxyPhysicsController::addSpring(CelestialBodyToRigidWrapper* a, CelestialBodyToRigidWrapper* b, double length) {
+    if (!a || !b) return;
+    addSpring(a->getParticleIndex(), b->getParticleIndex(), length);
+}
 
-        btVector3 diff = posB - posA;
-        double currentDist = diff.length();
+void GalaxyPhysicsController::addSpring(int indexA, int indexB, double length, double stiffness) {
+    if (indexA >= state_.size() || indexB >= state_.size()) return;
+    springs_.add(indexA, indexB, length, stiffness);
+    // A spring can pull a body off its Kepler orbit; review before the next step.
+    if (orbitLod_) orbitLod_->reset();
+}
 
-        if (currentDist < 0.001) continue;
-        double delta = currentDist - spring.targetLength;
+void GalaxyPhysicsController::clearSprings() {
+    springs_.clear();
+    if (orbitLod_) orbitLod_->reset();
+}
 
-        double forceMagnitude = spring.stiffness * delta;
+void GalaxyPhysicsController::gatherFromRigidBodies() {
+    for (int i = 0; i < state_.size(); ++i) {
+        state_.x[i] = bodies_[i]->getX();
+        state_.y[i] = bodies_[i]->getY();
+        state_.z[i] = bodies_[i]->getZ();
+    }
+}
 
-        btVector3 forceDir = diff.normalized();
+void GalaxyPhysicsController::gatherVelocitiesFromRigidBodies() {
+    for (int i = 0; i < state_.size(); ++i) {
+        btVector3 v = bodies_[i]->getRigidBody()->getLinearVelocity();
+        state_.vx[i] = v.x();
+        state_.vy[i] = v.y();
+        state_.vz[i] = v.z();
+    }
+}
 
-        btVector3 force = forceDir * forceMagnitude;
+void GalaxyPhysicsController::computeAccelerations(ParticleState& state) {
+    state.clearAccelerations();
+    WorkerPool* pool = state.size() >= PARALLEL_THRESHOLD ? pool_.get() : nullptr;
+    {
+        PhaseTimer gravityTimer(phaseSink(&StepDiagnostics::gravitySeconds));
+        for (auto* field : gravityFields_) {
+            field->accumulateAccelerations(state, pool);
+        }
+    }
+    accumulateSpringForces(state);
+}
 
-        rbA->applyCentralImpulse(force * deltaTime);
-        rbB->applyCentralImpulse(-force * deltaTime);
+void GalaxyPhysicsController::computeActiveAccelerations(ParticleState& state, const std::vector<int>& active) {
+    WorkerPool* pool = static_cast<int>(active.size()) >= PARALLEL_THRESHOLD ? pool_.get() : nullptr;
+    {
+        PhaseTimer gravityTimer(phaseSink(&StepDiagnostics::gravitySeconds));
+        for (auto* field : gravityFields_) {
+            field->accumulateActiveAccelerations(state, active, pool);
+        }
     }
-}
\ No newline at end of file
+    accumulateSpringForces(state);
+}
+
+void GalaxyPhysicsController::accumulateSpringForces(ParticleState& state) {
+    PhaseTimer springTimer(phaseSink(&StepDiagnostics::springSeconds));
+    const bool parallel = springs_.size() >= PARALLEL_THRESHOLD || state.size() >= PARALLEL_THRESHOLD;
+    springs_.accumulate(state, parallel ? pool_.get() : nullptr);
+}
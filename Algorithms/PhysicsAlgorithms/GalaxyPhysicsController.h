@@ -3,20 +3,27 @@
 
 #include "PhysicsEngine.h"
 #include "CelestialBodyToRigidWrapper.h"
-#include "BlackHoleGravityField.h"
+#include "GravityField.h"
+#include "ParticleState.h"
+#include "WorkerPool.h"
+#include "BlockTimestepIntegrator.h"
+#include "OrbitLodScheduler.h"
+#include "PhysicsDiagnostics.h"
+#include "SpringSet.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
+class PhysicsCheckpoint;
+
 /**
- * @struct PhysicsSpring
- * @brief Represents a restorative force between two physical bodies.
- * * Used to maintain a target distance between celestial objects,
- * effectively acting like a structural bond or a graph edge constraint.
+ * @enum PhysicsBackend
+ * @brief Selects how GalaxyPhysicsController integrates the bodies.
  */
-struct PhysicsSpring {
-    CelestialBodyToRigidWrapper* bodyA; ///< First connected body.
-    CelestialBodyToRigidWrapper* bodyB; ///< Second connected body.
-    double targetLength;               ///< The ideal distance between bodies.
-    double stiffness;                  ///< The force constant (Hooke's Law).
+enum class PhysicsBackend {
+    Bullet,   ///< Every body is a btRigidBody stepped by the PhysicsEngine (supports collisions).
+    Particles ///< Bodies are point masses in a ParticleState, advanced with leapfrog; no engine needed.
 };
 
 /**
@@ -31,6 +38,16 @@ struct PhysicsSpring {
  * This controller acts as a facade for the `PhysicsEngine`. It manages the
  * lifecycle of physical entities, applies global forces (like black hole gravity),
  * and handles internal constraints (springs) between systems.
+ *
+ * Forces are always computed over a structure-of-arrays ParticleState. With the
+ * Bullet backend the state is gathered from the rigid bodies every step and the
+ * accelerations are applied back as central forces; with the particle backend the
+ * state is the simulation itself and the engine is not used at all.
+ *
+ * Force accumulation runs on a WorkerPool. Gravity fields split the bodies between
+ * the workers; springs live in a SpringSet, whose forces are computed per spring and
+ * then gathered per body, so the result is identical from run to run for a given
+ * thread count.
  * *
 
 [Image of mass-spring system diagram]
@@ -40,9 +57,12 @@ class GalaxyPhysicsController {
 public:
     /**
      * @brief Constructs the controller tied to a specific physics engine.
-     * @param engine Pointer to the core PhysicsEngine instance.
+     * @param engine Pointer to the core PhysicsEngine instance (may be nullptr for PhysicsBackend::Particles).
+     * @param backend How bodies are integrated.
+     * @param threadCount Number of force workers; 0 = one per hardware thread.
      */
-    GalaxyPhysicsController(PhysicsEngine* engine);
+    GalaxyPhysicsController(PhysicsEngine* engine, PhysicsBackend backend = PhysicsBackend::Bullet,
+                            int threadCount = 0);
 
     /**
      * @brief Destructor.
@@ -52,15 +72,41 @@ public:
 
     /**
      * @brief Registers a new celestial body into the physics simulation loop.
+     * * With PhysicsBackend::Particles the body must be a point-mass wrapper; it is
+     * attached to a new particle slot, taking over its current position and velocity.
      * @param body The physics-wrapped celestial object.
+     * @param key Caller's identifier for the body (e.g. its galaxy index), or -1 for none.
+     * A body registered under a key that is already in use replaces it in findBody().
+     */
+    void addCelestialBody(CelestialBodyToRigidWrapper* body, int key = -1);
+
+    /**
+     * @brief Takes a body out of the simulation without touching the others.
+     * * The last body moves into the freed slot (its particle index changes) and the
+     * springs attached to the removed body are dropped, so the cost does not depend on
+     * the number of bodies; gravity fields pick up the change at the next step.
+     * @param key The key the body was added with.
+     * @return The detached wrapper (the caller deletes it), or nullptr if the key is unknown.
+     */
+    CelestialBodyToRigidWrapper* removeCelestialBody(int key);
+
+    /** @brief Returns the index in getBodies() of the body added with `key`, or -1. */
+    int findBody(int key) const;
+
+    /** @brief Returns the key body `index` was added with, or -1. */
+    int getBodyKey(int index) const { return bodyKeys_[index]; }
+
+    /**
+     * @brief Returns a counter that changes whenever bodies are added or removed, i.e.
+     * whenever body indices (and snapshots taken earlier) may have become stale.
      */
-    void addCelestialBody(CelestialBodyToRigidWrapper* body);
+    std::uint64_t getBodiesVersion() const { return bodiesVersion_; }
 
     /**
-     * @brief Adds a gravity source (e.g., a Black Hole) to the simulation.
-     * @param field Pointer to the gravity field to be applied every step.
+     * @brief Adds a gravity source (e.g., a Black Hole or Barnes–Hut N-body gravity) to the simulation.
+     * @param field Pointer to the gravity field to be applied every step (not owned).
      */
-    void addGravityField(BlackHoleGravityField* field);
+    void addGravityField(GravityField* field);
 
     /**
      * @brief Performs a single simulation step.
@@ -76,6 +122,89 @@ public:
     /** @brief Returns the list of currently managed physical bodies. */
     const std::vector<CelestialBodyToRigidWrapper*>& getBodies() const { return bodies_; }
 
+    /** @brief Returns the SoA state of all bodies, indexed like getBodies(). */
+    const ParticleState& getState() const { return state_; }
+
+    /**
+     * @brief Bullet backend: copies the rigid bodies' positions and velocities into getState(),
+     * which otherwise only holds what the last force pass needed. No-op for particles.
+     */
+    void refreshState();
+
+    /**
+     * @brief Overwrites positions, velocities, masses, damping and springs with a checkpoint's.
+     * * Checkpoint bodies are matched to getBodies() by key, or by index if they have none.
+     * @param checkpoint A loaded checkpoint with as many bodies as the controller.
+     * @return False (and nothing changed) if the bodies do not match.
+     * @see PhysicsCheckpoint::restore()
+     */
+    bool restoreState(const PhysicsCheckpoint& checkpoint);
+
+    /**
+     * @brief Particle backend: integrates every body with its own power-of-two
+     * fraction of deltaTime (see BlockTimestepIntegrator) instead of one shared step.
+     * @param enabled False returns to the plain leapfrog step.
+     * @param options Step criterion and deepest level.
+     */
+    void setBlockTimesteps(bool enabled, const BlockTimestepIntegrator::Options& options = {});
+
+    /** @brief Returns the block timestep integrator, or nullptr if block timesteps are off. */
+    const BlockTimestepIntegrator* getBlockTimesteps() const { return blockIntegrator_.get(); }
+
+    /**
+     * @brief Moves bodies on undisturbed orbits around `central` analytically (see OrbitLodScheduler).
+     * * Works with the Bullet backend and with the shared-step particle backend; with
+     * block timesteps on it is ignored. Analytic rigid bodies get no impulses and are
+     * put back on their orbit after every Bullet step.
+     * @param central The black hole; must be one of the gravity fields. nullptr turns the LOD off.
+     * @param options Review criteria.
+     */
+    void setOrbitLod(const BlackHoleGravityField* central, const OrbitLodScheduler::Options& options = {});
+
+    /** @brief Returns the orbit LOD scheduler, or nullptr if it is off. */
+    const OrbitLodScheduler* getOrbitLod() const { return orbitLod_.get(); }
+
+    /**
+     * @brief Records a StepDiagnostics for every following step (see PhysicsDiagnostics).
+     * * Costs a few clock reads per phase and one pass over the velocities per step, plus
+     * a potential energy pass every Options::energyInterval steps. Enabling again starts
+     * a new history (and truncates the CSV file).
+     * @param options History length, energy sampling and CSV output.
+     */
+    void enableDiagnostics(const PhysicsDiagnostics::Options& options);
+
+    /** @brief Stops recording and closes the CSV file. */
+    void disableDiagnostics();
+
+    /** @brief Returns the diagnostics, or nullptr if they are off. Not safe to read while stepping. */
+    const PhysicsDiagnostics* getDiagnostics() const { return diagnostics_.get(); }
+
+    /** @brief Returns the backend chosen at construction. */
+    PhysicsBackend getBackend() const { return backend_; }
+
+    /**
+     * @brief Replaces the force worker pool.
+     * @param threadCount Number of workers; 0 = one per hardware thread.
+     */
+    void setThreadCount(int threadCount);
+
+    /** @brief Returns the number of force workers. */
+    int getThreadCount() const { return pool_->threadCount(); }
+
+    /**
+     * @brief Returns the kinetic energy plus the potential energy of every gravity field.
+     *
+     * Body i counts with its CelestialObject mass (see GravityField::potentialEnergy()), so
+     * the value is conserved by undamped gravity-only runs and its drift measures the
+     * integration error. Springs act on the inertial masses, so their energy is not in these
+     * units and is left out (see StepDiagnostics::springEnergy); damping is not included
+     * either. Not thread-safe against a running SimulationThread.
+     */
+    double computeTotalEnergy();
+
+    /** @brief Returns the force workers, e.g. to share them with a layout pass (not while stepping). */
+    WorkerPool* getWorkerPool() const { return pool_.get(); }
+
     /**
      * @brief Creates a physical constraint between two bodies.
      * Useful for visual graph layout or binary star system modeling.
@@ -85,20 +214,93 @@ public:
      */
     void addSpring(CelestialBodyToRigidWrapper* a, CelestialBodyToRigidWrapper* b, double length);
 
+    /**
+     * @brief Creates a spring between two particle indices (see CelestialBodyToRigidWrapper::getParticleIndex()).
+     * @param indexA First body.
+     * @param indexB Second body.
+     * @param length The desired rest length of the connection.
+     * @param stiffness Hooke's constant.
+     */
+    void addSpring(int indexA, int indexB, double length, double stiffness = DEFAULT_SPRING_STIFFNESS);
+
+    /** @brief Returns the springs. */
+    const SpringSet& getSprings() const { return springs_; }
+
     /** @brief Removes all active spring constraints. */
     void clearSprings();
 
 private:
     PhysicsEngine* engine_;                                 ///< Core physics engine (e.g., Bullet wrapper).
+    PhysicsBackend backend_;                                ///< How bodies are integrated.
+    ParticleState state_;                                   ///< SoA body state used for force computation.
     std::vector<CelestialBodyToRigidWrapper*> bodies_;      ///< Managed physical bodies.
-    std::vector<BlackHoleGravityField*> gravityFields_;    ///< Active gravitational sources.
-    std::vector<PhysicsSpring> springs_;                    ///< Active spring constraints.
+    std::vector<int> bodyKeys_;                             ///< Key of each body, -1 if none.
+    std::unordered_map<int, int> keyToBody_;                ///< Body index of each key.
+    std::uint64_t bodiesVersion_ = 0;                       ///< Incremented by every add and remove.
+    std::vector<GravityField*> gravityFields_;              ///< Active gravitational sources.
+    SpringSet springs_;                                     ///< Active spring constraints.
+
+    std::unique_ptr<WorkerPool> pool_;                      ///< Threads for force accumulation.
+    std::unique_ptr<BlockTimestepIntegrator> blockIntegrator_; ///< Set when block timesteps are on.
+    std::unique_ptr<OrbitLodScheduler> orbitLod_;           ///< Set when the orbit LOD is on.
+    std::unique_ptr<PhysicsDiagnostics> diagnostics_;       ///< Set when diagnostics are on.
+    StepDiagnostics currentStep_;                           ///< Record of the step in progress.
+
+    /// @brief Below this many bodies (or springs) the work is done on the calling thread.
+    static constexpr int PARALLEL_THRESHOLD = 1024;
+
+    /// @brief Stiffness of springs added without an explicit one.
+    static constexpr double DEFAULT_SPRING_STIFFNESS = 5.0;
+
+    /** @brief The work of simulateStep(), without the diagnostics bookkeeping. */
+    void stepBodies(double deltaTime);
+
+    /** @brief Returns where the running step accumulates `phase` seconds, or nullptr without diagnostics. */
+    double* phaseSink(double StepDiagnostics::* phase) { return diagnostics_ ? &(currentStep_.*phase) : nullptr; }
+
+    /**
+     * @brief Fills in the energies, angular momentum, max speed and non-finite count of
+     * the current state (refreshState() first).
+     * @param record Receives the measurements.
+     * @param withPotential False leaves potentialEnergy at NaN and skips the field passes.
+     */
+    void measureState(StepDiagnostics& record, bool withPotential);
+
+    /**
+     * @brief Adds the Hooke's Law accelerations of all springs to state.ax/ay/az.
+     */
+    void accumulateSpringForces(ParticleState& state);
+
+    /**
+     * @brief Clears state.ax/ay/az and accumulates gravity and spring accelerations.
+     */
+    void computeAccelerations(ParticleState& state);
+
+    /**
+     * @brief Accumulates gravity for the active bodies and all spring accelerations
+     * (state.ax/ay/az are cleared by the BlockTimestepIntegrator).
+     */
+    void computeActiveAccelerations(ParticleState& state, const std::vector<int>& active);
+
+    /**
+     * @brief Bullet backend: copies rigid body positions into state_ (velocities are not needed for forces).
+     */
+    void gatherFromRigidBodies();
+
+    /** @brief Bullet backend: copies rigid body velocities into state_. */
+    void gatherVelocitiesFromRigidBodies();
+
+    /**
+     * @brief Runs a due LOD review: full accelerations at the current positions, then
+     * reclassification. Returns true if state_.ax/ay/az now hold all accelerations.
+     */
+    bool reviewOrbitLod();
 
     /**
-     * @brief Internal logic to apply Hooke's Law forces to connected bodies.
-     * @param deltaTime Time step for force application.
+     * @brief Clears state.ax/ay/az and fills them at least for the LOD's integrated bodies;
+     * falls back to computeAccelerations() when most bodies are integrated anyway.
      */
-    void applySpringForces(double deltaTime);
+    void computeLodAccelerations(ParticleState& state);
 };
 
 #endif // GALAXYPHYSICSCONTROLLER_H
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef GRAVITYFIELD_H
+#define GRAVITYFIELD_H
+
+#include "ParticleState.h"
+#include "WorkerPool.h"
+#include <vector>
+
+/**
+ * @file GravityField.h
+ * @brief Common interface for every gravity source applied by GalaxyPhysicsController.
+ */
+
+/**
+ * @class GravityField
+ * @brief A source of gravitational acceleration that acts on all simulated bodies once per step.
+ *
+ * GalaxyPhysicsController::simulateStep() gathers the body positions into a
+ * ParticleState and calls accumulateAccelerations() on every registered field, so
+ * new gravity models (a central black hole, body-to-body N-body gravity, ...) plug in
+ * without changing the controller, and work with both the Bullet and the particle backend.
+ */
+class GravityField {
+public:
+    /** @brief Virtual destructor for safe polymorphic deletion. */
+    virtual ~GravityField() = default;
+
+    /**
+     * @brief Adds this field's accelerations to state.ax/ay/az.
+     *
+     * Implementations split the work over the pool's workers so that each body's
+     * acceleration is written by exactly one worker; the result must not depend on
+     * the number of workers.
+     *
+     * @param state Positions and masses of all bodies; accelerations are accumulated, not overwritten.
+     * @param pool Workers to use, or nullptr to run on the calling thread.
+     */
+    virtual void accumulateAccelerations(ParticleState& state, WorkerPool* pool) = 0;
+
+    /**
+     * @brief Returns the potential energy of all bodies in this field (diagnostics only).
+     *
+     * Body i counts with mass state.gravitationalMass[i], matching the kinetic energy in
+     * GalaxyPhysicsController::computeTotalEnergy(). The default is a field without potential.
+     *
+     * @param state Positions and masses of all bodies.
+     * @param pool Workers to use, or nullptr to run on the calling thread.
+     */
+    virtual double potentialEnergy(const ParticleState& /*state*/, WorkerPool* /*pool*/) const { return 0.0; }
+
+    /**
+     * @brief Like accumulateAccelerations(), but only the bodies listed in `active` need
+     * their acceleration (BlockTimestepIntegrator). Positions of all bodies are current.
+     *
+     * The default evaluates every body; fields that can do less work override it.
+     * Entries of bodies outside `active` may change and are ignored by the caller.
+     *
+     * @param state Positions and masses of all bodies; accelerations are accumulated.
+     * @param active Indices of the bodies that need an acceleration.
+     * @param pool Workers to use, or nullptr to run on the calling thread.
+     */
+    virtual void accumulateActiveAccelerations(ParticleState& state, const std::vector<int>& /*active*/, WorkerPool* pool) {
+        accumulateAccelerations(state, pool);
+    }
+};
+
+#endif // GRAVITYFIELD_H
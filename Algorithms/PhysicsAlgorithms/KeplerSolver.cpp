@@ -0,0 +1,93 @@
+#include "KeplerSolver.h"
+#include <cmath>
+
+bool KeplerSolver::fromState(double rx, double ry, double rz, double vx, double vy, double vz, double mu,
+                             KeplerOrbit &orbit) {
+    const double r = std::sqrt(rx * rx + ry * ry + rz * rz);
+    if (r <= 0 || mu <= 0) return false;
+    const double v2 = vx * vx + vy * vy + vz * vz;
+    const double energy = 0.5 * v2 - mu / r;
+    if (energy >= 0) return false;
+
+    // Specific angular momentum h = r x v; zero for radial motion.
+    const double hx = ry * vz - rz * vy, hy = rz * vx - rx * vz, hz = rx * vy - ry * vx;
+    const double h = std::sqrt(hx * hx + hy * hy + hz * hz);
+    if (h <= 1e-12 * r * std::sqrt(v2)) return false;
+
+    // Eccentricity vector (v x h) / mu - r / |r|, pointing at periapsis.
+    double ex = (vy * hz - vz * hy) / mu - rx / r;
+    double ey = (vz * hx - vx * hz) / mu - ry / r;
+    double ez = (vx * hy - vy * hx) / mu - rz / r;
+    const double e = std::sqrt(ex * ex + ey * ey + ez * ez);
+    if (e >= 1.0) return false;
+
+    KeplerOrbit result;
+    result.semiMajorAxis = -mu / (2.0 * energy);
+    result.eccentricity = e;
+    result.meanMotion = std::sqrt(mu / (result.semiMajorAxis * result.semiMajorAxis * result.semiMajorAxis));
+
+    // P towards periapsis; for a (numerically) circular orbit the epoch position instead.
+    if (e > 1e-10) {
+        result.px = ex / e;
+        result.py = ey / e;
+        result.pz = ez / e;
+    } else {
+        result.eccentricity = 0;
+        result.px = rx / r;
+        result.py = ry / r;
+        result.pz = rz / r;
+    }
+    // Q = (h / |h|) x P.
+    result.qx = (hy * result.pz - hz * result.py) / h;
+    result.qy = (hz * result.px - hx * result.pz) / h;
+    result.qz = (hx * result.py - hy * result.px) / h;
+
+    // True anomaly of the epoch position, then eccentric and mean anomaly.
+    const double cosNu = (rx * result.px + ry * result.py + rz * result.pz) / r;
+    const double sinNu = (rx * result.qx + ry * result.qy + rz * result.qz) / r;
+    const double eccentric = std::atan2(std::sqrt(1.0 - e * e) * sinNu, result.eccentricity + cosNu);
+    result.meanAnomalyAtEpoch = eccentric - result.eccentricity * std::sin(eccentric);
+
+    orbit = result;
+    return true;
+}
+
+double KeplerSolver::eccentricAnomaly(double meanAnomaly, double eccentricity) {
+    const double m = std::remainder(meanAnomaly, 2.0 * M_PI);
+    // Starting at pi for very eccentric orbits keeps Newton from overshooting near periapsis.
+    double E = eccentricity < 0.8 ? m + eccentricity * std::sin(m) : (m < 0 ? -M_PI : M_PI);
+    for (int iteration = 0; iteration < 32; ++iteration) {
+        const double f = E - eccentricity * std::sin(E) - m;
+        const double step = f / (1.0 - eccentricity * std::cos(E));
+        E -= step;
+        if (std::abs(step) < 1e-14) break;
+    }
+    return E;
+}
+
+void KeplerSolver::stateAt(const KeplerOrbit &orbit, double t, double &rx, double &ry, double &rz,
+                           double &vx, double &vy, double &vz) {
+    const double a = orbit.semiMajorAxis;
+    const double e = orbit.eccentricity;
+    const double E = eccentricAnomaly(orbit.meanAnomalyAtEpoch + orbit.meanMotion * t, e);
+    const double cosE = std::cos(E), sinE = std::sin(E);
+    const double minorFactor = std::sqrt(1.0 - e * e);
+
+    // In-plane coordinates along P and Q; |v| scales with n a^2 / r.
+    const double p = a * (cosE - e);
+    const double q = a * minorFactor * sinE;
+    const double speed = orbit.meanMotion * a * a / (a * (1.0 - e * cosE));
+    const double vp = -speed * sinE;
+    const double vq = speed * minorFactor * cosE;
+
+    rx = p * orbit.px + q * orbit.qx;
+    ry = p * orbit.py + q * orbit.qy;
+    rz = p * orbit.pz + q * orbit.qz;
+    vx = vp * orbit.px + vq * orbit.qx;
+    vy = vp * orbit.py + vq * orbit.qy;
+    vz = vp * orbit.pz + vq * orbit.qz;
+}
+
+double KeplerSolver::period(const KeplerOrbit &orbit) {
+    return orbit.meanMotion > 0 ? 2.0 * M_PI / orbit.meanMotion : 0.0;
+}
@@ -0,0 +1,74 @@
+#ifndef KEPLERSOLVER_H
+#define KEPLERSOLVER_H
+
+/**
+ * @file KeplerSolver.h
+ * @brief Closed-form two-body motion about a fixed central mass.
+ */
+
+/**
+ * @struct KeplerOrbit
+ * @brief A bound (elliptic) orbit relative to the central mass, with the epoch at t = 0.
+ *
+ * The orbit plane is spanned by the unit vectors P (towards periapsis) and Q (90 degrees
+ * ahead in the direction of motion). Circular orbits have no periapsis; there P points
+ * at the epoch position.
+ */
+struct KeplerOrbit {
+    double semiMajorAxis = 0;      ///< a.
+    double eccentricity = 0;       ///< e, in [0, 1).
+    double meanMotion = 0;         ///< n = sqrt(mu / a^3), radians per time unit.
+    double meanAnomalyAtEpoch = 0; ///< M at t = 0.
+    double px = 1, py = 0, pz = 0; ///< Unit vector towards periapsis.
+    double qx = 0, qy = 1, qz = 0; ///< Unit vector completing the orbit plane.
+};
+
+/**
+ * @class KeplerSolver
+ * @brief Converts state vectors to orbital elements and back, at any time, without stepping.
+ *
+ * A body that only feels a point mass follows a Kepler ellipse exactly, so its state
+ * after any time t is
+ *
+ *     M = M0 + n t,   E - e sin E = M,
+ *     r = P a (cos E - e) + Q a sqrt(1 - e^2) sin E
+ *
+ * which costs one solution of Kepler's equation (a few Newton iterations) regardless
+ * of t, and does not accumulate integration error.
+ */
+class KeplerSolver {
+public:
+    /**
+     * @brief Computes the orbit of a body from its position and velocity relative to the central mass.
+     * @param rx, ry, rz Position relative to the central mass.
+     * @param vx, vy, vz Velocity.
+     * @param mu Gravitational parameter G * M of the central mass.
+     * @param orbit Receives the elements, with the epoch at the given state.
+     * @return False (orbit unchanged) if the body is unbound or moves on a radial line.
+     */
+    static bool fromState(double rx, double ry, double rz, double vx, double vy, double vz, double mu,
+                          KeplerOrbit &orbit);
+
+    /**
+     * @brief Solves Kepler's equation E - e sin E = M with Newton's method.
+     * @param meanAnomaly M, any value (reduced to [-pi, pi]).
+     * @param eccentricity e, in [0, 1).
+     * @return The eccentric anomaly E in [-pi, pi].
+     */
+    static double eccentricAnomaly(double meanAnomaly, double eccentricity);
+
+    /**
+     * @brief Returns the state on the orbit `t` time units after the epoch.
+     * @param orbit The orbit.
+     * @param t Time since the epoch (may be negative).
+     * @param rx, ry, rz Receive the position relative to the central mass.
+     * @param vx, vy, vz Receive the velocity.
+     */
+    static void stateAt(const KeplerOrbit &orbit, double t, double &rx, double &ry, double &rz,
+                        double &vx, double &vy, double &vz);
+
+    /** @brief Returns the orbital period 2 * pi / n. */
+    static double period(const KeplerOrbit &orbit);
+};
+
+#endif // KEPLERSOLVER_H
@@ -0,0 +1,192 @@
+#include "MultilevelLayout.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <tuple>
+
+MultilevelLayout::MultilevelLayout(WorkerPool *pool)
+    : layout_(pool) {}
+
+void MultilevelLayout::setGraph(int vertexCount, const std::vector<int> &from, const std::vector<int> &to,
+                                const std::vector<double> &restLength) {
+    const int n = std::max(0, vertexCount);
+    const size_t m = std::min({from.size(), to.size(), restLength.size()});
+
+    levels_.assign(1, Level());
+    Level &graph = levels_[0];
+    graph.vertexCount = n;
+    for (size_t e = 0; e < m; ++e) {
+        if (from[e] < 0 || from[e] >= n || to[e] < 0 || to[e] >= n || from[e] == to[e]) continue;
+        graph.from.push_back(from[e]);
+        graph.to.push_back(to[e]);
+        graph.rest.push_back(restLength[e]);
+    }
+}
+
+MultilevelLayout::Level MultilevelLayout::coarsen(Level &fine) {
+    const int n = fine.vertexCount;
+    const size_t m = fine.from.size();
+
+    std::vector<int> offset(n + 1, 0), neighbor(2 * m);
+    std::vector<double> rest(2 * m);
+    for (size_t e = 0; e < m; ++e) {
+        ++offset[fine.from[e] + 1];
+        ++offset[fine.to[e] + 1];
+    }
+    for (int v = 0; v < n; ++v) offset[v + 1] += offset[v];
+    std::vector<int> fill(offset.begin(), offset.end() - 1);
+    for (size_t e = 0; e < m; ++e) {
+        neighbor[fill[fine.from[e]]] = fine.to[e];
+        rest[fill[fine.from[e]]++] = fine.rest[e];
+        neighbor[fill[fine.to[e]]] = fine.from[e];
+        rest[fill[fine.to[e]]++] = fine.rest[e];
+    }
+
+    // Low-degree vertices pick first, so leaves pair up before hubs swallow them.
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return offset[a + 1] - offset[a] < offset[b + 1] - offset[b];
+    });
+
+    std::vector<int> &group = fine.parent;
+    group.assign(n, -1);
+    std::vector<int> groupSize;
+
+    // Matching: pair each vertex with its unmatched neighbor along the shortest edge.
+    for (int v: order) {
+        if (group[v] >= 0) continue;
+        int best = -1;
+        double bestRest = 0;
+        for (int k = offset[v]; k < offset[v + 1]; ++k) {
+            int u = neighbor[k];
+            if (group[u] >= 0 || (best >= 0 && rest[k] >= bestRest)) continue;
+            best = u;
+            bestRest = rest[k];
+        }
+        if (best < 0) continue;
+        group[v] = group[best] = static_cast<int>(groupSize.size());
+        groupSize.push_back(2);
+    }
+
+    // Leftovers (all neighbors already matched) join the smallest neighboring group;
+    // without this, stars and other hub-heavy graphs would barely shrink.
+    for (int v: order) {
+        if (group[v] >= 0) continue;
+        int best = -1;
+        for (int k = offset[v]; k < offset[v + 1]; ++k) {
+            int g = group[neighbor[k]];
+            if (g >= 0 && (best < 0 || groupSize[g] < groupSize[best])) best = g;
+        }
+        if (best < 0) {
+            best = static_cast<int>(groupSize.size());
+            groupSize.push_back(0);
+        }
+        group[v] = best;
+        ++groupSize[best];
+    }
+
+    Level coarse;
+    coarse.vertexCount = static_cast<int>(groupSize.size());
+
+    // Parallel edges between two groups merge into one with the mean rest length.
+    std::vector<std::tuple<int, int, double>> edges;
+    edges.reserve(m);
+    for (size_t e = 0; e < m; ++e) {
+        int a = group[fine.from[e]], b = group[fine.to[e]];
+        if (a == b) continue;
+        edges.emplace_back(std::min(a, b), std::max(a, b), fine.rest[e]);
+    }
+    std::sort(edges.begin(), edges.end());
+    for (size_t i = 0; i < edges.size();) {
+        size_t j = i;
+        double sum = 0;
+        for (; j < edges.size() && std::get<0>(edges[j]) == std::get<0>(edges[i]) &&
+               std::get<1>(edges[j]) == std::get<1>(edges[i]); ++j)
+            sum += std::get<2>(edges[j]);
+        coarse.from.push_back(std::get<0>(edges[i]));
+        coarse.to.push_back(std::get<1>(edges[i]));
+        coarse.rest.push_back(sum / static_cast<double>(j - i));
+        i = j;
+    }
+    return coarse;
+}
+
+int MultilevelLayout::run(double *x, double *y, double *z, const Options &options) {
+    if (levels_.empty()) return 0;
+
+    levels_.resize(1);
+    while (levels_.back().vertexCount > options.coarsestSize && static_cast<int>(levels_.size()) < options.maxLevels) {
+        Level coarse = coarsen(levels_.back());
+        if (coarse.vertexCount > options.minShrink * levels_.back().vertexCount) break;
+        levels_.push_back(std::move(coarse));
+    }
+    levels_.back().parent.clear();
+    const int coarsest = static_cast<int>(levels_.size()) - 1;
+
+    auto positions = [&](int l, double *&px, double *&py, double *&pz) {
+        if (l == 0) {
+            px = x;
+            py = y;
+            pz = z;
+        } else {
+            px = levels_[l].x.data();
+            py = levels_[l].y.data();
+            pz = levels_[l].z.data();
+        }
+    };
+
+    // Restrict the start layout: a coarse vertex starts at the centroid of its group.
+    for (int l = 1; l <= coarsest; ++l) {
+        Level &level = levels_[l];
+        level.x.assign(level.vertexCount, 0.0);
+        level.y.assign(level.vertexCount, 0.0);
+        level.z.assign(level.vertexCount, 0.0);
+        std::vector<int> count(level.vertexCount, 0);
+        double *fx, *fy, *fz;
+        positions(l - 1, fx, fy, fz);
+        const std::vector<int> &parent = levels_[l - 1].parent;
+        for (int v = 0; v < levels_[l - 1].vertexCount; ++v) {
+            level.x[parent[v]] += fx[v];
+            level.y[parent[v]] += fy[v];
+            level.z[parent[v]] += fz[v];
+            ++count[parent[v]];
+        }
+        for (int c = 0; c < level.vertexCount; ++c) {
+            if (count[c] == 0) continue;
+            level.x[c] /= count[c];
+            level.y[c] /= count[c];
+            level.z[c] /= count[c];
+        }
+    }
+
+    double *px, *py, *pz;
+    positions(coarsest, px, py, pz);
+    layout_.setGraph(levels_[coarsest].vertexCount, levels_[coarsest].from, levels_[coarsest].to,
+                     levels_[coarsest].rest);
+    int iterations = layout_.run(px, py, pz, options.layout);
+
+    ForceDirectedLayout::Options refine = options.layout;
+    refine.initialStep = options.refineStep;
+    refine.maxIterations = options.refineIterations;
+    for (int l = coarsest - 1; l >= 0; --l) {
+        const Level &level = levels_[l];
+        layout_.setGraph(level.vertexCount, level.from, level.to, level.rest);
+
+        // Prolong: start at the parent's position, spread by a small golden-angle offset
+        // so that the members of a group do not coincide.
+        double *cx, *cy, *cz;
+        positions(l + 1, cx, cy, cz);
+        positions(l, px, py, pz);
+        const double spread = 0.1 * layout_.meanRestLength();
+        for (int v = 0; v < level.vertexCount; ++v) {
+            const int p = level.parent[v];
+            const double angle = 2.39996322972865332 * v;
+            px[v] = cx[p] + spread * std::cos(angle);
+            py[v] = cy[p] + spread * std::sin(angle);
+            if (!options.layout.planar) pz[v] = cz[p] + spread * (std::fmod(0.6180339887498949 * v, 1.0) - 0.5);
+        }
+        iterations += layout_.run(px, py, pz, refine);
+    }
+    return iterations;
+}
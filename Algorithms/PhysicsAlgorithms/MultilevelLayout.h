@@ -0,0 +1,108 @@
+#ifndef MULTILEVELLAYOUT_H
+#define MULTILEVELLAYOUT_H
+
+#include "ForceDirectedLayout.h"
+#include <vector>
+
+/**
+ * @file MultilevelLayout.h
+ * @brief Coarsen–layout–refine driver for ForceDirectedLayout.
+ */
+
+/**
+ * @class MultilevelLayout
+ * @brief Lays out large graphs by solving a hierarchy of ever smaller graphs (Walshaw / sfdp scheme).
+ *
+ * A single force-directed run from random positions needs many iterations
+ * before distant parts of a large graph have untangled, because each iteration
+ * only moves vertices by a bounded step. The multilevel scheme removes that
+ * long-range work:
+ *  1. **Coarsen**: a matching merges every vertex with a neighbor (shortest edge
+ *     first); vertices whose neighbors are all taken join the smallest
+ *     neighboring group. Parallel edges collapse into one with the mean rest
+ *     length. This repeats until the graph has at most `coarsestSize` vertices
+ *     or stops shrinking.
+ *  2. **Layout** the coarsest graph, starting from the mean of the caller's
+ *     positions of the vertices each coarse vertex stands for.
+ *  3. **Refine**: every vertex starts at its group's position (plus a small
+ *     deterministic offset) and ForceDirectedLayout polishes the level with a
+ *     short initial step, down to the original graph.
+ *
+ * Each level costs about as much as one ForceDirectedLayout iteration per
+ * iteration and the levels shrink geometrically, so the total stays close to
+ * linear in the graph size.
+ *
+ * @code
+ * MultilevelLayout layout(&pool);
+ * layout.setGraph(n, from, to, restLength);
+ * layout.run(x.data(), y.data(), z.data());
+ * @endcode
+ */
+class MultilevelLayout {
+public:
+    /**
+     * @struct Options
+     * @brief Tuning parameters.
+     */
+    struct Options {
+        ForceDirectedLayout::Options layout; ///< Used on every level (initialStep only on the coarsest).
+        int coarsestSize = 50;              ///< Stop coarsening at this many vertices.
+        double minShrink = 0.8;             ///< Stop coarsening when a level keeps more than this fraction of vertices.
+        int maxLevels = 40;                 ///< Hard limit on the hierarchy depth.
+        double refineStep = 0.2;            ///< Initial step on the finer levels, relative to their mean rest length.
+        int refineIterations = 30;          ///< Iteration limit on the finer levels.
+    };
+
+    /**
+     * @brief Creates an empty layout engine.
+     * @param pool Workers for the per-level layouts, or nullptr for the calling thread only.
+     */
+    explicit MultilevelLayout(WorkerPool *pool = nullptr);
+
+    /**
+     * @brief Sets the graph to lay out (same rules as ForceDirectedLayout::setGraph).
+     * @param vertexCount Number of vertices.
+     * @param from, to Edge endpoints (vertex indices).
+     * @param restLength Preferred length of each edge.
+     */
+    void setGraph(int vertexCount, const std::vector<int> &from, const std::vector<int> &to,
+                  const std::vector<double> &restLength);
+
+    /**
+     * @brief Builds the hierarchy and improves the given positions in place.
+     * @param x, y, z Vertex positions (size of the graph); used as the start layout.
+     * @param options Tuning parameters.
+     * @return Total number of force-directed iterations over all levels.
+     */
+    int run(double *x, double *y, double *z, const Options &options);
+
+    /** @brief Runs with default options. */
+    int run(double *x, double *y, double *z) { return run(x, y, z, Options()); }
+
+    /** @brief Returns the number of levels built by the last run(), including the original graph. */
+    int levelCount() const { return static_cast<int>(levels_.size()); }
+
+    /** @brief Returns the vertex count of a level (0 = original graph). */
+    int levelSize(int level) const { return levels_[level].vertexCount; }
+
+private:
+    /**
+     * @struct Level
+     * @brief One graph of the hierarchy.
+     */
+    struct Level {
+        int vertexCount = 0;
+        std::vector<int> from, to;
+        std::vector<double> rest;
+        std::vector<int> parent;          ///< Coarse vertex on the next level, per vertex.
+        std::vector<double> x, y, z;      ///< Positions (unused for level 0, which works on the caller's arrays).
+    };
+
+    ForceDirectedLayout layout_;
+    std::vector<Level> levels_;
+
+    /** @brief Fills fine.parent and returns the next coarser level. */
+    static Level coarsen(Level &fine);
+};
+
+#endif // MULTILEVELLAYOUT_H
@@ -0,0 +1,94 @@
+#include "OrbitLodScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+OrbitLodScheduler::OrbitLodScheduler(const BlackHoleGravityField *central)
+    : OrbitLodScheduler(central, Options()) {}
+
+OrbitLodScheduler::OrbitLodScheduler(const BlackHoleGravityField *central, const Options &options)
+    : central_(central), options_(options) {}
+
+bool OrbitLodScheduler::reviewDue(int bodies) const {
+    return static_cast<int>(analytic_.size()) != bodies || stepsSinceReview_ >= options_.reviewInterval;
+}
+
+void OrbitLodScheduler::reset() {
+    analytic_.clear();
+    orbits_.clear();
+    elapsed_.clear();
+    integrated_.clear();
+    analyticList_.clear();
+    stepsSinceReview_ = 0;
+}
+
+void OrbitLodScheduler::review(const ParticleState &state, const SpringSet &springs) {
+    const int n = state.size();
+    analytic_.assign(n, 0);
+    orbits_.resize(n);
+    elapsed_.assign(n, 0.0);
+    integrated_.clear();
+    analyticList_.clear();
+    stepsSinceReview_ = 0;
+    if (!central_) {
+        for (int i = 0; i < n; ++i) integrated_.push_back(i);
+        return;
+    }
+
+    std::vector<char> pinned(n, 0);
+    for (int s = 0; s < springs.size(); ++s) {
+        if (springs.indexA()[s] < n) pinned[springs.indexA()[s]] = 1;
+        if (springs.indexB()[s] < n) pinned[springs.indexB()[s]] = 1;
+    }
+
+    const double mu = central_->getGravitationalParameter();
+    const double cx = central_->getX(), cy = central_->getY(), cz = central_->getZ();
+    const double minPeriapsis = std::max(options_.minPeriapsis, BlackHoleGravityField::CLAMP_RADIUS);
+    for (int i = 0; i < n; ++i) {
+        if (pinned[i] || state.damping[i] > 0) continue;
+
+        const double rx = state.x[i] - cx, ry = state.y[i] - cy, rz = state.z[i] - cz;
+        const double r2 = rx * rx + ry * ry + rz * rz;
+        if (r2 < minPeriapsis * minPeriapsis) continue;
+
+        // Everything but the central pull -mu r / |r|^3 is perturbation.
+        const double centralScale = -mu / (r2 * std::sqrt(r2));
+        const double dx = state.ax[i] - centralScale * rx;
+        const double dy = state.ay[i] - centralScale * ry;
+        const double dz = state.az[i] - centralScale * rz;
+        const double central2 = centralScale * centralScale * r2;
+        const double tolerance = options_.maxPerturbation;
+        if (dx * dx + dy * dy + dz * dz > tolerance * tolerance * central2) continue;
+
+        KeplerOrbit orbit;
+        if (!KeplerSolver::fromState(rx, ry, rz, state.vx[i], state.vy[i], state.vz[i], mu, orbit)) continue;
+        if (orbit.eccentricity > options_.maxEccentricity) continue;
+        if (orbit.semiMajorAxis * (1.0 - orbit.eccentricity) < minPeriapsis) continue;
+
+        orbits_[i] = orbit;
+        analytic_[i] = 1;
+    }
+
+    for (int i = 0; i < n; ++i) (analytic_[i] ? analyticList_ : integrated_).push_back(i);
+}
+
+void OrbitLodScheduler::advance(ParticleState &state, double dt, WorkerPool *pool) {
+    ++stepsSinceReview_;
+    if (analyticList_.empty()) return;
+
+    const double cx = central_->getX(), cy = central_->getY(), cz = central_->getZ();
+    auto range = [&](int begin, int end, int) {
+        for (int k = begin; k < end; ++k) {
+            const int i = analyticList_[k];
+            // Always from the epoch, so no error builds up between reviews.
+            elapsed_[i] += dt;
+            double rx, ry, rz;
+            KeplerSolver::stateAt(orbits_[i], elapsed_[i], rx, ry, rz, state.vx[i], state.vy[i], state.vz[i]);
+            state.x[i] = cx + rx;
+            state.y[i] = cy + ry;
+            state.z[i] = cz + rz;
+        }
+    };
+    const int count = static_cast<int>(analyticList_.size());
+    if (pool) pool->parallelFor(count, range);
+    else range(0, count, 0);
+}
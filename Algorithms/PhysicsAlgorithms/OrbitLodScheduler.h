@@ -0,0 +1,113 @@
+#ifndef ORBITLODSCHEDULER_H
+#define ORBITLODSCHEDULER_H
+
+#include "BlackHoleGravityField.h"
+#include "KeplerSolver.h"
+#include "ParticleState.h"
+#include "SpringSet.h"
+#include "WorkerPool.h"
+#include <vector>
+
+/**
+ * @file OrbitLodScheduler.h
+ * @brief Level of detail for bodies on undisturbed orbits around the central black hole.
+ */
+
+/**
+ * @class OrbitLodScheduler
+ * @brief Moves bodies on quiet orbits analytically and leaves the force computation to the rest.
+ *
+ * Most bodies of a large galaxy circle the central black hole and feel almost nothing
+ * else. At every review (every Options::reviewInterval steps, and after bodies were
+ * added or removed) the scheduler looks at the full accelerations and puts a body on
+ * its closed-form Kepler orbit (see KeplerSolver) if
+ *  - it has no springs and no damping,
+ *  - all other forces together are below maxPerturbation times the central pull,
+ *  - its orbit is bound, at most maxEccentricity eccentric and stays outside minPeriapsis.
+ *
+ * Until the next review these analytic bodies cost one solution of Kepler's equation per
+ * step; forces are only computed for integratedBodies(). Analytic bodies still act as
+ * gravity sources, at their exact orbital positions. A review returns every body whose
+ * surroundings changed (a neighbour came close, a spring was added) to full integration.
+ *
+ * Per review the caller does one full force pass:
+ * @code
+ * if (lod.reviewDue(state.size())) {
+ *     computeAllAccelerations(state);
+ *     lod.review(state, springs);
+ * }
+ * integrate(state, lod.integratedBodies(), dt); // forces for these bodies only
+ * lod.advance(state, dt, nullptr);              // overwrites the analytic bodies
+ * @endcode
+ */
+class OrbitLodScheduler {
+public:
+    /**
+     * @struct Options
+     * @brief When a body counts as undisturbed, and how often that is checked.
+     */
+    struct Options {
+        double maxPerturbation = 1e-3; ///< Largest |a - a_central| / |a_central| of an analytic body.
+        double maxEccentricity = 0.2;  ///< Only (nearly) circular orbits are taken over.
+        double minPeriapsis = 2 * BlackHoleGravityField::CLAMP_RADIUS; ///< Keeps orbits away from the clamped core.
+        int reviewInterval = 60;       ///< Steps between two reviews.
+    };
+
+    /**
+     * @brief Creates a scheduler for orbits around `central` with default options.
+     * @param central The black hole field; must also be one of the controller's gravity fields (not owned).
+     */
+    explicit OrbitLodScheduler(const BlackHoleGravityField *central);
+
+    /**
+     * @brief Creates a scheduler for orbits around `central`.
+     * @param central The black hole field; must also be one of the controller's gravity fields (not owned).
+     * @param options Review criteria.
+     */
+    OrbitLodScheduler(const BlackHoleGravityField *central, const Options &options);
+
+    /** @brief Returns true if review() must run before the next step of `bodies` bodies. */
+    bool reviewDue(int bodies) const;
+
+    /**
+     * @brief Decides for every body whether it moves analytically until the next review.
+     * @param state Positions, velocities and the full accelerations at these positions.
+     * @param springs Springs between the bodies; their endpoints are always integrated.
+     */
+    void review(const ParticleState &state, const SpringSet &springs);
+
+    /**
+     * @brief Moves the analytic bodies dt further along their orbits (positions and velocities).
+     * @param state The particles; entries of integrated bodies are not touched.
+     * @param dt The time step.
+     * @param pool Workers to split the bodies over, or nullptr.
+     */
+    void advance(ParticleState &state, double dt, WorkerPool *pool);
+
+    /** @brief Returns the bodies that need forces and integration, in ascending order. */
+    const std::vector<int> &integratedBodies() const { return integrated_; }
+
+    /** @brief Returns true if body i currently moves on its Kepler orbit. */
+    bool isAnalytic(int i) const { return i < static_cast<int>(analytic_.size()) && analytic_[i]; }
+
+    /** @brief Returns the number of analytic bodies. */
+    int analyticCount() const { return static_cast<int>(analytic_.size() - integrated_.size()); }
+
+    /** @brief Integrates every body again until the next review, which is due at once. */
+    void reset();
+
+    /** @brief Returns the options. */
+    const Options &options() const { return options_; }
+
+private:
+    const BlackHoleGravityField *central_;
+    Options options_;
+    std::vector<char> analytic_;         ///< 1 for bodies on their Kepler orbit.
+    std::vector<KeplerOrbit> orbits_;    ///< Orbit of each analytic body, epoch at its last review.
+    std::vector<double> elapsed_;        ///< Time since the epoch of each orbit.
+    std::vector<int> integrated_;        ///< Bodies with analytic_ == 0.
+    std::vector<int> analyticList_;      ///< Bodies with analytic_ == 1.
+    int stepsSinceReview_ = 0;
+};
+
+#endif // ORBITLODSCHEDULER_H
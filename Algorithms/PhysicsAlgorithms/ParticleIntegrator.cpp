@@ -0,0 +1,36 @@
+#include "ParticleIntegrator.h"
+#include <cmath>
+
+void ParticleIntegrator::step(ParticleState &state, double deltaTime, const AccelerationFunction &computeAccelerations) {
+    const double half = 0.5 * deltaTime;
+    drift(state, half);
+    state.clearAccelerations();
+    if (computeAccelerations) computeAccelerations(state);
+    kick(state, deltaTime);
+    drift(state, half);
+}
+
+void ParticleIntegrator::drift(ParticleState &state, double dt) {
+    const int n = state.size();
+    double *x = state.x.data(), *y = state.y.data(), *z = state.z.data();
+    const double *vx = state.vx.data(), *vy = state.vy.data(), *vz = state.vz.data();
+    for (int i = 0; i < n; ++i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        z[i] += vz[i] * dt;
+    }
+}
+
+void ParticleIntegrator::kick(ParticleState &state, double dt) {
+    const int n = state.size();
+    double *vx = state.vx.data(), *vy = state.vy.data(), *vz = state.vz.data();
+    const double *ax = state.ax.data(), *ay = state.ay.data(), *az = state.az.data();
+    const double *damping = state.damping.data();
+    for (int i = 0; i < n; ++i) {
+        // Same damping law as btRigidBody::applyDamping; 1 for undamped bodies.
+        double keep = damping[i] > 0 ? std::pow(1.0 - damping[i], dt) : 1.0;
+        vx[i] = (vx[i] + ax[i] * dt) * keep;
+        vy[i] = (vy[i] + ay[i] * dt) * keep;
+        vz[i] = (vz[i] + az[i] * dt) * keep;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef PARTICLEINTEGRATOR_H
+#define PARTICLEINTEGRATOR_H
+
+#include "ParticleState.h"
+#include <functional>
+
+/**
+ * @file ParticleIntegrator.h
+ * @brief Symplectic time integration for ParticleState.
+ */
+
+/**
+ * @class ParticleIntegrator
+ * @brief Advances point masses with the leapfrog (drift-kick-drift) scheme.
+ *
+ * One step is
+ *  1. drift: x += v * dt / 2
+ *  2. accelerations are recomputed at the midpoint positions
+ *  3. kick:  v += a * dt, then linear damping
+ *  4. drift: x += v * dt / 2
+ *
+ * Leapfrog is symplectic and time-reversible, so orbits keep their energy over long
+ * runs (the error oscillates instead of drifting), and it needs only one force
+ * evaluation per step.
+ */
+class ParticleIntegrator {
+public:
+    /// @brief Callback that fills state.ax/ay/az for the current positions.
+    using AccelerationFunction = std::function<void(ParticleState &)>;
+
+    /**
+     * @brief Performs one leapfrog step.
+     * @param state The particles to advance.
+     * @param deltaTime The time step.
+     * @param computeAccelerations Called once, after the first half drift.
+     */
+    static void step(ParticleState &state, double deltaTime, const AccelerationFunction &computeAccelerations);
+
+    /**
+     * @brief Moves every particle along its velocity: x += v * dt.
+     */
+    static void drift(ParticleState &state, double dt);
+
+    /**
+     * @brief Applies the accelerations and damping: v = (v + a * dt) * (1 - damping)^dt.
+     */
+    static void kick(ParticleState &state, double dt);
+};
+
+#endif // PARTICLEINTEGRATOR_H
@@ -0,0 +1,72 @@
+#ifndef PARTICLESTATE_H
+#define PARTICLESTATE_H
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * @file ParticleState.h
+ * @brief Structure-of-arrays storage for point-mass bodies.
+ */
+
+/**
+ * @struct ParticleState
+ * @brief Positions, velocities, accelerations and masses of all simulated point masses.
+ *
+ * Each quantity is a separate contiguous array, so the force and integration loops
+ * touch only the data they need and can be vectorized. Gravity fields and springs
+ * add into ax/ay/az; the integrator (or the Bullet backend) consumes them.
+ */
+struct ParticleState {
+    std::vector<double> x, y, z;    ///< Positions.
+    std::vector<double> vx, vy, vz; ///< Velocities.
+    std::vector<double> ax, ay, az; ///< Accumulated accelerations for the current step.
+    std::vector<double> mass;       ///< Inertial mass (used to turn forces into accelerations).
+    std::vector<double> gravitationalMass; ///< Source strength for mutual gravity, in CelestialObject units.
+    std::vector<double> damping;    ///< Linear damping in [0, 1), with Bullet's semantics.
+
+    /** @brief Returns the number of particles. */
+    int size() const { return static_cast<int>(x.size()); }
+
+    /**
+     * @brief Appends a particle at rest.
+     * @return Index of the new particle.
+     */
+    int add(double px, double py, double pz, double inertialMass, double sourceMass) {
+        x.push_back(px); y.push_back(py); z.push_back(pz);
+        vx.push_back(0); vy.push_back(0); vz.push_back(0);
+        ax.push_back(0); ay.push_back(0); az.push_back(0);
+        mass.push_back(inertialMass);
+        gravitationalMass.push_back(sourceMass);
+        damping.push_back(0);
+        return size() - 1;
+    }
+
+    /**
+     * @brief Removes particle i by moving the last particle into its slot.
+     * @return The former index of the moved particle (equal to i if i was the last one).
+     */
+    int swapRemove(int i) {
+        const int last = size() - 1;
+        for (auto *array: {&x, &y, &z, &vx, &vy, &vz, &ax, &ay, &az, &mass, &gravitationalMass, &damping}) {
+            (*array)[i] = (*array)[last];
+            array->pop_back();
+        }
+        return last;
+    }
+
+    /** @brief Removes all particles. */
+    void clear() {
+        for (auto *array: {&x, &y, &z, &vx, &vy, &vz, &ax, &ay, &az, &mass, &gravitationalMass, &damping})
+            array->clear();
+    }
+
+    /** @brief Resets the accumulated accelerations to zero. */
+    void clearAccelerations() {
+        std::fill(ax.begin(), ax.end(), 0.0);
+        std::fill(ay.begin(), ay.end(), 0.0);
+        std::fill(az.begin(), az.end(), 0.0);
+    }
+};
+
+#endif // PARTICLESTATE_H
@@ -0,0 +1,190 @@
+#include "PhysicsCheckpoint.h"
+#include "GalaxyPhysicsController.h"
+#include "BlackHoleGravityField.h"
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+static_assert(std::is_trivially_copyable_v<PhysicsCheckpointHeader>);
+static_assert(sizeof(PhysicsCheckpointHeader) == 96, "the header is part of the file format");
+
+namespace {
+    std::uint64_t alignTo8(std::uint64_t bytes) { return (bytes + 7) & ~std::uint64_t(7); }
+
+    template<typename T>
+    void writeArray(std::ofstream& out, const T* data, std::uint64_t count) {
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+    }
+
+    void writePadding(std::ofstream& out, std::uint64_t bytes) {
+        static const char zeros[8] = {};
+        out.write(zeros, static_cast<std::streamsize>(alignTo8(bytes) - bytes));
+    }
+
+    bool fail(std::string* error, const std::string& message) {
+        if (error) *error = message;
+        return false;
+    }
+}
+
+PhysicsCheckpoint::Layout PhysicsCheckpoint::layout(std::uint64_t bodies, std::uint64_t springs,
+                                                    std::uint64_t rngBytes, std::uint64_t generationBytes) {
+    Layout l{};
+    l.keys = sizeof(PhysicsCheckpointHeader) + BODY_ARRAY_COUNT * bodies * sizeof(double);
+    l.springDoubles = l.keys + alignTo8(bodies * sizeof(std::int32_t));
+    l.springIndices = l.springDoubles + 2 * springs * sizeof(double);
+    l.rng = l.springIndices + alignTo8(2 * springs * sizeof(std::int32_t));
+    l.generation = l.rng + rngBytes;
+    l.total = l.generation + generationBytes;
+    return l;
+}
+
+bool PhysicsCheckpoint::save(const std::string& path, GalaxyPhysicsController& controller,
+                             const BlackHoleGravityField* blackHole, const std::string& rngState,
+                             const std::string& generationState, double simulationTime, std::string* error) {
+    controller.refreshState();
+    const ParticleState& state = controller.getState();
+    const SpringSet& springs = controller.getSprings();
+    const std::uint64_t bodies = state.size();
+    const std::uint64_t springCount = springs.size();
+
+    PhysicsCheckpointHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.bodyCount = bodies;
+    header.springCount = springCount;
+    header.rngStateBytes = rngState.size();
+    header.generationStateBytes = generationState.size();
+    header.simulationTime = simulationTime;
+    if (blackHole) {
+        header.flags |= HAS_BLACK_HOLE;
+        header.blackHoleMass = blackHole->getMass();
+        header.blackHoleX = blackHole->getX();
+        header.blackHoleY = blackHole->getY();
+        header.blackHoleZ = blackHole->getZ();
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return fail(error, "Cannot open " + path + " for writing");
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const std::vector<double>* array : {&state.x, &state.y, &state.z, &state.vx, &state.vy, &state.vz,
+                                             &state.mass, &state.gravitationalMass, &state.damping}) {
+        writeArray(out, array->data(), bodies);
+    }
+
+    std::vector<std::int32_t> keys(bodies);
+    for (std::uint64_t i = 0; i < bodies; ++i) keys[i] = controller.getBodyKey(static_cast<int>(i));
+    writeArray(out, keys.data(), bodies);
+    writePadding(out, bodies * sizeof(std::int32_t));
+
+    writeArray(out, springs.restLength().data(), springCount);
+    writeArray(out, springs.stiffness().data(), springCount);
+    static_assert(sizeof(int) == sizeof(std::int32_t));
+    writeArray(out, springs.indexA().data(), springCount);
+    writeArray(out, springs.indexB().data(), springCount);
+    writePadding(out, 2 * springCount * sizeof(std::int32_t));
+
+    out.write(rngState.data(), static_cast<std::streamsize>(rngState.size()));
+    out.write(generationState.data(), static_cast<std::streamsize>(generationState.size()));
+    out.close();
+    if (!out) return fail(error, "Cannot write " + path);
+    return true;
+}
+
+bool PhysicsCheckpoint::load(const std::string& path) {
+    if (data_) file_.unmap(const_cast<uchar*>(data_));
+    file_.close();
+    data_ = nullptr;
+    header_ = nullptr;
+
+    file_.setFileName(QString::fromStdString(path));
+    if (!file_.open(QIODevice::ReadOnly)) return fail(&error_, "Cannot open " + path);
+    const std::uint64_t size = file_.size();
+    if (size < sizeof(PhysicsCheckpointHeader)) return fail(&error_, path + " is not a checkpoint");
+    data_ = file_.map(0, static_cast<qint64>(size));
+    if (!data_) return fail(&error_, "Cannot map " + path);
+
+    const auto* header = reinterpret_cast<const PhysicsCheckpointHeader*>(data_);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) return fail(&error_, path + " is not a checkpoint");
+    if (header->byteOrderMark != BYTE_ORDER_MARK)
+        return fail(&error_, path + " was written on a machine with another byte order");
+    if (header->version != VERSION)
+        return fail(&error_, path + " has format version " + std::to_string(header->version) +
+                                 ", expected " + std::to_string(VERSION));
+    // Counts beyond int range cannot come from a controller; this also keeps layout() from overflowing.
+    constexpr std::uint64_t limit = 0x7fffffff;
+    if (header->bodyCount > limit || header->springCount > limit || header->rngStateBytes > size ||
+        header->generationStateBytes > size ||
+        layout(header->bodyCount, header->springCount, header->rngStateBytes, header->generationStateBytes).total !=
+            size)
+        return fail(&error_, path + " is truncated or damaged");
+
+    const std::uint64_t springIndices = layout(header->bodyCount, header->springCount, 0, 0).springIndices;
+    const auto* a = reinterpret_cast<const std::int32_t*>(data_ + springIndices);
+    const auto* b = a + header->springCount;
+    for (std::uint64_t i = 0; i < header->springCount; ++i) {
+        if (a[i] < 0 || b[i] < 0 || static_cast<std::uint64_t>(a[i]) >= header->bodyCount ||
+            static_cast<std::uint64_t>(b[i]) >= header->bodyCount)
+            return fail(&error_, path + " has a spring between unknown bodies");
+    }
+
+    header_ = header;
+    error_.clear();
+    return true;
+}
+
+bool PhysicsCheckpoint::restore(GalaxyPhysicsController& controller, BlackHoleGravityField* blackHole) const {
+    if (!header_) return fail(&error_, "No checkpoint loaded");
+    if (!controller.restoreState(*this))
+        return fail(&error_, "The checkpoint's " + std::to_string(bodyCount()) +
+                                 " bodies do not match the simulation's bodies");
+    if (blackHole && (header_->flags & HAS_BLACK_HOLE)) {
+        blackHole->setMass(header_->blackHoleMass);
+        blackHole->setPosition(header_->blackHoleX, header_->blackHoleY, header_->blackHoleZ);
+    }
+    return true;
+}
+
+const double* PhysicsCheckpoint::bodyArray(BodyArray array) const {
+    if (!header_) return nullptr;
+    return reinterpret_cast<const double*>(data_ + sizeof(PhysicsCheckpointHeader)) + array * header_->bodyCount;
+}
+
+const std::int32_t* PhysicsCheckpoint::keys() const {
+    if (!header_) return nullptr;
+    return reinterpret_cast<const std::int32_t*>(data_ + layout(header_->bodyCount, 0, 0, 0).keys);
+}
+
+const double* PhysicsCheckpoint::springRestLength() const {
+    if (!header_) return nullptr;
+    return reinterpret_cast<const double*>(data_ + layout(header_->bodyCount, 0, 0, 0).springDoubles);
+}
+
+const double* PhysicsCheckpoint::springStiffness() const {
+    return header_ ? springRestLength() + header_->springCount : nullptr;
+}
+
+const std::int32_t* PhysicsCheckpoint::springA() const {
+    if (!header_) return nullptr;
+    const Layout l = layout(header_->bodyCount, header_->springCount, 0, 0);
+    return reinterpret_cast<const std::int32_t*>(data_ + l.springIndices);
+}
+
+const std::int32_t* PhysicsCheckpoint::springB() const {
+    return header_ ? springA() + header_->springCount : nullptr;
+}
+
+std::string PhysicsCheckpoint::rngState() const {
+    if (!header_) return {};
+    const Layout l = layout(header_->bodyCount, header_->springCount, header_->rngStateBytes, 0);
+    return std::string(reinterpret_cast<const char*>(data_ + l.rng), header_->rngStateBytes);
+}
+
+std::string PhysicsCheckpoint::generationState() const {
+    if (!header_) return {};
+    const Layout l = layout(header_->bodyCount, header_->springCount, header_->rngStateBytes,
+                            header_->generationStateBytes);
+    return std::string(reinterpret_cast<const char*>(data_ + l.generation), header_->generationStateBytes);
+}
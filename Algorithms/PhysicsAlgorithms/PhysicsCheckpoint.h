@@ -0,0 +1,187 @@
+#ifndef PHYSICSCHECKPOINT_H
+#define PHYSICSCHECKPOINT_H
+
+#include <QFile>
+#include <cstdint>
+#include <string>
+
+class GalaxyPhysicsController;
+class BlackHoleGravityField;
+
+/**
+ * @file PhysicsCheckpoint.h
+ * @brief Binary save and memory-mapped restore of the complete physics state.
+ */
+
+/**
+ * @struct PhysicsCheckpointHeader
+ * @brief First bytes of a checkpoint file; the arrays follow at offsets derived from the counts.
+ *
+ * File layout (version 2, every section starts at a multiple of 8 bytes):
+ *  - this header;
+ *  - 9 double arrays of bodyCount entries: x, y, z, vx, vy, vz, mass, gravitationalMass, damping;
+ *  - bodyCount int32 body keys (see GalaxyPhysicsController::addCelestialBody());
+ *  - 2 double arrays of springCount entries: rest lengths, stiffnesses;
+ *  - 2 int32 arrays of springCount entries: endpoints A and B (body indices in this file);
+ *  - rngStateBytes of RandomGenerator::saveState() text;
+ *  - generationStateBytes of RandomGenerator::saveState() text from before the galaxy was generated.
+ *
+ * Values are stored in the byte order of the writing machine; byteOrderMark lets a
+ * reader with the other order reject the file instead of loading garbage.
+ */
+struct PhysicsCheckpointHeader {
+    char magic[8];                ///< PhysicsCheckpoint::MAGIC.
+    std::uint32_t version;        ///< PhysicsCheckpoint::VERSION at the time of writing.
+    std::uint32_t byteOrderMark;  ///< PhysicsCheckpoint::BYTE_ORDER_MARK as written by the saving machine.
+    std::uint64_t bodyCount;
+    std::uint64_t springCount;
+    std::uint64_t rngStateBytes;
+    std::uint64_t generationStateBytes;
+    std::uint32_t flags;          ///< PhysicsCheckpoint::HAS_BLACK_HOLE.
+    std::uint32_t reserved;       ///< Zero.
+    double simulationTime;        ///< Simulated time of the saved state.
+    double blackHoleMass;         ///< Central black hole, if HAS_BLACK_HOLE.
+    double blackHoleX, blackHoleY, blackHoleZ;
+};
+
+/**
+ * @class PhysicsCheckpoint
+ * @brief Saves a GalaxyPhysicsController to a compact binary file and maps it back in.
+ *
+ * A checkpoint holds everything needed to continue a run where it stopped: the
+ * ParticleState arrays, the body keys, the springs, the central black hole and the
+ * random generator state. The CelestialObjects themselves are not stored; instead the
+ * generator state from before the galaxy was generated is kept, so the same galaxy can
+ * be generated again, after which the checkpoint replaces the bodies' physical state.
+ * That skips the layout and the simulated time in between.
+ *
+ * load() maps the file instead of reading it, so it returns immediately for any size;
+ * the arrays are read straight from the mapping by restore(), which is essentially a
+ * memcpy per array when the bodies were added in the same order as before the save.
+ *
+ * @code
+ * const std::string generationState = rng.saveState();
+ * generateGalaxy(rng);
+ * ...
+ * PhysicsCheckpoint::save("galaxy.chk", controller, &blackHole, rng.saveState(), generationState, time);
+ * ...
+ * PhysicsCheckpoint checkpoint;
+ * if (checkpoint.load("galaxy.chk") && rng.restoreState(checkpoint.generationState())) {
+ *     generateGalaxy(rng); // The same objects, added with the same keys.
+ *     if (checkpoint.restore(controller, &blackHole)) rng.restoreState(checkpoint.rngState());
+ * }
+ * @endcode
+ */
+class PhysicsCheckpoint {
+public:
+    /// @brief File signature.
+    static constexpr char MAGIC[8] = {'G', 'A', 'L', 'A', 'X', 'Y', 'C', 'P'};
+
+    /// @brief Format version written by save(); load() accepts only this one.
+    static constexpr std::uint32_t VERSION = 2;
+
+    /// @brief Reads back as a different number on a machine with the other byte order.
+    static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    /// @brief PhysicsCheckpointHeader::flags bit: the black hole fields are set.
+    static constexpr std::uint32_t HAS_BLACK_HOLE = 1;
+
+    /// @brief Body arrays, in file order.
+    enum BodyArray { X, Y, Z, VX, VY, VZ, Mass, GravitationalMass, Damping, BODY_ARRAY_COUNT };
+
+    PhysicsCheckpoint() = default;
+    PhysicsCheckpoint(const PhysicsCheckpoint&) = delete;
+    PhysicsCheckpoint& operator=(const PhysicsCheckpoint&) = delete;
+
+    /**
+     * @brief Writes the controller's current state to `path` (replacing the file).
+     * @param path Output file.
+     * @param controller The simulation; not thread-safe against a running SimulationThread.
+     * @param blackHole The central black hole, or nullptr.
+     * @param rngState RandomGenerator::saveState() of the generator to continue, or empty.
+     * @param generationState RandomGenerator::saveState() from before the galaxy was generated, or empty.
+     * @param simulationTime Simulated time, stored for the caller.
+     * @param error Receives a description if saving fails (may be nullptr).
+     * @return True if the whole file was written.
+     */
+    static bool save(const std::string& path, GalaxyPhysicsController& controller,
+                     const BlackHoleGravityField* blackHole, const std::string& rngState,
+                     const std::string& generationState, double simulationTime, std::string* error = nullptr);
+
+    /**
+     * @brief Maps a checkpoint file and validates its header and size.
+     * @param path Checkpoint written by save().
+     * @return False (see errorString()) if the file is missing, truncated or of another version.
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Copies the loaded state into the controller and the black hole.
+     * * The controller must hold the same bodies as at save time. A body is matched by its
+     * key if it has one and by its index otherwise. Springs are replaced; block timestep
+     * levels and the orbit LOD start afresh.
+     * @param controller The simulation to overwrite.
+     * @param blackHole Receives the mass and position of the saved black hole (may be nullptr).
+     * @return False (and nothing changed) if no checkpoint is loaded or the bodies do not match.
+     */
+    bool restore(GalaxyPhysicsController& controller, BlackHoleGravityField* blackHole) const;
+
+    /** @brief Returns true after a successful load(). */
+    bool isLoaded() const { return header_ != nullptr; }
+
+    /** @brief Returns why the last load() or restore() failed. */
+    const std::string& errorString() const { return error_; }
+
+    /** @brief Returns the header of the loaded file (must be loaded). */
+    const PhysicsCheckpointHeader& header() const { return *header_; }
+
+    /** @brief Returns the number of saved bodies. */
+    int bodyCount() const { return header_ ? static_cast<int>(header_->bodyCount) : 0; }
+
+    /** @brief Returns the number of saved springs. */
+    int springCount() const { return header_ ? static_cast<int>(header_->springCount) : 0; }
+
+    /** @brief Returns one of the saved body arrays (bodyCount() entries). */
+    const double* bodyArray(BodyArray array) const;
+
+    /** @brief Returns the saved body keys (-1 for bodies without a key). */
+    const std::int32_t* keys() const;
+
+    /** @brief Returns the saved spring rest lengths. */
+    const double* springRestLength() const;
+
+    /** @brief Returns the saved spring stiffnesses. */
+    const double* springStiffness() const;
+
+    /** @brief Returns the first endpoints of the saved springs. */
+    const std::int32_t* springA() const;
+
+    /** @brief Returns the second endpoints of the saved springs. */
+    const std::int32_t* springB() const;
+
+    /** @brief Returns the saved RandomGenerator state (empty if none was saved). */
+    std::string rngState() const;
+
+    /** @brief Returns the generator state the galaxy was generated from (empty if none was saved). */
+    std::string generationState() const;
+
+    /** @brief Returns the simulated time of the saved state. */
+    double simulationTime() const { return header_ ? header_->simulationTime : 0.0; }
+
+private:
+    QFile file_;
+    const uchar* data_ = nullptr;                    ///< Start of the mapping.
+    const PhysicsCheckpointHeader* header_ = nullptr; ///< Set once the file is validated.
+    mutable std::string error_;
+
+    /// @brief Byte offsets of the sections after the header.
+    struct Layout {
+        std::uint64_t keys, springDoubles, springIndices, rng, generation, total;
+    };
+
+    /** @brief Computes where the sections start for the given counts. */
+    static Layout layout(std::uint64_t bodies, std::uint64_t springs, std::uint64_t rngBytes,
+                         std::uint64_t generationBytes);
+};
+
+#endif // PHYSICSCHECKPOINT_H
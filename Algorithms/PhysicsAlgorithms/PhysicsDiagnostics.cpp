@@ -0,0 +1,47 @@
+#include "PhysicsDiagnostics.h"
+#include <limits>
+
+PhysicsDiagnostics::PhysicsDiagnostics() : PhysicsDiagnostics(Options()) {}
+
+PhysicsDiagnostics::PhysicsDiagnostics(const Options &options)
+    : options_(options), history_(options.capacity) {
+    if (options_.csvPath.empty()) return;
+    csv_.open(options_.csvPath, std::ios::out | std::ios::trunc);
+    if (csv_) writeCsvHeader(csv_);
+}
+
+bool PhysicsDiagnostics::energyDue() const {
+    return options_.energyInterval > 0 && recorded_ % options_.energyInterval == 0;
+}
+
+void PhysicsDiagnostics::record(StepDiagnostics record) {
+    simulationTime_ += record.deltaTime;
+    record.step = recorded_++;
+    record.simulationTime = simulationTime_;
+    history_.push(record);
+    if (csv_) writeCsvRow(csv_, record);
+}
+
+void PhysicsDiagnostics::writeCsvHeader(std::ostream &out) {
+    out << "step,time,dt,bodies,analytic_bodies,gravity_s,springs_s,integrate_s,sync_s,total_s,"
+           "kinetic_energy,potential_energy,spring_energy,total_energy,angular_momentum_x,angular_momentum_y,"
+           "angular_momentum_z,max_speed,non_finite_bodies\n";
+}
+
+void PhysicsDiagnostics::writeCsvRow(std::ostream &out, const StepDiagnostics &record) {
+    // Enough digits to read the doubles back exactly.
+    const auto precision = out.precision(std::numeric_limits<double>::max_digits10);
+    out << record.step << ',' << record.simulationTime << ',' << record.deltaTime << ',' << record.bodies << ','
+        << record.analyticBodies << ',' << record.gravitySeconds << ',' << record.springSeconds << ','
+        << record.integrateSeconds << ',' << record.syncSeconds << ',' << record.totalSeconds << ','
+        << record.kineticEnergy << ',' << record.potentialEnergy << ',' << record.springEnergy << ','
+        << record.totalEnergy() << ','
+        << record.angularMomentumX << ',' << record.angularMomentumY << ',' << record.angularMomentumZ << ','
+        << record.maxSpeed << ',' << record.nonFiniteBodies << '\n';
+    out.precision(precision);
+}
+
+void PhysicsDiagnostics::writeCsv(std::ostream &out) const {
+    writeCsvHeader(out);
+    for (int i = 0; i < history_.size(); ++i) writeCsvRow(out, history_[i]);
+}
@@ -0,0 +1,148 @@
+#ifndef PHYSICSDIAGNOSTICS_H
+#define PHYSICSDIAGNOSTICS_H
+
+#include "RingBuffer.h"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+
+/**
+ * @file PhysicsDiagnostics.h
+ * @brief Per-step cost and health records of a GalaxyPhysicsController.
+ */
+
+/**
+ * @struct StepDiagnostics
+ * @brief What one simulation step cost and what state it left behind.
+ *
+ * Energies and angular momentum use the CelestialObject masses, like
+ * GalaxyPhysicsController::computeTotalEnergy(). The potential energy needs a pass over
+ * every gravity field and spring, so it is only measured every Options::energyInterval
+ * steps; in the other records it (and the total energy) is NaN. The spring forces act on
+ * the inertial masses, so the spring energy is not in the same units as the others and is
+ * reported on its own rather than added to the total.
+ */
+struct StepDiagnostics {
+    std::uint64_t step = 0;       ///< Steps recorded before this one.
+    double simulationTime = 0;    ///< Simulated time at the end of the step.
+    double deltaTime = 0;         ///< Length of the step.
+    int bodies = 0;               ///< Bodies simulated.
+    int analyticBodies = 0;       ///< Bodies moved by the orbit LOD instead of being integrated.
+
+    double gravitySeconds = 0;    ///< Wall time in the gravity fields.
+    double springSeconds = 0;     ///< Wall time in the spring forces.
+    double integrateSeconds = 0;  ///< Wall time of the integrator or the Bullet step (forces excluded).
+    double syncSeconds = 0;       ///< Wall time copying state between the bodies and the ParticleState.
+    double totalSeconds = 0;      ///< Wall time of the whole step.
+
+    double kineticEnergy = 0;     ///< sum(m v^2 / 2).
+    double potentialEnergy = 0;   ///< Sum of all fields' potentials, or NaN if not measured.
+    double springEnergy = 0;      ///< Energy stored in the springs (inertial-mass units), or NaN if not measured.
+    double angularMomentumX = 0;  ///< sum(m r x v) about the origin.
+    double angularMomentumY = 0;
+    double angularMomentumZ = 0;
+    double maxSpeed = 0;          ///< Largest |v|; grows without bound when the integration blows up.
+    int nonFiniteBodies = 0;      ///< Bodies with a NaN or infinite position or velocity.
+
+    /** @brief Returns kinetic plus potential energy (NaN if the potentials were not measured); springs excluded. */
+    double totalEnergy() const { return kineticEnergy + potentialEnergy; }
+};
+
+/**
+ * @class PhysicsDiagnostics
+ * @brief Ring buffer of the latest StepDiagnostics, optionally streamed to a CSV file.
+ *
+ * The buffer keeps the recent history for on-screen graphs and health checks at a fixed
+ * memory cost; the CSV file receives every record for offline analysis of long runs.
+ */
+class PhysicsDiagnostics {
+public:
+    /**
+     * @struct Options
+     * @brief History length, energy sampling and output file.
+     */
+    struct Options {
+        int capacity = 1024;   ///< Records kept in memory.
+        int energyInterval = 60; ///< Measure the potential energies every this many steps; 0 = never.
+        std::string csvPath;   ///< If not empty, every record is appended to this file.
+    };
+
+    /** @brief Creates the diagnostics with default options. */
+    PhysicsDiagnostics();
+
+    /**
+     * @brief Creates the diagnostics; opens (and truncates) Options::csvPath if set.
+     * @param options Buffer size, energy sampling and output file.
+     */
+    explicit PhysicsDiagnostics(const Options &options);
+
+    /** @brief Returns true if the potential energy should be measured for the next step. */
+    bool energyDue() const;
+
+    /**
+     * @brief Stores a record; fills in its step number and simulated time.
+     * @param record The measurements of the step that just finished.
+     */
+    void record(StepDiagnostics record);
+
+    /** @brief Returns the recorded history, oldest first. */
+    const RingBuffer<StepDiagnostics> &history() const { return history_; }
+
+    /** @brief Returns the number of steps recorded so far (also those no longer in history()). */
+    std::uint64_t recordedSteps() const { return recorded_; }
+
+    /** @brief Returns true if the CSV file could not be opened or written. */
+    bool csvFailed() const { return !options_.csvPath.empty() && !csv_; }
+
+    /** @brief Writes the CSV header line. */
+    static void writeCsvHeader(std::ostream &out);
+
+    /** @brief Writes one record as a CSV line. */
+    static void writeCsvRow(std::ostream &out, const StepDiagnostics &record);
+
+    /** @brief Writes the header and the whole history() as CSV. */
+    void writeCsv(std::ostream &out) const;
+
+    /** @brief Returns the options. */
+    const Options &options() const { return options_; }
+
+private:
+    Options options_;
+    RingBuffer<StepDiagnostics> history_;
+    std::uint64_t recorded_ = 0;
+    double simulationTime_ = 0;
+    std::ofstream csv_;
+};
+
+/**
+ * @class PhaseTimer
+ * @brief Adds the wall time of its scope to a StepDiagnostics field; does nothing for nullptr.
+ *
+ * @code
+ * {
+ *     PhaseTimer timer(diagnosticsEnabled ? &current.gravitySeconds : nullptr);
+ *     field->accumulateAccelerations(state, pool);
+ * }
+ * @endcode
+ */
+class PhaseTimer {
+public:
+    explicit PhaseTimer(double *seconds) : seconds_(seconds) {
+        if (seconds_) start_ = std::chrono::steady_clock::now();
+    }
+
+    ~PhaseTimer() {
+        if (seconds_) *seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+private:
+    double *seconds_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#endif // PHYSICSDIAGNOSTICS_H
@@ -1,21 +1,151 @@
 #include "PhysicsEngine.h"
 #include <algorithm>
-PhysicsEngine::PhysicsEngine() {
+#ifdef BT_THREADSAFE
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+#include "LinearMath/btThreads.h"
+#endif
+
+namespace {
+    /**
+     * @brief Broadphase that never reports a pair; proxies exist only because every
+     * collision object needs one.
+     */
+    class NullBroadphase : public btBroadphaseInterface {
+    public:
+        btBroadphaseProxy* createProxy(const btVector3& aabbMin, const btVector3& aabbMax, int, void* userPtr,
+                                       int collisionFilterGroup, int collisionFilterMask, btDispatcher*) override {
+            auto* proxy = new btBroadphaseProxy(aabbMin, aabbMax, userPtr, collisionFilterGroup, collisionFilterMask);
+            proxy->m_uniqueId = ++lastId_;
+            return proxy;
+        }
+
+        void destroyProxy(btBroadphaseProxy* proxy, btDispatcher*) override { delete proxy; }
+
+        void setAabb(btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax,
+                     btDispatcher*) override {
+            proxy->m_aabbMin = aabbMin;
+            proxy->m_aabbMax = aabbMax;
+        }
+
+        void getAabb(btBroadphaseProxy* proxy, btVector3& aabbMin, btVector3& aabbMax) const override {
+            aabbMin = proxy->m_aabbMin;
+            aabbMax = proxy->m_aabbMax;
+        }
+
+        void rayTest(const btVector3&, const btVector3&, btBroadphaseRayCallback&, const btVector3&,
+                     const btVector3&) override {}
+
+        void aabbTest(const btVector3&, const btVector3&, btBroadphaseAabbCallback&) override {}
+
+        void calculateOverlappingPairs(btDispatcher*) override {}
+
+        btOverlappingPairCache* getOverlappingPairCache() override { return &pairs_; }
+
+        const btOverlappingPairCache* getOverlappingPairCache() const override { return &pairs_; }
+
+        void getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax) const override {
+            aabbMin.setValue(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+            aabbMax.setValue(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+        }
+
+        void printStats() override {}
+
+    private:
+        btNullPairCache pairs_;
+        int lastId_ = 0;
+    };
+
+    /**
+     * @brief A dynamics world whose bodies never collide: the per-step AABB update,
+     * pair search and narrowphase are skipped; forces and constraints still apply.
+     */
+    template<typename World>
+    class CollisionFreeWorld : public World {
+    public:
+        using World::World;
+
+        void performDiscreteCollisionDetection() override {}
+    };
+
+#ifdef BT_THREADSAFE
+    /** @brief Installs Bullet's default task scheduler once and returns it (nullptr if unavailable). */
+    btITaskScheduler* sharedTaskScheduler() {
+        static btITaskScheduler* scheduler = [] {
+            btITaskScheduler* created = btCreateDefaultTaskScheduler();
+            if (created) btSetTaskScheduler(created);
+            return created;
+        }();
+        return scheduler;
+    }
+#endif
+}
+
+PhysicsEngine::PhysicsEngine() : PhysicsEngine(Profile()) {}
+
+PhysicsEngine::PhysicsEngine(const Profile& profile) : profile_(profile) {
     collisionConfiguration = new btDefaultCollisionConfiguration();
-    dispatcher = new btCollisionDispatcher(collisionConfiguration);
-    broadphase = new btDbvtBroadphase();
-    solver = new btSequentialImpulseConstraintSolver();
+    broadphase = createBroadphase();
+    const bool collisions = profile_.broadphase != BroadphaseType::None;
 
-    dynamicsWorld = new btDiscreteDynamicsWorld(
-        dispatcher,
-        broadphase,
-        solver,
-        collisionConfiguration
-    );
+#ifdef BT_THREADSAFE
+    if (profile_.solverThreads != 1) {
+        if (btITaskScheduler* scheduler = sharedTaskScheduler()) {
+            int threads = profile_.solverThreads > 0 ? profile_.solverThreads : scheduler->getMaxNumThreads();
+            threads = std::clamp(threads, 1, scheduler->getMaxNumThreads());
+            scheduler->setNumThreads(threads);
+
+            dispatcher = new btCollisionDispatcherMt(collisionConfiguration, 40);
+            solverPool = new btConstraintSolverPoolMt(threads);
+            solver = new btSequentialImpulseConstraintSolverMt();
+            if (collisions) {
+                dynamicsWorld = new btDiscreteDynamicsWorldMt(dispatcher, broadphase, solverPool, solver,
+                                                              collisionConfiguration);
+            } else {
+                dynamicsWorld = new CollisionFreeWorld<btDiscreteDynamicsWorldMt>(
+                    dispatcher, broadphase, solverPool, solver, collisionConfiguration);
+            }
+        }
+    }
+#endif
+
+    if (!solverPool) {
+        dispatcher = new btCollisionDispatcher(collisionConfiguration);
+        solver = new btSequentialImpulseConstraintSolver();
+        if (collisions) {
+            dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
+        } else {
+            dynamicsWorld = new CollisionFreeWorld<btDiscreteDynamicsWorld>(dispatcher, broadphase, solver,
+                                                                            collisionConfiguration);
+        }
+    }
 
     dynamicsWorld->setGravity(btVector3(0, 0, 0));
 }
 
+btBroadphaseInterface* PhysicsEngine::createBroadphase() const {
+    const int capacity = std::max(1, profile_.maxBodies);
+    switch (profile_.broadphase) {
+        case BroadphaseType::None:
+            return new NullBroadphase();
+        case BroadphaseType::Simple:
+            return new btSimpleBroadphase(capacity);
+        case BroadphaseType::AxisSweep: {
+            const btScalar e = profile_.worldHalfExtent;
+            // The 16-bit sweep is meant for up to 16384 proxies; larger worlds need the 32-bit one.
+            if (capacity <= 16384)
+                return new btAxisSweep3(btVector3(-e, -e, -e), btVector3(e, e, e),
+                                        static_cast<unsigned short>(capacity));
+            return new bt32BitAxisSweep3(btVector3(-e, -e, -e), btVector3(e, e, e),
+                                         static_cast<unsigned int>(capacity));
+        }
+        case BroadphaseType::Dbvt:
+        default:
+            return new btDbvtBroadphase();
+    }
+}
+
 PhysicsEngine::~PhysicsEngine() {
     for (btRigidBody* body : bodies) {
         dynamicsWorld->removeRigidBody(body);
@@ -27,15 +157,23 @@ PhysicsEngine::~PhysicsEngine() {
         delete shape;
     }
 
+    // Pooled bodies still in the world lose their broadphase proxies here; bodyPool
+    // releases them (in one go) when the members are destroyed.
     delete dynamicsWorld;
     delete solver;
+#ifdef BT_THREADSAFE
+    delete solverPool;
+#endif
     delete broadphase;
     delete dispatcher;
     delete collisionConfiguration;
 }
 
 void PhysicsEngine::stepSimulation(float deltaTime) {
-    dynamicsWorld->stepSimulation(deltaTime);
+    // maxSubSteps = 0: one step of exactly deltaTime. The caller owns the fixed
+    // timestep (FixedTimestep), so Bullet's own accumulator would only add a
+    // second, unsynchronized layer that skips or doubles steps.
+    dynamicsWorld->stepSimulation(deltaTime, 0);
 }
 
 void PhysicsEngine::addRigidBody(btRigidBody* body, btCollisionShape* shape) {
@@ -2,13 +2,27 @@
 #define PHYSICSENGINE_H
 
 #include <btBulletDynamicsCommon.h>
+#include "RigidBodyPool.h"
 #include <vector>
 
+class btConstraintSolverPoolMt;
+
 /**
  * @file PhysicsEngine.h
  * @brief Core physics engine wrapper for the Bullet Dynamics library.
  */
 
+/**
+ * @enum BroadphaseType
+ * @brief Selects how the Bullet world finds potentially colliding pairs.
+ */
+enum class BroadphaseType {
+    None,      ///< No collision detection at all; bodies only integrate forces and constraints.
+    Simple,    ///< btSimpleBroadphase: brute force, for a few hundred bodies.
+    AxisSweep, ///< btAxisSweep3 (sweep and prune) over a fixed world box; cheap for mostly static scenes.
+    Dbvt       ///< btDbvtBroadphase: dynamic AABB trees, Bullet's general-purpose default.
+};
+
 /**
  * @class PhysicsEngine
  * @brief Encapsulates the Bullet Physics pipeline and dynamics world.
@@ -16,14 +30,50 @@
  * This class is responsible for the low-level initialization of the physics world,
  * including collision detection, impulse solving, and step integration. It acts
  * as a container for all physical entities and their geometric shapes.
+ *
+ * How the world is built is chosen per view with a Profile. Views whose bodies never
+ * touch (point masses driven by GalaxyPhysicsController) should use
+ * Profile::collisionFree(): the world then skips AABB updates, the broadphase and the
+ * narrowphase on every step, which otherwise dominate the step time for many bodies.
  */
 class PhysicsEngine {
+public:
+    /**
+     * @struct Profile
+     * @brief Construction options of the Bullet world.
+     */
+    struct Profile {
+        BroadphaseType broadphase = BroadphaseType::Dbvt; ///< Pair search; None disables collisions.
+        double worldHalfExtent = 1.0e5; ///< AxisSweep: bodies are expected inside [-e, e]^3.
+        int maxBodies = 16384;          ///< Simple and AxisSweep: proxy capacity.
+        /**
+         * @brief Solver threads; above 1 the world is a btDiscreteDynamicsWorldMt with a
+         * btConstraintSolverPoolMt (requires Bullet built with BT_THREADSAFE, otherwise
+         * the world stays single-threaded); 0 = one per hardware thread.
+         */
+        int solverThreads = 1;
+
+        /** @brief Profile for bodies that never collide: no broadphase, no narrowphase. */
+        static Profile collisionFree(int solverThreads = 1) {
+            Profile profile;
+            profile.broadphase = BroadphaseType::None;
+            profile.solverThreads = solverThreads;
+            return profile;
+        }
+    };
+
 private:
+    /** @brief The options the world was built with. */
+    Profile profile_;
+
     /** @brief The main container for all rigid bodies and constraints. */
     btDiscreteDynamicsWorld* dynamicsWorld;
 
     /** @brief Handles how bodies react to collisions and constraints (impulses). */
-    btSequentialImpulseConstraintSolver* solver;
+    btConstraintSolver* solver;
+
+    /** @brief Multithreaded worlds: pool of per-thread solvers (nullptr otherwise). */
+    btConstraintSolverPoolMt* solverPool = nullptr;
 
     /** @brief The "Broadphase" algorithm used to quickly filter out pairs of bodies that cannot collide. */
     btBroadphaseInterface* broadphase;
@@ -34,12 +84,18 @@ private:
     /** @brief Global settings for collision memory allocation and algorithms. */
     btDefaultCollisionConfiguration* collisionConfiguration;
 
+    /** @brief Creates the broadphase selected by the profile. */
+    btBroadphaseInterface* createBroadphase() const;
+
     /** @brief Internal registry of collision shapes to ensure proper memory cleanup. */
     std::vector<btCollisionShape*> shapes;
 
     /** @brief Internal registry of rigid bodies managed by this engine. */
     std::vector<btRigidBody*> bodies;
 
+    /** @brief Storage of pooled bodies and shared shapes; released after the world is deleted. */
+    RigidBodyPool bodyPool;
+
 public:
     /**
      * @brief Constructor: Initializes the complete Bullet physics pipeline.
@@ -48,6 +104,12 @@ public:
      */
     PhysicsEngine();
 
+    /**
+     * @brief Constructor: Builds the Bullet world as described by a profile.
+     * @param profile Broadphase and threading options.
+     */
+    explicit PhysicsEngine(const Profile& profile);
+
     /**
      * @brief Destructor: Performs a deep cleanup of the physics world.
      * * Explicitly deletes all bodies, shapes, and the dynamics world components
@@ -56,14 +118,16 @@ public:
     ~PhysicsEngine();
 
     /**
-     * @brief Advances the physics simulation by a given time interval.
-     * * @param deltaTime The time step (usually from a QTimer or frame clock).
-     * Bullet will automatically handle "sub-stepping" to maintain stability.
+     * @brief Advances the physics simulation by exactly one step of the given length.
+     * * @param deltaTime The time step; should be constant (see FixedTimestep).
+     * Bullet's internal sub-stepping is bypassed, so every call integrates once.
      */
     void stepSimulation(float deltaTime);
 
     /**
      * @brief Registers a rigid body and its collision shape in the dynamics world.
+     * * The engine takes ownership of both and deletes them on destruction. Bodies
+     * from getBodyPool() are added to getWorld() directly instead.
      * @param body The Bullet rigid body instance.
      * @param shape The collision geometry associated with the body.
      */
@@ -77,6 +141,15 @@ public:
 
     /** @brief Provides direct access to the Bullet world for advanced configurations. */
     btDiscreteDynamicsWorld* getWorld() const { return dynamicsWorld; }
+
+    /** @brief Returns the pool for bodies and shared shapes that live as long as the engine. */
+    RigidBodyPool& getBodyPool() { return bodyPool; }
+
+    /** @brief Returns the options the world was built with. */
+    const Profile& getProfile() const { return profile_; }
+
+    /** @brief Returns true if the world runs Bullet's multithreaded pipeline. */
+    bool isMultithreaded() const { return solverPool != nullptr; }
 };
 
 #endif // PHYSICSENGINE_H
\ No newline at end of file
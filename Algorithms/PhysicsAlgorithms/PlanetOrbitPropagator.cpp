@@ -0,0 +1,113 @@
+#include "PlanetOrbitPropagator.h"
+#include "StarSystem.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+
+void PlanetOrbitPropagator::build(const std::vector<CelestialObject *> &objects) {
+    clear();
+    for (int k = 0; k < static_cast<int>(objects.size()); ++k) {
+        auto *system = dynamic_cast<StarSystem *>(objects[k]);
+        if (!system) continue;
+        for (const Planet *planet : system->getPlanets()) {
+            const double a = planet->getOrbit();
+            addOrbit(k, a, 0.0, displayMeanMotion(a), 0.0, planet->getInclination());
+        }
+    }
+    planetStart_.resize(objects.size() + 1, size());
+}
+
+void PlanetOrbitPropagator::addOrbit(int object, double semiMajorAxis, double eccentricity, double meanMotion,
+                                     double meanAnomalyAtEpoch, double inclinationDegrees) {
+    // Close the (possibly empty) groups of the objects up to and including `object`.
+    if (planetStart_.empty()) planetStart_.push_back(0);
+    while (static_cast<int>(planetStart_.size()) <= object + 1) planetStart_.push_back(size());
+
+    const double e = std::clamp(eccentricity, 0.0, MAX_ECCENTRICITY);
+    const double inclination = inclinationDegrees * M_PI / 180.0;
+    semiMajorAxis_.push_back(semiMajorAxis);
+    eccentricity_.push_back(e);
+    turnsPerSecond_.push_back(meanMotion / (2.0 * M_PI));
+    turnsAtEpoch_.push_back(meanAnomalyAtEpoch / (2.0 * M_PI));
+    minorFactor_.push_back(std::sqrt(1.0 - e * e));
+    cosInclination_.push_back(std::cos(inclination));
+    sinInclination_.push_back(std::sin(inclination));
+    maxEccentricity_ = std::max(maxEccentricity_, e);
+    ++planetStart_.back();
+
+    for (auto *result : {&u_, &v_, &x_, &y_, &z_, &turns_, &sinE_, &cosE_, &meanAnomaly_, &eccentricAnomaly_})
+        result->push_back(0.0);
+    u_.back() = x_.back() = semiMajorAxis * (1.0 - e);
+}
+
+void PlanetOrbitPropagator::clear() {
+    planetStart_.clear();
+    for (auto *array : {&semiMajorAxis_, &eccentricity_, &turnsPerSecond_, &turnsAtEpoch_, &minorFactor_,
+                        &cosInclination_, &sinInclination_, &u_, &v_, &x_, &y_, &z_,
+                        &turns_, &sinE_, &cosE_, &meanAnomaly_, &eccentricAnomaly_})
+        array->clear();
+    maxEccentricity_ = 0;
+    time_ = 0;
+}
+
+int PlanetOrbitPropagator::firstPlanet(int object) const {
+    if (object < 0 || object + 1 >= static_cast<int>(planetStart_.size())) return size();
+    return planetStart_[object];
+}
+
+int PlanetOrbitPropagator::planetCount(int object) const {
+    if (object < 0 || object + 1 >= static_cast<int>(planetStart_.size())) return 0;
+    return planetStart_[object + 1] - planetStart_[object];
+}
+
+double PlanetOrbitPropagator::displayMeanMotion(double orbitRadius) {
+    return 0.5 / std::sqrt(orbitRadius + 1.0);
+}
+
+void PlanetOrbitPropagator::propagate(double time, WorkerPool *pool) {
+    time_ = time;
+    if (pool && size() >= PARALLEL_THRESHOLD) {
+        pool->parallelFor(size(), [&](int begin, int end, int) { propagateRange(begin, end, time); });
+    } else {
+        propagateRange(0, size(), time);
+    }
+}
+
+void PlanetOrbitPropagator::propagateRange(int begin, int end, double time) {
+    const int count = end - begin;
+    double *turns = turns_.data() + begin, *sinE = sinE_.data() + begin, *cosE = cosE_.data() + begin;
+    for (int i = begin; i < end; ++i) turns_[i] = turnsAtEpoch_[i] + turnsPerSecond_[i] * time;
+    SimdKernels::sinCosTurns(turns, sinE, cosE, count);
+
+    // Circular orbits (all planets so far) need no Kepler solve: E = M.
+    if (maxEccentricity_ > 0) {
+        const double twoPi = 2.0 * M_PI;
+        for (int i = begin; i < end; ++i) {
+            const double m = twoPi * (turns_[i] - std::floor(turns_[i] + 0.5));
+            meanAnomaly_[i] = m;
+            eccentricAnomaly_[i] = m + eccentricity_[i] * sinE_[i];
+        }
+        for (int k = 0; k < NEWTON_ITERATIONS; ++k) {
+            for (int i = begin; i < end; ++i) turns_[i] = eccentricAnomaly_[i] / twoPi;
+            SimdKernels::sinCosTurns(turns, sinE, cosE, count);
+            for (int i = begin; i < end; ++i) {
+                const double e = eccentricity_[i];
+                eccentricAnomaly_[i] -= (eccentricAnomaly_[i] - e * sinE_[i] - meanAnomaly_[i]) /
+                                        (1.0 - e * cosE_[i]);
+            }
+        }
+        for (int i = begin; i < end; ++i) turns_[i] = eccentricAnomaly_[i] / twoPi;
+        SimdKernels::sinCosTurns(turns, sinE, cosE, count);
+    }
+
+    for (int i = begin; i < end; ++i) {
+        const double a = semiMajorAxis_[i];
+        const double u = a * (cosE_[i] - eccentricity_[i]);
+        const double v = a * minorFactor_[i] * sinE_[i];
+        u_[i] = u;
+        v_[i] = v;
+        x_[i] = u;
+        y_[i] = v * sinInclination_[i];
+        z_[i] = v * cosInclination_[i];
+    }
+}
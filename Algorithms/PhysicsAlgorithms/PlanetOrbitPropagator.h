@@ -0,0 +1,132 @@
+#ifndef PLANETORBITPROPAGATOR_H
+#define PLANETORBITPROPAGATOR_H
+
+#include "CelestialObject.h"
+#include "Planet.h"
+#include "WorkerPool.h"
+#include <vector>
+
+/**
+ * @file PlanetOrbitPropagator.h
+ * @brief Positions of all planets of a galaxy at a given time, in one batched pass.
+ */
+
+/**
+ * @class PlanetOrbitPropagator
+ * @brief Kepler orbits of every planet of every StarSystem, stored as flat arrays.
+ *
+ * build() collects the orbital elements of all planets, grouped by the galaxy index of
+ * their star system (CSR-style: the planets of object k are [firstPlanet(k),
+ * firstPlanet(k) + planetCount(k))). propagate() then evaluates
+ *
+ *     M = M0 + n t,   E - e sin E = M,   (u, v) = a (cos E - e, sqrt(1 - e^2) sin E)
+ *
+ * for all of them in passes over the arrays: a fixed number of Newton iterations (none
+ * while every orbit is circular) instead of KeplerSolver's data-dependent loop, so every
+ * planet costs the same, and each pass takes the sines and cosines of all planets at
+ * once with SimdKernels::sinCosTurns(). Angles are kept in turns, which drops whole
+ * revolutions exactly.
+ * (u, v) are the coordinates in the orbit plane, u towards periapsis; x, y, z tilt that
+ * plane by the planet's inclination about the u axis, with y as "up" (the 3D view's
+ * convention).
+ *
+ * Planets only carry a radius, speed and inclination, so orbits are circular and all
+ * start at the same phase at t = 0; the mean motion follows displayMeanMotion(), the
+ * law the 2D system view has always animated with. Both views propagate to the same
+ * wall-clock time, so they show the same planet positions.
+ *
+ * @code
+ * PlanetOrbitPropagator orbits;
+ * orbits.build(galaxy->getObject());
+ * orbits.propagate(QDateTime::currentMSecsSinceEpoch() / 1000.0);
+ * for (int p = orbits.firstPlanet(k); p < orbits.firstPlanet(k) + orbits.planetCount(k); ++p)
+ *     draw(orbits.x()[p], orbits.z()[p]);
+ * @endcode
+ */
+class PlanetOrbitPropagator {
+public:
+    /**
+     * @brief Reads the planets of all star systems among `objects` (other objects get none).
+     * @param objects The galaxy's objects; planet elements are copied, no pointers are kept.
+     */
+    void build(const std::vector<CelestialObject *> &objects);
+
+    /**
+     * @brief Adds one orbit; build() uses it for every planet.
+     * @param object Galaxy index of the star system; must not be smaller than that of the previous orbit.
+     * @param semiMajorAxis a, in the planet's orbit radius units (AU).
+     * @param eccentricity e, clamped to [0, MAX_ECCENTRICITY].
+     * @param meanMotion n, radians per second.
+     * @param meanAnomalyAtEpoch M at t = 0.
+     * @param inclinationDegrees Tilt of the orbit plane.
+     */
+    void addOrbit(int object, double semiMajorAxis, double eccentricity, double meanMotion,
+                  double meanAnomalyAtEpoch, double inclinationDegrees);
+
+    /** @brief Removes all orbits. */
+    void clear();
+
+    /**
+     * @brief Computes the positions of all planets at time t.
+     * @param time Seconds since the epoch.
+     * @param pool Workers to split the planets over, or nullptr.
+     */
+    void propagate(double time, WorkerPool *pool = nullptr);
+
+    /** @brief Returns the index of the first planet of galaxy object `object`. */
+    int firstPlanet(int object) const;
+
+    /** @brief Returns the number of planets of galaxy object `object` (0 if it has none or is unknown). */
+    int planetCount(int object) const;
+
+    /** @brief Returns the total number of planets. */
+    int size() const { return static_cast<int>(semiMajorAxis_.size()); }
+
+    /** @brief Returns the semi-major axes. */
+    const std::vector<double> &semiMajorAxis() const { return semiMajorAxis_; }
+
+    /** @brief Returns the in-plane coordinates towards periapsis (valid after propagate()). */
+    const std::vector<double> &u() const { return u_; }
+
+    /** @brief Returns the in-plane coordinates 90 degrees ahead of periapsis. */
+    const std::vector<double> &v() const { return v_; }
+
+    /** @brief Returns the positions relative to the star, y up. */
+    const std::vector<double> &x() const { return x_; }
+    const std::vector<double> &y() const { return y_; }
+    const std::vector<double> &z() const { return z_; }
+
+    /** @brief Returns the time of the last propagate(). */
+    double time() const { return time_; }
+
+    /**
+     * @brief Angular speed the views animate a planet with, in radians per second.
+     * @param orbitRadius The planet's orbit radius (AU).
+     */
+    static double displayMeanMotion(double orbitRadius);
+
+    /// @brief Orbits are clamped to this eccentricity, for which NEWTON_ITERATIONS always converge.
+    static constexpr double MAX_ECCENTRICITY = 0.5;
+
+    /// @brief Newton steps per eccentric planet, from E0 = M + e sin M.
+    static constexpr int NEWTON_ITERATIONS = 5;
+
+private:
+    std::vector<int> planetStart_;                 ///< CSR offsets, size objects + 1.
+    std::vector<double> semiMajorAxis_, eccentricity_;
+    std::vector<double> turnsPerSecond_, turnsAtEpoch_; ///< n and M0, in turns.
+    std::vector<double> minorFactor_;              ///< sqrt(1 - e^2).
+    std::vector<double> cosInclination_, sinInclination_;
+    std::vector<double> u_, v_, x_, y_, z_;        ///< Results.
+    std::vector<double> turns_, sinE_, cosE_, meanAnomaly_, eccentricAnomaly_; ///< Scratch.
+    double maxEccentricity_ = 0;
+    double time_ = 0;
+
+    /// @brief Below this many planets propagate() stays on the calling thread.
+    static constexpr int PARALLEL_THRESHOLD = 16384;
+
+    /** @brief Propagates planets [begin, end). */
+    void propagateRange(int begin, int end, double time);
+};
+
+#endif // PLANETORBITPROPAGATOR_H
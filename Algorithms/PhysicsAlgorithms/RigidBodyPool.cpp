@@ -0,0 +1,89 @@
+#include "RigidBodyPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <new>
+
+RigidBodyPool::~RigidBodyPool() {
+    clear();
+}
+
+void RigidBodyPool::grow(int slots) {
+    blocks_.push_back(std::make_unique<Slot[]>(slots));
+    blockSizes_.push_back(slots);
+    capacity_ += slots;
+
+    // Pushed in reverse so slots are handed out in address order.
+    Slot* block = blocks_.back().get();
+    freeSlots_.reserve(freeSlots_.size() + slots);
+    for (int s = slots - 1; s >= 0; --s) freeSlots_.push_back(&block[s]);
+}
+
+void RigidBodyPool::reserve(int bodies) {
+    const int missing = bodies - liveBodies_ - static_cast<int>(freeSlots_.size());
+    if (missing > 0) grow(missing);
+}
+
+btCollisionShape* RigidBodyPool::sphereShape(double radius) {
+    const int radiusClass = static_cast<int>(std::lround(CLASSES_PER_OCTAVE * std::log2(std::max(radius, 1e-6))));
+    auto& shape = shapes_[radiusClass];
+    if (!shape) {
+        shape = std::make_unique<btSphereShape>(btScalar(std::exp2(double(radiusClass) / CLASSES_PER_OCTAVE)));
+    }
+    return shape.get();
+}
+
+btRigidBody* RigidBodyPool::createBody(btRigidBody::btRigidBodyConstructionInfo info,
+                                       const btTransform& startTransform) {
+    // Without reserve() the blocks double, so n bodies take O(log n) allocations.
+    if (freeSlots_.empty()) grow(std::max(64, capacity_));
+    Slot* slot = freeSlots_.back();
+    freeSlots_.pop_back();
+
+    auto* motionState = new (slot->motionState) btDefaultMotionState(startTransform);
+    info.m_motionState = motionState;
+    auto* body = new (slot->body) btRigidBody(info);
+    slot->live = true;
+    ++liveBodies_;
+    return body;
+}
+
+RigidBodyPool::Slot* RigidBodyPool::findSlot(const btRigidBody* body) {
+    // Compared as integers: relational operators on pointers into different blocks are unspecified.
+    const auto address = reinterpret_cast<std::uintptr_t>(body);
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        const auto first = reinterpret_cast<std::uintptr_t>(blocks_[b].get());
+        if (address < first || address >= first + blockSizes_[b] * sizeof(Slot)) continue;
+
+        Slot& slot = blocks_[b][(address - first) / sizeof(Slot)];
+        return reinterpret_cast<std::uintptr_t>(slot.body) == address ? &slot : nullptr;
+    }
+    return nullptr;
+}
+
+void RigidBodyPool::destroyBody(btRigidBody* body) {
+    if (!body) return;
+    Slot* slot = findSlot(body);
+    if (!slot || !slot->live) return;
+
+    slot->rigidBody()->~btRigidBody();
+    slot->defaultMotionState()->~btDefaultMotionState();
+    slot->live = false;
+    --liveBodies_;
+    freeSlots_.push_back(slot);
+}
+
+void RigidBodyPool::clear() {
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        for (int s = 0; s < blockSizes_[b]; ++s) {
+            Slot& slot = blocks_[b][s];
+            if (slot.live) destroyBody(slot.rigidBody());
+        }
+    }
+    blocks_.clear();
+    blockSizes_.clear();
+    freeSlots_.clear();
+    shapes_.clear();
+    liveBodies_ = 0;
+    capacity_ = 0;
+}
@@ -0,0 +1,92 @@
+#include "SimulationThread.h"
+#include <algorithm>
+
+SimulationThread::SimulationThread(GalaxyPhysicsController* controller, double stepSize, double timeScale,
+                                   int maxSubsteps)
+    : controller_(controller), stepSize_(stepSize > 0 ? stepSize : 1.0 / 60.0),
+      timeScale_(timeScale > 0 ? timeScale : 1.0), maxSubsteps_(std::max(1, maxSubsteps)) {}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start(double startTime) {
+    if (!controller_ || thread_.joinable()) return;
+    simulationTime_ = startTime;
+    step_ = 0;
+    droppedTime_ = 0;
+    running_ = true;
+    thread_ = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    running_ = false;
+    if (thread_.joinable()) thread_.join();
+}
+
+std::unique_lock<std::mutex> SimulationThread::lockController() {
+    ++pauseRequests_;
+    std::unique_lock<std::mutex> lock(controllerMutex_);
+    --pauseRequests_;
+    return lock;
+}
+
+double SimulationThread::interpolationFactor() const {
+    const PhysicsSnapshot& current = snapshot();
+    if (current.step == 0) return 1.0;
+    std::chrono::duration<double> sincePublished = std::chrono::steady_clock::now() - current.publishedAt;
+    return std::clamp(current.alpha + sincePublished.count() * timeScale_ / stepSize_, 0.0, 1.0);
+}
+
+void SimulationThread::run() {
+    using Clock = std::chrono::steady_clock;
+    FixedTimestep timestep(stepSize_, maxSubsteps_);
+    auto last = Clock::now();
+
+    while (running_) {
+        auto now = Clock::now();
+        int steps = timestep.advance(std::chrono::duration<double>(now - last).count() * timeScale_);
+        last = now;
+
+        if (steps > 0) {
+            PhysicsSnapshot& out = snapshots_.writeBuffer();
+            for (int s = 0; s < steps && running_; ++s) {
+                // std::mutex is not fair; step aside so that lockController() cannot starve.
+                while (pauseRequests_ > 0) std::this_thread::yield();
+
+                std::lock_guard<std::mutex> lock(controllerMutex_);
+                if (s == steps - 1) capturePositions(out.previousX, out.previousY, out.previousZ);
+                controller_->simulateStep(stepSize_);
+                simulationTime_ += stepSize_;
+                ++step_;
+                if (s == steps - 1) {
+                    capturePositions(out.x, out.y, out.z);
+                    out.bodiesVersion = controller_->getBodiesVersion();
+                }
+            }
+            out.simulationTime = simulationTime_;
+            out.step = step_;
+            out.alpha = timestep.alpha();
+            out.publishedAt = Clock::now();
+            snapshots_.publish();
+            droppedTime_ = timestep.droppedTime();
+        }
+
+        // Sleep until the next step is due.
+        std::chrono::duration<double> wait((1.0 - timestep.alpha()) * stepSize_ / timeScale_);
+        std::this_thread::sleep_for(wait);
+    }
+}
+
+void SimulationThread::capturePositions(std::vector<double>& x, std::vector<double>& y, std::vector<double>& z) const {
+    const auto& bodies = controller_->getBodies();
+    const size_t n = bodies.size();
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = bodies[i]->getX();
+        y[i] = bodies[i]->getY();
+        z[i] = bodies[i]->getZ();
+    }
+}
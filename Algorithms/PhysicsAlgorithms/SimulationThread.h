@@ -0,0 +1,151 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include "GalaxyPhysicsController.h"
+#include "FixedTimestep.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file SimulationThread.h
+ * @brief Runs a GalaxyPhysicsController on its own thread and publishes position snapshots.
+ */
+
+/**
+ * @struct PhysicsSnapshot
+ * @brief Body positions after the latest simulation step and the one before it.
+ */
+struct PhysicsSnapshot {
+    std::vector<double> x, y, z; ///< Positions, indexed like GalaxyPhysicsController::getBodies().
+    std::vector<double> previousX, previousY, previousZ; ///< Positions one step earlier (may be shorter than x).
+    double simulationTime = 0;   ///< Simulated seconds, counted from the start time passed to start().
+    std::uint64_t step = 0;      ///< Number of steps taken since start().
+    std::uint64_t bodiesVersion = 0; ///< GalaxyPhysicsController::getBodiesVersion() when x/y/z were taken.
+    double alpha = 0;            ///< Unsimulated fraction of a step when the snapshot was published.
+    std::chrono::steady_clock::time_point publishedAt; ///< Wall-clock time of publication.
+
+    /**
+     * @brief Blends the previous and the latest position of body i.
+     * @param i Body index.
+     * @param t 0 = previous step, 1 = latest step.
+     * @param px, py, pz Receive the position.
+     */
+    void interpolate(int i, double t, double &px, double &py, double &pz) const {
+        px = x[i];
+        py = y[i];
+        pz = z[i];
+        if (i >= static_cast<int>(previousX.size())) return; // Body was added during the last step.
+        px = previousX[i] + (px - previousX[i]) * t;
+        py = previousY[i] + (py - previousY[i]) * t;
+        pz = previousZ[i] + (pz - previousZ[i]) * t;
+    }
+};
+
+/**
+ * @class SimulationThread
+ * @brief Steps the physics independently of the GUI frame rate.
+ *
+ * The thread feeds the elapsed wall-clock time (times `timeScale`) into a
+ * FixedTimestep and runs the steps that are due, always with the same dt; at most
+ * `maxSubsteps` per wake-up, so a stall (or physics slower than real time) drops
+ * time instead of snowballing. After each batch it publishes the positions of the
+ * last two steps into a TripleBuffer, so the views pick them up at their own frame
+ * rate without locks: a slow physics step never stalls painting, and slow painting
+ * never throttles the physics. Views blend the two states with
+ * interpolationFactor() to move smoothly between steps.
+ *
+ * While the thread runs, the controller and its bodies belong to it. Code on other
+ * threads that needs to change them (e.g. adding a body) must hold lockController(),
+ * which waits until the current step is finished.
+ *
+ * @code
+ * SimulationThread thread(controller, 1.0 / 60.0, 3.0);
+ * thread.start();
+ * // Every frame on the GUI thread:
+ * thread.fetchSnapshot();
+ * draw(thread.snapshot(), thread.interpolationFactor());
+ * @endcode
+ */
+class SimulationThread {
+public:
+    /**
+     * @brief Creates a stopped simulation thread.
+     * @param controller The simulation to run (not owned; must outlive this object).
+     * @param stepSize Simulated seconds per step.
+     * @param timeScale Simulated seconds per wall-clock second.
+     * @param maxSubsteps Most steps run at one wake-up; older time is dropped.
+     */
+    SimulationThread(GalaxyPhysicsController* controller, double stepSize, double timeScale = 1.0,
+                     int maxSubsteps = 8);
+
+    /** @brief Stops the thread. */
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /**
+     * @brief Starts stepping (no-op if already running).
+     * @param startTime Simulated time to count from, e.g. PhysicsCheckpoint::simulationTime() after a resume.
+     */
+    void start(double startTime = 0.0);
+
+    /** @brief Stops stepping and joins the thread; the controller may be used directly afterwards. */
+    void stop();
+
+    /** @brief Returns true between start() and stop(). */
+    bool isRunning() const { return thread_.joinable(); }
+
+    /**
+     * @brief Pauses the simulation between two steps for as long as the lock is held.
+     * @return A lock that grants exclusive access to the controller and its bodies.
+     */
+    std::unique_lock<std::mutex> lockController();
+
+    /**
+     * @brief Consumer side: takes the newest published snapshot.
+     * Must always be called from the same thread (normally the GUI thread).
+     * @return True if snapshot() changed.
+     */
+    bool fetchSnapshot() { return snapshots_.fetch(); }
+
+    /** @brief Returns the snapshot taken by the last successful fetchSnapshot(). */
+    const PhysicsSnapshot& snapshot() const { return snapshots_.readBuffer(); }
+
+    /**
+     * @brief Consumer side: how far the present lies between snapshot()'s previous
+     * and latest step, extrapolated from the wall-clock time since publication.
+     * @return A blend factor in [0, 1] for PhysicsSnapshot::interpolate().
+     */
+    double interpolationFactor() const;
+
+    /** @brief Returns the simulated time discarded by the substep clamp (thread-safe). */
+    double droppedTime() const { return droppedTime_; }
+
+private:
+    GalaxyPhysicsController* controller_;
+    double stepSize_;
+    double timeScale_;
+    int maxSubsteps_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::mutex controllerMutex_;           ///< Held by the simulation thread during each step.
+    std::atomic<int> pauseRequests_{0};    ///< Threads waiting in lockController().
+    TripleBuffer<PhysicsSnapshot> snapshots_;
+    double simulationTime_ = 0;
+    std::uint64_t step_ = 0;
+    std::atomic<double> droppedTime_{0};
+
+    /** @brief Main loop of the simulation thread. */
+    void run();
+
+    /** @brief Copies the current body positions into x/y/z. */
+    void capturePositions(std::vector<double>& x, std::vector<double>& y, std::vector<double>& z) const;
+};
+
+#endif // SIMULATIONTHREAD_H
@@ -0,0 +1,153 @@
+#include "SpringSet.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+void SpringSet::add(int indexA, int indexB, double restLength, double stiffness) {
+    if (indexA < 0 || indexB < 0 || indexA == indexB) return;
+    // Hooke's force is symmetric, so the endpoints can be swapped freely.
+    if (indexB < indexA) std::swap(indexA, indexB);
+    if (!a_.empty() && (indexA < a_.back() || (indexA == a_.back() && indexB < b_.back()))) ordered_ = false;
+
+    a_.push_back(indexA);
+    b_.push_back(indexB);
+    rest_.push_back(restLength);
+    k_.push_back(stiffness);
+    bodyStart_.clear();
+}
+
+void SpringSet::removeBody(int index, int movedFrom) {
+    const int m = size();
+    int kept = 0;
+    for (int s = 0; s < m; ++s) {
+        int a = a_[s], b = b_[s];
+        if (a == index || b == index) continue;
+        if (a == movedFrom) a = index;
+        if (b == movedFrom) b = index;
+        if (b < a) std::swap(a, b);
+        if (kept > 0 && (a < a_[kept - 1] || (a == a_[kept - 1] && b < b_[kept - 1]))) ordered_ = false;
+        a_[kept] = a;
+        b_[kept] = b;
+        rest_[kept] = rest_[s];
+        k_[kept] = k_[s];
+        ++kept;
+    }
+    a_.resize(kept);
+    b_.resize(kept);
+    rest_.resize(kept);
+    k_.resize(kept);
+    bodyStart_.clear();
+}
+
+void SpringSet::clear() {
+    a_.clear();
+    b_.clear();
+    rest_.clear();
+    k_.clear();
+    bodyStart_.clear();
+    incidentSpring_.clear();
+    incidentSign_.clear();
+    ordered_ = true;
+}
+
+double SpringSet::potentialEnergy(const ParticleState &state) const {
+    double energy = 0;
+    for (int s = 0; s < size(); ++s) {
+        double dx = state.x[b_[s]] - state.x[a_[s]];
+        double dy = state.y[b_[s]] - state.y[a_[s]];
+        double dz = state.z[b_[s]] - state.z[a_[s]];
+        double stretch = std::sqrt(dx * dx + dy * dy + dz * dz) - rest_[s];
+        energy += 0.5 * k_[s] * stretch * stretch;
+    }
+    return energy;
+}
+
+void SpringSet::prepare(int bodies) {
+    const int m = size();
+    if (!ordered_) {
+        std::vector<int> order(m);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int s, int t) {
+            return a_[s] != a_[t] ? a_[s] < a_[t] : b_[s] < b_[t];
+        });
+        auto permute = [&order, m](auto &values) {
+            auto sorted = values;
+            for (int s = 0; s < m; ++s) sorted[s] = values[order[s]];
+            values.swap(sorted);
+        };
+        permute(a_);
+        permute(b_);
+        permute(rest_);
+        permute(k_);
+        ordered_ = true;
+        bodyStart_.clear();
+    }
+    if (static_cast<int>(bodyStart_.size()) == bodies + 1) return;
+
+    // Counting sort of the 2m spring ends by body.
+    bodyStart_.assign(bodies + 1, 0);
+    for (int s = 0; s < m; ++s) {
+        ++bodyStart_[a_[s] + 1];
+        ++bodyStart_[b_[s] + 1];
+    }
+    for (int i = 0; i < bodies; ++i) bodyStart_[i + 1] += bodyStart_[i];
+    incidentSpring_.resize(2 * static_cast<size_t>(m));
+    incidentSign_.resize(2 * static_cast<size_t>(m));
+    std::vector<int> next(bodyStart_.begin(), bodyStart_.end() - 1);
+    for (int s = 0; s < m; ++s) {
+        int e = next[a_[s]]++;
+        incidentSpring_[e] = s;
+        incidentSign_[e] = 1.0;
+        e = next[b_[s]]++;
+        incidentSpring_[e] = s;
+        incidentSign_[e] = -1.0;
+    }
+}
+
+void SpringSet::accumulate(ParticleState &state, WorkerPool *pool) {
+    const int m = size();
+    if (m == 0) return;
+    const int n = state.size();
+    prepare(n);
+
+    fx_.resize(m);
+    fy_.resize(m);
+    fz_.resize(m);
+    // Work is split in blocks of SPRING_BLOCK springs, so which springs take the kernel's
+    // vector path (and its rounding) does not depend on the number of workers.
+    const int blocks = (m + SPRING_BLOCK - 1) / SPRING_BLOCK;
+    auto forces = [&](int firstBlock, int lastBlock, int) {
+        const int begin = firstBlock * SPRING_BLOCK;
+        const int end = std::min(m, lastBlock * SPRING_BLOCK);
+        SimdKernels::springForces(state.x.data(), state.y.data(), state.z.data(),
+                                  a_.data() + begin, b_.data() + begin, rest_.data() + begin, k_.data() + begin,
+                                  fx_.data() + begin, fy_.data() + begin, fz_.data() + begin, end - begin);
+    };
+    auto gather = [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            if (bodyStart_[i] == bodyStart_[i + 1]) continue;
+            double sx = 0, sy = 0, sz = 0;
+            for (int e = bodyStart_[i]; e < bodyStart_[i + 1]; ++e) {
+                const int s = incidentSpring_[e];
+                const double sign = incidentSign_[e];
+                sx += sign * fx_[s];
+                sy += sign * fy_[s];
+                sz += sign * fz_[s];
+            }
+            const double inverseMass = 1.0 / state.mass[i];
+            state.ax[i] += sx * inverseMass;
+            state.ay[i] += sy * inverseMass;
+            state.az[i] += sz * inverseMass;
+        }
+    };
+
+    if (pool) {
+        pool->parallelFor(blocks, forces);
+        pool->parallelFor(n, gather);
+    } else {
+        forces(0, blocks, 0);
+        gather(0, n, 0);
+    }
+}
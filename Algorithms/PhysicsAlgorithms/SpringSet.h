@@ -0,0 +1,95 @@
+#ifndef SPRINGSET_H
+#define SPRINGSET_H
+
+#include "ParticleState.h"
+#include "WorkerPool.h"
+#include <vector>
+
+/**
+ * @file SpringSet.h
+ * @brief Hooke's law springs between particles, stored as flat arrays.
+ */
+
+/**
+ * @class SpringSet
+ * @brief Springs as contiguous (indexA, indexB, restLength, stiffness) arrays referencing a ParticleState.
+ *
+ * Springs are usually one per graph edge, so there can be millions of them. Instead of
+ * holding body pointers, every spring stores the particle indices of its endpoints.
+ * Before the first force pass after a change the springs are put in canonical order
+ * (indexA < indexB, sorted by indexA then indexB), so consecutive springs read nearby
+ * positions. The incident springs of every body are then grouped CSR-style: body i owns
+ * entries [bodyStart[i], bodyStart[i + 1]) of the incidence list.
+ *
+ * accumulate() runs in two passes, both split between workers without any shared writes:
+ * 1. SimdKernels::springForces() computes the force of every spring (branch-free);
+ * 2. every body gathers the forces of its incident springs in CSR order.
+ * Each body therefore sums its springs in the same order for every thread count.
+ */
+class SpringSet {
+public:
+    /**
+     * @brief Adds a spring; self-springs and negative indices are ignored.
+     * @param indexA, indexB Particle indices of the endpoints.
+     * @param restLength Length at which the spring exerts no force.
+     * @param stiffness Hooke's constant.
+     */
+    void add(int indexA, int indexB, double restLength, double stiffness);
+
+    /**
+     * @brief Follows ParticleState::swapRemove(): drops the springs attached to `index` and
+     * renumbers the particle `movedFrom` to `index`.
+     *
+     * One pass over the springs, without reallocation; the canonical order is only lost
+     * (and restored by the next accumulate()) if a renumbered spring no longer fits.
+     */
+    void removeBody(int index, int movedFrom);
+
+    /** @brief Removes all springs. */
+    void clear();
+
+    /** @brief Returns the number of springs. */
+    int size() const { return static_cast<int>(a_.size()); }
+
+    /** @brief Returns the first endpoints (in canonical order once accumulate() ran). */
+    const std::vector<int> &indexA() const { return a_; }
+
+    /** @brief Returns the second endpoints. */
+    const std::vector<int> &indexB() const { return b_; }
+
+    /** @brief Returns the rest lengths. */
+    const std::vector<double> &restLength() const { return rest_; }
+
+    /** @brief Returns the stiffnesses. */
+    const std::vector<double> &stiffness() const { return k_; }
+
+    /**
+     * @brief Adds the accelerations of all springs to state.ax/ay/az.
+     * @param state Positions and inertial masses; every spring index must be below state.size().
+     * @param pool Workers for both passes, or nullptr to run on the calling thread.
+     */
+    void accumulate(ParticleState &state, WorkerPool *pool);
+
+    /**
+     * @brief Returns the energy stored in all springs, sum(k * (|d| - restLength)^2 / 2).
+     * @param state Positions; every spring index must be below state.size().
+     */
+    double potentialEnergy(const ParticleState &state) const;
+
+private:
+    std::vector<int> a_, b_;                 ///< Endpoint particle indices.
+    std::vector<double> rest_, k_;           ///< Rest lengths and stiffnesses.
+    std::vector<double> fx_, fy_, fz_;       ///< Force of each spring on its endpoint A.
+    std::vector<int> bodyStart_;             ///< CSR offsets into incidentSpring_/incidentSign_, size bodies + 1.
+    std::vector<int> incidentSpring_;        ///< Springs attached to each body.
+    std::vector<double> incidentSign_;       ///< +1 where the body is endpoint A, -1 where it is endpoint B.
+    bool ordered_ = true;                    ///< False after add() until the next canonical sort.
+
+    /// @brief Springs per work item; a multiple of every SimdKernels vector width.
+    static constexpr int SPRING_BLOCK = 8;
+
+    /** @brief Sorts the springs and rebuilds the incidence lists for `bodies` particles if needed. */
+    void prepare(int bodies);
+};
+
+#endif // SPRINGSET_H
@@ -0,0 +1,70 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <vector>
+
+/**
+ * @file RingBuffer.h
+ * @brief Fixed-capacity history that overwrites its oldest entry.
+ */
+
+/**
+ * @class RingBuffer
+ * @brief Keeps the last `capacity` values pushed into it, in one preallocated array.
+ *
+ * push() never allocates once the buffer is full, so it can record a value every
+ * simulation step for as long as the simulation runs. Entries are indexed from the
+ * oldest (0) to the newest (size() - 1).
+ *
+ * @tparam T The value type (default-constructible, copy-assignable).
+ *
+ * @code
+ * RingBuffer<double> lastFrames(3);
+ * for (double t : {1.0, 2.0, 3.0, 4.0}) lastFrames.push(t);
+ * // lastFrames[0] == 2.0, lastFrames.back() == 4.0
+ * @endcode
+ */
+template<typename T>
+class RingBuffer {
+public:
+    /**
+     * @brief Creates an empty buffer.
+     * @param capacity Number of entries kept (at least 1).
+     */
+    explicit RingBuffer(int capacity) : slots_(capacity > 0 ? capacity : 1) {}
+
+    /** @brief Appends a value, dropping the oldest one if the buffer is full. */
+    void push(const T &value) {
+        slots_[head_] = value;
+        head_ = (head_ + 1) % capacity();
+        if (size_ < capacity()) ++size_;
+    }
+
+    /** @brief Returns entry i, counted from the oldest. */
+    const T &operator[](int i) const { return slots_[(head_ - size_ + i + capacity()) % capacity()]; }
+
+    /** @brief Returns the newest entry (the buffer must not be empty). */
+    const T &back() const { return (*this)[size_ - 1]; }
+
+    /** @brief Returns the number of stored entries. */
+    int size() const { return size_; }
+
+    /** @brief Returns true if nothing was pushed since construction or clear(). */
+    bool empty() const { return size_ == 0; }
+
+    /** @brief Returns the maximum number of entries. */
+    int capacity() const { return static_cast<int>(slots_.size()); }
+
+    /** @brief Forgets all entries (the storage is kept). */
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+private:
+    std::vector<T> slots_;
+    int head_ = 0; ///< Slot written by the next push().
+    int size_ = 0;
+};
+
+#endif // RINGBUFFER_H
@@ -0,0 +1,503 @@
+#include "SimdKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Scalar reference implementations
+// ---------------------------------------------------------------------------
+
+template<typename W>
+static void relaxRowScalar(const W *row, W du, int u, W *dist, int *parent, int n) {
+    const W inf = std::numeric_limits<W>::max();
+    for (int v = 0; v < n; ++v) {
+        W w = row[v];
+        W candidate = (w != W{}) ? du + w : inf;
+        bool better = candidate < dist[v];
+        dist[v] = better ? candidate : dist[v];
+        parent[v] = better ? u : parent[v];
+    }
+}
+
+template<typename W>
+static void minPlusRowScalar(const W *rowK, W dik, W *rowI, int n) {
+    for (int j = 0; j < n; ++j) {
+        rowI[j] = std::min(rowI[j], dik + rowK[j]);
+    }
+}
+
+static void centralGravityScalar(const double *x, const double *y, const double *z,
+                                 double *ax, double *ay, double *az, int n,
+                                 double cx, double cy, double cz, double gm, double minDistSq) {
+    for (int i = 0; i < n; ++i) {
+        double dx = cx - x[i], dy = cy - y[i], dz = cz - z[i];
+        double d2 = std::max(dx * dx + dy * dy + dz * dz, minDistSq);
+        if (d2 <= 0) continue;
+        double inv = 1.0 / std::sqrt(d2);
+        double s = gm * inv * inv * inv;
+        ax[i] += s * dx;
+        ay[i] += s * dy;
+        az[i] += s * dz;
+    }
+}
+
+static void gravitySumScalar(double px, double py, double pz,
+                             const double *qx, const double *qy, const double *qz, const double *qm,
+                             int n, double epsSq, double *out) {
+    double sx = 0, sy = 0, sz = 0;
+    for (int j = 0; j < n; ++j) {
+        double dx = qx[j] - px, dy = qy[j] - py, dz = qz[j] - pz;
+        double r2 = dx * dx + dy * dy + dz * dz + epsSq;
+        double inv = r2 > 0 ? 1.0 / std::sqrt(r2) : 0.0;
+        double s = qm[j] * inv * inv * inv;
+        sx += s * dx;
+        sy += s * dy;
+        sz += s * dz;
+    }
+    out[0] += sx;
+    out[1] += sy;
+    out[2] += sz;
+}
+
+static void springForcesScalar(const double *x, const double *y, const double *z,
+                               const int *a, const int *b, const double *rest, const double *k,
+                               double *fx, double *fy, double *fz, int m) {
+    for (int s = 0; s < m; ++s) {
+        double dx = x[b[s]] - x[a[s]], dy = y[b[s]] - y[a[s]], dz = z[b[s]] - z[a[s]];
+        double d2 = dx * dx + dy * dy + dz * dz;
+        // Branch-free: degenerate springs get a finite length and a zero factor.
+        double live = d2 >= 1e-6 ? 1.0 : 0.0;
+        double d = std::sqrt(std::max(d2, 1e-6));
+        double f = live * k[s] * (d - rest[s]) / d;
+        fx[s] = f * dx;
+        fy[s] = f * dy;
+        fz[s] = f * dz;
+    }
+}
+
+// Taylor coefficients of sin(r) / r - 1 and cos(r) - 1 in r^2, highest first; on
+// |r| <= pi / 4 the first omitted terms are below 1e-16.
+static constexpr double SIN_POLY[] = {-1.0 / 1307674368000.0, 1.0 / 6227020800.0, -1.0 / 39916800.0,
+                                      1.0 / 362880.0, -1.0 / 5040.0, 1.0 / 120.0, -1.0 / 6.0};
+static constexpr double COS_POLY[] = {1.0 / 20922789888000.0, -1.0 / 87178291200.0, 1.0 / 479001600.0,
+                                      -1.0 / 3628800.0, 1.0 / 40320.0, -1.0 / 720.0, 1.0 / 24.0, -0.5};
+
+static void sinCosTurnsScalar(const double *turns, double *s, double *c, int n) {
+    for (int i = 0; i < n; ++i) {
+        // Drop whole turns, then split off the quadrant q in [-2, 2]; r is within pi / 4.
+        double t = turns[i] - std::nearbyint(turns[i]);
+        double q = std::nearbyint(4.0 * t);
+        double r = (t - 0.25 * q) * (2.0 * M_PI);
+        double r2 = r * r;
+        double ps = SIN_POLY[0], pc = COS_POLY[0];
+        for (int k = 1; k < 7; ++k) ps = ps * r2 + SIN_POLY[k];
+        for (int k = 1; k < 8; ++k) pc = pc * r2 + COS_POLY[k];
+        double sr = r + r * r2 * ps;
+        double cr = 1.0 + r2 * pc;
+        // Rotate (cos r, sin r) by q quarter turns.
+        bool swap = q == 1.0 || q == -1.0;
+        double sa = swap ? cr : sr, ca = swap ? sr : cr;
+        s[i] = (q < 0.0 || q == 2.0) ? -sa : sa;
+        c[i] = (q == 1.0 || q == 2.0 || q == -2.0) ? -ca : ca;
+    }
+}
+
+#ifdef SIMD_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// SSE4.1 (128-bit)
+// ---------------------------------------------------------------------------
+
+__attribute__((target("sse4.1")))
+static void relaxRowSse41(const float *row, float du, int u, float *dist, int *parent, int n) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::max());
+    const __m128 duv = _mm_set1_ps(du);
+    const __m128i uv = _mm_set1_epi32(u);
+    int v = 0;
+    for (; v + 4 <= n; v += 4) {
+        __m128 w = _mm_loadu_ps(row + v);
+        __m128 d = _mm_loadu_ps(dist + v);
+        __m128 candidate = _mm_blendv_ps(inf, _mm_add_ps(duv, w), _mm_cmpneq_ps(w, zero));
+        __m128 better = _mm_cmplt_ps(candidate, d);
+        _mm_storeu_ps(dist + v, _mm_blendv_ps(d, candidate, better));
+
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(parent + v));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(parent + v), _mm_blendv_epi8(p, uv, _mm_castps_si128(better)));
+    }
+    relaxRowScalar(row + v, du, u, dist + v, parent + v, n - v);
+}
+
+__attribute__((target("sse4.1")))
+static void relaxRowSse41(const double *row, double du, int u, double *dist, int *parent, int n) {
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d inf = _mm_set1_pd(std::numeric_limits<double>::max());
+    const __m128d duv = _mm_set1_pd(du);
+    const __m128i uv = _mm_set1_epi32(u);
+    int v = 0;
+    for (; v + 2 <= n; v += 2) {
+        __m128d w = _mm_loadu_pd(row + v);
+        __m128d d = _mm_loadu_pd(dist + v);
+        __m128d candidate = _mm_blendv_pd(inf, _mm_add_pd(duv, w), _mm_cmpneq_pd(w, zero));
+        __m128d better = _mm_cmplt_pd(candidate, d);
+        _mm_storeu_pd(dist + v, _mm_blendv_pd(d, candidate, better));
+
+        // Narrow the two 64-bit lane masks to two 32-bit masks for the int parents.
+        __m128i mask = _mm_shuffle_epi32(_mm_castpd_si128(better), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128i p = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(parent + v));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(parent + v), _mm_blendv_epi8(p, uv, mask));
+    }
+    relaxRowScalar(row + v, du, u, dist + v, parent + v, n - v);
+}
+
+__attribute__((target("sse4.1")))
+static void minPlusRowSse41(const float *rowK, float dik, float *rowI, int n) {
+    const __m128 dikv = _mm_set1_ps(dik);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m128 via = _mm_add_ps(dikv, _mm_loadu_ps(rowK + j));
+        _mm_storeu_ps(rowI + j, _mm_min_ps(_mm_loadu_ps(rowI + j), via));
+    }
+    minPlusRowScalar(rowK + j, dik, rowI + j, n - j);
+}
+
+__attribute__((target("sse4.1")))
+static void minPlusRowSse41(const double *rowK, double dik, double *rowI, int n) {
+    const __m128d dikv = _mm_set1_pd(dik);
+    int j = 0;
+    for (; j + 2 <= n; j += 2) {
+        __m128d via = _mm_add_pd(dikv, _mm_loadu_pd(rowK + j));
+        _mm_storeu_pd(rowI + j, _mm_min_pd(_mm_loadu_pd(rowI + j), via));
+    }
+    minPlusRowScalar(rowK + j, dik, rowI + j, n - j);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 (256-bit)
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static void relaxRowAvx2(const float *row, float du, int u, float *dist, int *parent, int n) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::max());
+    const __m256 duv = _mm256_set1_ps(du);
+    const __m256i uv = _mm256_set1_epi32(u);
+    int v = 0;
+    for (; v + 8 <= n; v += 8) {
+        __m256 w = _mm256_loadu_ps(row + v);
+        __m256 d = _mm256_loadu_ps(dist + v);
+        __m256 candidate = _mm256_blendv_ps(inf, _mm256_add_ps(duv, w), _mm256_cmp_ps(w, zero, _CMP_NEQ_OQ));
+        __m256 better = _mm256_cmp_ps(candidate, d, _CMP_LT_OQ);
+        _mm256_storeu_ps(dist + v, _mm256_blendv_ps(d, candidate, better));
+
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(parent + v));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(parent + v),
+                            _mm256_blendv_epi8(p, uv, _mm256_castps_si256(better)));
+    }
+    relaxRowScalar(row + v, du, u, dist + v, parent + v, n - v);
+}
+
+__attribute__((target("avx2")))
+static void relaxRowAvx2(const double *row, double du, int u, double *dist, int *parent, int n) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d inf = _mm256_set1_pd(std::numeric_limits<double>::max());
+    const __m256d duv = _mm256_set1_pd(du);
+    const __m128i uv = _mm_set1_epi32(u);
+    const __m256i evenLanes = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    int v = 0;
+    for (; v + 4 <= n; v += 4) {
+        __m256d w = _mm256_loadu_pd(row + v);
+        __m256d d = _mm256_loadu_pd(dist + v);
+        __m256d candidate = _mm256_blendv_pd(inf, _mm256_add_pd(duv, w), _mm256_cmp_pd(w, zero, _CMP_NEQ_OQ));
+        __m256d better = _mm256_cmp_pd(candidate, d, _CMP_LT_OQ);
+        _mm256_storeu_pd(dist + v, _mm256_blendv_pd(d, candidate, better));
+
+        // Narrow the four 64-bit lane masks to four 32-bit masks for the int parents.
+        __m128i mask = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(better), evenLanes));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(parent + v));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(parent + v), _mm_blendv_epi8(p, uv, mask));
+    }
+    relaxRowScalar(row + v, du, u, dist + v, parent + v, n - v);
+}
+
+__attribute__((target("avx2")))
+static void minPlusRowAvx2(const float *rowK, float dik, float *rowI, int n) {
+    const __m256 dikv = _mm256_set1_ps(dik);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256 via = _mm256_add_ps(dikv, _mm256_loadu_ps(rowK + j));
+        _mm256_storeu_ps(rowI + j, _mm256_min_ps(_mm256_loadu_ps(rowI + j), via));
+    }
+    minPlusRowScalar(rowK + j, dik, rowI + j, n - j);
+}
+
+__attribute__((target("avx2")))
+static void minPlusRowAvx2(const double *rowK, double dik, double *rowI, int n) {
+    const __m256d dikv = _mm256_set1_pd(dik);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d via = _mm256_add_pd(dikv, _mm256_loadu_pd(rowK + j));
+        _mm256_storeu_pd(rowI + j, _mm256_min_pd(_mm256_loadu_pd(rowI + j), via));
+    }
+    minPlusRowScalar(rowK + j, dik, rowI + j, n - j);
+}
+
+/**
+ * 1/sqrt(r2) for four doubles: the 12-bit float estimate refined by two Newton
+ * steps y' = y * (1.5 - 0.5 * r2 * y^2).
+ */
+__attribute__((target("avx2")))
+static inline __m256d rsqrtNewtonAvx2(__m256d r2) {
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d threeHalves = _mm256_set1_pd(1.5);
+    __m256d y = _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(r2)));
+    __m256d halfR2 = _mm256_mul_pd(half, r2);
+    y = _mm256_mul_pd(y, _mm256_sub_pd(threeHalves, _mm256_mul_pd(halfR2, _mm256_mul_pd(y, y))));
+    y = _mm256_mul_pd(y, _mm256_sub_pd(threeHalves, _mm256_mul_pd(halfR2, _mm256_mul_pd(y, y))));
+    return y;
+}
+
+__attribute__((target("avx2")))
+static double horizontalSumAvx2(__m256d v) {
+    __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+__attribute__((target("avx2")))
+static void centralGravityAvx2(const double *x, const double *y, const double *z,
+                               double *ax, double *ay, double *az, int n,
+                               double cx, double cy, double cz, double gm, double minDistSq) {
+    const __m256d cxv = _mm256_set1_pd(cx), cyv = _mm256_set1_pd(cy), czv = _mm256_set1_pd(cz);
+    const __m256d gmv = _mm256_set1_pd(gm), minD2 = _mm256_set1_pd(minDistSq);
+    const __m256d zero = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d dx = _mm256_sub_pd(cxv, _mm256_loadu_pd(x + i));
+        __m256d dy = _mm256_sub_pd(cyv, _mm256_loadu_pd(y + i));
+        __m256d dz = _mm256_sub_pd(czv, _mm256_loadu_pd(z + i));
+        __m256d d2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+        d2 = _mm256_max_pd(d2, minD2);
+        __m256d inv = rsqrtNewtonAvx2(d2);
+        __m256d s = _mm256_mul_pd(gmv, _mm256_mul_pd(inv, _mm256_mul_pd(inv, inv)));
+        s = _mm256_and_pd(s, _mm256_cmp_pd(d2, zero, _CMP_GT_OQ));
+        _mm256_storeu_pd(ax + i, _mm256_add_pd(_mm256_loadu_pd(ax + i), _mm256_mul_pd(s, dx)));
+        _mm256_storeu_pd(ay + i, _mm256_add_pd(_mm256_loadu_pd(ay + i), _mm256_mul_pd(s, dy)));
+        _mm256_storeu_pd(az + i, _mm256_add_pd(_mm256_loadu_pd(az + i), _mm256_mul_pd(s, dz)));
+    }
+    centralGravityScalar(x + i, y + i, z + i, ax + i, ay + i, az + i, n - i, cx, cy, cz, gm, minDistSq);
+}
+
+__attribute__((target("avx2")))
+static void gravitySumAvx2(double px, double py, double pz,
+                           const double *qx, const double *qy, const double *qz, const double *qm,
+                           int n, double epsSq, double *out) {
+    const __m256d pxv = _mm256_set1_pd(px), pyv = _mm256_set1_pd(py), pzv = _mm256_set1_pd(pz);
+    const __m256d eps = _mm256_set1_pd(epsSq);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d sx = zero, sy = zero, sz = zero;
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(qx + j), pxv);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(qy + j), pyv);
+        __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(qz + j), pzv);
+        __m256d r2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+                                   _mm256_add_pd(_mm256_mul_pd(dz, dz), eps));
+        __m256d inv = rsqrtNewtonAvx2(r2);
+        __m256d s = _mm256_mul_pd(_mm256_loadu_pd(qm + j), _mm256_mul_pd(inv, _mm256_mul_pd(inv, inv)));
+        s = _mm256_and_pd(s, _mm256_cmp_pd(r2, zero, _CMP_GT_OQ)); // The point itself: inf * 0 -> masked to 0.
+        sx = _mm256_add_pd(sx, _mm256_mul_pd(s, dx));
+        sy = _mm256_add_pd(sy, _mm256_mul_pd(s, dy));
+        sz = _mm256_add_pd(sz, _mm256_mul_pd(s, dz));
+    }
+    out[0] += horizontalSumAvx2(sx);
+    out[1] += horizontalSumAvx2(sy);
+    out[2] += horizontalSumAvx2(sz);
+    gravitySumScalar(px, py, pz, qx + j, qy + j, qz + j, qm + j, n - j, epsSq, out);
+}
+
+/**
+ * base[index] for four doubles. The unmasked _mm256_i32gather_pd starts from an undefined
+ * vector, which GCC reports as -Wmaybe-uninitialized; gathering all lanes into zeros does not.
+ */
+__attribute__((target("avx2")))
+static inline __m256d gatherAvx2(const double *base, __m128i index) {
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, index, all, 8);
+}
+
+__attribute__((target("avx2")))
+static void springForcesAvx2(const double *x, const double *y, const double *z,
+                             const int *a, const int *b, const double *rest, const double *k,
+                             double *fx, double *fy, double *fz, int m) {
+    const __m256d minD2 = _mm256_set1_pd(1e-6);
+    int s = 0;
+    for (; s + 4 <= m; s += 4) {
+        __m128i ia = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + s));
+        __m128i ib = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + s));
+        __m256d dx = _mm256_sub_pd(gatherAvx2(x, ib), gatherAvx2(x, ia));
+        __m256d dy = _mm256_sub_pd(gatherAvx2(y, ib), gatherAvx2(y, ia));
+        __m256d dz = _mm256_sub_pd(gatherAvx2(z, ib), gatherAvx2(z, ia));
+        __m256d d2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+        __m256d inv = rsqrtNewtonAvx2(d2);
+        __m256d d = _mm256_mul_pd(d2, inv);
+        __m256d f = _mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(k + s), _mm256_sub_pd(d, _mm256_loadu_pd(rest + s))), inv);
+        f = _mm256_and_pd(f, _mm256_cmp_pd(d2, minD2, _CMP_GE_OQ));
+        _mm256_storeu_pd(fx + s, _mm256_mul_pd(f, dx));
+        _mm256_storeu_pd(fy + s, _mm256_mul_pd(f, dy));
+        _mm256_storeu_pd(fz + s, _mm256_mul_pd(f, dz));
+    }
+    springForcesScalar(x, y, z, a + s, b + s, rest + s, k + s, fx + s, fy + s, fz + s, m - s);
+}
+
+__attribute__((target("avx2")))
+static void sinCosTurnsAvx2(const double *turns, double *s, double *c, int n) {
+    constexpr int nearest = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+    const __m256d quarter = _mm256_set1_pd(0.25), four = _mm256_set1_pd(4.0), twoPi = _mm256_set1_pd(2.0 * M_PI);
+    const __m256d one = _mm256_set1_pd(1.0), two = _mm256_set1_pd(2.0), zero = _mm256_setzero_pd();
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d t = _mm256_loadu_pd(turns + i);
+        t = _mm256_sub_pd(t, _mm256_round_pd(t, nearest));
+        __m256d q = _mm256_round_pd(_mm256_mul_pd(four, t), nearest);
+        __m256d r = _mm256_mul_pd(_mm256_sub_pd(t, _mm256_mul_pd(quarter, q)), twoPi);
+        __m256d r2 = _mm256_mul_pd(r, r);
+        __m256d ps = _mm256_set1_pd(SIN_POLY[0]), pc = _mm256_set1_pd(COS_POLY[0]);
+        for (int k = 1; k < 7; ++k) ps = _mm256_add_pd(_mm256_mul_pd(ps, r2), _mm256_set1_pd(SIN_POLY[k]));
+        for (int k = 1; k < 8; ++k) pc = _mm256_add_pd(_mm256_mul_pd(pc, r2), _mm256_set1_pd(COS_POLY[k]));
+        __m256d sr = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(r, r2), ps));
+        __m256d cr = _mm256_add_pd(one, _mm256_mul_pd(r2, pc));
+
+        __m256d absQ = _mm256_andnot_pd(signBit, q);
+        __m256d swap = _mm256_cmp_pd(absQ, one, _CMP_EQ_OQ);
+        __m256d half = _mm256_cmp_pd(absQ, two, _CMP_EQ_OQ);
+        __m256d sinNeg = _mm256_or_pd(_mm256_cmp_pd(q, zero, _CMP_LT_OQ), _mm256_cmp_pd(q, two, _CMP_EQ_OQ));
+        __m256d cosNeg = _mm256_or_pd(_mm256_cmp_pd(q, one, _CMP_EQ_OQ), half);
+        __m256d sa = _mm256_blendv_pd(sr, cr, swap), ca = _mm256_blendv_pd(cr, sr, swap);
+        _mm256_storeu_pd(s + i, _mm256_xor_pd(sa, _mm256_and_pd(sinNeg, signBit)));
+        _mm256_storeu_pd(c + i, _mm256_xor_pd(ca, _mm256_and_pd(cosNeg, signBit)));
+    }
+    sinCosTurnsScalar(turns + i, s + i, c + i, n - i);
+}
+
+#endif // SIMD_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// Runtime dispatch
+// ---------------------------------------------------------------------------
+
+static std::atomic<SimdKernels::Level> &activeLevelSlot() {
+    static std::atomic<SimdKernels::Level> level{SimdKernels::detectedLevel()};
+    return level;
+}
+
+SimdKernels::Level SimdKernels::detectedLevel() {
+#ifdef SIMD_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return Level::SSE41;
+#endif
+    return Level::Scalar;
+}
+
+SimdKernels::Level SimdKernels::activeLevel() {
+    return activeLevelSlot().load(std::memory_order_relaxed);
+}
+
+SimdKernels::Level SimdKernels::setLevel(Level level) {
+    Level selected = std::min(level, detectedLevel());
+    activeLevelSlot().store(selected, std::memory_order_relaxed);
+    return selected;
+}
+
+const char *SimdKernels::levelName(Level level) {
+    switch (level) {
+        case Level::AVX2: return "avx2";
+        case Level::SSE41: return "sse4.1";
+        default: return "scalar";
+    }
+}
+
+void SimdKernels::relaxRow(const float *row, float du, int u, float *dist, int *parent, int n) {
+#ifdef SIMD_KERNELS_X86
+    switch (activeLevel()) {
+        case Level::AVX2: return relaxRowAvx2(row, du, u, dist, parent, n);
+        case Level::SSE41: return relaxRowSse41(row, du, u, dist, parent, n);
+        default: break;
+    }
+#endif
+    relaxRowScalar(row, du, u, dist, parent, n);
+}
+
+void SimdKernels::relaxRow(const double *row, double du, int u, double *dist, int *parent, int n) {
+#ifdef SIMD_KERNELS_X86
+    switch (activeLevel()) {
+        case Level::AVX2: return relaxRowAvx2(row, du, u, dist, parent, n);
+        case Level::SSE41: return relaxRowSse41(row, du, u, dist, parent, n);
+        default: break;
+    }
+#endif
+    relaxRowScalar(row, du, u, dist, parent, n);
+}
+
+void SimdKernels::minPlusRow(const float *rowK, float dik, float *rowI, int n) {
+#ifdef SIMD_KERNELS_X86
+    switch (activeLevel()) {
+        case Level::AVX2: return minPlusRowAvx2(rowK, dik, rowI, n);
+        case Level::SSE41: return minPlusRowSse41(rowK, dik, rowI, n);
+        default: break;
+    }
+#endif
+    minPlusRowScalar(rowK, dik, rowI, n);
+}
+
+void SimdKernels::minPlusRow(const double *rowK, double dik, double *rowI, int n) {
+#ifdef SIMD_KERNELS_X86
+    switch (activeLevel()) {
+        case Level::AVX2: return minPlusRowAvx2(rowK, dik, rowI, n);
+        case Level::SSE41: return minPlusRowSse41(rowK, dik, rowI, n);
+        default: break;
+    }
+#endif
+    minPlusRowScalar(rowK, dik, rowI, n);
+}
+
+void SimdKernels::centralGravity(const double *x, const double *y, const double *z,
+                                 double *ax, double *ay, double *az, int n,
+                                 double cx, double cy, double cz, double gm, double minDistSq) {
+#ifdef SIMD_KERNELS_X86
+    if (activeLevel() == Level::AVX2) return centralGravityAvx2(x, y, z, ax, ay, az, n, cx, cy, cz, gm, minDistSq);
+#endif
+    centralGravityScalar(x, y, z, ax, ay, az, n, cx, cy, cz, gm, minDistSq);
+}
+
+void SimdKernels::gravitySum(double px, double py, double pz,
+                             const double *qx, const double *qy, const double *qz, const double *qm,
+                             int n, double epsSq, double *out) {
+#ifdef SIMD_KERNELS_X86
+    if (activeLevel() == Level::AVX2) return gravitySumAvx2(px, py, pz, qx, qy, qz, qm, n, epsSq, out);
+#endif
+    gravitySumScalar(px, py, pz, qx, qy, qz, qm, n, epsSq, out);
+}
+
+void SimdKernels::springForces(const double *x, const double *y, const double *z,
+                               const int *a, const int *b, const double *rest, const double *k,
+                               double *fx, double *fy, double *fz, int m) {
+#ifdef SIMD_KERNELS_X86
+    if (activeLevel() == Level::AVX2) return springForcesAvx2(x, y, z, a, b, rest, k, fx, fy, fz, m);
+#endif
+    springForcesScalar(x, y, z, a, b, rest, k, fx, fy, fz, m);
+}
+
+void SimdKernels::sinCosTurns(const double *turns, double *s, double *c, int n) {
+#ifdef SIMD_KERNELS_X86
+    if (activeLevel() == Level::AVX2) return sinCosTurnsAvx2(turns, s, c, n);
+#endif
+    sinCosTurnsScalar(turns, s, c, n);
+}
\ No newline at end of file
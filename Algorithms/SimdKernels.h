@@ -0,0 +1,147 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+/**
+ * @file SimdKernels.h
+ * @brief Vectorized inner loops (AVX2 / SSE4.1 / scalar) selected at runtime.
+ */
+
+/**
+ * @class SimdKernels
+ * @brief Collection of hot inner loops with one implementation per instruction set.
+ *
+ * The best level supported by the CPU is detected once at startup; every call
+ * dispatches on it, so one binary runs everywhere and still uses AVX2 where
+ * available. The scalar versions are the reference implementations and are
+ * what non-x86 builds use.
+ *
+ * The graph kernels work on contiguous rows and treat a weight of 0 as "no edge",
+ * matching GraphMatrix::adjacencyMatrix. Unreachable distances are
+ * std::numeric_limits<T>::max().
+ *
+ * The physics kernels work on structure-of-arrays positions (see ParticleState).
+ * Their AVX2 versions compute 1/sqrt(r^2) with the hardware reciprocal square root
+ * estimate refined by two Newton steps (about 1e-13 relative error) instead of a
+ * sqrt and a division; only AVX2 has vector versions, SSE4.1 uses the scalar loops.
+ * sinCosTurns() runs the same polynomial at every level, so levels agree to rounding.
+ */
+class SimdKernels {
+public:
+    /**
+     * @brief Instruction set used by the kernels.
+     */
+    enum class Level {
+        Scalar, ///< Portable C++ loops.
+        SSE41, ///< 128-bit SSE4.1 (blendv).
+        AVX2 ///< 256-bit AVX2.
+    };
+
+    /** @brief Returns the best level supported by the running CPU. */
+    static Level detectedLevel();
+
+    /** @brief Returns the level currently used by the kernels. */
+    static Level activeLevel();
+
+    /**
+     * @brief Forces a level (e.g., to compare implementations in tests or benchmarks).
+     * @param level The requested level; clamped to detectedLevel().
+     * @return The level actually selected.
+     */
+    static Level setLevel(Level level);
+
+    /** @brief Returns a printable name ("scalar", "sse4.1", "avx2"). */
+    static const char *levelName(Level level);
+
+    /**
+     * @brief Dijkstra row relaxation: dist[v] = min(dist[v], du + row[v]) for every edge in the row.
+     * @param row Matrix row of the settled vertex (0 = no edge).
+     * @param du Distance of the settled vertex.
+     * @param u Index of the settled vertex, written to parent[v] wherever dist[v] improved.
+     * @param dist Tentative distances (updated in place).
+     * @param parent Parent indices (updated in place).
+     * @param n Row length.
+     */
+    static void relaxRow(const float *row, float du, int u, float *dist, int *parent, int n);
+
+    /** @copydoc relaxRow(const float*, float, int, float*, int*, int) */
+    static void relaxRow(const double *row, double du, int u, double *dist, int *parent, int n);
+
+    /**
+     * @brief Floyd–Warshall min-plus row update: rowI[j] = min(rowI[j], dik + rowK[j]).
+     * @param rowK Distances from the pivot vertex k.
+     * @param dik Distance from i to k (must not be the unreachable marker).
+     * @param rowI Distances from i (updated in place).
+     * @param n Row length.
+     */
+    static void minPlusRow(const float *rowK, float dik, float *rowI, int n);
+
+    /** @copydoc minPlusRow(const float*, float, float*, int) */
+    static void minPlusRow(const double *rowK, double dik, double *rowI, int n);
+
+    /**
+     * @brief Point-mass attraction of every body toward one center, accumulated into a.
+     *
+     * a_i += gm * (c - p_i) / max(|c - p_i|^2, minDistSq)^(3/2)
+     *
+     * @param x, y, z Body positions.
+     * @param ax, ay, az Accelerations (accumulated).
+     * @param n Number of bodies.
+     * @param cx, cy, cz The attracting center.
+     * @param gm Gravitational constant times the central mass.
+     * @param minDistSq Lower bound for the squared distance (keeps the force finite).
+     */
+    static void centralGravity(const double *x, const double *y, const double *z,
+                               double *ax, double *ay, double *az, int n,
+                               double cx, double cy, double cz, double gm, double minDistSq);
+
+    /**
+     * @brief Sums the softened attraction of a list of sources on one point.
+     *
+     * out += sum_j m_j * (q_j - p) / (|q_j - p|^2 + epsSq)^(3/2); sources at r^2 == 0
+     * (the point itself) contribute nothing.
+     *
+     * @param px, py, pz The attracted point.
+     * @param qx, qy, qz, qm Source positions and masses.
+     * @param n Number of sources.
+     * @param epsSq Squared softening length.
+     * @param out Three accumulators (x, y, z), updated in place.
+     */
+    static void gravitySum(double px, double py, double pz,
+                           const double *qx, const double *qy, const double *qz, const double *qm,
+                           int n, double epsSq, double *out);
+
+    /**
+     * @brief Hooke's law forces of m springs between indexed bodies.
+     *
+     * For spring s between bodies a[s] and b[s], f_s = k_s * (|d| - rest_s) * d / |d| with
+     * d = p_b - p_a; this is the force on a[s] (b[s] receives -f_s). Springs shorter than
+     * 0.001 produce no force.
+     *
+     * @param x, y, z Body positions.
+     * @param a, b Endpoint indices of each spring.
+     * @param rest Rest length of each spring.
+     * @param k Stiffness of each spring.
+     * @param fx, fy, fz Output force on a[s] (overwritten).
+     * @param m Number of springs.
+     */
+    static void springForces(const double *x, const double *y, const double *z,
+                             const int *a, const int *b, const double *rest, const double *k,
+                             double *fx, double *fy, double *fz, int m);
+
+    /**
+     * @brief Sine and cosine of whole arrays of angles given in turns (1 turn = 2 pi).
+     *
+     * s_i = sin(2 pi t_i), c_i = cos(2 pi t_i). The whole turns are dropped exactly, the
+     * remainder is reduced to an octant and evaluated with fixed-degree polynomials
+     * (about 1e-15 absolute error), so every element costs the same and the loop has no
+     * branches. Angles far from zero lose the precision their whole turns take up, as
+     * with any double.
+     *
+     * @param turns Angles in turns.
+     * @param s, c Sines and cosines (overwritten).
+     * @param n Number of angles.
+     */
+    static void sinCosTurns(const double *turns, double *s, double *c, int n);
+};
+
+#endif // SIMDKERNELS_H
@@ -0,0 +1,187 @@
+#include "SpatialHashGrid.h"
+#include <queue>
+
+SpatialHashGrid::SpatialHashGrid(double cellSize) {
+    setCellSize(cellSize);
+}
+
+void SpatialHashGrid::setCellSize(double cellSize) {
+    cellSize_ = cellSize > 0 ? cellSize : 1.0;
+    inverseCellSize_ = 1.0 / cellSize_;
+}
+
+void SpatialHashGrid::clear() {
+    bucketStart_.clear();
+    index_.clear();
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    cellX_.clear();
+    cellY_.clear();
+    cellZ_.clear();
+    mask_ = 0;
+    for (int a = 0; a < 3; ++a) {
+        minCell_[a] = 0;
+        maxCell_[a] = -1;
+    }
+}
+
+void SpatialHashGrid::build(const double *x, const double *y, const double *z, int count) {
+    clear();
+    if (count <= 0) return;
+
+    std::uint32_t buckets = 1;
+    while (buckets < 2u * static_cast<std::uint32_t>(count)) buckets <<= 1;
+    mask_ = buckets - 1;
+
+    // Counting sort by bucket: count, prefix sum, scatter.
+    std::vector<int> cells(3 * static_cast<size_t>(count));
+    std::vector<std::uint32_t> bucket(count);
+    bucketStart_.assign(buckets + 1, 0);
+    for (int a = 0; a < 3; ++a) {
+        minCell_[a] = std::numeric_limits<int>::max();
+        maxCell_[a] = std::numeric_limits<int>::min();
+    }
+    for (int i = 0; i < count; ++i) {
+        int *c = &cells[3 * static_cast<size_t>(i)];
+        c[0] = cellOf(x[i]);
+        c[1] = cellOf(y[i]);
+        c[2] = z ? cellOf(z[i]) : 0;
+        for (int a = 0; a < 3; ++a) {
+            minCell_[a] = std::min(minCell_[a], c[a]);
+            maxCell_[a] = std::max(maxCell_[a], c[a]);
+        }
+        bucket[i] = bucketOf(c[0], c[1], c[2]);
+        ++bucketStart_[bucket[i] + 1];
+    }
+    for (std::uint32_t b = 0; b < buckets; ++b) bucketStart_[b + 1] += bucketStart_[b];
+
+    index_.resize(count);
+    x_.resize(count);
+    y_.resize(count);
+    z_.resize(count);
+    cellX_.resize(count);
+    cellY_.resize(count);
+    cellZ_.resize(count);
+    std::vector<int> next(bucketStart_.begin(), bucketStart_.end() - 1);
+    for (int i = 0; i < count; ++i) {
+        const int k = next[bucket[i]]++;
+        index_[k] = i;
+        x_[k] = x[i];
+        y_[k] = y[i];
+        z_[k] = z ? z[i] : 0.0;
+        cellX_[k] = cells[3 * static_cast<size_t>(i)];
+        cellY_[k] = cells[3 * static_cast<size_t>(i) + 1];
+        cellZ_[k] = cells[3 * static_cast<size_t>(i) + 2];
+    }
+}
+
+std::vector<int> SpatialHashGrid::queryRadius(double x, double y, double z, double radius) const {
+    std::vector<int> result;
+    forEachInRadius(x, y, z, radius, [&](int i, double) { result.push_back(i); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template<typename Visitor, typename Done>
+void SpatialHashGrid::searchRings(double x, double y, double z, Visitor &&visit, Done &&done) const {
+    if (index_.empty()) return;
+    const int center[3] = {cellOf(x), cellOf(y), cellOf(z)};
+
+    // Rings closer than the bounding box of the occupied cells are empty.
+    long long first = 0, last = 0;
+    for (int a = 0; a < 3; ++a) {
+        first = std::max(first, std::max<long long>(minCell_[a] - center[a], center[a] - maxCell_[a]));
+        last = std::max(last, std::max<long long>(center[a] - minCell_[a], maxCell_[a] - center[a]));
+    }
+
+    long long visitedCells = 0;
+    for (long long r = first; r <= last; ++r) {
+        long long lo[3], hi[3];
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::max<long long>(center[a] - r, minCell_[a]);
+            hi[a] = std::min<long long>(center[a] + r, maxCell_[a]);
+        }
+        visitedCells += (hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) * (hi[2] - lo[2] + 1);
+        if (visitedCells > static_cast<long long>(index_.size())) {
+            // Sparse outliers make the rings expensive; scan the points the inner rings did not reach.
+            for (int k = 0; k < size(); ++k) {
+                const long long distance = std::max({std::abs(cellX_[k] - static_cast<long long>(center[0])),
+                                                     std::abs(cellY_[k] - static_cast<long long>(center[1])),
+                                                     std::abs(cellZ_[k] - static_cast<long long>(center[2]))});
+                if (distance >= r) visit(k);
+            }
+            return;
+        }
+
+        for (long long cx = lo[0]; cx <= hi[0]; ++cx) {
+            for (long long cy = lo[1]; cy <= hi[1]; ++cy) {
+                const bool onShell = std::abs(cx - center[0]) == r || std::abs(cy - center[1]) == r;
+                for (long long cz = lo[2]; cz <= hi[2]; ++cz) {
+                    // Only the shell of the cube is new; jump over its inside.
+                    if (!onShell && std::abs(cz - center[2]) != r) {
+                        cz = std::max(cz, center[2] + r - 1);
+                        continue;
+                    }
+                    forEachInCell(static_cast<int>(cx), static_cast<int>(cy), static_cast<int>(cz), visit);
+                }
+            }
+        }
+        // Every point outside the cube lies at least r whole cells away from the query.
+        if (done(static_cast<double>(r) * cellSize_)) return;
+    }
+}
+
+int SpatialHashGrid::nearest(double x, double y, double z, double maxRadius) const {
+    int best = -1;
+    double bestD2 = maxRadius * maxRadius;
+    searchRings(x, y, z, [&](int k) {
+        const double dx = x_[k] - x, dy = y_[k] - y, dz = z_[k] - z;
+        const double d2 = dx * dx + dy * dy + dz * dz;
+        if (d2 < bestD2 || (d2 == bestD2 && (best < 0 || index_[k] < best))) {
+            bestD2 = d2;
+            best = index_[k];
+        }
+    }, [&](double ringDistance) {
+        return ringDistance * ringDistance > bestD2;
+    });
+    return best;
+}
+
+std::vector<int> SpatialHashGrid::kNearest(double x, double y, double z, int k) const {
+    std::vector<int> result;
+    if (k <= 0) return result;
+
+    // Max-heap of the k best (distance, index) pairs seen so far.
+    std::priority_queue<std::pair<double, int>> best;
+    searchRings(x, y, z, [&](int s) {
+        const double dx = x_[s] - x, dy = y_[s] - y, dz = z_[s] - z;
+        const std::pair<double, int> candidate(dx * dx + dy * dy + dz * dz, index_[s]);
+        if (static_cast<int>(best.size()) < k) best.push(candidate);
+        else if (candidate < best.top()) {
+            best.pop();
+            best.push(candidate);
+        }
+    }, [&](double ringDistance) {
+        return static_cast<int>(best.size()) == k && ringDistance * ringDistance > best.top().first;
+    });
+
+    result.resize(best.size());
+    for (int i = static_cast<int>(best.size()) - 1; i >= 0; --i) {
+        result[i] = best.top().second;
+        best.pop();
+    }
+    return result;
+}
+
+std::vector<std::pair<int, int>> SpatialHashGrid::pairsWithin(double radius) const {
+    std::vector<std::pair<int, int>> pairs;
+    for (int k = 0; k < size(); ++k) {
+        const int i = index_[k];
+        forEachInRadius(x_[k], y_[k], z_[k], radius, [&](int j, double) {
+            if (i < j) pairs.emplace_back(i, j);
+        });
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
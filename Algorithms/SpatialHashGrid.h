@@ -0,0 +1,174 @@
+#ifndef SPATIALHASHGRID_H
+#define SPATIALHASHGRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file SpatialHashGrid.h
+ * @brief Uniform hashed grid over point positions for neighbour queries.
+ */
+
+/**
+ * @class SpatialHashGrid
+ * @brief Buckets points by the cubic cell they fall in and answers radius, nearest and k-nearest queries.
+ *
+ * build() is O(N): each point's cell is hashed into a table of about 2N buckets and the
+ * points are counting-sorted by bucket, so the points of one cell lie next to each other
+ * in memory. Only occupied cells cost memory, so the grid works for sparse galaxies of
+ * any extent. A query only looks at the cells its search sphere overlaps; different cells
+ * that share a bucket are told apart by their stored cell coordinates.
+ *
+ * With a cell size near the typical query radius (e.g. the picking radius), a query touches
+ * a constant number of cells. 2D data simply passes no z coordinates.
+ *
+ * Indices returned by the queries are positions in the arrays given to build().
+ *
+ * @code
+ * SpatialHashGrid grid(20.0);
+ * grid.build(xs.data(), ys.data(), nullptr, n);
+ * int hit = grid.nearest(mouseX, mouseY, 0.0, 10.0);
+ * @endcode
+ */
+class SpatialHashGrid {
+public:
+    /**
+     * @brief Creates an empty grid.
+     * @param cellSize Edge length of a cell; non-positive values are replaced by 1.
+     */
+    explicit SpatialHashGrid(double cellSize = 1.0);
+
+    /** @brief Sets the cell size used by the next build(). */
+    void setCellSize(double cellSize);
+
+    /** @brief Returns the cell size. */
+    double cellSize() const { return cellSize_; }
+
+    /**
+     * @brief Replaces the contents with `count` points.
+     * @param x X coordinates.
+     * @param y Y coordinates.
+     * @param z Z coordinates, or nullptr for points in the z = 0 plane.
+     * @param count Number of points.
+     */
+    void build(const double *x, const double *y, const double *z, int count);
+
+    /** @brief Removes all points. */
+    void clear();
+
+    /** @brief Returns the number of points. */
+    int size() const { return static_cast<int>(index_.size()); }
+
+    /**
+     * @brief Calls visit(index, distanceSquared) for every point within `radius` of (x, y, z).
+     * * The order of the calls is unspecified.
+     */
+    template<typename Visitor>
+    void forEachInRadius(double x, double y, double z, double radius, Visitor &&visit) const;
+
+    /**
+     * @brief Returns the indices of all points within `radius` of (x, y, z), in ascending order.
+     */
+    std::vector<int> queryRadius(double x, double y, double z, double radius) const;
+
+    /**
+     * @brief Returns the point closest to (x, y, z), or -1 if none lies within maxRadius.
+     * * Ties are resolved towards the smaller index.
+     */
+    int nearest(double x, double y, double z,
+                double maxRadius = std::numeric_limits<double>::infinity()) const;
+
+    /**
+     * @brief Returns up to k points closest to (x, y, z), nearest first (ties by index).
+     */
+    std::vector<int> kNearest(double x, double y, double z, int k) const;
+
+    /**
+     * @brief Returns every pair (i, j), i < j, of points at most `radius` apart, sorted.
+     * * Useful to connect objects that came close to each other.
+     */
+    std::vector<std::pair<int, int>> pairsWithin(double radius) const;
+
+private:
+    double cellSize_ = 1.0;
+    double inverseCellSize_ = 1.0;
+    std::uint32_t mask_ = 0;                 ///< Bucket count - 1 (a power of two).
+    std::vector<int> bucketStart_;           ///< Points of bucket b are [bucketStart_[b], bucketStart_[b + 1]).
+    std::vector<int> index_;                 ///< Original index of every point, in bucket order.
+    std::vector<double> x_, y_, z_;          ///< Positions in bucket order.
+    std::vector<int> cellX_, cellY_, cellZ_; ///< Cell coordinates in bucket order.
+    int minCell_[3] = {0, 0, 0};             ///< Bounding box of the occupied cells.
+    int maxCell_[3] = {-1, -1, -1};
+
+    /** @brief Returns the cell coordinate of a position along one axis. */
+    int cellOf(double v) const;
+
+    /** @brief Returns the bucket of a cell. */
+    std::uint32_t bucketOf(int cx, int cy, int cz) const;
+
+    /** @brief Calls visit(k) for every sorted point k that lies in cell (cx, cy, cz). */
+    template<typename Visitor>
+    void forEachInCell(int cx, int cy, int cz, Visitor &&visit) const;
+
+    /**
+     * @brief Visits the occupied cells ring by ring (Chebyshev distance r from the query cell).
+     * * After each ring, done(ringDistance) is asked whether to stop, where ringDistance is a
+     * lower bound on the distance of every point not visited yet. Falls back to visiting all
+     * points when the rings would cover more cells than there are points.
+     */
+    template<typename Visitor, typename Done>
+    void searchRings(double x, double y, double z, Visitor &&visit, Done &&done) const;
+};
+
+inline int SpatialHashGrid::cellOf(double v) const {
+    const double c = std::floor(v * inverseCellSize_);
+    const double limit = 1 << 30;
+    return static_cast<int>(std::clamp(c, -limit, limit));
+}
+
+inline std::uint32_t SpatialHashGrid::bucketOf(int cx, int cy, int cz) const {
+    const std::uint32_t h = static_cast<std::uint32_t>(cx) * 73856093u ^
+                            static_cast<std::uint32_t>(cy) * 19349663u ^
+                            static_cast<std::uint32_t>(cz) * 83492791u;
+    return h & mask_;
+}
+
+template<typename Visitor>
+void SpatialHashGrid::forEachInCell(int cx, int cy, int cz, Visitor &&visit) const {
+    const std::uint32_t b = bucketOf(cx, cy, cz);
+    for (int k = bucketStart_[b]; k < bucketStart_[b + 1]; ++k)
+        if (cellX_[k] == cx && cellY_[k] == cy && cellZ_[k] == cz) visit(k);
+}
+
+template<typename Visitor>
+void SpatialHashGrid::forEachInRadius(double x, double y, double z, double radius, Visitor &&visit) const {
+    if (index_.empty() || !(radius >= 0)) return;
+    const double r2 = radius * radius;
+    auto test = [&](int k) {
+        const double dx = x_[k] - x, dy = y_[k] - y, dz = z_[k] - z;
+        const double d2 = dx * dx + dy * dy + dz * dz;
+        if (d2 <= r2) visit(index_[k], d2);
+    };
+
+    const int lo[3] = {std::max(cellOf(x - radius), minCell_[0]), std::max(cellOf(y - radius), minCell_[1]),
+                       std::max(cellOf(z - radius), minCell_[2])};
+    const int hi[3] = {std::min(cellOf(x + radius), maxCell_[0]), std::min(cellOf(y + radius), maxCell_[1]),
+                       std::min(cellOf(z + radius), maxCell_[2])};
+    if (lo[0] > hi[0] || lo[1] > hi[1] || lo[2] > hi[2]) return;
+
+    // A huge sphere is cheaper to answer by scanning the points once.
+    const double cells = double(hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) * (hi[2] - lo[2] + 1);
+    if (cells > static_cast<double>(index_.size())) {
+        for (int k = 0; k < size(); ++k) test(k);
+        return;
+    }
+    for (int cx = lo[0]; cx <= hi[0]; ++cx)
+        for (int cy = lo[1]; cy <= hi[1]; ++cy)
+            for (int cz = lo[2]; cz <= hi[2]; ++cz) forEachInCell(cx, cy, cz, test);
+}
+
+#endif // SPATIALHASHGRID_H
@@ -0,0 +1,75 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+/**
+ * @file TripleBuffer.h
+ * @brief Lock-free hand-off of the latest value from one producer thread to one consumer thread.
+ */
+
+/**
+ * @class TripleBuffer
+ * @brief Single-producer, single-consumer triple buffer.
+ *
+ * The producer fills writeBuffer() and calls publish(); the consumer calls fetch()
+ * and reads readBuffer(). Three slots rotate between the two threads: the producer
+ * owns the back slot, the consumer owns the front slot, and the middle slot is
+ * swapped atomically. Neither side ever waits for the other, and the consumer
+ * always sees the newest complete value; intermediate values it did not fetch in
+ * time are simply skipped.
+ *
+ * Slots are reused, so a producer that keeps writing into the same containers
+ * stops allocating once every slot has reached its final size.
+ *
+ * @tparam T The value type (default-constructible).
+ *
+ * @code
+ * TripleBuffer<std::vector<double>> buffer;
+ * // Producer thread:
+ * buffer.writeBuffer() = computePositions();
+ * buffer.publish();
+ * // Consumer thread:
+ * if (buffer.fetch()) draw(buffer.readBuffer());
+ * @endcode
+ */
+template<typename T>
+class TripleBuffer {
+public:
+    /** @brief Producer: returns the slot to fill before the next publish(). */
+    T &writeBuffer() { return slots_[back_]; }
+
+    /**
+     * @brief Producer: makes the contents of writeBuffer() the newest value.
+     * Afterwards writeBuffer() refers to a different slot holding an older value.
+     */
+    void publish() {
+        int previous = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+        back_ = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Consumer: takes the newest published value, if there is one.
+     * @return True if readBuffer() now refers to a value that was not fetched before.
+     */
+    bool fetch() {
+        if (!(middle_.load(std::memory_order_acquire) & FRESH)) return false;
+        int previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & INDEX_MASK;
+        return true;
+    }
+
+    /** @brief Consumer: returns the value taken by the last successful fetch(). */
+    const T &readBuffer() const { return slots_[front_]; }
+
+private:
+    static constexpr int INDEX_MASK = 3; ///< Bits holding a slot index.
+    static constexpr int FRESH = 4;      ///< Set in middle_ while it holds an unfetched value.
+
+    T slots_[3];
+    alignas(64) int back_ = 0;              ///< Producer's slot.
+    alignas(64) std::atomic<int> middle_{1}; ///< Shared slot index plus the FRESH flag.
+    alignas(64) int front_ = 2;             ///< Consumer's slot.
+};
+
+#endif // TRIPLEBUFFER_H
@@ -0,0 +1,72 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int threadCount) {
+    if (threadCount <= 0) threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, threadCount);
+    threads_.reserve(threadCount - 1);
+    for (int w = 1; w < threadCount; ++w) threads_.emplace_back(&WorkerPool::workerLoop, this, w);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_.notify_all();
+    for (auto &thread: threads_) thread.join();
+}
+
+void WorkerPool::blockOf(int count, int worker, int &begin, int &end) const {
+    const long long workers = threadCount();
+    begin = static_cast<int>(count * worker / workers);
+    end = static_cast<int>(count * (worker + 1) / workers);
+}
+
+void WorkerPool::parallelFor(int count, const RangeFunction &body) {
+    if (count <= 0) return;
+    if (threads_.empty()) {
+        body(0, count, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &body;
+        jobCount_ = count;
+        pending_ = static_cast<int>(threads_.size());
+        ++generation_;
+    }
+    start_.notify_all();
+
+    int begin, end;
+    blockOf(count, 0, begin, end);
+    if (begin < end) body(begin, end, 0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [this] { return pending_ == 0; });
+    job_ = nullptr;
+}
+
+void WorkerPool::workerLoop(int worker) {
+    unsigned long long seen = 0;
+    while (true) {
+        const RangeFunction *job;
+        int count;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+            job = job_;
+            count = jobCount_;
+        }
+
+        int begin, end;
+        blockOf(count, worker, begin, end);
+        if (begin < end) (*job)(begin, end, worker);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) finished_.notify_one();
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file WorkerPool.h
+ * @brief A fixed set of threads that run data-parallel loops.
+ */
+
+/**
+ * @class WorkerPool
+ * @brief Runs a loop body on a fixed number of threads with a static partition.
+ *
+ * parallelFor() splits [0, count) into threadCount() contiguous blocks; block w is
+ * always processed by worker w (the calling thread is worker 0). Because the
+ * partition depends only on count and threadCount(), per-worker results can be
+ * combined in worker order to get the same answer on every run.
+ *
+ * @code
+ * WorkerPool pool(4);
+ * pool.parallelFor(n, [&](int begin, int end, int worker) {
+ *     for (int i = begin; i < end; ++i) out[i] = f(i);
+ * });
+ * @endcode
+ */
+class WorkerPool {
+public:
+    /// @brief Loop body: processes [begin, end) as worker `worker`.
+    using RangeFunction = std::function<void(int begin, int end, int worker)>;
+
+    /**
+     * @brief Starts the worker threads.
+     * @param threadCount Total number of workers including the caller; 0 = std::thread::hardware_concurrency().
+     */
+    explicit WorkerPool(int threadCount = 0);
+
+    /** @brief Stops and joins the worker threads. */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /** @brief Returns the number of workers, including the calling thread. */
+    int threadCount() const { return static_cast<int>(threads_.size()) + 1; }
+
+    /**
+     * @brief Runs body on every block of [0, count) and waits for all of them.
+     * * Workers whose block is empty are not called. Must not be called re-entrantly
+     * from inside a body.
+     * @param count Number of items.
+     * @param body The loop body.
+     */
+    void parallelFor(int count, const RangeFunction &body);
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_;    ///< Signals a new job (or shutdown) to the workers.
+    std::condition_variable finished_; ///< Signals the caller that all workers are done.
+    const RangeFunction *job_ = nullptr;
+    int jobCount_ = 0;
+    unsigned long long generation_ = 0; ///< Incremented for every job.
+    int pending_ = 0;                   ///< Workers still running the current job.
+    bool stopping_ = false;
+
+    /** @brief Returns the block [begin, end) of worker w. */
+    void blockOf(int count, int worker, int &begin, int &end) const;
+
+    /** @brief Main loop of background worker `worker` (1-based). */
+    void workerLoop(int worker);
+};
+
+#endif // WORKERPOOL_H
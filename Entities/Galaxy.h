@@ -10,6 +10,7 @@
 #include "CelestialObject.h"
 #include "Nebula.h"
 #include "StarSystem.h"
+#include "GraphSnapshot.h"
 
 
 /**
@@ -60,6 +61,7 @@ private:
     std::string name; ///< The name of the galaxy.
     GraphType systemGraph; ///< The graph representing relationships between objects.
     std::vector<CelestialObject *> celestial_objects; ///< Owns all objects in the galaxy.
+    GraphSnapshotStore<GraphType> graphSnapshots; ///< Immutable published copies of systemGraph for readers.
 
 public:
     /**
@@ -117,7 +119,7 @@ public:
      * @brief Connects two objects with an edge representing distance.
      * @param id1 An id of the first object to be connected.
      * @param id2 An id of the second object to be connected.
-     * @param distance The weight of the edge (e.g., distance in light years).
+     * @param distance The weight of the edge (e.g., distance in light years), in the graph's weight type.
      *
      * @example
      * @code
@@ -125,7 +127,7 @@ public:
      * galaxy.connectObjects(0, 5, 42);
      * @endcode
      */
-    void connectObjects(int id1, int id2, int distance) {
+    void connectObjects(int id1, int id2, typename GraphType::weight_type distance) {
         systemGraph.addEdge(id1, id2, distance);
     }
 
@@ -137,6 +139,35 @@ public:
         return systemGraph;
     }
 
+    /**
+     * @brief Publishes the current state of the graph as a new immutable snapshot.
+     *
+     * Call this on the writer (GUI) thread after a batch of edits so that readers
+     * on worker threads observe the changes. Edits made through getGraph() are not
+     * visible to readers until the next publish.
+     * @return The version number of the published snapshot.
+     */
+    std::uint64_t publishGraph() {
+        return graphSnapshots.publish(systemGraph);
+    }
+
+    /**
+     * @brief Returns the latest published snapshot of the graph.
+     *
+     * Thread-safe. The snapshot stays valid and unchanged for as long as the
+     * returned pointer is held, regardless of later edits.
+     *
+     * @example
+     * @code
+     * auto snapshot = galaxy.getGraphSnapshot();
+     * DijkstraPathList<CelestialObject*, double> solver;
+     * auto path = solver.findShortestPath(snapshot->graph, 0, 5);
+     * @endcode
+     */
+    std::shared_ptr<const GraphSnapshot<GraphType> > getGraphSnapshot() const {
+        return graphSnapshots.acquire();
+    }
+
     /**
      * @brief Returns the name of a galaxy.
      * @return The string name of galaxy.
@@ -72,7 +72,7 @@ Nebula* GalaxyFactory::createNebula(const nlohmann::json& data, RandomGenerator&
     return new Nebula(nebulaName, mass, nType);
 }
 
-void GalaxyFactory::populateGalaxy(Galaxy<GraphList<CelestialObject*>>& galaxy, const nlohmann::json& data, RandomGenerator& rng) {
+void GalaxyFactory::populateGalaxy(Galaxy<GraphList<CelestialObject*, double>>& galaxy, const nlohmann::json& data, RandomGenerator& rng) {
     int systemCount = rng.getInt(40, 60);
     for (int i = 0; i < systemCount; ++i)
         galaxy.addObject(createStarSystem(i, data, rng));
@@ -44,11 +44,11 @@ public:
      * std::ifstream f("universe_config.json");
      * nlohmann::json data = nlohmann::json::parse(f);
      * RandomGenerator rng;
-     * * Galaxy<GraphList<CelestialObject*>> myGalaxy;
+     * * Galaxy<GraphList<CelestialObject*, double>> myGalaxy;
      * GalaxyFactory::populateGalaxy(myGalaxy, data, rng);
      * @endcode
      */
-    static void populateGalaxy(Galaxy<GraphList<CelestialObject*>>& galaxy, const nlohmann::json& data, RandomGenerator& rng);
+    static void populateGalaxy(Galaxy<GraphList<CelestialObject*, double>>& galaxy, const nlohmann::json& data, RandomGenerator& rng);
 
     /**
      * @brief Factory method to generate a new random Planet.
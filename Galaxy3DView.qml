@@ -1,6 +1,7 @@
 import QtQuick
 import QtQuick3D
 import QtQuick3D.Helpers
+import Galaxy3D 1.0
 
 Rectangle {
     id: root
@@ -111,6 +112,19 @@ Rectangle {
         pathContainer.children.forEach(c => c.destroy());
     }
 
+    // Galaxy index of the object under (x, y), or -1.
+    function objectIndexAt(x, y) {
+        var result = view3D.pick(x, y);
+        if (result.objectHit === starModel) return starInstancing.objectIndex(result.instanceIndex);
+        if (result.objectHit === nebulaModel) return nebulaInstancing.objectIndex(result.instanceIndex);
+        return -1;
+    }
+
+    function setHoveredObject(objectIndex) {
+        starInstancing.highlightedIndex = objectIndex;
+        mouseArea.cursorShape = objectIndex !== -1 ? Qt.PointingHandCursor : Qt.ArrowCursor;
+    }
+
     function getDistance(v1, v2) {
         return Math.sqrt(Math.pow(v1.x-v2.x, 2) + Math.pow(v1.y-v2.y, 2) + Math.pow(v1.z-v2.z, 2));
     }
@@ -171,98 +185,95 @@ Rectangle {
                     color: "white"; brightness: 1.5; eulerRotation: Qt.vector3d(-30, 45, 0); castsShadow: false
                 }
 
-                Repeater3D {
-                    id: objectsRepeater
-                    model: celestialModel
-                    delegate: Node {
-                        id: objectNode
-                        position: Qt.vector3d(Number(model.xPos || 0), Number(model.yPos || 0), Number(model.zPos || 0))
-                        property int objectIndex: index
-                        property int type: model.objectType
-                        property bool isHovered: false
-
-                        Node {
-                            visible: objectNode.type === 1
-                            Model {
-                                id: sphereModel
-                                source: "#Sphere"
-                                pickable: true
-                                property real baseScale: model.sizeFactor * 0.5
-                                scale: Qt.vector3d(baseScale * (objectNode.isHovered ? 1.2 : 1.0), baseScale * (objectNode.isHovered ? 1.2 : 1.0), baseScale * (objectNode.isHovered ? 1.2 : 1.0))
-                                Behavior on scale {
-                                    Vector3dAnimation {
-                                        duration: 200; easing.type: Easing.OutCubic
-                                    }
-                                }
-                                materials: [PrincipledMaterial {
-                                    baseColor: model.objectColor || "white"; metalness: 0.3; roughness: 0.5; lighting: PrincipledMaterial.NoLighting
-                                }]
-                            }
+                // All objects of a kind are drawn by one instanced Model (see CelestialObjectInstancing);
+                // per-object size, colour and position come from the instance tables.
+                CelestialObjectInstancing {
+                    id: starInstancing
+                    model: celestialModel; objectType: 1; shape: Qt.vector3d(0.5, 0.5, 0.5)
+                }
+                CelestialObjectInstancing {
+                    id: starGlowInstancing
+                    model: celestialModel; objectType: 1; shape: Qt.vector3d(1.0, 1.0, 1.0)
+                }
+                CelestialObjectInstancing {
+                    id: nebulaInstancing
+                    model: celestialModel; objectType: 2; shape: Qt.vector3d(2.0, 1.6, 2.0)
+                }
+                CelestialObjectInstancing {
+                    id: nebulaCoreInstancing
+                    model: celestialModel; objectType: 2; shape: Qt.vector3d(1.4, 1.4, 1.4)
+                    spinAxis: Qt.vector3d(1, 0, 0)
+                }
 
-                            Model {
-                                source: "#Sphere"
-                                pickable: false
-                                property real glowScale: model.sizeFactor * 0.5
-                                scale: Qt.vector3d(glowScale, glowScale, glowScale)
-                                opacity: 0.2
-                                materials: [PrincipledMaterial {
-                                    baseColor: model.objectColor || "white"; opacity: 0.2; alphaMode: PrincipledMaterial.Blend; lighting: PrincipledMaterial.NoLighting
-                                }]
-                                SequentialAnimation on scale {
-                                    running: true; loops: Animation.Infinite
-                                    Vector3dAnimation {
-                                        to: Qt.vector3d(model.sizeFactor * 1.8, model.sizeFactor * 1.8, model.sizeFactor * 1.8); duration: 2000; easing.type: Easing.InOutSine
-                                    }
-                                    Vector3dAnimation {
-                                        to: Qt.vector3d(model.sizeFactor * 1.5, model.sizeFactor * 1.5, model.sizeFactor * 1.5); duration: 2000; easing.type: Easing.InOutSine
-                                    }
-                                }
+                Model {
+                    id: starModel
+                    source: "#Sphere"
+                    pickable: true
+                    instancing: starInstancing
+                    materials: [PrincipledMaterial {
+                        baseColor: "white"; metalness: 0.3; roughness: 0.5; lighting: PrincipledMaterial.NoLighting
+                    }]
+                }
+
+                Model {
+                    source: "#Sphere"
+                    pickable: false
+                    instancing: starGlowInstancing
+                    opacity: 0.2
+                    materials: [PrincipledMaterial {
+                        baseColor: "white"; opacity: 0.2; alphaMode: PrincipledMaterial.Blend; lighting: PrincipledMaterial.NoLighting
+                    }]
+                }
+                SequentialAnimation {
+                    running: true; loops: Animation.Infinite
+                    NumberAnimation {
+                        target: starGlowInstancing; property: "scaleFactor"; from: 1.5; to: 1.8; duration: 2000; easing.type: Easing.InOutSine
+                    }
+                    NumberAnimation {
+                        target: starGlowInstancing; property: "scaleFactor"; from: 1.8; to: 1.5; duration: 2000; easing.type: Easing.InOutSine
+                    }
+                }
+
+                // The instance colour multiplies baseColor, tinting the texture per nebula.
+                Model {
+                    id: nebulaModel
+                    source: "#Sphere"
+                    pickable: true
+                    instancing: nebulaInstancing
+                    materials: [
+                        PrincipledMaterial {
+                            baseColorMap: Texture {
+                                source: "qrc:/3DView/textures/nebula.png"
                             }
+                            baseColor: "white"
+                            opacity: 0.4
+                            blendMode: PrincipledMaterial.Screen
+                            lighting: PrincipledMaterial.NoLighting
+                            cullMode: Material.NoCulling
                         }
-                        Node {
-                            visible: objectNode.type === 2
-                            scale: Qt.vector3d(2.0, 2.0, 2.0)
-                            Model {
-                                source: "#Sphere"
-                                pickable: true
-                                scale: Qt.vector3d(model.sizeFactor, model.sizeFactor * 0.8, model.sizeFactor)
-                                eulerRotation: Qt.vector3d(Math.random() * 360, Math.random() * 360, 0)
-                                materials: [
-                                    DefaultMaterial {
-                                        diffuseMap: Texture {
-                                            source: "qrc:/3DView/textures/nebula.png"
-                                        }
-                                        diffuseColor: model.objectColor
-                                        opacity: 0.4
-                                        blendMode: DefaultMaterial.Screen
-                                        lighting: DefaultMaterial.NoLighting
-                                        cullMode: Material.NoCulling
-                                    }
-                                ]
-                                NumberAnimation on eulerRotation.y {
-                                    from: 0;
-                                    to: 360; duration: 50000; loops: Animation.Infinite
-                                }
-                            }
-                            Model {
-                                source: "#Sphere"
-                                scale: Qt.vector3d(model.sizeFactor * 0.7, model.sizeFactor * 0.7, model.sizeFactor * 0.7)
-                                materials: [DefaultMaterial {
-                                    diffuseMap: Texture {
-                                        source: "qrc:/3DView/textures/nebula.png"
-                                    }
-                                    diffuseColor: "white"
-                                    opacity: 0.2
-                                    blendMode: DefaultMaterial.Screen
-                                    lighting: DefaultMaterial.NoLighting
-                                }]
-                                NumberAnimation on eulerRotation.x {
-                                    from: 0;
-                                    to: 360; duration: 40000; loops: Animation.Infinite
-                                }
-                            }
+                    ]
+                }
+                NumberAnimation {
+                    target: nebulaInstancing; property: "spinAngle"
+                    from: 0; to: 360; duration: 50000; loops: Animation.Infinite; running: true
+                }
+
+                Model {
+                    source: "#Sphere"
+                    instancing: nebulaCoreInstancing
+                    materials: [PrincipledMaterial {
+                        baseColorMap: Texture {
+                            source: "qrc:/3DView/textures/nebula.png"
                         }
-                    }
+                        baseColor: "white"
+                        opacity: 0.2
+                        blendMode: PrincipledMaterial.Screen
+                        lighting: PrincipledMaterial.NoLighting
+                    }]
+                }
+                NumberAnimation {
+                    target: nebulaCoreInstancing; property: "spinAngle"
+                    from: 0; to: 360; duration: 40000; loops: Animation.Infinite; running: true
                 }
             }
 
@@ -359,27 +370,23 @@ Rectangle {
                 Repeater3D {
                     model: planetModel
                     Node {
-                        NumberAnimation on eulerRotation.y {
-                            from: 0; to: 360; duration: model.rotationSpeed; loops: Animation.Infinite; running: true
-                        }
-                        Node {
-                            position: Qt.vector3d(model.orbitRadius, 0, 0)
-                            Model {
-                                source: "#Sphere"
-                                scale: Qt.vector3d(model.planetSize, model.planetSize, model.planetSize)
-                                materials: PrincipledMaterial {
-                                    baseColorMap: Texture {
-                                        source: model.texturePath
-                                        tilingModeHorizontal: Texture.Repeat
-                                        tilingModeVertical: Texture.ClampToEdge
-                                    }
-                                    metalness: 0.0
-                                    roughness: 0.8
-                                    baseColor: "white"
-                                }
-                                NumberAnimation on eulerRotation.y {
-                                    from: 0; to: 360; duration: 10000 + Math.random() * 10000; loops: Animation.Infinite
+                        // Moved by the C++ side every frame (PlanetarySystemModel::updatePositions).
+                        position: model.planetPosition
+                        Model {
+                            source: "#Sphere"
+                            scale: Qt.vector3d(model.planetSize, model.planetSize, model.planetSize)
+                            materials: PrincipledMaterial {
+                                baseColorMap: Texture {
+                                    source: model.texturePath
+                                    tilingModeHorizontal: Texture.Repeat
+                                    tilingModeVertical: Texture.ClampToEdge
                                 }
+                                metalness: 0.0
+                                roughness: 0.8
+                                baseColor: "white"
+                            }
+                            NumberAnimation on eulerRotation.y {
+                                from: 0; to: 360; duration: 10000 + Math.random() * 10000; loops: Animation.Infinite
                             }
                         }
                     }
@@ -469,7 +476,6 @@ Rectangle {
     MouseArea {
         id: mouseArea
         anchors.fill: view3D
-        property var hoveredObject: null
 
         Timer {
             id: clickTimer
@@ -486,34 +492,14 @@ Rectangle {
         }
 
         onPositionChanged: function (mouse) {
-            var result = view3D.pick(mouse.x, mouse.y)
-            if (hoveredObject && hoveredObject !== result.objectHit) {
-                if (hoveredObject.parent) hoveredObject.parent.isHovered = false
-            }
-            if (result.objectHit && result.objectHit.pickable) {
-                hoveredObject = result.objectHit
-                if (result.objectHit.parent) {
-                    result.objectHit.parent.isHovered = true;
-                    mouseArea.cursorShape = Qt.PointingHandCursor
-                }
-            } else {
-                hoveredObject = null;
-                mouseArea.cursorShape = Qt.ArrowCursor
-            }
+            root.setHoveredObject(root.objectIndexAt(mouse.x, mouse.y));
         }
 
         onClicked: function (mouse) {
-            var result = view3D.pick(mouse.x, mouse.y);
-            if (result.objectHit && result.objectHit.pickable) {
-                var candidate = result.objectHit.parent;
-                while (candidate) {
-                    if (candidate.objectIndex !== undefined) {
-                        clickTimer.pendingVertexId = candidate.objectIndex;
-                        clickTimer.restart();
-                        return;
-                    }
-                    candidate = candidate.parent;
-                }
+            var objectIndex = root.objectIndexAt(mouse.x, mouse.y);
+            if (objectIndex !== -1) {
+                clickTimer.pendingVertexId = objectIndex;
+                clickTimer.restart();
             } else {
                 root.backgroundClicked();
             }
@@ -525,23 +511,14 @@ Rectangle {
                 clickTimer.pendingVertexId = -1;
             }
 
-            var result = view3D.pick(mouse.x, mouse.y);
-            if (result.objectHit && result.objectHit.pickable) {
-                var candidate = result.objectHit.parent;
-                while (candidate) {
-                    if (candidate.objectIndex !== undefined) {
-                        root.objectDoubleClicked(candidate.objectIndex);
-                        return;
-                    }
-                    candidate = candidate.parent;
-                }
+            var objectIndex = root.objectIndexAt(mouse.x, mouse.y);
+            if (objectIndex !== -1) {
+                root.objectDoubleClicked(objectIndex);
             }
         }
 
         onExited: {
-            if (hoveredObject && hoveredObject.parent) hoveredObject.parent.isHovered = false;
-            hoveredObject = null;
-            cursorShape = Qt.ArrowCursor
+            root.setHoveredObject(-1);
         }
     }
 
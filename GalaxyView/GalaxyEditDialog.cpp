@@ -2,12 +2,13 @@
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QPushButton>
+#include <QInputDialog>
 #include "GraphList.h"
 #include "Galaxy.h"
 #include <algorithm>
 
 
-GalaxyEditDialog::GalaxyEditDialog(Galaxy<GraphList<CelestialObject *> > *g,
+GalaxyEditDialog::GalaxyEditDialog(Galaxy<GraphList<CelestialObject *, double> > *g,
                                    RandomGenerator *rng,
                                    const nlohmann::json *data,
                                    QWidget *parent)
@@ -38,6 +39,9 @@ GalaxyEditDialog::GalaxyEditDialog(Galaxy<GraphList<CelestialObject *> > *g,
     layout->addWidget(addStarSystem);
     layout->addWidget(addNebula);
 
+    QPushButton *removeObject = new QPushButton("Remove Object", this);
+    layout->addWidget(removeObject);
+
     layout->addWidget(new QWidget(this));
 
     QPushButton *closeButton = new QPushButton("Close", this);
@@ -47,6 +51,7 @@ GalaxyEditDialog::GalaxyEditDialog(Galaxy<GraphList<CelestialObject *> > *g,
 
     connect(addStarSystem, &QPushButton::clicked, this, &GalaxyEditDialog::on_addStarSystem_clicked);
     connect(addNebula, &QPushButton::clicked, this, &GalaxyEditDialog::on_addNebula_clicked);
+    connect(removeObject, &QPushButton::clicked, this, &GalaxyEditDialog::on_removeObject_clicked);
 
     connect(saveNameButton, &QPushButton::clicked, this, [this]() {
         galaxy->setName(nameEdit->text().toStdString());
@@ -85,6 +90,7 @@ void GalaxyEditDialog::on_addStarSystem_clicked() {
                 }
             }
         }
+        galaxy->publishGraph();
         emit galaxyModified();
     }
 }
@@ -121,10 +127,34 @@ void GalaxyEditDialog::on_addNebula_clicked() {
                 }
             }
         }
+        galaxy->publishGraph();
         emit galaxyModified();
     }
 }
 
+void GalaxyEditDialog::on_removeObject_clicked() {
+    QStringList names;
+    std::vector<int> indices;
+    const auto &vertices = galaxy->getGraph().getVertices();
+    for (int i = 0; i < static_cast<int>(galaxy->getObject().size()); ++i) {
+        if (i >= static_cast<int>(vertices.size()) || vertices[i].getId() == -1) continue;
+        // The index keeps the entries unique when names repeat.
+        names << QString("%1 (#%2)").arg(QString::fromStdString(galaxy->getObject()[i]->getName())).arg(i);
+        indices.push_back(i);
+    }
+    if (indices.empty()) return;
+
+    bool ok = false;
+    QString choice = QInputDialog::getItem(this, "Remove Object", "Object:", names, 0, false, &ok);
+    if (!ok) return;
+
+    int index = indices[names.indexOf(choice)];
+    galaxy->getGraph().removeVertex(vertices[index].getId());
+    galaxy->publishGraph();
+    emit objectRemoved(index);
+    emit galaxyModified();
+}
+
 QString GalaxyEditDialog::getNewGalaxyName() const {
     return nameEdit->text();
 }
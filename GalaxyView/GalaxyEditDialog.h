@@ -16,7 +16,7 @@
 /**
  * @class GalaxyEditDialog
  * @brief A QDialog window that allows editing the galaxy's name
- * and adding new celestial objects.
+ * and adding or removing celestial objects.
  */
 class GalaxyEditDialog : public QDialog {
     Q_OBJECT
@@ -29,7 +29,7 @@ public:
      * @param data Pointer to the JSON configuration data (for new objects).
      * @param parent The parent Qt widget.
      */
-    explicit GalaxyEditDialog(Galaxy<GraphList<CelestialObject *> > *g,
+    explicit GalaxyEditDialog(Galaxy<GraphList<CelestialObject *, double> > *g,
                               RandomGenerator *rng,
                               const nlohmann::json *data,
                               QWidget *parent = nullptr);
@@ -63,15 +63,29 @@ private slots:
    */
     void on_addNebula_clicked();
 
+    /**
+   * @brief Qt Slot: Handles the removal of an object.
+   *
+   * Lets the user pick one of the active objects, removes its vertex (and with it
+   * its edges) from the graph and emits objectRemoved() with its index.
+   */
+    void on_removeObject_clicked();
+
 signals:
     void galaxyModified();
 
+    /**
+     * @brief Emitted after the object at `index` was removed from the graph.
+     * @param index Index of the object in Galaxy::getObject().
+     */
+    void objectRemoved(int index);
+
 private:
     /**
            * @brief Qt Signal: Emitted whenever a change is made (new object added).
            * Used for live-updating the main graph view.
            */
-    Galaxy<GraphList<CelestialObject *> > *galaxy; ///< Pointer to the main Galaxy object (non-owning).
+    Galaxy<GraphList<CelestialObject *, double> > *galaxy; ///< Pointer to the main Galaxy object (non-owning).
     QLineEdit *nameEdit; ///< The text input field for the galaxy's name.
 
     RandomGenerator *rngPtr; ///< Non-owning pointer to the random number generator.
@@ -14,18 +14,21 @@
 #include <QLabel>
 #include <QDebug>
 #include <QMessageBox>
+#include <QFileDialog>
 #include <algorithm>
 
-#include "DijkstraPathList.h"
 #include "GalaxyFactory.h"
+#include "PhysicsCheckpoint.h"
 static constexpr double PHYSICS_MASS_SCALE = 1.0e-7;
+static constexpr double PHYSICS_STEP = 1.0 / 60.0; ///< Simulated seconds per physics step.
+static constexpr double PHYSICS_TIME_SCALE = 3.0; ///< Simulated seconds per wall-clock second.
 
 GalaxyView::GalaxyView(QWidget *parent) : QWidget(parent), ui(new Ui::GalaxyView) {
     ui->setupUi(this);
 
     graphWidget = new GraphWidget(this);
 
-    simulationTimer = new QTimer(this);
+    frameTimer = new QTimer(this);
     if (ui->graphArea->layout() == nullptr) {
         QVBoxLayout *layout = new QVBoxLayout(ui->graphArea);
         layout->setContentsMargins(0, 0, 0, 0);
@@ -52,6 +55,8 @@ GalaxyView::GalaxyView(QWidget *parent) : QWidget(parent), ui(new Ui::GalaxyView
 
     QPushButton *editButtonLocal = new QPushButton("Edit Object", paramsWindow);
     this->editButton = editButtonLocal;
+    saveStateButton = new QPushButton("Save Simulation", paramsWindow);
+    loadStateButton = new QPushButton("Load Simulation", paramsWindow);
 
     zoomOutButton = new QPushButton("Back to Galaxy", this);
     zoomOutButton->hide();
@@ -59,10 +64,12 @@ GalaxyView::GalaxyView(QWidget *parent) : QWidget(parent), ui(new Ui::GalaxyView
     paramsLayout->addWidget(titleLabel);
     paramsLayout->addWidget(infoText);
     paramsLayout->addWidget(this->editButton);
+    paramsLayout->addWidget(saveStateButton);
+    paramsLayout->addWidget(loadStateButton);
     paramsWindow->setLayout(paramsLayout);
 
     paramsButton->resize(160, 40);
-    paramsWindow->resize(240, 220);
+    paramsWindow->resize(240, 300);
 
     connect(paramsButton, &QPushButton::clicked, this, &GalaxyView::on_paramsButton_clicked);
     connect(zoomOutButton, &QPushButton::clicked, this, &GalaxyView::on_zoomOutButton_clicked);
@@ -70,7 +77,9 @@ GalaxyView::GalaxyView(QWidget *parent) : QWidget(parent), ui(new Ui::GalaxyView
     connect(graphWidget, &GraphWidget::vertexClicked, this, &GalaxyView::onVertexClicked);
     connect(graphWidget, &GraphWidget::backgroundClicked, this, &GalaxyView::onBackgroundClicked);
     connect(editButton, &QPushButton::clicked, this, &GalaxyView::on_editButton_clicked);
-    connect(simulationTimer, &QTimer::timeout, this, &GalaxyView::onPhysicsTimerTick);
+    connect(saveStateButton, &QPushButton::clicked, this, &GalaxyView::on_saveStateButton_clicked);
+    connect(loadStateButton, &QPushButton::clicked, this, &GalaxyView::on_loadStateButton_clicked);
+    connect(frameTimer, &QTimer::timeout, this, &GalaxyView::onFrameTimerTick);
     connect(graphWidget, &GraphWidget::planetDoubleClicked, this, [this](int index) {
         int sysId = graphWidget->getDetailedVertexId();
         if (sysId < 0 || !galaxy) return;
@@ -94,6 +103,7 @@ GalaxyView::GalaxyView(QWidget *parent) : QWidget(parent), ui(new Ui::GalaxyView
 }
 
 GalaxyView::~GalaxyView() {
+    delete simulationThread;
     if (galaxy) {
         delete galaxy;
         galaxy = nullptr;
@@ -101,6 +111,7 @@ GalaxyView::~GalaxyView() {
     delete physicsController;
     delete physicsEngine;
     delete blackHoleField;
+    delete bodyGravityField;
     delete ui;
 }
 
@@ -212,11 +223,13 @@ void GalaxyView::generateAndDisplayGalaxy(const nlohmann::json &data, RandomGene
     if (data.contains("Galaxy") && data["Galaxy"].is_array() && !data["Galaxy"].empty()) {
         galaxyNameFile = data["Galaxy"][0].get<std::string>();
     }
+    generationState = rng.saveState();
     std::string randomGalaxyName = rng.getRandomNameFromFile(galaxyNameFile);
 
-    galaxy = new Galaxy<GraphList<CelestialObject *> >(randomGalaxyName);
+    galaxy = new Galaxy<GraphList<CelestialObject *, double> >(randomGalaxyName);
 
     GalaxyFactory::populateGalaxy(*galaxy, data, rng);
+    galaxy->publishGraph();
 
     this->dataPtr = const_cast<nlohmann::json *>(&data);
     this->rngPtr = &rng;
@@ -230,10 +243,10 @@ void GalaxyView::generateAndDisplayGalaxy(const nlohmann::json &data, RandomGene
     updateParametersWindow();
 }
 
-void GalaxyView::createPhysicsBody(CelestialObject *obj) {
+void GalaxyView::createPhysicsBody(int index) {
     if (!physicsEngine || !physicsController) return;
 
-    auto *wrapper = new CelestialBodyToRigidWrapper(obj, physicsEngine->getWorld());
+    auto *wrapper = new CelestialBodyToRigidWrapper(galaxy->getObject()[index], physicsEngine);
 
     double minScreenDimension = std::min(ui->graphArea->width(), ui->graphArea->height());
     double maxScreenRadius = (minScreenDimension / 2.0) - 50.0;
@@ -261,14 +274,74 @@ void GalaxyView::createPhysicsBody(CelestialObject *obj) {
 
     wrapper->getRigidBody()->setLinearVelocity(vel);
 
-    physicsController->addCelestialBody(wrapper);
+    physicsController->addCelestialBody(wrapper, index);
 
     vertexPositions.push_back(physicsToScreen(physX, physY));
 }
 
+void GalaxyView::removePhysicsBody(int index) {
+    if (!physicsController) return;
+
+    std::unique_lock<std::mutex> lock;
+    if (simulationThread) lock = simulationThread->lockController();
+    // The wrapper's destructor takes the body out of the Bullet world.
+    delete physicsController->removeCelestialBody(index);
+}
+
+void GalaxyView::on_saveStateButton_clicked() {
+    if (!physicsController || !rngPtr) return;
+    QString path = QFileDialog::getSaveFileName(this, "Save Simulation", QString(), "Galaxy checkpoints (*.chk)");
+    if (path.isEmpty()) return;
+
+    std::string error;
+    bool saved;
+    {
+        std::unique_lock<std::mutex> lock;
+        if (simulationThread) lock = simulationThread->lockController();
+        double time = simulationThread ? simulationThread->snapshot().simulationTime : 0.0;
+        saved = PhysicsCheckpoint::save(path.toStdString(), *physicsController, blackHoleField,
+                                        rngPtr->saveState(), generationState, time, &error);
+    }
+    if (!saved) QMessageBox::warning(this, "Save Simulation", QString::fromStdString(error));
+}
+
+void GalaxyView::on_loadStateButton_clicked() {
+    if (!dataPtr || !rngPtr) return;
+    QString path = QFileDialog::getOpenFileName(this, "Load Simulation", QString(), "Galaxy checkpoints (*.chk)");
+    if (path.isEmpty()) return;
+
+    PhysicsCheckpoint checkpoint;
+    if (!checkpoint.load(path.toStdString())) {
+        QMessageBox::warning(this, "Load Simulation", QString::fromStdString(checkpoint.errorString()));
+        return;
+    }
+    if (!rngPtr->restoreState(checkpoint.generationState())) {
+        QMessageBox::warning(this, "Load Simulation", "The file does not say which galaxy it was saved from.");
+        return;
+    }
+    // The old galaxy's objects are deleted while regenerating, so its simulation stops first.
+    delete simulationThread;
+    simulationThread = nullptr;
+    if (graphWidget && graphWidget->isInPlanetMode()) on_zoomOutButton_clicked();
+    if (zoomOutButton && zoomOutButton->isVisible()) on_zoomOutButton_clicked();
+    resetPathSelection();
+    generateAndDisplayGalaxy(*dataPtr, *rngPtr);
+
+    // Restore with the simulation stopped, then let its clock continue from the saved time.
+    if (simulationThread) simulationThread->stop();
+    const bool restored = checkpoint.restore(*physicsController, blackHoleField);
+    if (restored) rngPtr->restoreState(checkpoint.rngState());
+    if (simulationThread) simulationThread->start(restored ? checkpoint.simulationTime() : 0.0);
+    // Objects added or removed after generation are not regenerated, so the bodies no longer match.
+    if (!restored) QMessageBox::warning(this, "Load Simulation", QString::fromStdString(checkpoint.errorString()));
+}
+
 void GalaxyView::initPhysicsSimulation() {
-    if (!simulationTimer) return;
-    simulationTimer->stop();
+    if (!frameTimer) return;
+    frameTimer->stop();
+
+    delete simulationThread;
+    simulationThread = nullptr;
 
     if (physicsController) {
         delete physicsController;
@@ -282,8 +355,13 @@ void GalaxyView::initPhysicsSimulation() {
         delete blackHoleField;
         blackHoleField = nullptr;
     }
+    if (bodyGravityField) {
+        delete bodyGravityField;
+        bodyGravityField = nullptr;
+    }
 
-    physicsEngine = new PhysicsEngine();
+    // Bodies are point masses that never touch, so the world needs no collision detection.
+    physicsEngine = new PhysicsEngine(PhysicsEngine::Profile::collisionFree());
     physicsController = new GalaxyPhysicsController(physicsEngine);
 
 
@@ -292,22 +370,19 @@ void GalaxyView::initPhysicsSimulation() {
     double simBlackHoleMass = realBlackHoleMass * PHYSICS_MASS_SCALE;
 
     blackHoleField = new BlackHoleGravityField(simBlackHoleMass, 0, 0, 0);
+    bodyGravityField = new BarnesHutGravityField(PHYSICS_MASS_SCALE);
 
     vertexPositions.clear();
     if (!galaxy) return;
 
-    std::vector<CelestialBodyToRigidWrapper *> wrappersMap(galaxy->getObject().size(), nullptr);
     int nVerticesTotal = galaxy->getObject().size();
 
+    // Random start positions for the active vertices, in body order.
+    std::vector<int> bodyIndex(nVerticesTotal, -1);
+    std::vector<int> bodyVertex;
+    std::vector<double> posX, posY, posZ;
     for (int i = 0; i < nVerticesTotal; ++i) {
-        CelestialObject *obj = galaxy->getObject()[i];
-        if (galaxy->getGraph().getVertices()[i].getId() == -1) {
-            vertexPositions.push_back(QPointF(0, 0));
-            continue;
-        }
-
-        auto *wrapper = new CelestialBodyToRigidWrapper(obj, physicsEngine->getWorld());
-        wrappersMap[i] = wrapper;
+        if (galaxy->getGraph().getVertices()[i].getId() == -1) continue;
 
         double minScreenDimension = std::min(ui->graphArea->width(), ui->graphArea->height());
 
@@ -320,45 +395,52 @@ void GalaxyView::initPhysicsSimulation() {
         double radius = rngPtr->getDouble(100, maxPhysicsRadius);
 
         double angle = rngPtr->getDouble(0, 2 * M_PI);
-        wrapper->setPosition(radius * std::cos(angle), radius * std::sin(angle), 0);
-        wrapper->getRigidBody()->setDamping(0.95, 0.95);
-        wrapper->getRigidBody()->setActivationState(DISABLE_DEACTIVATION);
-
-        physicsController->addCelestialBody(wrapper);
+        bodyIndex[i] = static_cast<int>(bodyVertex.size());
+        bodyVertex.push_back(i);
+        posX.push_back(radius * std::cos(angle));
+        posY.push_back(radius * std::sin(angle));
+        posZ.push_back(0);
     }
 
+    // Spread the graph out so that connected systems sit about edge.weight * 5 apart.
     double radiusMultiplying = 5;
+    std::vector<int> edgeFrom, edgeTo;
+    std::vector<double> edgeLength;
     for (const auto &edge: galaxy->getGraph().getEdges()) {
         if (!edge.isActive()) continue;
-        if (wrappersMap[edge.from] && wrappersMap[edge.to]) {
-            physicsController->addSpring(wrappersMap[edge.from], wrappersMap[edge.to], edge.weight * radiusMultiplying);
+        if (bodyIndex[edge.from] >= 0 && bodyIndex[edge.to] >= 0) {
+            edgeFrom.push_back(bodyIndex[edge.from]);
+            edgeTo.push_back(bodyIndex[edge.to]);
+            edgeLength.push_back(edge.weight * radiusMultiplying);
         }
     }
 
-    qDebug() << "Pre-calculating positions...";
-    for (int i = 0; i < 500; ++i) {
-        physicsController->simulateStep(0.016);
-    }
+    MultilevelLayout layout(physicsController->getWorkerPool());
+    layout.setGraph(static_cast<int>(bodyVertex.size()), edgeFrom, edgeTo, edgeLength);
+    MultilevelLayout::Options layoutOptions;
+    layoutOptions.layout.planar = true;
+    layout.run(posX.data(), posY.data(), posZ.data(), layoutOptions);
 
-    physicsController->clearSprings();
     physicsController->addGravityField(blackHoleField);
+    physicsController->addGravityField(bodyGravityField);
+    // Systems on undisturbed orbits move on their Kepler ellipses instead of being integrated.
+    physicsController->setOrbitLod(blackHoleField);
 
     double G = 1.0;
 
-    for (int i = 0; i < nVerticesTotal; ++i) {
-        if (!wrappersMap[i]) {
-            if (i >= vertexPositions.size()) vertexPositions.push_back(QPointF(0, 0));
-            continue;
-        }
-
-        auto *wrapper = wrappersMap[i];
-        wrapper->updateFromPhysics();
+    vertexPositions.assign(nVerticesTotal, QPointF(0, 0));
+    // One block for all bodies and motion states, one shared sphere shape.
+    physicsEngine->getBodyPool().reserve(static_cast<int>(bodyVertex.size()));
+    for (size_t b = 0; b < bodyVertex.size(); ++b) {
+        int i = bodyVertex[b];
+        auto *wrapper = new CelestialBodyToRigidWrapper(galaxy->getObject()[i], physicsEngine);
 
-        wrapper->getRigidBody()->setLinearVelocity(btVector3(0, 0, 0));
+        double x = posX[b];
+        double y = posY[b];
+        wrapper->setPosition(x, y, 0);
         wrapper->getRigidBody()->setDamping(0.0, 0.0);
+        wrapper->getRigidBody()->setActivationState(DISABLE_DEACTIVATION);
 
-        double x = wrapper->getX();
-        double y = wrapper->getY();
         double dist = std::sqrt(x * x + y * y);
         if (dist < 10.0) dist = 10.0;
 
@@ -370,11 +452,14 @@ void GalaxyView::initPhysicsSimulation() {
 
         wrapper->getRigidBody()->setLinearVelocity(vel);
 
-        if (i < vertexPositions.size()) vertexPositions[i] = physicsToScreen(x, y);
-        else vertexPositions.push_back(physicsToScreen(x, y));
+        physicsController->addCelestialBody(wrapper, i);
+
+        vertexPositions[i] = physicsToScreen(x, y);
     }
 
-    simulationTimer->start(16);
+    simulationThread = new SimulationThread(physicsController, PHYSICS_STEP, PHYSICS_TIME_SCALE);
+    simulationThread->start();
+    frameTimer->start(16);
 }
 
 void GalaxyView::checkForNewObjects() {
@@ -387,11 +472,12 @@ void GalaxyView::checkForNewObjects() {
     if (totalObjectsInGalaxy > knownObjects) {
         qDebug() << "Found new objects! Adding to physics engine...";
 
-        for (int i = knownObjects; i < totalObjectsInGalaxy; ++i) {
-            CelestialObject *obj = galaxy->getObject()[i];
+        std::unique_lock<std::mutex> lock;
+        if (simulationThread) lock = simulationThread->lockController();
 
+        for (int i = knownObjects; i < totalObjectsInGalaxy; ++i) {
             if (galaxy->getGraph().getVertices()[i].getId() != -1) {
-                createPhysicsBody(obj);
+                createPhysicsBody(i);
             } else {
                 vertexPositions.push_back(QPointF(0, 0));
             }
@@ -399,28 +485,35 @@ void GalaxyView::checkForNewObjects() {
     }
 }
 
-void GalaxyView::onPhysicsTimerTick() {
-    if (!physicsController) return;
+void GalaxyView::onFrameTimerTick() {
+    if (!galaxy || !simulationThread) return;
 
-    for (int i = 0; i < 3; ++i) {
-        physicsController->simulateStep(1.0 / 60.0);
-    }
-    const auto &bodies = physicsController->getBodies();
+    const bool newSnapshot = simulationThread->fetchSnapshot();
+    const PhysicsSnapshot &snapshot = simulationThread->snapshot();
+    if (snapshot.step == 0) return;
+    const double alpha = simulationThread->interpolationFactor();
 
-    int bodyIndex = 0;
-    for (int i = 0; i < vertexPositions.size(); ++i) {
-        if (galaxy->getGraph().getVertices()[i].getId() == -1) continue;
-
-        if (bodyIndex < bodies.size()) {
-            auto *wrapper = bodies[bodyIndex];
-            double px = wrapper->getX();
-            double py = wrapper->getY();
+    // Bodies are keyed by vertex index. A snapshot taken before the last add or remove
+    // may use the old body indices, so positions wait for the next one.
+    if (snapshot.bodiesVersion == physicsController->getBodiesVersion()) {
+        for (int i = 0; i < vertexPositions.size(); ++i) {
+            int bodyIndex = physicsController->findBody(i);
+            if (bodyIndex < 0 || bodyIndex >= snapshot.x.size()) continue;
 
+            double px, py, pz;
+            snapshot.interpolate(bodyIndex, alpha, px, py, pz);
             vertexPositions[i] = physicsToScreen(px, py);
-            bodyIndex++;
         }
     }
 
+    // Edge weights follow the physics step, not the frame: the graph is republished (a full
+    // copy for the route planner) only when a new snapshot has moved the objects.
+    if (newSnapshot) updateEdgeWeights();
+
+    updateGraphDisplay();
+}
+
+void GalaxyView::updateEdgeWeights() {
     auto &edges = galaxy->getGraph().getEdges();
 
     for (auto &edge: edges) {
@@ -438,11 +531,10 @@ void GalaxyView::onPhysicsTimerTick() {
             double dy = pA.y() - pB.y();
             double realDistance = std::sqrt(dx * dx + dy * dy);
 
-            edge.changeWeight(static_cast<int>(realDistance));
+            edge.changeWeight(realDistance);
         }
     }
-
-    updateGraphDisplay();
+    galaxy->publishGraph();
 
     if (pathInfoWidget && pathInfoWidget->isVisible() && !pathEdges.empty()) {
         double totalDistance = 0;
@@ -461,7 +553,7 @@ void GalaxyView::onPhysicsTimerTick() {
             }
         }
 
-        pathDistanceLabel->setText("Total Distance: " + QString::number((int) totalDistance));
+        pathDistanceLabel->setText("Total Distance: " + QString::number(totalDistance, 'f', 1));
     }
 }
 
@@ -489,10 +581,12 @@ void GalaxyView::on_editButton_clicked() {
 
     GalaxyEditDialog dlg(galaxy, rngPtr, dataPtr, this);
 
+    connect(&dlg, &GalaxyEditDialog::objectRemoved, this, &GalaxyView::removePhysicsBody, Qt::DirectConnection);
     connect(&dlg, &GalaxyEditDialog::galaxyModified, this,
             [this]() {
                 updateParametersWindow();
                 checkForNewObjects();
+                graphWidget->refreshPlanetOrbits();
                 updateGraphDisplay();
                 QApplication::processEvents();
             },
@@ -584,6 +678,9 @@ void GalaxyView::resetPathSelection() {
     startNodeId = -1;
     endNodeId = -1;
     pathEdges.clear();
+    routes.clear();
+    currentRoute = 0;
+    if (nextRouteButton) nextRouteButton->hide();
 
     if (pathInfoWidget) pathInfoWidget->hide();
 
@@ -595,16 +692,26 @@ void GalaxyView::resetPathSelection() {
 }
 
 void GalaxyView::calculateShortestPath() {
-    DijkstraPathList<CelestialObject *> solver;
+    auto snapshot = galaxy->getGraphSnapshot();
+    routes = routePlanner.findKShortestPaths(snapshot->graph, startNodeId, endNodeId, MAX_ROUTES);
+    currentRoute = 0;
+    showRoute(currentRoute);
+}
 
-    std::vector<int> pathIndices = solver.findShortestPath(galaxy->getGraph(), startNodeId, endNodeId);
+void GalaxyView::showRoute(int index) {
+    std::vector<int> pathIndices;
+    if (index >= 0 && index < static_cast<int>(routes.size())) {
+        pathIndices = routes[index].vertices;
+    }
 
     pathEdges.clear();
-    if (pathIndices.empty()) {
-    } else {
-        for (size_t i = 0; i < pathIndices.size() - 1; ++i) {
-            pathEdges.push_back({pathIndices[i], pathIndices[i + 1]});
-        }
+    for (size_t i = 0; i + 1 < pathIndices.size(); ++i) {
+        pathEdges.push_back({pathIndices[i], pathIndices[i + 1]});
+    }
+
+    if (nextRouteButton) {
+        nextRouteButton->setVisible(routes.size() > 1);
+        nextRouteButton->setText(QString("Route %1/%2").arg(index + 1).arg(routes.size()));
     }
     if (graphWidget) {
         graphWidget->setHighlightedNodes(pathIndices);
@@ -612,6 +719,12 @@ void GalaxyView::calculateShortestPath() {
     updateGraphDisplay();
 }
 
+void GalaxyView::onNextRouteClicked() {
+    if (routes.size() < 2) return;
+    currentRoute = (currentRoute + 1) % static_cast<int>(routes.size());
+    showRoute(currentRoute);
+}
+
 void GalaxyView::setupPathInfoWidget() {
     pathInfoWidget = new QWidget(this);
 
@@ -644,12 +757,23 @@ void GalaxyView::setupPathInfoWidget() {
     );
     pathDistanceLabel->setAlignment(Qt::AlignCenter);
 
+    nextRouteButton = new QPushButton("Route 1/1", pathInfoWidget);
+    nextRouteButton->setStyleSheet(
+        "QPushButton { background: transparent; border: 1px solid #00aaff; border-radius: 8px;"
+        "  color: #00aaff; font-family: 'Segoe UI'; font-size: 12px; padding: 2px 8px; }"
+        "QPushButton:hover { background-color: rgba(0, 170, 255, 60); }"
+    );
+    nextRouteButton->setCursor(Qt::PointingHandCursor);
+    nextRouteButton->hide();
+    connect(nextRouteButton, &QPushButton::clicked, this, &GalaxyView::onNextRouteClicked);
+
     layout->addWidget(pathStatusLabel);
     layout->addWidget(pathDetailsLabel);
     layout->addWidget(pathDistanceLabel);
+    layout->addWidget(nextRouteButton, 0, Qt::AlignCenter);
 
     pathInfoWidget->setLayout(layout);
-    pathInfoWidget->resize(240, 140);
+    pathInfoWidget->resize(240, 170);
     pathInfoWidget->hide();
 }
 
@@ -833,6 +957,7 @@ void GalaxyView::editStarSystem(StarSystem *system) {
     if (dlg.exec() == QDialog::Accepted) {
         dlg.saveChanges();
         showObjectParameters(system);
+        graphWidget->refreshPlanetOrbits();
         updateGraphDisplay();
         QApplication::processEvents();
     }
@@ -874,6 +999,8 @@ void GalaxyView::applySpaceStyle() {
 
     if (paramsButton) paramsButton->setStyleSheet(btnStyle);
     if (editButton) editButton->setStyleSheet(btnStyle);
+    if (saveStateButton) saveStateButton->setStyleSheet(btnStyle);
+    if (loadStateButton) loadStateButton->setStyleSheet(btnStyle);
     if (zoomOutButton) zoomOutButton->setStyleSheet(btnStyle);
 
     QString windowStyle =
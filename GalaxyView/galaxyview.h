@@ -6,6 +6,7 @@
 #include "Galaxy.h"
 #include "GraphList.h"
 #include "DijkstraList.h"
+#include "KShortestPathsList.h"
 #include "nlohmann/json.hpp"
 #include "GraphWidget.h"
 #include <cmath>
@@ -14,8 +15,11 @@
 #include <QPushButton>
 #include "PhysicsEngine.h"
 #include "BlackHoleGravityField.h"
+#include "BarnesHutGravityField.h"
 #include "CelestialBodyToRigidWrapper.h"
 #include "GalaxyPhysicsController.h"
+#include "SimulationThread.h"
+#include "MultilevelLayout.h"
 
 // Forward declarations to avoid circular dependencies
 class GalaxyEditDialog;
@@ -134,15 +138,37 @@ private slots:
     void on_editObjectButton_clicked();
 
     /**
-     * @brief Qt Slot: Called on each physics timer tick.
-     * Updates the positions of objects based on physics calculations.
+     * @brief Qt Slot: Called on each frame timer tick.
+     * Takes the newest snapshot from the simulation thread, interpolates the object
+     * positions between its last two steps and updates edge lengths and the display.
      */
-    void onPhysicsTimerTick();
+    void onFrameTimerTick();
+
+    /**
+     * @brief Qt Slot: Called when the "Route" button in the path window is clicked.
+     * Cycles the highlighted route through the alternatives found by calculateShortestPath().
+     */
+    void onNextRouteClicked();
+
+    /**
+     * @brief Qt Slot: Called when the "Save Simulation" button is clicked.
+     * Writes the physics state to a checkpoint file chosen by the user; the simulation
+     * thread is paused while the state is copied.
+     */
+    void on_saveStateButton_clicked();
+
+    /**
+     * @brief Qt Slot: Called when the "Load Simulation" button is clicked.
+     * Regenerates the galaxy a checkpoint was saved from (the random generator is reset to
+     * the checkpoint's generation state, so the same objects get the same keys) and then
+     * continues from the saved physics state.
+     */
+    void on_loadStateButton_clicked();
 
 private:
     double viewScale = 0.2; ///< Current scale for rendering.
     Ui::GalaxyView *ui; ///< Pointer to the UI namespace object.
-    Galaxy<GraphList<CelestialObject *> > *galaxy = nullptr; ///< Pointer to the core Galaxy data structure.
+    Galaxy<GraphList<CelestialObject *, double> > *galaxy = nullptr; ///< Pointer to the core Galaxy data structure.
 
     /**
      * @brief Synchronizes the data in the parameters window with the currently selected object.
@@ -160,6 +186,9 @@ private:
     RandomGenerator *rngPtr = nullptr; ///< Pointer to the shared random generator.
     nlohmann::json *dataPtr = nullptr; ///< Pointer to the loaded configuration data.
     QPushButton *editButton = nullptr; ///< UI button for editing.
+    QPushButton *saveStateButton = nullptr; ///< Saves the physics state to a checkpoint.
+    QPushButton *loadStateButton = nullptr; ///< Regenerates a saved galaxy and continues its physics state.
+    std::string generationState; ///< Generator state before the galaxy was generated (see PhysicsCheckpoint).
     QPushButton *zoomOutButton = nullptr; ///< UI button for resetting zoom.
     std::vector<QPointF> vertexPositions; ///< Cached screen positions of vertices.
 
@@ -183,7 +212,9 @@ private:
     PhysicsEngine *physicsEngine = nullptr; ///< The core physics simulation engine.
     GalaxyPhysicsController *physicsController = nullptr; ///< High-level controller for galaxy-specific physics.
     BlackHoleGravityField *blackHoleField = nullptr; ///< Special gravity field representing the galactic center.
-    QTimer *simulationTimer = nullptr; ///< Timer that drives the physics update loop.
+    BarnesHutGravityField *bodyGravityField = nullptr; ///< Mutual gravity between the celestial objects.
+    SimulationThread *simulationThread = nullptr; ///< Steps the physics off the GUI thread.
+    QTimer *frameTimer = nullptr; ///< Timer that shows the latest physics snapshot at the display rate.
 
     /**
      * @brief Initializes the Bullet physics simulation and gravity fields.
@@ -192,14 +223,22 @@ private:
 
     /**
      * @brief Scans the galaxy for new objects that don't have a physics body yet.
+     * Pauses the simulation thread while the bodies are added.
      */
     void checkForNewObjects();
 
     /**
      * @brief Wraps a CelestialObject in a rigid body and adds it to the physics world.
-     * @param obj The object to add to physics.
+     * @param index Index of the object in the galaxy; the body is registered under it.
      */
-    void createPhysicsBody(CelestialObject *obj);
+    void createPhysicsBody(int index);
+
+    /**
+     * @brief Removes the physics body of a removed object; the other bodies keep running.
+     * Pauses the simulation thread while the body is taken out.
+     * @param index Index of the object in the galaxy.
+     */
+    void removePhysicsBody(int index);
 
     /**
      * @brief Maps physics world coordinates to screen pixel coordinates.
@@ -209,10 +248,21 @@ private:
      */
     QPointF physicsToScreen(double x, double y);
 
+    /**
+     * @brief Sets every edge weight to the drawn distance of its ends, publishes the graph
+     * for the route planner and refreshes the shown path length. Called once per physics snapshot.
+     */
+    void updateEdgeWeights();
+
     int startNodeId = -1; ///< ID of the starting node for pathfinding.
     int endNodeId = -1; ///< ID of the destination node for pathfinding.
 
-    std::vector<std::pair<int, int> > pathEdges; ///< List of edge pairs forming the shortest path.
+    std::vector<std::pair<int, int> > pathEdges; ///< List of edge pairs forming the highlighted route.
+
+    static constexpr int MAX_ROUTES = 3; ///< Number of alternative routes offered between two objects.
+    KShortestPathsList<CelestialObject *, double> routePlanner; ///< Yen's k-shortest paths engine (keeps its workspace).
+    std::vector<WeightedPath<double> > routes; ///< Routes from the last calculation, cheapest first.
+    int currentRoute = 0; ///< Index of the highlighted route in `routes`.
 
     /**
      * @brief Resets current pathfinding selection and highlights.
@@ -220,14 +270,22 @@ private:
     void resetPathSelection();
 
     /**
-     * @brief Calculates the shortest path between startNodeId and endNodeId using Dijkstra.
+     * @brief Calculates up to MAX_ROUTES loopless routes between startNodeId and endNodeId
+     * and highlights the cheapest one.
      */
     void calculateShortestPath();
 
+    /**
+     * @brief Highlights one of the calculated routes.
+     * @param index Index into `routes`.
+     */
+    void showRoute(int index);
+
     QWidget *pathInfoWidget = nullptr; ///< UI container for pathfinding information.
     QLabel *pathStatusLabel = nullptr; ///< Label showing current status (e.g., "Select target").
     QLabel *pathDetailsLabel = nullptr; ///< Label showing path sequence or errors.
     QLabel *pathDistanceLabel = nullptr; ///< Label showing the total cost of the path.
+    QPushButton *nextRouteButton = nullptr; ///< Cycles through alternative routes.
 
     /**
      * @brief Creates and initializes the path information UI elements.
@@ -0,0 +1,170 @@
+#include "gtest/gtest.h"
+#include "BarnesHutTree.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Bodies {
+        std::vector<double> x, y, z, m;
+        int size() const { return static_cast<int>(x.size()); }
+    };
+
+    Bodies randomBodies(int n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> pos(-1000.0, 1000.0);
+        std::uniform_real_distribution<double> mass(0.1, 10.0);
+        Bodies b;
+        for (int i = 0; i < n; ++i) {
+            b.x.push_back(pos(rng));
+            b.y.push_back(pos(rng));
+            b.z.push_back(pos(rng) * 0.1);
+            b.m.push_back(mass(rng));
+        }
+        return b;
+    }
+
+    void directSum(const Bodies &b, double G, double eps, std::vector<double> &ax, std::vector<double> &ay, std::vector<double> &az) {
+        int n = b.size();
+        ax.assign(n, 0); ay.assign(n, 0); az.assign(n, 0);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (i == j) continue;
+                double dx = b.x[j] - b.x[i], dy = b.y[j] - b.y[i], dz = b.z[j] - b.z[i];
+                double r2 = dx * dx + dy * dy + dz * dz + eps * eps;
+                double s = G * b.m[j] / (r2 * std::sqrt(r2));
+                ax[i] += s * dx; ay[i] += s * dy; az[i] += s * dz;
+            }
+        }
+    }
+}
+
+TEST(BarnesHutTreeTest, ZeroOpeningAngleMatchesDirectSum) {
+    Bodies b = randomBodies(300, 1);
+    BarnesHutTree tree;
+    tree.build(b.x.data(), b.y.data(), b.z.data(), b.m.data(), b.size());
+
+    std::vector<double> ax(b.size()), ay(b.size()), az(b.size());
+    tree.computeAccelerations(2.0, 0.0, 0.5, ax.data(), ay.data(), az.data());
+
+    std::vector<double> ex, ey, ez;
+    directSum(b, 2.0, 0.5, ex, ey, ez);
+    for (int i = 0; i < b.size(); ++i) {
+        EXPECT_NEAR(ax[i], ex[i], 1e-9 * (1 + std::abs(ex[i])));
+        EXPECT_NEAR(ay[i], ey[i], 1e-9 * (1 + std::abs(ey[i])));
+        EXPECT_NEAR(az[i], ez[i], 1e-9 * (1 + std::abs(ez[i])));
+    }
+}
+
+TEST(BarnesHutTreeTest, ApproximationErrorIsSmall) {
+    Bodies b = randomBodies(2000, 2);
+    BarnesHutTree tree;
+    tree.build(b.x.data(), b.y.data(), b.z.data(), b.m.data(), b.size());
+
+    std::vector<double> ax(b.size()), ay(b.size()), az(b.size());
+    tree.computeAccelerations(1.0, 0.5, 1.0, ax.data(), ay.data(), az.data());
+
+    std::vector<double> ex, ey, ez;
+    directSum(b, 1.0, 1.0, ex, ey, ez);
+
+    double errSq = 0, normSq = 0;
+    for (int i = 0; i < b.size(); ++i) {
+        double dx = ax[i] - ex[i], dy = ay[i] - ey[i], dz = az[i] - ez[i];
+        errSq += dx * dx + dy * dy + dz * dz;
+        normSq += ex[i] * ex[i] + ey[i] * ey[i] + ez[i] * ez[i];
+    }
+    EXPECT_LT(std::sqrt(errSq / normSq), 0.01) << "theta = 0.5 should be within about 1% RMS";
+}
+
+TEST(BarnesHutTreeTest, PotentialsMatchDirectSum) {
+    Bodies b = randomBodies(1500, 6);
+    BarnesHutTree tree;
+    tree.build(b.x.data(), b.y.data(), b.z.data(), b.m.data(), b.size());
+
+    std::vector<double> exact(b.size(), 0.0);
+    for (int i = 0; i < b.size(); ++i) {
+        for (int j = 0; j < b.size(); ++j) {
+            if (i == j) continue;
+            double dx = b.x[j] - b.x[i], dy = b.y[j] - b.y[i], dz = b.z[j] - b.z[i];
+            exact[i] -= 2.0 * b.m[j] / std::sqrt(dx * dx + dy * dy + dz * dz + 0.25);
+        }
+    }
+
+    std::vector<double> phi(b.size());
+    tree.computePotentials(2.0, 0.0, 0.5, phi.data());
+    for (int i = 0; i < b.size(); ++i) EXPECT_NEAR(phi[i], exact[i], 1e-9 * std::abs(exact[i]));
+
+    tree.computePotentials(2.0, 0.5, 0.5, phi.data());
+    double energy = 0, exactEnergy = 0;
+    for (int i = 0; i < b.size(); ++i) {
+        EXPECT_NEAR(phi[i], exact[i], 0.01 * std::abs(exact[i]));
+        energy += b.m[i] * phi[i];
+        exactEnergy += b.m[i] * exact[i];
+    }
+    EXPECT_NEAR(energy, exactEnergy, 5e-3 * std::abs(exactEnergy));
+}
+
+TEST(BarnesHutTreeTest, NodesSummarizeTheirBodies) {
+    Bodies b = randomBodies(500, 3);
+    BarnesHutTree tree(4);
+    tree.build(b.x.data(), b.y.data(), b.z.data(), b.m.data(), b.size());
+
+    const auto &root = tree.nodes()[0];
+    EXPECT_EQ(root.begin, 0);
+    EXPECT_EQ(root.end, b.size());
+
+    double total = 0, cx = 0;
+    for (int i = 0; i < b.size(); ++i) {
+        total += b.m[i];
+        cx += b.m[i] * b.x[i];
+    }
+    EXPECT_NEAR(root.mass, total, 1e-9 * total);
+    EXPECT_NEAR(root.comX, cx / total, 1e-9);
+
+    std::vector<int> seen(b.size(), 0);
+    for (int i: tree.order()) ++seen[i];
+    for (int count: seen) EXPECT_EQ(count, 1);
+
+    for (const auto &node: tree.nodes()) {
+        if (node.firstChild < 0) {
+            EXPECT_LE(node.end - node.begin, 4);
+            continue;
+        }
+        EXPECT_EQ(tree.nodes()[node.firstChild].begin, node.begin);
+        EXPECT_EQ(tree.nodes()[node.firstChild + node.childCount - 1].end, node.end);
+    }
+}
+
+TEST(BarnesHutTreeTest, CoincidentAndDegenerateInput) {
+    BarnesHutTree tree(1);
+    tree.build(nullptr, nullptr, nullptr, nullptr, 0);
+    EXPECT_EQ(tree.bodyCount(), 0);
+    EXPECT_TRUE(tree.nodes().empty());
+
+    // Many bodies at the same point must not recurse forever.
+    std::vector<double> x(20, 5.0), y(20, 5.0), z(20, 5.0), m(20, 1.0);
+    x.push_back(15.0); y.push_back(5.0); z.push_back(5.0); m.push_back(1.0);
+    tree.build(x.data(), y.data(), z.data(), m.data(), static_cast<int>(x.size()));
+
+    std::vector<double> ax(x.size()), ay(x.size()), az(x.size());
+    tree.computeAccelerations(1.0, 0.5, 0.0, ax.data(), ay.data(), az.data());
+    for (std::size_t i = 0; i < x.size(); ++i) EXPECT_TRUE(std::isfinite(ax[i]));
+    EXPECT_NEAR(ax[0], 1.0 / 100.0, 1e-12) << "Only the lone body at distance 10 pulls";
+    EXPECT_NEAR(ax[20], -20.0 / 100.0, 1e-12);
+}
+
+TEST(BarnesHutTreeTest, WorkerPoolGivesIdenticalResults) {
+    Bodies b = randomBodies(3000, 4);
+    BarnesHutTree tree;
+    tree.build(b.x.data(), b.y.data(), b.z.data(), b.m.data(), b.size());
+
+    std::vector<double> ax(b.size()), ay(b.size()), az(b.size());
+    tree.computeAccelerations(1.0, 0.5, 1.0, ax.data(), ay.data(), az.data());
+
+    WorkerPool pool(4);
+    std::vector<double> px(b.size()), py(b.size()), pz(b.size());
+    tree.computeAccelerations(1.0, 0.5, 1.0, px.data(), py.data(), pz.data(), &pool);
+    EXPECT_EQ(ax, px);
+    EXPECT_EQ(ay, py);
+    EXPECT_EQ(az, pz);
+}
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "BlockTimestepIntegrator.h"
+#include "ParticleIntegrator.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    const double CENTRAL_MASS = 1000.0;
+
+    void centralGravity(ParticleState &state, const std::vector<int> &active) {
+        for (int i: active) {
+            double r2 = state.x[i] * state.x[i] + state.y[i] * state.y[i] + state.z[i] * state.z[i];
+            double s = -CENTRAL_MASS / (r2 * std::sqrt(r2));
+            state.ax[i] += s * state.x[i];
+            state.ay[i] += s * state.y[i];
+            state.az[i] += s * state.z[i];
+        }
+    }
+
+    double orbitalEnergy(const ParticleState &state, int i) {
+        double v2 = state.vx[i] * state.vx[i] + state.vy[i] * state.vy[i] + state.vz[i] * state.vz[i];
+        double r = std::sqrt(state.x[i] * state.x[i] + state.y[i] * state.y[i] + state.z[i] * state.z[i]);
+        return 0.5 * v2 - CENTRAL_MASS / r;
+    }
+
+    /// Orbit with semi-major axis 50 and eccentricity 0.9, starting at apocenter (r = 95).
+    int addEccentricOrbit(ParticleState &state) {
+        const double a = 50.0, e = 0.9;
+        int i = state.add(a * (1 + e), 0.0, 0.0, 1.0, 0.0);
+        state.vy[i] = std::sqrt(CENTRAL_MASS / a * (1 - e) / (1 + e));
+        return i;
+    }
+}
+
+TEST(BlockTimestepIntegratorTest, LevelsFollowAcceleration) {
+    ParticleState state;
+    state.add(2.0, 0.0, 0.0, 1.0, 0.0);
+    state.add(500.0, 0.0, 0.0, 1.0, 0.0);
+    state.vy[0] = std::sqrt(CENTRAL_MASS / 2.0);
+    state.vy[1] = std::sqrt(CENTRAL_MASS / 500.0);
+
+    BlockTimestepIntegrator integrator;
+    integrator.step(state, 0.5, centralGravity);
+
+    EXPECT_EQ(integrator.level(1), 0);
+    EXPECT_EQ(integrator.level(0), integrator.options().maxLevel);
+    // The inner body was evaluated 2^maxLevel times, the outer one once (plus one initial evaluation each).
+    EXPECT_EQ(integrator.forceEvaluations(), 2u + (1u << integrator.options().maxLevel) + 1u);
+}
+
+TEST(BlockTimestepIntegratorTest, FreeBodiesStaySynchronized) {
+    ParticleState state;
+    for (int i = 0; i < 3; ++i) {
+        state.add(i, 0.0, 0.0, 1.0, 0.0);
+        state.vx[i] = 1.0 + i;
+    }
+    BlockTimestepIntegrator::Options options;
+    options.maxLevel = 3;
+    BlockTimestepIntegrator integrator(options);
+
+    // Body 0 feels a strong constant pull (fine level); the others feel nothing.
+    auto force = [](ParticleState &s, const std::vector<int> &active) {
+        for (int i: active)
+            if (i == 0) s.ay[i] += 1000.0;
+    };
+    for (int block = 0; block < 4; ++block) integrator.step(state, 0.25, force);
+
+    EXPECT_GT(integrator.level(0), 0);
+    EXPECT_NEAR(state.y[0], 0.5 * 1000.0 * 1.0 * 1.0, 1e-9) << "Leapfrog is exact for constant force";
+    EXPECT_DOUBLE_EQ(state.x[1], 1.0 + 2.0 * 1.0);
+    EXPECT_DOUBLE_EQ(state.x[2], 2.0 + 3.0 * 1.0);
+}
+
+TEST(BlockTimestepIntegratorTest, EccentricOrbitBeatsSharedStepPerEvaluation) {
+    const double blockStep = 0.5;
+    const int blocks = 2000; // About 4 orbits (period 2*pi*sqrt(a^3 / M) ~ 222).
+
+    // Largest energy error seen at the block boundaries; the shared step's error
+    // peaks during each pericenter passage and mostly recovers afterwards.
+    ParticleState adaptive;
+    int i = addEccentricOrbit(adaptive);
+    const double e0 = orbitalEnergy(adaptive, i);
+    BlockTimestepIntegrator integrator;
+    double adaptiveError = 0;
+    for (int b = 0; b < blocks; ++b) {
+        integrator.step(adaptive, blockStep, centralGravity);
+        adaptiveError = std::max(adaptiveError, std::abs(orbitalEnergy(adaptive, i) - e0));
+    }
+
+    // Shared step with the same number of force evaluations.
+    ParticleState shared;
+    addEccentricOrbit(shared);
+    const int steps = static_cast<int>(integrator.forceEvaluations());
+    const double dt = blockStep * blocks / steps;
+    const std::vector<int> all = {0};
+    double sharedError = 0;
+    for (int s = 0; s < steps; ++s) {
+        ParticleIntegrator::step(shared, dt, [&](ParticleState &state) { centralGravity(state, all); });
+        // Sampled at the first step after each block boundary, like the adaptive run.
+        if (std::floor((s + 1) * dt / blockStep) > std::floor(s * dt / blockStep))
+            sharedError = std::max(sharedError, std::abs(orbitalEnergy(shared, 0) - e0));
+    }
+
+    EXPECT_LT(steps, blocks * (1 << integrator.options().maxLevel) / 4) << "Fine steps only near pericenter";
+    EXPECT_LT(adaptiveError, 0.05 * std::abs(e0));
+    EXPECT_LT(4 * adaptiveError, sharedError);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "TestFixtures.h"
+#include "DijkstraDenseMatrix.h"
+#include <random>
+
+TEST(DijkstraDenseMatrixTest, BasicPath) {
+    GraphMatrix<std::string> g;
+    g.addVertex(1, "A");
+    g.addVertex(2, "B");
+    g.addVertex(3, "C");
+    g.addEdge(1, 2, 4);
+    g.addEdge(2, 3, 5);
+    g.addEdge(1, 3, 10);
+
+    DijkstraDenseMatrixAlgorithm<std::string> alg;
+    EXPECT_EQ(alg.run(g, 1, 3), 9) << "Shortest path 1→2→3 should have total weight 9";
+}
+
+TEST(DijkstraDenseMatrixTest, NoPathAndInvalidNodes) {
+    GraphMatrix<std::string, float> g;
+    g.addVertex(1, "A");
+    g.addVertex(2, "B");
+    g.addVertex(3, "C");
+    g.addEdge(1, 2, 3.0f);
+
+    DijkstraDenseMatrixAlgorithm<std::string, float> alg;
+    constexpr int NO_PATH = -1;
+    EXPECT_EQ(alg.run(g, 1, 3), NO_PATH);
+    EXPECT_EQ(alg.run(g, 0, 2), NO_PATH);
+    EXPECT_EQ(alg.run(g, 1, 4), NO_PATH);
+}
+
+TEST(DijkstraDenseMatrixTest, RealValuedWeights) {
+    GraphMatrix<std::string, double> g;
+    g.addVertex(1, "A");
+    g.addVertex(2, "B");
+    g.addVertex(3, "C");
+    g.addVertex(4, "D");
+    g.addEdge(1, 2, 1.25);
+    g.addEdge(2, 4, 1.5);
+    g.addEdge(1, 3, 2.5);
+    g.addEdge(3, 4, 0.125);
+
+    DijkstraDenseMatrixAlgorithm<std::string, double> alg;
+    EXPECT_DOUBLE_EQ(alg.shortestDistance(g, 1, 4), 2.625);
+
+    ShortestPathTree<double> tree = denseDijkstraShortestPaths(g, 0);
+    EXPECT_EQ(tree.parent[3], 2) << "D is reached through C";
+    EXPECT_EQ(tree.parent[2], 0);
+}
+
+TEST(DijkstraDenseMatrixTest, MatchesHeapDijkstra) {
+    GraphMatrix<int, double> g;
+    const int N = 40;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> weight(0.5, 20.0);
+    std::bernoulli_distribution hasEdge(0.15);
+
+    for (int i = 0; i < N; ++i) g.addVertex(i, i);
+    for (int i = 0; i < N; ++i)
+        for (int j = i + 1; j < N; ++j)
+            if (hasEdge(rng)) g.addEdge(i, j, weight(rng));
+
+    for (int start = 0; start < N; start += 7) {
+        ShortestPathTree<double> dense = denseDijkstraShortestPaths(g, start);
+        ShortestPathTree<double> heap = dijkstraShortestPaths(g, start);
+        for (int v = 0; v < N; ++v) {
+            EXPECT_DOUBLE_EQ(dense.dist[v], heap.dist[v]) << "start " << start << ", vertex " << v;
+        }
+    }
+}
@@ -56,3 +56,17 @@ TEST_F(DijkstraListFixture, InvalidNodes) {
     EXPECT_EQ(dist1, NO_PATH) << "Invalid start node should return -1";
     EXPECT_EQ(dist2, NO_PATH) << "Invalid end node should return -1";
 }
+
+TEST(DijkstraListWeightTest, RealValuedWeights) {
+    GraphList<std::string, double> g;
+    g.addVertex(1, "A");
+    g.addVertex(2, "B");
+    g.addVertex(3, "C");
+    g.addEdge(1, 2, 0.4);
+    g.addEdge(2, 3, 0.45);
+    g.addEdge(1, 3, 0.9);
+
+    DijkstraListAlgorithm<std::string, double> alg;
+    EXPECT_DOUBLE_EQ(alg.shortestDistance(g, 1, 3), 0.85) << "Fractional weights must not be truncated";
+    EXPECT_EQ(alg.run(g, 1, 3), 1) << "run() rounds the real distance to the nearest int";
+}
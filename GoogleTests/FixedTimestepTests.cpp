@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+#include "FixedTimestep.h"
+#include <random>
+
+TEST(FixedTimestepTest, ShortFramesAccumulate) {
+    FixedTimestep timestep(0.01);
+    EXPECT_EQ(timestep.advance(0.004), 0);
+    EXPECT_EQ(timestep.advance(0.004), 0);
+    EXPECT_EQ(timestep.advance(0.004), 1);
+    EXPECT_NEAR(timestep.alpha(), 0.2, 1e-9);
+    EXPECT_EQ(timestep.advance(0.025), 2);
+    EXPECT_NEAR(timestep.alpha(), 0.7, 1e-9);
+}
+
+TEST(FixedTimestepTest, IrregularFramesKeepRealTime) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> frame(0.0, 0.05);
+    FixedTimestep timestep(1.0 / 60.0, 8);
+
+    double total = 0;
+    long long steps = 0;
+    for (int i = 0; i < 10000; ++i) {
+        double elapsed = frame(rng);
+        total += elapsed;
+        steps += timestep.advance(elapsed);
+        ASSERT_GE(timestep.alpha(), 0.0);
+        ASSERT_LT(timestep.alpha(), 1.0);
+    }
+    EXPECT_NEAR((steps + timestep.alpha()) * timestep.stepSize(), total, 1e-6);
+    EXPECT_EQ(timestep.droppedTime(), 0.0);
+}
+
+TEST(FixedTimestepTest, SpikesAreClampedAndDropped) {
+    FixedTimestep timestep(0.01, 4);
+    EXPECT_EQ(timestep.advance(1.005), 4);
+    EXPECT_NEAR(timestep.droppedTime(), 0.96, 1e-9);
+    EXPECT_NEAR(timestep.alpha(), 0.5, 1e-6) << "The fractional step survives the clamp";
+    EXPECT_EQ(timestep.advance(0.0), 0) << "No catch-up burst after a spike";
+
+    EXPECT_EQ(timestep.advance(-1.0), 0);
+    timestep.reset();
+    EXPECT_EQ(timestep.alpha(), 0.0);
+    EXPECT_EQ(timestep.droppedTime(), 0.0);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "TestFixtures.h"
+#include "FloydWarshallMatrix.h"
+#include "DijkstraDenseMatrix.h"
+#include <random>
+
+TEST(FloydWarshallMatrixTest, BasicPath) {
+    GraphMatrix<std::string> g;
+    g.addVertex(1, "A");
+    g.addVertex(2, "B");
+    g.addVertex(3, "C");
+    g.addEdge(1, 2, 4);
+    g.addEdge(2, 3, 5);
+    g.addEdge(1, 3, 10);
+
+    FloydWarshallMatrixAlgorithm<std::string> alg;
+    EXPECT_EQ(alg.run(g, 1, 3), 9) << "Shortest path 1→2→3 should have total weight 9";
+
+    AllPairsDistances<int> table = alg.allPairs(g);
+    EXPECT_EQ(table.at(0, 0), 0);
+    EXPECT_EQ(table.at(2, 0), 9) << "Edges are undirected";
+}
+
+TEST(FloydWarshallMatrixTest, UnreachablePairs) {
+    GraphMatrix<std::string> g;
+    g.addVertex(1, "A");
+    g.addVertex(2, "B");
+    g.addVertex(3, "C");
+    g.addEdge(1, 2, 3);
+
+    FloydWarshallMatrixAlgorithm<std::string> alg;
+    constexpr int NO_PATH = -1;
+    EXPECT_EQ(alg.run(g, 1, 3), NO_PATH);
+    EXPECT_EQ(alg.run(g, 1, 4), NO_PATH);
+    EXPECT_EQ(alg.allPairs(g).at(2, 1), AllPairsDistances<int>::unreachable);
+}
+
+TEST_F(SimdKernelsFixture, FloydWarshallMatchesDijkstraAtEveryLevel) {
+    const int N = 70; // More than one tile with blockSize 16, with a partial last tile.
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> weight(0.5, 50.0);
+    std::bernoulli_distribution hasEdge(0.08);
+
+    std::vector<Vertex<int> > vertices(N);
+    std::vector<Edge<int, double> > edges;
+    for (int i = 0; i < N; ++i) {
+        vertices[i].setId(i);
+        vertices[i].setData(i);
+        for (int j = i + 1; j < N; ++j) {
+            if (!hasEdge(rng)) continue;
+            Edge<int, double> edge;
+            edge.connect(i, j);
+            edge.weight = weight(rng);
+            edges.push_back(edge);
+        }
+    }
+    GraphMatrix<int, double> g(vertices, edges);
+
+    for (auto level: supportedLevels()) {
+        SimdKernels::setLevel(level);
+        AllPairsDistances<double> table = floydWarshall(g, 16);
+        for (int s = 0; s < N; s += 9) {
+            ShortestPathTree<double> tree = denseDijkstraShortestPaths(g, s);
+            for (int v = 0; v < N; ++v) {
+                EXPECT_NEAR(table.at(s, v), tree.dist[v], 1e-9)
+                    << SimdKernels::levelName(level) << ": " << s << " -> " << v;
+            }
+        }
+    }
+}
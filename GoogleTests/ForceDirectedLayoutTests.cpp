@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "ForceDirectedLayout.h"
+#include "WorkerPool.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Layout {
+        std::vector<double> x, y, z;
+    };
+
+    Layout scrambled(int n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> pos(-50.0, 50.0);
+        Layout l;
+        for (int i = 0; i < n; ++i) {
+            l.x.push_back(pos(rng));
+            l.y.push_back(pos(rng));
+            l.z.push_back(pos(rng));
+        }
+        return l;
+    }
+
+    double distance(const Layout &l, int a, int b) {
+        return std::sqrt((l.x[a] - l.x[b]) * (l.x[a] - l.x[b]) + (l.y[a] - l.y[b]) * (l.y[a] - l.y[b]) +
+                         (l.z[a] - l.z[b]) * (l.z[a] - l.z[b]));
+    }
+}
+
+TEST(ForceDirectedLayoutTest, TriangleReachesRestLengths) {
+    ForceDirectedLayout layout;
+    layout.setGraph(3, {0, 1, 2}, {1, 2, 0}, {10.0, 10.0, 10.0});
+    Layout l = scrambled(3, 1);
+
+    int iterations = layout.run(l.x.data(), l.y.data(), l.z.data());
+
+    EXPECT_LT(iterations, ForceDirectedLayout::Options().maxIterations);
+    EXPECT_NEAR(distance(l, 0, 1), 10.0, 0.5);
+    EXPECT_NEAR(distance(l, 1, 2), 10.0, 0.5);
+    EXPECT_NEAR(distance(l, 2, 0), 10.0, 0.5);
+}
+
+TEST(ForceDirectedLayoutTest, PlanarKeepsDepthAndSeparatesVertices) {
+    const int n = 200;
+    std::vector<int> from, to;
+    std::vector<double> rest;
+    for (int i = 1; i < n; ++i) {
+        from.push_back((i - 1) / 2);
+        to.push_back(i);
+        rest.push_back(20.0);
+    }
+    ForceDirectedLayout layout;
+    layout.setGraph(n, from, to, rest);
+    Layout l = scrambled(n, 2);
+    std::vector<double> z0 = l.z;
+
+    ForceDirectedLayout::Options options;
+    options.planar = true;
+    layout.run(l.x.data(), l.y.data(), l.z.data(), options);
+
+    EXPECT_EQ(l.z, z0);
+    double sum = 0;
+    for (size_t e = 0; e < from.size(); ++e) sum += std::hypot(l.x[from[e]] - l.x[to[e]], l.y[from[e]] - l.y[to[e]]);
+    EXPECT_GT(sum / from.size(), 10.0);
+    EXPECT_LT(sum / from.size(), 60.0);
+}
+
+TEST(ForceDirectedLayoutTest, WorkerPoolGivesIdenticalResults) {
+    const int n = 3000;
+    std::mt19937 rng(3);
+    std::vector<int> from, to;
+    std::vector<double> rest;
+    for (int i = 1; i < n; ++i) {
+        from.push_back(std::uniform_int_distribution<int>(0, i - 1)(rng));
+        to.push_back(i);
+        rest.push_back(std::uniform_real_distribution<double>(5.0, 15.0)(rng));
+    }
+    ForceDirectedLayout::Options options;
+    options.maxIterations = 30;
+
+    Layout serial = scrambled(n, 4);
+    ForceDirectedLayout serialLayout;
+    serialLayout.setGraph(n, from, to, rest);
+    int serialIterations = serialLayout.run(serial.x.data(), serial.y.data(), serial.z.data(), options);
+
+    WorkerPool pool(4);
+    Layout parallel = scrambled(n, 4);
+    ForceDirectedLayout parallelLayout(&pool);
+    parallelLayout.setGraph(n, from, to, rest);
+    int parallelIterations = parallelLayout.run(parallel.x.data(), parallel.y.data(), parallel.z.data(), options);
+
+    EXPECT_EQ(serialIterations, parallelIterations);
+    EXPECT_EQ(serial.x, parallel.x);
+    EXPECT_EQ(serial.y, parallel.y);
+    EXPECT_EQ(serial.z, parallel.z);
+}
@@ -0,0 +1,109 @@
+#include "TestFixtures.h"
+#include "gtest/gtest.h"
+#include "GraphList.h"
+#include "GraphSnapshot.h"
+#include "DijkstraPathList.h"
+#include "IsConnectedList.h"
+#include <atomic>
+#include <thread>
+
+TEST_F(GraphListFixture, SnapshotStartsEmpty) {
+    GraphSnapshotStore<GraphList<std::string> > store;
+
+    auto snapshot = store.acquire();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->version, 0u);
+    EXPECT_TRUE(snapshot->graph.getVertices().empty());
+}
+
+TEST_F(GraphListFixture, SnapshotIsIsolatedFromLaterEdits) {
+    GraphSnapshotStore<GraphList<std::string> > store;
+    store.publish(g);
+    auto snapshot = store.acquire();
+
+    g.addVertex(4, "D");
+    g.addEdge(3, 4, 2);
+    g.removeEdge(1, 2);
+
+    EXPECT_EQ(snapshot->graph.getVertices().size(), 3) << "Published snapshot must not see new vertices";
+    EXPECT_TRUE(snapshot->graph.edgeExists(1, 2)) << "Published snapshot must not see removed edges";
+    EXPECT_FALSE(snapshot->graph.edgeExists(3, 4));
+
+    store.publish(g);
+    EXPECT_EQ(store.acquire()->graph.getVertices().size(), 4);
+    EXPECT_FALSE(store.acquire()->graph.edgeExists(1, 2));
+}
+
+TEST_F(GraphListFixture, SnapshotVersionsAreMonotonic) {
+    GraphSnapshotStore<GraphList<std::string> > store;
+
+    EXPECT_EQ(store.publish(g), 1u);
+    EXPECT_EQ(store.publish(g), 2u);
+    EXPECT_EQ(store.version(), 2u);
+}
+
+TEST_F(GraphListFixture, QueriesRunOnSnapshot) {
+    GraphSnapshotStore<GraphList<std::string> > store;
+    store.publish(g);
+    auto snapshot = store.acquire();
+
+    DijkstraPathList<std::string> solver;
+    std::vector<int> path = solver.findShortestPath(snapshot->graph, 2, 3);
+    std::vector<int> expected = {1, 0, 2};
+    EXPECT_EQ(path, expected);
+
+    IsConnectedList<std::string> connectivity;
+    EXPECT_EQ(connectivity.isConnected(snapshot->graph), 1);
+}
+
+TEST(GraphSnapshotTest, ConcurrentReadersSeeConsistentVersions) {
+    GraphList<std::string> g;
+    GraphSnapshotStore<GraphList<std::string> > store;
+    const int EDITS = 200;
+
+    g.addVertex(0, "V0");
+    store.publish(g);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+
+    auto reader = [&]() {
+        DijkstraPathList<std::string> solver;
+        while (!done.load()) {
+            auto snapshot = store.acquire();
+            int n = static_cast<int>(snapshot->graph.getVertices().size());
+            // Writer publishes a chain 0-1-...-(n-1), one vertex per version.
+            if (n != static_cast<int>(snapshot->version)) inconsistent++;
+            std::vector<int> path = solver.findShortestPath(snapshot->graph, 0, n - 1);
+            if (static_cast<int>(path.size()) != n) inconsistent++;
+        }
+    };
+
+    std::thread r1(reader);
+    std::thread r2(reader);
+
+    for (int i = 1; i < EDITS; ++i) {
+        g.addVertex(i, "V" + std::to_string(i));
+        g.addEdge(i - 1, i, 1);
+        store.publish(g);
+    }
+    done = true;
+    r1.join();
+    r2.join();
+
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_EQ(store.version(), static_cast<std::uint64_t>(EDITS));
+}
+
+TEST_F(GalaxyListFixture, PublishGraph) {
+    g.addObject(new Star("Sun", 1.0, 5800, Star::starType::Main_sequence_Star));
+    g.addObject(new Star("Alpha", 1.5, 5000, Star::starType::Main_sequence_Star));
+    g.connectObjects(0, 1, 100);
+
+    EXPECT_TRUE(g.getGraphSnapshot()->graph.getVertices().empty()) << "Edits are invisible until published";
+
+    g.publishGraph();
+    auto snapshot = g.getGraphSnapshot();
+    EXPECT_EQ(snapshot->graph.getVertices().size(), 2);
+    EXPECT_TRUE(snapshot->graph.edgeExists(0, 1));
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "GraphList.h"
+#include "GraphMatrix.h"
+#include "GraphCSR.h"
+#include "GraphTraversal.h"
+#include "TestFixtures.h"
+#include <climits>
+
+static_assert(AdjacencyGraph<GraphList<std::string> >);
+static_assert(AdjacencyGraph<GraphMatrix<std::string> >);
+static_assert(AdjacencyGraph<GraphCSR<std::string> >);
+
+/**
+ * @brief Builds the same weighted 6-vertex graph in every representation.
+ *
+ * 0 -4- 1 -1- 2
+ * |     |     |
+ * 2     5     3
+ * |     |     |
+ * 3 -7- 4     5
+ */
+template<typename GraphType>
+static void buildWeighted(GraphType &g) {
+    for (int i = 0; i < 6; ++i) g.addVertex(i, std::string(1, static_cast<char>('A' + i)));
+    g.addEdge(0, 1, 4);
+    g.addEdge(1, 2, 1);
+    g.addEdge(0, 3, 2);
+    g.addEdge(1, 4, 5);
+    g.addEdge(2, 5, 3);
+    g.addEdge(3, 4, 7);
+}
+
+TEST_F(GraphListFixture, CSRMatchesAdjacencyList) {
+    GraphCSR<std::string> csr(g);
+
+    ASSERT_EQ(csr.vertexCount(), g.vertexCount());
+    EXPECT_EQ(csr.adjacencySize(), 4);
+    for (int u = 0; u < g.vertexCount(); ++u) {
+        auto row = csr.neighbors(u);
+        std::vector<std::pair<int, int> > actual(row.begin(), row.end());
+        EXPECT_EQ(actual, g.neighbors(u)) << "Row " << u;
+    }
+}
+
+TEST_F(GraphMatrixFixture, NeighborsSkipMissingEdges) {
+    std::vector<int> row;
+    for (auto [v, w]: g.neighbors(0)) row.push_back(v);
+    EXPECT_EQ(row, (std::vector<int>{1, 2}));
+
+    row.clear();
+    for (auto [v, w]: g.neighbors(1)) row.push_back(v);
+    EXPECT_EQ(row, (std::vector<int>{0}));
+}
+
+TEST(GraphTraversalTest, RepresentationsAgree) {
+    GraphList<std::string> list;
+    GraphMatrix<std::string> matrix;
+    buildWeighted(list);
+    buildWeighted(matrix);
+    GraphCSR<std::string> csr(list);
+
+    // List and CSR share neighbor order; the matrix yields columns in ascending order, so only reachability is compared.
+    for (int start = 0; start < 6; ++start) {
+        EXPECT_EQ(breadthFirstOrder(list, start), breadthFirstOrder(csr, start));
+        EXPECT_EQ(depthFirstOrder(list, start), depthFirstOrder(csr, start));
+        EXPECT_EQ(breadthFirstOrder(matrix, start).size(), 6);
+        EXPECT_EQ(depthFirstOrder(matrix, start).size(), 6);
+
+        ShortestPathTree fromList = dijkstraShortestPaths(list, start);
+        EXPECT_EQ(fromList.dist, dijkstraShortestPaths(matrix, start).dist);
+        EXPECT_EQ(fromList.dist, dijkstraShortestPaths(csr, start).dist);
+    }
+
+    EXPECT_TRUE(isGraphConnected(list));
+    EXPECT_TRUE(isGraphConnected(matrix));
+    EXPECT_TRUE(isGraphConnected(csr));
+}
+
+TEST(GraphTraversalTest, DijkstraDistancesAndParents) {
+    GraphList<std::string> g;
+    buildWeighted(g);
+
+    ShortestPathTree tree = dijkstraShortestPaths(GraphCSR<std::string>(g), 0);
+    EXPECT_EQ(tree.dist, (std::vector<int>{0, 4, 5, 2, 9, 8}));
+    EXPECT_EQ(tree.parent[0], -1);
+    EXPECT_EQ(tree.parent[5], 2);
+    EXPECT_EQ(tree.parent[2], 1);
+}
+
+TEST(GraphTraversalTest, UnreachableAndInvalidStart) {
+    GraphMatrix<std::string> g;
+    g.addVertex(1, "A");
+    g.addVertex(2, "B");
+    g.addVertex(3, "C");
+    g.addEdge(1, 2, 3);
+
+    ShortestPathTree tree = dijkstraShortestPaths(g, 0);
+    EXPECT_EQ(tree.dist[1], 3);
+    EXPECT_EQ(tree.dist[2], INT_MAX);
+    EXPECT_FALSE(isGraphConnected(g));
+
+    EXPECT_TRUE(breadthFirstOrder(g, -1).empty());
+    EXPECT_TRUE(depthFirstOrder(g, 7).empty());
+}
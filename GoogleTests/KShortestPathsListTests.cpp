@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "TestFixtures.h"
+#include "KShortestPathsList.h"
+#include "DijkstraPathList.h"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+
+TEST_F(GraphListFixture, KShortestPathsOnTriangle) {
+    g.addEdge(2, 3, 5);
+
+    KShortestPathsList<std::string> router;
+    auto routes = router.findKShortestPaths(g, 2, 3, 5);
+
+    ASSERT_EQ(routes.size(), 2) << "B and C are joined directly and through A only";
+    EXPECT_EQ(routes[0].vertices, (std::vector<int>{1, 0, 2}));
+    EXPECT_EQ(routes[0].cost, 2);
+    EXPECT_EQ(routes[1].vertices, (std::vector<int>{1, 2}));
+    EXPECT_EQ(routes[1].cost, 5);
+}
+
+TEST_F(GraphListFixture, KShortestPathsInvalidInput) {
+    KShortestPathsList<std::string> router;
+    EXPECT_TRUE(router.findKShortestPaths(g, 1, 9, 3).empty());
+    EXPECT_TRUE(router.findKShortestPaths(g, 1, 2, 0).empty());
+
+    g.addVertex(4, "D");
+    EXPECT_TRUE(router.findKShortestPaths(g, 1, 4, 3).empty()) << "Unreachable target";
+}
+
+TEST(KShortestPathsListTest, FirstPathMatchesDijkstra) {
+    GraphList<std::string, double> g;
+    for (int i = 0; i < 6; ++i) g.addVertex(i, std::string(1, static_cast<char>('A' + i)));
+    g.addEdge(0, 1, 3.0);
+    g.addEdge(0, 2, 2.0);
+    g.addEdge(1, 3, 4.0);
+    g.addEdge(2, 1, 1.0);
+    g.addEdge(2, 3, 2.0);
+    g.addEdge(2, 4, 3.0);
+    g.addEdge(3, 4, 2.0);
+    g.addEdge(3, 5, 1.0);
+    g.addEdge(4, 5, 2.0);
+
+    KShortestPathsList<std::string, double> router;
+    auto routes = router.findKShortestPaths(g, 0, 5, 3);
+    ASSERT_EQ(routes.size(), 3);
+
+    DijkstraPathList<std::string, double> dijkstra;
+    EXPECT_EQ(routes[0].vertices, dijkstra.findShortestPath(g, 0, 5));
+    EXPECT_DOUBLE_EQ(routes[0].cost, 5.0); // A-C-D-F
+    EXPECT_DOUBLE_EQ(routes[1].cost, 7.0); // A-C-E-F
+    EXPECT_DOUBLE_EQ(routes[2].cost, 7.0); // A-B-D-F
+}
+
+TEST(KShortestPathsListTest, MatchesBruteForceEnumeration) {
+    const int N = 9;
+    const int K = 12;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> weight(1, 9);
+    std::bernoulli_distribution hasEdge(0.4);
+
+    GraphList<int> g;
+    for (int i = 0; i < N; ++i) g.addVertex(i, i);
+    for (int i = 0; i < N; ++i)
+        for (int j = i + 1; j < N; ++j)
+            if (hasEdge(rng)) g.addEdge(i, j, weight(rng));
+
+    // Enumerate every simple path from 0 to N-1.
+    std::vector<int> allCosts;
+    std::vector<char> onPath(N, 0);
+    std::function<void(int, int)> walk = [&](int u, int cost) {
+        if (u == N - 1) {
+            allCosts.push_back(cost);
+            return;
+        }
+        onPath[u] = 1;
+        for (auto [v, w]: g.neighbors(u))
+            if (!onPath[v]) walk(v, cost + w);
+        onPath[u] = 0;
+    };
+    walk(0, 0);
+    std::sort(allCosts.begin(), allCosts.end());
+
+    KShortestPathsList<int> router;
+    for (int round = 0; round < 2; ++round) { // The second round reuses the workspace.
+        auto routes = router.findKShortestPaths(g, 0, N - 1, K);
+        ASSERT_EQ(routes.size(), std::min<std::size_t>(K, allCosts.size()));
+
+        std::set<std::vector<int> > unique;
+        for (std::size_t i = 0; i < routes.size(); ++i) {
+            EXPECT_EQ(routes[i].cost, allCosts[i]) << "Route " << i;
+            std::set<int> seen(routes[i].vertices.begin(), routes[i].vertices.end());
+            EXPECT_EQ(seen.size(), routes[i].vertices.size()) << "Routes must be loopless";
+            unique.insert(routes[i].vertices);
+        }
+        EXPECT_EQ(unique.size(), routes.size()) << "Routes must be distinct";
+    }
+}
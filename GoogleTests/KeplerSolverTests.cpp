@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include "KeplerSolver.h"
+#include "ParticleIntegrator.h"
+#include <cmath>
+
+namespace {
+    const double MU = 1000.0;
+
+    void centralGravity(ParticleState &state) {
+        for (int i = 0; i < state.size(); ++i) {
+            double r2 = state.x[i] * state.x[i] + state.y[i] * state.y[i] + state.z[i] * state.z[i];
+            double s = -MU / (r2 * std::sqrt(r2));
+            state.ax[i] += s * state.x[i];
+            state.ay[i] += s * state.y[i];
+            state.az[i] += s * state.z[i];
+        }
+    }
+}
+
+TEST(KeplerSolverTest, StateRoundTripsThroughElements) {
+    const double r[3] = {80.0, 10.0, -5.0}, v[3] = {0.5, 3.0, 0.2};
+    KeplerOrbit orbit;
+    ASSERT_TRUE(KeplerSolver::fromState(r[0], r[1], r[2], v[0], v[1], v[2], MU, orbit));
+    EXPECT_GT(orbit.eccentricity, 0.1);
+    EXPECT_LT(orbit.eccentricity, 1.0);
+
+    // At the epoch and one full period later the body is back at the input state.
+    for (double t : {0.0, KeplerSolver::period(orbit)}) {
+        double x, y, z, vx, vy, vz;
+        KeplerSolver::stateAt(orbit, t, x, y, z, vx, vy, vz);
+        EXPECT_NEAR(x, r[0], 1e-9);
+        EXPECT_NEAR(y, r[1], 1e-9);
+        EXPECT_NEAR(z, r[2], 1e-9);
+        EXPECT_NEAR(vx, v[0], 1e-11);
+        EXPECT_NEAR(vy, v[1], 1e-11);
+        EXPECT_NEAR(vz, v[2], 1e-11);
+    }
+
+    KeplerOrbit unchanged = orbit;
+    EXPECT_FALSE(KeplerSolver::fromState(100, 0, 0, 0, 10, 0, MU, orbit)) << "Unbound";
+    EXPECT_FALSE(KeplerSolver::fromState(100, 0, 0, -1, 0, 0, MU, orbit)) << "Radial";
+    EXPECT_EQ(orbit.semiMajorAxis, unchanged.semiMajorAxis);
+
+    for (double e : {0.0, 0.3, 0.95}) {
+        for (double m = -3.0; m <= 3.0; m += 0.25) {
+            double E = KeplerSolver::eccentricAnomaly(m, e);
+            EXPECT_NEAR(E - e * std::sin(E), m, 1e-12);
+        }
+    }
+}
+
+TEST(KeplerSolverTest, MatchesFineLeapfrogIntegration) {
+    ParticleState state;
+    state.add(100.0, 0.0, 20.0, 1.0, 0.0);
+    state.vx[0] = 0.3;
+    state.vy[0] = 2.8;
+    state.vz[0] = 0.1;
+    KeplerOrbit orbit;
+    ASSERT_TRUE(KeplerSolver::fromState(state.x[0], state.y[0], state.z[0], state.vx[0], state.vy[0],
+                                        state.vz[0], MU, orbit));
+
+    const double dt = 0.002;
+    const int steps = 50000;
+    for (int step = 0; step < steps; ++step) ParticleIntegrator::step(state, dt, centralGravity);
+
+    double x, y, z, vx, vy, vz;
+    KeplerSolver::stateAt(orbit, steps * dt, x, y, z, vx, vy, vz);
+    EXPECT_NEAR(x, state.x[0], 1e-3);
+    EXPECT_NEAR(y, state.y[0], 1e-3);
+    EXPECT_NEAR(z, state.z[0], 1e-3);
+    EXPECT_NEAR(vy, state.vy[0], 1e-4);
+}
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include "MultilevelLayout.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Graph {
+        int n = 0;
+        std::vector<int> from, to;
+        std::vector<double> rest;
+    };
+
+    Graph randomTree(int n, unsigned seed) {
+        std::mt19937 rng(seed);
+        Graph g;
+        g.n = n;
+        for (int i = 1; i < n; ++i) {
+            g.from.push_back(std::uniform_int_distribution<int>(0, i - 1)(rng));
+            g.to.push_back(i);
+            g.rest.push_back(std::uniform_real_distribution<double>(50.0, 200.0)(rng));
+        }
+        return g;
+    }
+
+    double meanRelativeEdgeError(const Graph &g, const std::vector<double> &x, const std::vector<double> &y) {
+        double sum = 0;
+        for (size_t e = 0; e < g.from.size(); ++e) {
+            double d = std::hypot(x[g.from[e]] - x[g.to[e]], y[g.from[e]] - y[g.to[e]]);
+            sum += std::abs(d - g.rest[e]) / g.rest[e];
+        }
+        return sum / g.from.size();
+    }
+}
+
+TEST(MultilevelLayoutTest, CoarsensGeometrically) {
+    Graph g = randomTree(5000, 1);
+    MultilevelLayout layout;
+    layout.setGraph(g.n, g.from, g.to, g.rest);
+    std::vector<double> x(g.n), y(g.n), z(g.n, 0.0);
+    for (int i = 0; i < g.n; ++i) {
+        x[i] = std::cos(i);
+        y[i] = std::sin(i);
+    }
+
+    MultilevelLayout::Options options;
+    options.layout.planar = true;
+    layout.run(x.data(), y.data(), z.data(), options);
+
+    ASSERT_GT(layout.levelCount(), 3);
+    EXPECT_EQ(layout.levelSize(0), g.n);
+    EXPECT_LE(layout.levelSize(layout.levelCount() - 1), options.coarsestSize);
+    for (int l = 1; l < layout.levelCount(); ++l)
+        EXPECT_LE(layout.levelSize(l), options.minShrink * layout.levelSize(l - 1));
+}
+
+TEST(MultilevelLayoutTest, BeatsSingleLevelLayoutOnLargeTree) {
+    Graph g = randomTree(5000, 2);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> pos(-1000.0, 1000.0);
+    std::vector<double> startX(g.n), startY(g.n), z(g.n, 0.0);
+    for (int i = 0; i < g.n; ++i) {
+        startX[i] = pos(rng);
+        startY[i] = pos(rng);
+    }
+
+    std::vector<double> x = startX, y = startY;
+    MultilevelLayout multilevel;
+    multilevel.setGraph(g.n, g.from, g.to, g.rest);
+    MultilevelLayout::Options options;
+    options.layout.planar = true;
+    int multilevelIterations = multilevel.run(x.data(), y.data(), z.data(), options);
+    double multilevelError = meanRelativeEdgeError(g, x, y);
+
+    std::vector<double> flatX = startX, flatY = startY;
+    ForceDirectedLayout flat;
+    flat.setGraph(g.n, g.from, g.to, g.rest);
+    ForceDirectedLayout::Options flatOptions = options.layout;
+    flatOptions.maxIterations = multilevelIterations;
+    flat.run(flatX.data(), flatY.data(), z.data(), flatOptions);
+
+    for (double v: z) EXPECT_EQ(v, 0.0);
+    EXPECT_LT(multilevelError, 1.0);
+    EXPECT_LT(multilevelError, meanRelativeEdgeError(g, flatX, flatY));
+}
+
+TEST(MultilevelLayoutTest, SmallGraphUsesSingleLevel) {
+    MultilevelLayout layout;
+    layout.setGraph(3, {0, 1, 2}, {1, 2, 0}, {10.0, 10.0, 10.0});
+    std::vector<double> x = {0, 30, -20}, y = {0, 5, 40}, z = {0, 10, -10};
+
+    layout.run(x.data(), y.data(), z.data());
+
+    EXPECT_EQ(layout.levelCount(), 1);
+    for (int i = 0; i < 3; ++i) {
+        int j = (i + 1) % 3;
+        double d = std::sqrt((x[i] - x[j]) * (x[i] - x[j]) + (y[i] - y[j]) * (y[i] - y[j]) +
+                             (z[i] - z[j]) * (z[i] - z[j]));
+        EXPECT_NEAR(d, 10.0, 0.5);
+    }
+}
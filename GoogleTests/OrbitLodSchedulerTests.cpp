@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include "GalaxyPhysicsController.h"
+#include "BarnesHutGravityField.h"
+#include "Star.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+    const double BLACK_HOLE_MASS = 1.0e5;
+
+    /// Bodies on circular orbits at radii 200, 300, ..., plus whatever the test adds.
+    struct OrbitingBodies {
+        std::vector<std::unique_ptr<Star> > stars;
+        std::vector<std::unique_ptr<CelestialBodyToRigidWrapper> > wrappers;
+
+        void add(GalaxyPhysicsController &controller, double radius, double angle, double mass = 1.0) {
+            stars.push_back(std::make_unique<Star>("Star", mass, 5778, Star::starType::Main_sequence_Star));
+            wrappers.push_back(std::make_unique<CelestialBodyToRigidWrapper>(stars.back().get()));
+            double v = std::sqrt(BLACK_HOLE_MASS / radius);
+            wrappers.back()->setPosition(radius * std::cos(angle), radius * std::sin(angle), 0);
+            wrappers.back()->setVelocity(-v * std::sin(angle), v * std::cos(angle), 0);
+            controller.addCelestialBody(wrappers.back().get());
+        }
+    };
+}
+
+TEST(OrbitLodSchedulerTest, QuietOrbitsBecomeAnalytic) {
+    GalaxyPhysicsController controller(nullptr, PhysicsBackend::Particles, 1);
+    BlackHoleGravityField blackHole(BLACK_HOLE_MASS);
+    BarnesHutGravityField nBody(1.0e-3);
+    controller.addGravityField(&blackHole);
+    controller.addGravityField(&nBody);
+    controller.setOrbitLod(&blackHole);
+
+    OrbitingBodies bodies;
+    for (int i = 0; i < 8; ++i) bodies.add(controller, 200.0 + 100.0 * i, 0.8 * i);
+    // A heavy neighbour right next to body 8 and a spring between bodies 1 and 2.
+    bodies.add(controller, 3000.0, 0.0);
+    bodies.add(controller, 3005.0, 0.0, 1.0e5);
+    controller.addSpring(1, 2, 100.0);
+
+    controller.simulateStep(0.01);
+    const OrbitLodScheduler *lod = controller.getOrbitLod();
+    ASSERT_NE(lod, nullptr);
+    for (int i : {0, 3, 4, 5, 6, 7}) EXPECT_TRUE(lod->isAnalytic(i)) << i;
+    for (int i : {1, 2, 8, 9}) EXPECT_FALSE(lod->isAnalytic(i)) << i;
+    EXPECT_EQ(lod->analyticCount(), 6);
+    EXPECT_EQ(lod->integratedBodies(), (std::vector<int>{1, 2, 8, 9}));
+
+    // Adding a body sends everyone back to full integration until the next review.
+    bodies.add(controller, 900.0, 1.0);
+    EXPECT_TRUE(lod->reviewDue(controller.getState().size()));
+    controller.simulateStep(0.01);
+    EXPECT_TRUE(lod->isAnalytic(10));
+
+    // So does attaching a spring to an analytic body; the next review integrates it.
+    controller.addSpring(0, 3, 50.0);
+    EXPECT_TRUE(lod->reviewDue(controller.getState().size()));
+    EXPECT_FALSE(lod->isAnalytic(0));
+    controller.simulateStep(0.01);
+    EXPECT_FALSE(lod->isAnalytic(0));
+    EXPECT_FALSE(lod->isAnalytic(3));
+    EXPECT_TRUE(lod->isAnalytic(4));
+
+    controller.clearSprings();
+    EXPECT_TRUE(lod->reviewDue(controller.getState().size()));
+}
+
+TEST(OrbitLodSchedulerTest, AnalyticBodiesFollowTheirOrbit) {
+    // The same galaxy with and without the LOD; the black hole dominates, so both agree closely.
+    std::vector<double> finalX[2], finalY[2];
+    int analytic = 0;
+    for (int run = 0; run < 2; ++run) {
+        GalaxyPhysicsController controller(nullptr, PhysicsBackend::Particles, 1);
+        BlackHoleGravityField blackHole(BLACK_HOLE_MASS);
+        BarnesHutGravityField nBody(1.0e-3);
+        controller.addGravityField(&blackHole);
+        controller.addGravityField(&nBody);
+        OrbitLodScheduler::Options options;
+        options.reviewInterval = 25;
+        if (run == 1) controller.setOrbitLod(&blackHole, options);
+
+        OrbitingBodies bodies;
+        for (int i = 0; i < 20; ++i) bodies.add(controller, 300.0 + 40.0 * i, 0.3 * i);
+        for (int step = 0; step < 500; ++step) controller.simulateStep(0.05);
+        if (run == 1) analytic = controller.getOrbitLod()->analyticCount();
+
+        finalX[run] = controller.getState().x;
+        finalY[run] = controller.getState().y;
+        for (int i = 0; i < 20; ++i) EXPECT_DOUBLE_EQ(bodies.wrappers[i]->getX(), finalX[run][i]);
+    }
+
+    EXPECT_EQ(analytic, 20);
+    for (int i = 0; i < 20; ++i) {
+        const double radius = 300.0 + 40.0 * i;
+        EXPECT_NEAR(std::hypot(finalX[1][i], finalY[1][i]), radius, 1e-6 * radius);
+        EXPECT_NEAR(finalX[1][i], finalX[0][i], 1e-3 * radius) << i;
+        EXPECT_NEAR(finalY[1][i], finalY[0][i], 1e-3 * radius) << i;
+    }
+}
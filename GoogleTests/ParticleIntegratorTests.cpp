@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "ParticleIntegrator.h"
+#include "BarnesHutGravityField.h"
+#include "BlackHoleGravityField.h"
+#include <cmath>
+#include <initializer_list>
+
+namespace {
+    const double CENTRAL_MASS = 1000.0;
+
+    void centralGravity(ParticleState &state) {
+        for (int i = 0; i < state.size(); ++i) {
+            double r2 = state.x[i] * state.x[i] + state.y[i] * state.y[i] + state.z[i] * state.z[i];
+            double s = -CENTRAL_MASS / (r2 * std::sqrt(r2));
+            state.ax[i] += s * state.x[i];
+            state.ay[i] += s * state.y[i];
+            state.az[i] += s * state.z[i];
+        }
+    }
+
+    double orbitalEnergy(const ParticleState &state, int i) {
+        double v2 = state.vx[i] * state.vx[i] + state.vy[i] * state.vy[i] + state.vz[i] * state.vz[i];
+        double r = std::sqrt(state.x[i] * state.x[i] + state.y[i] * state.y[i] + state.z[i] * state.z[i]);
+        return 0.5 * v2 - CENTRAL_MASS / r;
+    }
+}
+
+TEST(ParticleIntegratorTest, CircularOrbitKeepsRadiusAndEnergy) {
+    ParticleState state;
+    int i = state.add(100.0, 0.0, 0.0, 1.0, 0.0);
+    state.vy[i] = std::sqrt(CENTRAL_MASS / 100.0);
+    const double e0 = orbitalEnergy(state, i);
+
+    // About ten orbits (period 2*pi*sqrt(r^3 / M) ~ 199 time units).
+    for (int step = 0; step < 20000; ++step) ParticleIntegrator::step(state, 0.1, centralGravity);
+
+    double r = std::sqrt(state.x[i] * state.x[i] + state.y[i] * state.y[i]);
+    EXPECT_NEAR(r, 100.0, 0.1);
+    EXPECT_NEAR(orbitalEnergy(state, i), e0, 1e-4 * std::abs(e0));
+}
+
+TEST(ParticleIntegratorTest, StepIsTimeReversible) {
+    ParticleState state;
+    state.add(80.0, 10.0, -5.0, 1.0, 0.0);
+    state.vx[0] = 0.5;
+    state.vy[0] = 3.0;
+    state.vz[0] = 0.2;
+
+    for (int step = 0; step < 500; ++step) ParticleIntegrator::step(state, 0.05, centralGravity);
+    state.vx[0] = -state.vx[0];
+    state.vy[0] = -state.vy[0];
+    state.vz[0] = -state.vz[0];
+    for (int step = 0; step < 500; ++step) ParticleIntegrator::step(state, 0.05, centralGravity);
+
+    EXPECT_NEAR(state.x[0], 80.0, 1e-8);
+    EXPECT_NEAR(state.y[0], 10.0, 1e-8);
+    EXPECT_NEAR(state.z[0], -5.0, 1e-8);
+}
+
+TEST(ParticleIntegratorTest, DampingMatchesBulletLaw) {
+    ParticleState state;
+    state.add(0.0, 0.0, 0.0, 1.0, 0.0);
+    state.vx[0] = 10.0;
+    state.damping[0] = 0.5;
+
+    ParticleIntegrator::step(state, 1.0, nullptr);
+    EXPECT_DOUBLE_EQ(state.vx[0], 5.0);
+    EXPECT_DOUBLE_EQ(state.x[0], 7.5) << "Half drift at 10, half drift at 5";
+}
+
+TEST(ParticleIntegratorTest, BarnesHutFieldConservesMomentum) {
+    ParticleState state;
+    for (int i = 0; i < 50; ++i)
+        state.add(std::cos(i * 0.7) * (10 + i), std::sin(i * 1.3) * (20 + i), i * 0.5, 1.0, 1.0 + i % 7);
+
+    BarnesHutGravityField field(2.0, 0.0, 0.1);
+    state.clearAccelerations();
+    field.accumulateAccelerations(state, nullptr);
+
+    double px = 0, py = 0, pz = 0, magnitude = 0;
+    for (int i = 0; i < state.size(); ++i) {
+        double m = state.gravitationalMass[i];
+        px += m * state.ax[i];
+        py += m * state.ay[i];
+        pz += m * state.az[i];
+        magnitude += m * std::abs(state.ax[i]);
+    }
+    EXPECT_GT(magnitude, 0.0);
+    EXPECT_NEAR(px, 0.0, 1e-12 * magnitude);
+    EXPECT_NEAR(py, 0.0, 1e-12 * magnitude);
+    EXPECT_NEAR(pz, 0.0, 1e-12 * magnitude);
+}
+
+TEST(ParticleIntegratorTest, FieldPotentialsMatchAccelerations) {
+    ParticleState state;
+    for (int i = 0; i < 20; ++i)
+        state.add(std::cos(i * 0.9) * (3 + 2 * i), std::sin(i * 1.7) * (4 + i), i * 0.3 - 2, 1.0, 1.0 + i % 5);
+
+    BlackHoleGravityField blackHole(500.0);
+    BarnesHutGravityField nBody(2.0, 0.0, 0.5);
+    for (GravityField *field: std::initializer_list<GravityField *>{&blackHole, &nBody}) {
+        state.clearAccelerations();
+        field->accumulateAccelerations(state, nullptr);
+
+        // -dU/dx_i = m_i * a_i, checked with central differences (bodies inside and outside r = 10).
+        const double h = 1e-5;
+        for (int i: {0, 3, 19}) {
+            double *coordinates[] = {&state.x[i], &state.y[i], &state.z[i]};
+            double accelerations[] = {state.ax[i], state.ay[i], state.az[i]};
+            for (int c = 0; c < 3; ++c) {
+                double saved = *coordinates[c];
+                *coordinates[c] = saved + h;
+                double up = field->potentialEnergy(state, nullptr);
+                *coordinates[c] = saved - h;
+                double down = field->potentialEnergy(state, nullptr);
+                *coordinates[c] = saved;
+                double force = -(up - down) / (2 * h);
+                EXPECT_NEAR(force, state.gravitationalMass[i] * accelerations[c],
+                            1e-5 * (1 + std::abs(force)));
+            }
+        }
+    }
+}
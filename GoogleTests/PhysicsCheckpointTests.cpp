@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+#include "PhysicsCheckpoint.h"
+#include "GalaxyPhysicsController.h"
+#include "BlackHoleGravityField.h"
+#include "BarnesHutGravityField.h"
+#include "RandomUtilities.h"
+#include "Star.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    /// A small galaxy on the particle backend; body i has key 10 * i and starts at radius 200 + 50 * i.
+    struct SmallGalaxy {
+        BlackHoleGravityField blackHole{1.0e5};
+        BarnesHutGravityField nBody{1.0e-3};
+        GalaxyPhysicsController controller{nullptr, PhysicsBackend::Particles, 1};
+        std::vector<std::unique_ptr<Star> > stars;
+        std::vector<std::unique_ptr<CelestialBodyToRigidWrapper> > wrappers;
+
+        /// @param order The order in which bodies 0..n-1 are added.
+        explicit SmallGalaxy(const std::vector<int> &order) {
+            controller.addGravityField(&blackHole);
+            controller.addGravityField(&nBody);
+            for (int i : order) {
+                const double radius = 200.0 + 50.0 * i;
+                stars.push_back(std::make_unique<Star>("Star", 1.0 + i, 5778, Star::starType::Main_sequence_Star));
+                wrappers.push_back(std::make_unique<CelestialBodyToRigidWrapper>(stars.back().get()));
+                wrappers.back()->setPosition(radius * std::cos(i), 0, radius * std::sin(i));
+                wrappers.back()->setVelocity(0, 0, 0);
+                controller.addCelestialBody(wrappers.back().get(), 10 * i);
+            }
+        }
+
+        /// Index of the body with key 10 * i.
+        int body(int i) const { return controller.findBody(10 * i); }
+    };
+
+    std::string checkpointPath(const std::string &name) { return ::testing::TempDir() + name; }
+}
+
+TEST(PhysicsCheckpointTest, RestoreContinuesTheSavedRun) {
+    const std::string path = checkpointPath("physics_checkpoint_roundtrip.chk");
+    SmallGalaxy original({0, 1, 2, 3, 4});
+    original.controller.addSpring(original.body(1), original.body(3), 80.0, 2.0);
+    for (int step = 0; step < 50; ++step) original.controller.simulateStep(0.02);
+    RandomGenerator rng(7);
+    const std::string generationState = rng.saveState();
+    rng.getDouble(0, 1);
+    original.blackHole.setPosition(1, 2, 3);
+    ASSERT_TRUE(PhysicsCheckpoint::save(path, original.controller, &original.blackHole, rng.saveState(),
+                                        generationState, 1.0));
+
+    // The restarted galaxy adds its bodies in another order, with a different black hole.
+    SmallGalaxy resumed({3, 1, 4, 0, 2});
+    resumed.blackHole.setMass(5.0);
+    PhysicsCheckpoint checkpoint;
+    ASSERT_TRUE(checkpoint.load(path)) << checkpoint.errorString();
+    EXPECT_EQ(checkpoint.bodyCount(), 5);
+    EXPECT_EQ(checkpoint.springCount(), 1);
+    EXPECT_DOUBLE_EQ(checkpoint.simulationTime(), 1.0);
+    ASSERT_TRUE(checkpoint.restore(resumed.controller, &resumed.blackHole)) << checkpoint.errorString();
+
+    EXPECT_DOUBLE_EQ(resumed.blackHole.getMass(), 1.0e5);
+    EXPECT_DOUBLE_EQ(resumed.blackHole.getY(), 2.0);
+    RandomGenerator resumedRng(1);
+    ASSERT_TRUE(resumedRng.restoreState(checkpoint.rngState()));
+    EXPECT_EQ(resumedRng.getInt(0, 1 << 30), rng.getInt(0, 1 << 30));
+    EXPECT_EQ(checkpoint.generationState(), generationState);
+
+    ASSERT_EQ(resumed.controller.getSprings().size(), 1);
+    const int a = resumed.controller.getSprings().indexA()[0], b = resumed.controller.getSprings().indexB()[0];
+    EXPECT_EQ(std::min(a, b), std::min(resumed.body(1), resumed.body(3)));
+    EXPECT_EQ(std::max(a, b), std::max(resumed.body(1), resumed.body(3)));
+
+    // Both runs continue identically (same bodies, forces and springs; only the order differs).
+    for (int step = 0; step < 20; ++step) {
+        original.controller.simulateStep(0.02);
+        resumed.controller.simulateStep(0.02);
+    }
+    const ParticleState &expected = original.controller.getState(), &actual = resumed.controller.getState();
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_NEAR(actual.x[resumed.body(i)], expected.x[original.body(i)], 1e-9) << i;
+        EXPECT_NEAR(actual.vz[resumed.body(i)], expected.vz[original.body(i)], 1e-9) << i;
+        EXPECT_DOUBLE_EQ(actual.gravitationalMass[resumed.body(i)], 1.0 + i);
+    }
+    EXPECT_DOUBLE_EQ(resumed.wrappers[0]->getX(), actual.x[resumed.body(3)]);
+    std::remove(path.c_str());
+}
+
+TEST(PhysicsCheckpointTest, RejectsDamagedOrMismatchedFiles) {
+    const std::string path = checkpointPath("physics_checkpoint_damaged.chk");
+    SmallGalaxy galaxy({0, 1, 2});
+    ASSERT_TRUE(PhysicsCheckpoint::save(path, galaxy.controller, nullptr, "", "", 0.0));
+
+    PhysicsCheckpoint checkpoint;
+    EXPECT_FALSE(checkpoint.restore(galaxy.controller, nullptr));
+    EXPECT_FALSE(checkpoint.load(checkpointPath("physics_checkpoint_missing.chk")));
+    ASSERT_TRUE(checkpoint.load(path));
+    EXPECT_TRUE(checkpoint.rngState().empty());
+    EXPECT_TRUE(checkpoint.generationState().empty());
+
+    // A galaxy with another body count is left untouched.
+    SmallGalaxy bigger({0, 1, 2, 3});
+    const double x = bigger.controller.getState().x[0];
+    EXPECT_FALSE(checkpoint.restore(bigger.controller, nullptr));
+    EXPECT_DOUBLE_EQ(bigger.controller.getState().x[0], x);
+
+    // Truncated file.
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+    EXPECT_FALSE(checkpoint.load(path));
+    EXPECT_FALSE(checkpoint.isLoaded());
+
+    // Future format version.
+    bytes[8] = static_cast<char>(PhysicsCheckpoint::VERSION + 1);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    EXPECT_FALSE(checkpoint.load(path));
+    EXPECT_NE(checkpoint.errorString().find("version"), std::string::npos);
+    std::remove(path.c_str());
+}
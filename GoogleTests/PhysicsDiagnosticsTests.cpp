@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+#include "GalaxyPhysicsController.h"
+#include "BlackHoleGravityField.h"
+#include "Star.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Two stars on circular orbits around a black hole, on the particle backend.
+    struct OrbitingPair {
+        BlackHoleGravityField blackHole{1.0e4};
+        GalaxyPhysicsController controller{nullptr, PhysicsBackend::Particles, 1};
+        std::vector<std::unique_ptr<Star> > stars;
+        std::vector<std::unique_ptr<CelestialBodyToRigidWrapper> > wrappers;
+
+        OrbitingPair() {
+            controller.addGravityField(&blackHole);
+            for (double radius : {100.0, 250.0}) {
+                stars.push_back(std::make_unique<Star>("Star", 2.0, 5778, Star::starType::Main_sequence_Star));
+                wrappers.push_back(std::make_unique<CelestialBodyToRigidWrapper>(stars.back().get()));
+                wrappers.back()->setPosition(radius, 0, 0);
+                wrappers.back()->setVelocity(0, std::sqrt(1.0e4 / radius), 0);
+                controller.addCelestialBody(wrappers.back().get());
+            }
+        }
+    };
+}
+
+TEST(PhysicsDiagnosticsTest, RingBufferKeepsTheNewestRecords) {
+    PhysicsDiagnostics::Options options;
+    options.capacity = 4;
+    options.energyInterval = 3;
+    PhysicsDiagnostics diagnostics(options);
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(diagnostics.energyDue(), i % 3 == 0) << i;
+        StepDiagnostics record;
+        record.deltaTime = 0.5;
+        diagnostics.record(record);
+    }
+    EXPECT_EQ(diagnostics.recordedSteps(), 10u);
+    ASSERT_EQ(diagnostics.history().size(), 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(diagnostics.history()[i].step, static_cast<std::uint64_t>(6 + i));
+        EXPECT_DOUBLE_EQ(diagnostics.history()[i].simulationTime, 0.5 * (7 + i));
+    }
+}
+
+TEST(PhysicsDiagnosticsTest, ControllerRecordsEnergyAndMomentum) {
+    OrbitingPair pair;
+    PhysicsDiagnostics::Options options;
+    options.energyInterval = 10;
+    pair.controller.enableDiagnostics(options);
+
+    for (int step = 0; step < 100; ++step) pair.controller.simulateStep(0.01);
+    const PhysicsDiagnostics *diagnostics = pair.controller.getDiagnostics();
+    ASSERT_NE(diagnostics, nullptr);
+    const RingBuffer<StepDiagnostics> &history = diagnostics->history();
+    ASSERT_EQ(history.size(), 100);
+
+    // The potential is only sampled every energyInterval steps.
+    EXPECT_FALSE(std::isnan(history[0].potentialEnergy));
+    EXPECT_TRUE(std::isnan(history[1].potentialEnergy));
+    EXPECT_FALSE(std::isnan(history[90].potentialEnergy));
+
+    const StepDiagnostics &last = history.back();
+    EXPECT_EQ(last.bodies, 2);
+    EXPECT_EQ(last.nonFiniteBodies, 0);
+    EXPECT_NEAR(last.maxSpeed, 10.0, 1e-3);
+    EXPECT_GE(last.totalSeconds, last.gravitySeconds);
+    EXPECT_DOUBLE_EQ(last.simulationTime, 100 * 0.01);
+
+    // A central field conserves angular momentum exactly up to round-off (leapfrog).
+    const double lz = 2.0 * (100.0 * 10.0 + 250.0 * std::sqrt(40.0));
+    for (int i = 0; i < history.size(); ++i) {
+        EXPECT_NEAR(history[i].angularMomentumZ, lz, 1e-9 * lz);
+        EXPECT_DOUBLE_EQ(history[i].angularMomentumX, 0.0);
+    }
+    EXPECT_NEAR(history[90].totalEnergy(), pair.controller.computeTotalEnergy(),
+                1e-4 * std::abs(history[90].totalEnergy()));
+
+    // A spring of rest length 0 stores k * d^2 / 2, reported apart from the total.
+    const double withoutSpring = pair.controller.computeTotalEnergy();
+    pair.controller.addSpring(pair.wrappers[0]->getParticleIndex(), pair.wrappers[1]->getParticleIndex(), 0.0, 3.0);
+    EXPECT_DOUBLE_EQ(pair.controller.computeTotalEnergy(), withoutSpring);
+
+    pair.controller.simulateStep(0.01);  // Step 100 measures the potentials.
+    const StepDiagnostics &withSpring = diagnostics->history().back();
+    const double distance = std::hypot(pair.wrappers[1]->getX() - pair.wrappers[0]->getX(),
+                                       pair.wrappers[1]->getY() - pair.wrappers[0]->getY());
+    EXPECT_NEAR(withSpring.springEnergy, 0.5 * 3.0 * distance * distance, 1e-9 * distance * distance);
+    EXPECT_DOUBLE_EQ(withSpring.totalEnergy(), withSpring.kineticEnergy + withSpring.potentialEnergy);
+}
+
+TEST(PhysicsDiagnosticsTest, CsvHasHeaderAndOneRowPerStep) {
+    const std::string path = ::testing::TempDir() + "physics_diagnostics_test.csv";
+    {
+        OrbitingPair pair;
+        PhysicsDiagnostics::Options options;
+        options.capacity = 2;
+        options.csvPath = path;
+        pair.controller.enableDiagnostics(options);
+        for (int step = 0; step < 5; ++step) pair.controller.simulateStep(0.01);
+        EXPECT_FALSE(pair.controller.getDiagnostics()->csvFailed());
+
+        // The in-memory dump only has what the ring buffer still holds.
+        std::ostringstream memory;
+        pair.controller.getDiagnostics()->writeCsv(memory);
+        std::string line;
+        int rows = -1;
+        for (std::istringstream in(memory.str()); std::getline(in, line);) ++rows;
+        EXPECT_EQ(rows, 2);
+        pair.controller.disableDiagnostics();
+        EXPECT_EQ(pair.controller.getDiagnostics(), nullptr);
+    }
+
+    std::ifstream file(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);) lines.push_back(line);
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(lines[0].rfind("step,time,dt,bodies,", 0), 0u);
+    EXPECT_EQ(lines[1].rfind("0,", 0), 0u);
+    EXPECT_EQ(lines[5].rfind("4,", 0), 0u);
+    // Same number of columns in every line.
+    for (const std::string &line : lines) EXPECT_EQ(std::count(line.begin(), line.end(), ','), 18) << line;
+    std::remove(path.c_str());
+}
@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+#include "PhysicsEngine.h"
+#include <vector>
+
+namespace {
+    /// @brief Adds a pooled unit sphere at x and returns it.
+    btRigidBody* addSphereAt(PhysicsEngine& engine, double x) {
+        RigidBodyPool& pool = engine.getBodyPool();
+        btRigidBody::btRigidBodyConstructionInfo info(1.0, nullptr, pool.sphereShape(1.0), btVector3(0.4, 0.4, 0.4));
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(btVector3(x, 0, 0));
+        btRigidBody* body = pool.createBody(info, transform);
+        engine.getWorld()->addRigidBody(body);
+        return body;
+    }
+
+    PhysicsEngine::Profile profileWith(BroadphaseType broadphase, int solverThreads = 1) {
+        PhysicsEngine::Profile profile;
+        profile.broadphase = broadphase;
+        profile.maxBodies = 64;
+        profile.solverThreads = solverThreads;
+        return profile;
+    }
+}
+
+TEST(PhysicsEngineTest, EveryProfileBuildsAndStepsAWorld) {
+    for (BroadphaseType broadphase : {BroadphaseType::None, BroadphaseType::Simple, BroadphaseType::AxisSweep,
+                                      BroadphaseType::Dbvt}) {
+        for (int threads : {1, 2}) {
+            PhysicsEngine engine(profileWith(broadphase, threads));
+            std::vector<btRigidBody*> bodies;
+            for (int i = 0; i < 4; ++i) bodies.push_back(addSphereAt(engine, 10.0 * i));
+            EXPECT_EQ(engine.getWorld()->getNumCollisionObjects(), 4);
+
+            engine.stepSimulation(1.0f / 60.0f);
+            engine.getWorld()->removeRigidBody(bodies[1]);
+            engine.getBodyPool().destroyBody(bodies[1]);
+            engine.stepSimulation(1.0f / 60.0f);
+            EXPECT_EQ(engine.getWorld()->getNumCollisionObjects(), 3);
+            // The remaining bodies are still in the world when the engine is destroyed.
+        }
+    }
+}
+
+TEST(PhysicsEngineTest, CollisionFreeWorldReportsNoPairs) {
+    PhysicsEngine colliding(profileWith(BroadphaseType::Dbvt));
+    addSphereAt(colliding, 0.0);
+    addSphereAt(colliding, 0.5);
+    colliding.stepSimulation(1.0f / 60.0f);
+    EXPECT_EQ(colliding.getWorld()->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs(), 1);
+
+    PhysicsEngine collisionFree(PhysicsEngine::Profile::collisionFree());
+    addSphereAt(collisionFree, 0.0);
+    addSphereAt(collisionFree, 0.5);
+    collisionFree.stepSimulation(1.0f / 60.0f);
+    EXPECT_EQ(collisionFree.getWorld()->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs(), 0);
+}
+
+TEST(PhysicsEngineTest, SolverThreadsNeedThreadsafeBullet) {
+    EXPECT_FALSE(PhysicsEngine(PhysicsEngine::Profile::collisionFree(1)).isMultithreaded());
+#ifndef BT_THREADSAFE
+    EXPECT_FALSE(PhysicsEngine(PhysicsEngine::Profile::collisionFree(2)).isMultithreaded());
+#endif
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "PlanetOrbitPropagator.h"
+#include "KeplerSolver.h"
+#include "StarSystem.h"
+#include "Nebula.h"
+#include "Star.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+TEST(PlanetOrbitPropagatorTest, MatchesKeplerSolver) {
+    PlanetOrbitPropagator orbits;
+    orbits.addOrbit(0, 1.0, 0.0, 0.7, 0.3, 0.0);
+    orbits.addOrbit(0, 5.2, 0.2, 0.1, -1.0, 30.0);
+    orbits.addOrbit(3, 30.0, 0.45, 0.01, 2.5, 90.0);
+    ASSERT_EQ(orbits.size(), 3);
+
+    for (double t : {0.0, 1.5, 100.0, 1.7e9}) {
+        orbits.propagate(t);
+        for (int i = 0; i < orbits.size(); ++i) {
+            KeplerOrbit reference;
+            reference.semiMajorAxis = orbits.semiMajorAxis()[i];
+            reference.eccentricity = std::vector<double>{0.0, 0.2, 0.45}[i];
+            reference.meanMotion = std::vector<double>{0.7, 0.1, 0.01}[i];
+            reference.meanAnomalyAtEpoch = std::vector<double>{0.3, -1.0, 2.5}[i];
+            double u, v, w, vx, vy, vz;
+            KeplerSolver::stateAt(reference, t, u, v, w, vx, vy, vz);
+
+            // Mean anomalies of ~1e8 radians keep only ~1e-8 of absolute precision.
+            const double tolerance = 1e-7 * reference.semiMajorAxis;
+            EXPECT_NEAR(orbits.u()[i], u, tolerance) << i << " at " << t;
+            EXPECT_NEAR(orbits.v()[i], v, tolerance) << i << " at " << t;
+            const double inclination = std::vector<double>{0.0, 30.0, 90.0}[i] * M_PI / 180.0;
+            EXPECT_DOUBLE_EQ(orbits.x()[i], orbits.u()[i]);
+            EXPECT_NEAR(orbits.y()[i], v * std::sin(inclination), tolerance);
+            EXPECT_NEAR(orbits.z()[i], v * std::cos(inclination), tolerance);
+        }
+    }
+    EXPECT_DOUBLE_EQ(orbits.time(), 1.7e9);
+}
+
+TEST(PlanetOrbitPropagatorTest, BuildGroupsPlanetsBySystem) {
+    auto solar = std::make_unique<StarSystem>(1, "Solar", new Star("Sun", 1.0, 5778.0, Star::starType::Main_sequence_Star));
+    solar->addPlanet(new Planet("Earth", 1.0, 1.0, 29.8, 0.0, Planet::planetType::Terrestrial_Planet, true));
+    solar->addPlanet(new Planet("Mars", 0.1, 1.5, 24.1, 1.8, Planet::planetType::Terrestrial_Planet, false));
+    auto empty = std::make_unique<StarSystem>(2, "Empty", new Star("Dim", 0.5, 3000.0, Star::starType::Red_Dwarf));
+    auto nebula = std::make_unique<Nebula>("Cloud", 100.0, Nebula::nebulaType::Emission);
+    auto tilted = std::make_unique<StarSystem>(3, "Tilted", new Star("Hot", 2.0, 9000.0, Star::starType::Main_sequence_Star));
+    tilted->addPlanet(new Planet("Far", 10.0, 20.0, 6.0, 60.0, Planet::planetType::Gas_Giant, false));
+    std::vector<CelestialObject *> objects = {nebula.get(), solar.get(), empty.get(), tilted.get(), nebula.get()};
+
+    PlanetOrbitPropagator orbits;
+    orbits.build(objects);
+    ASSERT_EQ(orbits.size(), 3);
+    EXPECT_EQ(orbits.planetCount(0), 0);
+    EXPECT_EQ(orbits.planetCount(1), 2);
+    EXPECT_EQ(orbits.planetCount(2), 0);
+    EXPECT_EQ(orbits.planetCount(3), 1);
+    EXPECT_EQ(orbits.planetCount(4), 0);
+    EXPECT_EQ(orbits.planetCount(5), 0);
+    EXPECT_EQ(orbits.firstPlanet(1), 0);
+    EXPECT_EQ(orbits.firstPlanet(3), 2);
+
+    // Circular orbits at the planet's radius, turning with the display mean motion.
+    const double t = 12.5;
+    orbits.propagate(t);
+    for (int i = 0; i < orbits.size(); ++i) {
+        const double a = orbits.semiMajorAxis()[i];
+        EXPECT_NEAR(std::hypot(orbits.x()[i], orbits.y()[i], orbits.z()[i]), a, 1e-12 * a);
+        const double angle = std::atan2(orbits.v()[i], orbits.u()[i]);
+        EXPECT_NEAR(std::remainder(angle - PlanetOrbitPropagator::displayMeanMotion(a) * t, 2 * M_PI), 0.0, 1e-12);
+    }
+    EXPECT_DOUBLE_EQ(orbits.semiMajorAxis()[orbits.firstPlanet(3)], 20.0);
+    const int far = orbits.firstPlanet(3);
+    EXPECT_NEAR(orbits.y()[far] / orbits.z()[far], std::tan(60.0 * M_PI / 180.0), 1e-9);
+}
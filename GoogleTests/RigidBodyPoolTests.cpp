@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+#include "RigidBodyPool.h"
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace {
+    btRigidBody* createAt(RigidBodyPool& pool, double x) {
+        btCollisionShape* shape = pool.sphereShape(1.0);
+        btRigidBody::btRigidBodyConstructionInfo info(1.0, nullptr, shape, btVector3(0.4, 0.4, 0.4));
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(btVector3(x, 0, 0));
+        return pool.createBody(info, transform);
+    }
+}
+
+TEST(RigidBodyPoolTest, ReservedBodiesComeFromOneBlock) {
+    RigidBodyPool pool;
+    pool.reserve(1000);
+
+    std::vector<btRigidBody*> bodies;
+    for (int i = 0; i < 1000; ++i) bodies.push_back(createAt(pool, i));
+
+    EXPECT_EQ(pool.blockCount(), 1);
+    EXPECT_EQ(pool.capacity(), 1000);
+    EXPECT_EQ(pool.liveBodies(), 1000);
+    EXPECT_EQ(pool.shapeCount(), 1);
+    for (int i = 0; i < 1000; i += 111) {
+        btTransform transform;
+        bodies[i]->getMotionState()->getWorldTransform(transform);
+        EXPECT_DOUBLE_EQ(transform.getOrigin().x(), i);
+        EXPECT_DOUBLE_EQ(bodies[i]->getInvMass(), 1.0);
+    }
+}
+
+TEST(RigidBodyPoolTest, ReleasedSlotsAreReused) {
+    RigidBodyPool pool;
+    std::set<btRigidBody*> addresses;
+    std::vector<btRigidBody*> bodies;
+    for (int i = 0; i < 100; ++i) {
+        bodies.push_back(createAt(pool, i));
+        addresses.insert(bodies.back());
+    }
+    const int blocks = pool.blockCount();
+    EXPECT_LE(blocks, 2) << "Unreserved growth doubles the block size";
+    EXPECT_EQ(addresses.size(), 100u);
+
+    for (int i = 0; i < 100; i += 2) pool.destroyBody(bodies[i]);
+    EXPECT_EQ(pool.liveBodies(), 50);
+    for (int i = 0; i < 50; ++i) EXPECT_EQ(addresses.count(createAt(pool, -i)), 1u);
+    EXPECT_EQ(pool.blockCount(), blocks);
+    EXPECT_EQ(pool.liveBodies(), 100);
+
+    pool.clear();
+    EXPECT_EQ(pool.liveBodies(), 0);
+    EXPECT_EQ(pool.blockCount(), 0);
+    EXPECT_EQ(pool.shapeCount(), 0);
+}
+
+TEST(RigidBodyPoolTest, ShapesAreSharedPerRadiusClass) {
+    RigidBodyPool pool;
+    btCollisionShape* unit = pool.sphereShape(1.0);
+    EXPECT_EQ(pool.sphereShape(1.05), unit);
+    EXPECT_NE(pool.sphereShape(2.0), unit);
+    EXPECT_NE(pool.sphereShape(0.5), unit);
+    EXPECT_EQ(pool.shapeCount(), 3);
+    EXPECT_DOUBLE_EQ(static_cast<btSphereShape*>(unit)->getRadius(), 1.0);
+    EXPECT_DOUBLE_EQ(static_cast<btSphereShape*>(pool.sphereShape(2.0))->getRadius(), 2.0);
+}
+
+TEST(RigidBodyPoolTest, ForeignBodiesAreIgnored) {
+    RigidBodyPool pool;
+    btRigidBody* pooled = createAt(pool, 1.0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pooled) % alignof(btRigidBody), 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pooled->getMotionState()) % alignof(btDefaultMotionState), 0u);
+
+    btDefaultMotionState motionState;
+    btRigidBody foreign(btRigidBody::btRigidBodyConstructionInfo(1.0, &motionState, pool.sphereShape(1.0)));
+    pool.destroyBody(&foreign);
+    EXPECT_EQ(pool.liveBodies(), 1);
+
+    pool.destroyBody(pooled);
+    pool.destroyBody(pooled);
+    EXPECT_EQ(pool.liveBodies(), 0);
+}
@@ -0,0 +1,196 @@
+#include "gtest/gtest.h"
+#include "SimdKernels.h"
+#include "TestFixtures.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST_F(SimdKernelsFixture, SetLevelClampsToDetected) {
+    EXPECT_EQ(SimdKernels::setLevel(SimdKernels::Level::Scalar), SimdKernels::Level::Scalar);
+    EXPECT_EQ(SimdKernels::activeLevel(), SimdKernels::Level::Scalar);
+    EXPECT_LE(SimdKernels::setLevel(SimdKernels::Level::AVX2), SimdKernels::detectedLevel());
+    EXPECT_STREQ(SimdKernels::levelName(SimdKernels::Level::Scalar), "scalar");
+}
+
+TEST_F(SimdKernelsFixture, RelaxRowMatchesScalarAtEveryLevel) {
+    const int N = 37; // Not a multiple of any vector width, so the scalar tail runs too.
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> weight(0.5, 10.0);
+    std::bernoulli_distribution hasEdge(0.6);
+
+    std::vector<double> row(N), startDist(N);
+    for (int v = 0; v < N; ++v) {
+        row[v] = hasEdge(rng) ? weight(rng) : 0.0;
+        startDist[v] = hasEdge(rng) ? weight(rng) * 2 : std::numeric_limits<double>::max();
+    }
+
+    std::vector<double> expectedDist;
+    std::vector<int> expectedParent;
+    for (auto level: supportedLevels()) {
+        SimdKernels::setLevel(level);
+        std::vector<double> dist = startDist;
+        std::vector<int> parent(N, -1);
+        SimdKernels::relaxRow(row.data(), 1.5, 7, dist.data(), parent.data(), N);
+
+        std::vector<float> rowF(row.begin(), row.end()), distF(N);
+        std::vector<int> parentF(N, -1);
+        for (int v = 0; v < N; ++v)
+            distF[v] = startDist[v] == std::numeric_limits<double>::max()
+                           ? std::numeric_limits<float>::max()
+                           : static_cast<float>(startDist[v]);
+        SimdKernels::relaxRow(rowF.data(), 1.5f, 7, distF.data(), parentF.data(), N);
+
+        if (expectedDist.empty()) {
+            expectedDist = dist;
+            expectedParent = parent;
+        }
+        EXPECT_EQ(dist, expectedDist) << SimdKernels::levelName(level);
+        EXPECT_EQ(parent, expectedParent) << SimdKernels::levelName(level);
+        EXPECT_EQ(parentF, expectedParent) << SimdKernels::levelName(level) << " (float)";
+    }
+
+    for (int v = 0; v < N; ++v) {
+        if (row[v] == 0.0) {
+            EXPECT_EQ(expectedDist[v], startDist[v]) << "Missing edges must not relax";
+        }
+    }
+}
+
+TEST_F(SimdKernelsFixture, MinPlusRowMatchesScalarAtEveryLevel) {
+    const int N = 29;
+    std::vector<float> rowK(N), startRow(N);
+    for (int j = 0; j < N; ++j) {
+        rowK[j] = (j % 3 == 0) ? std::numeric_limits<float>::max() : static_cast<float>(j);
+        startRow[j] = static_cast<float>(30 - j);
+    }
+
+    for (auto level: supportedLevels()) {
+        SimdKernels::setLevel(level);
+        std::vector<float> rowI = startRow;
+        SimdKernels::minPlusRow(rowK.data(), 2.0f, rowI.data(), N);
+        for (int j = 0; j < N; ++j) {
+            float expected = (j % 3 == 0) ? startRow[j] : std::min(startRow[j], 2.0f + rowK[j]);
+            EXPECT_EQ(rowI[j], expected) << SimdKernels::levelName(level) << " column " << j;
+        }
+    }
+}
+
+namespace {
+    void expectClose(const std::vector<double> &actual, const std::vector<double> &expected, const char *level) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i)
+            EXPECT_NEAR(actual[i], expected[i], 1e-12 * (1.0 + std::abs(expected[i]))) << level << " at " << i;
+    }
+}
+
+TEST_F(SimdKernelsFixture, CentralGravityMatchesScalarAtEveryLevel) {
+    const int N = 23;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> pos(-500.0, 500.0);
+    std::vector<double> x(N), y(N), z(N);
+    for (int i = 0; i < N; ++i) {
+        x[i] = pos(rng);
+        y[i] = pos(rng);
+        z[i] = pos(rng);
+    }
+    x[5] = 1.0; y[5] = 2.0; z[5] = 3.0; // Inside the clamp radius.
+
+    std::vector<double> expected;
+    for (auto level: supportedLevels()) {
+        SimdKernels::setLevel(level);
+        std::vector<double> ax(N, 1.0), ay(N, 0.0), az(N, -1.0);
+        SimdKernels::centralGravity(x.data(), y.data(), z.data(), ax.data(), ay.data(), az.data(), N,
+                                    0.0, 0.0, 0.0, 1.3e5, 100.0);
+        std::vector<double> all = ax;
+        all.insert(all.end(), ay.begin(), ay.end());
+        all.insert(all.end(), az.begin(), az.end());
+        if (expected.empty()) expected = all;
+        expectClose(all, expected, SimdKernels::levelName(level));
+    }
+
+    double r = std::sqrt(x[0] * x[0] + y[0] * y[0] + z[0] * z[0]);
+    EXPECT_NEAR(expected[0], 1.0 - 1.3e5 * x[0] / (r * r * r), 1e-9) << "Accumulates on top of existing values";
+}
+
+TEST_F(SimdKernelsFixture, GravitySumMatchesScalarAtEveryLevel) {
+    const int N = 31;
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<double> pos(-50.0, 50.0);
+    std::uniform_real_distribution<double> mass(0.1, 5.0);
+    std::vector<double> qx(N), qy(N), qz(N), qm(N);
+    for (int j = 0; j < N; ++j) {
+        qx[j] = pos(rng);
+        qy[j] = pos(rng);
+        qz[j] = pos(rng);
+        qm[j] = mass(rng);
+    }
+    qx[2] = 1.0; qy[2] = -2.0; qz[2] = 0.5; // The attracted point itself.
+
+    std::vector<double> expected;
+    for (auto level: supportedLevels()) {
+        SimdKernels::setLevel(level);
+        std::vector<double> out = {0.0, 0.0, 0.0};
+        SimdKernels::gravitySum(1.0, -2.0, 0.5, qx.data(), qy.data(), qz.data(), qm.data(), N, 0.0, out.data());
+        for (double v: out) EXPECT_TRUE(std::isfinite(v)) << SimdKernels::levelName(level);
+        if (expected.empty()) expected = out;
+        expectClose(out, expected, SimdKernels::levelName(level));
+    }
+}
+
+TEST_F(SimdKernelsFixture, SpringForcesMatchScalarAtEveryLevel) {
+    const int BODIES = 12;
+    const int M = 19;
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> pos(-100.0, 100.0);
+    std::uniform_int_distribution<int> body(0, BODIES - 1);
+    std::vector<double> x(BODIES), y(BODIES), z(BODIES);
+    for (int i = 0; i < BODIES; ++i) {
+        x[i] = pos(rng);
+        y[i] = pos(rng);
+        z[i] = pos(rng);
+    }
+    std::vector<int> a(M), b(M);
+    std::vector<double> rest(M), k(M);
+    for (int s = 0; s < M; ++s) {
+        a[s] = body(rng);
+        b[s] = body(rng);
+        rest[s] = 10.0 + s;
+        k[s] = 5.0;
+    }
+    a[0] = b[0] = 3; // Zero-length spring: no force.
+
+    std::vector<double> expected;
+    for (auto level: supportedLevels()) {
+        SimdKernels::setLevel(level);
+        std::vector<double> fx(M), fy(M), fz(M);
+        SimdKernels::springForces(x.data(), y.data(), z.data(), a.data(), b.data(), rest.data(), k.data(),
+                                  fx.data(), fy.data(), fz.data(), M);
+        EXPECT_EQ(fx[0], 0.0);
+        std::vector<double> all = fx;
+        all.insert(all.end(), fy.begin(), fy.end());
+        all.insert(all.end(), fz.begin(), fz.end());
+        if (expected.empty()) expected = all;
+        expectClose(all, expected, SimdKernels::levelName(level));
+    }
+}
+
+TEST_F(SimdKernelsFixture, SinCosTurnsMatchesLibmAtEveryLevel) {
+    // Quadrant boundaries, negative angles and whole turns, plus random angles.
+    std::vector<double> turns = {0.0, 0.125, 0.25, 0.375, 0.5, -0.125, -0.25, -0.5, 0.875, 3.0, -7.75, 1.0e6 + 0.1};
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> angle(-20.0, 20.0);
+    while (turns.size() < 41) turns.push_back(angle(rng));
+
+    for (auto level: supportedLevels()) {
+        SimdKernels::setLevel(level);
+        std::vector<double> s(turns.size()), c(turns.size());
+        SimdKernels::sinCosTurns(turns.data(), s.data(), c.data(), static_cast<int>(turns.size()));
+        for (std::size_t i = 0; i < turns.size(); ++i) {
+            // Whole turns are exact; the reference angle in radians is not.
+            const double fraction = turns[i] - std::nearbyint(turns[i]);
+            EXPECT_NEAR(s[i], std::sin(2.0 * M_PI * fraction), 1e-15) << SimdKernels::levelName(level) << " at " << turns[i];
+            EXPECT_NEAR(c[i], std::cos(2.0 * M_PI * fraction), 1e-15) << SimdKernels::levelName(level) << " at " << turns[i];
+        }
+    }
+}
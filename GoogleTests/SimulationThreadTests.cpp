@@ -0,0 +1,138 @@
+#include "gtest/gtest.h"
+#include "SimulationThread.h"
+#include "Star.h"
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct OrbitingBodies {
+        std::vector<std::unique_ptr<Star> > stars;
+        std::vector<std::unique_ptr<CelestialBodyToRigidWrapper> > wrappers;
+
+        void add(GalaxyPhysicsController &controller, double x, int key = -1) {
+            stars.push_back(std::make_unique<Star>("Star", 1.0, 5778, Star::starType::Main_sequence_Star));
+            wrappers.push_back(std::make_unique<CelestialBodyToRigidWrapper>(stars.back().get()));
+            wrappers.back()->setPosition(x, 0, 0);
+            wrappers.back()->setVelocity(0, 0, 1.0);
+            controller.addCelestialBody(wrappers.back().get(), key);
+        }
+    };
+
+    bool waitForStep(SimulationThread &thread, std::uint64_t minStep) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (thread.fetchSnapshot() && thread.snapshot().step >= minStep) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+}
+
+TEST(SimulationThreadTest, PublishesSnapshotsWhileRunning) {
+    GalaxyPhysicsController controller(nullptr, PhysicsBackend::Particles, 1);
+    OrbitingBodies bodies;
+    bodies.add(controller, 100.0);
+    bodies.add(controller, -100.0);
+
+    SimulationThread thread(&controller, 0.01, 10.0);
+    EXPECT_FALSE(thread.fetchSnapshot());
+    thread.start();
+    ASSERT_TRUE(waitForStep(thread, 5));
+    thread.stop();
+
+    const PhysicsSnapshot &snapshot = thread.snapshot();
+    ASSERT_EQ(snapshot.x.size(), 2u);
+    EXPECT_NEAR(snapshot.simulationTime, snapshot.step * 0.01, 1e-9);
+    EXPECT_GT(snapshot.z[0], 0.0) << "Bodies moved with their initial velocity";
+    EXPECT_DOUBLE_EQ(snapshot.x[0], 100.0);
+
+    ASSERT_EQ(snapshot.previousZ.size(), 2u);
+    EXPECT_NEAR(snapshot.z[0] - snapshot.previousZ[0], 0.01, 1e-12) << "Previous state is one step earlier";
+    double x, y, z;
+    snapshot.interpolate(0, 0.5, x, y, z);
+    EXPECT_NEAR(z, snapshot.z[0] - 0.005, 1e-12);
+    double alpha = thread.interpolationFactor();
+    EXPECT_GE(alpha, 0.0);
+    EXPECT_LE(alpha, 1.0);
+}
+
+TEST(SimulationThreadTest, ClockContinuesFromTheStartTime) {
+    GalaxyPhysicsController controller(nullptr, PhysicsBackend::Particles, 1);
+    OrbitingBodies bodies;
+    bodies.add(controller, 100.0);
+
+    SimulationThread thread(&controller, 0.01, 10.0);
+    thread.start(5.0);
+    ASSERT_TRUE(waitForStep(thread, 3));
+    thread.stop();
+    thread.fetchSnapshot(); // Anything published after the wait.
+    EXPECT_NEAR(thread.snapshot().simulationTime, 5.0 + thread.snapshot().step * 0.01, 1e-9);
+
+    // A restart begins a new run: the step count starts over from the new time.
+    thread.start(2.0);
+    ASSERT_TRUE(waitForStep(thread, 1));
+    thread.stop();
+    thread.fetchSnapshot();
+    EXPECT_NEAR(thread.snapshot().simulationTime, 2.0 + thread.snapshot().step * 0.01, 1e-9);
+}
+
+TEST(SimulationThreadTest, BodiesCanBeAddedUnderTheLock) {
+    GalaxyPhysicsController controller(nullptr, PhysicsBackend::Particles, 1);
+    OrbitingBodies bodies;
+    bodies.add(controller, 100.0);
+
+    SimulationThread thread(&controller, 0.01, 10.0);
+    thread.start();
+    ASSERT_TRUE(waitForStep(thread, 1));
+    {
+        auto lock = thread.lockController();
+        bodies.add(controller, 200.0);
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    bool seen = false;
+    while (!seen && std::chrono::steady_clock::now() < deadline) {
+        if (thread.fetchSnapshot()) seen = thread.snapshot().x.size() == 2;
+    }
+    thread.stop();
+    EXPECT_TRUE(seen);
+}
+
+TEST(SimulationThreadTest, BodiesCanBeRemovedByKey) {
+    GalaxyPhysicsController controller(nullptr, PhysicsBackend::Particles, 1);
+    OrbitingBodies bodies;
+    for (int key = 0; key < 4; ++key) bodies.add(controller, 100.0 * (key + 1), key);
+    controller.addSpring(controller.findBody(1), controller.findBody(3), 200.0); // At rest.
+
+    SimulationThread thread(&controller, 0.01, 10.0);
+    thread.start();
+    ASSERT_TRUE(waitForStep(thread, 1));
+    std::uint64_t version;
+    {
+        auto lock = thread.lockController();
+        EXPECT_EQ(controller.removeCelestialBody(1), bodies.wrappers[1].get());
+        EXPECT_EQ(controller.removeCelestialBody(1), nullptr);
+        version = controller.getBodiesVersion();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    bool seen = false;
+    while (!seen && std::chrono::steady_clock::now() < deadline) {
+        if (thread.fetchSnapshot()) seen = thread.snapshot().bodiesVersion == version;
+    }
+    thread.stop();
+    ASSERT_TRUE(seen);
+
+    // The last body took the freed slot; the spring went with the removed body.
+    EXPECT_EQ(controller.getBodies().size(), 3u);
+    EXPECT_EQ(controller.findBody(1), -1);
+    EXPECT_EQ(controller.findBody(3), 1);
+    EXPECT_EQ(controller.getBodies()[1], bodies.wrappers[3].get());
+    EXPECT_EQ(bodies.wrappers[3]->getParticleIndex(), 1);
+    EXPECT_EQ(controller.getSprings().size(), 0);
+    EXPECT_DOUBLE_EQ(thread.snapshot().x[1], 400.0);
+    EXPECT_EQ(bodies.wrappers[1]->getParticleIndex(), -1);
+    EXPECT_DOUBLE_EQ(bodies.wrappers[1]->getX(), 200.0) << "The detached body keeps its last state";
+}
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "SpatialHashGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+    struct Points {
+        std::vector<double> x, y, z;
+
+        double distance2(int i, double px, double py, double pz) const {
+            return (x[i] - px) * (x[i] - px) + (y[i] - py) * (y[i] - py) + (z[i] - pz) * (z[i] - pz);
+        }
+    };
+
+    /// Clustered points plus a few far outliers, to exercise both dense cells and empty space.
+    Points makePoints(int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> cluster(0.0, 30.0);
+        std::uniform_real_distribution<double> center(-500.0, 500.0);
+        Points points;
+        for (int c = 0; c < 8; ++c) {
+            double cx = center(rng), cy = center(rng), cz = center(rng) * 0.1;
+            for (int i = 0; i < count / 8; ++i) {
+                points.x.push_back(cx + cluster(rng));
+                points.y.push_back(cy + cluster(rng));
+                points.z.push_back(cz + cluster(rng) * 0.1);
+            }
+        }
+        points.x.push_back(1.0e5);
+        points.y.push_back(-3.0e4);
+        points.z.push_back(0.0);
+        return points;
+    }
+}
+
+TEST(SpatialHashGridTest, RadiusQueriesMatchBruteForce) {
+    Points points = makePoints(2000, 3);
+    const int n = static_cast<int>(points.x.size());
+    SpatialHashGrid grid(10.0);
+    grid.build(points.x.data(), points.y.data(), points.z.data(), n);
+    ASSERT_EQ(grid.size(), n);
+
+    for (int q = 0; q < 50; ++q) {
+        double px = points.x[q * 37] + 3.0, py = points.y[q * 37] - 2.0, pz = points.z[q * 37];
+        for (double radius: {0.0, 5.0, 25.0, 400.0}) {
+            std::vector<int> expected;
+            for (int i = 0; i < n; ++i)
+                if (points.distance2(i, px, py, pz) <= radius * radius) expected.push_back(i);
+            EXPECT_EQ(grid.queryRadius(px, py, pz, radius), expected) << "radius " << radius;
+        }
+    }
+
+    std::vector<std::pair<int, int>> expectedPairs;
+    for (int i = 0; i < n; ++i)
+        for (int j = i + 1; j < n; ++j)
+            if (points.distance2(i, points.x[j], points.y[j], points.z[j]) <= 4.0 * 4.0) expectedPairs.emplace_back(i, j);
+    EXPECT_FALSE(expectedPairs.empty());
+    EXPECT_EQ(grid.pairsWithin(4.0), expectedPairs);
+}
+
+TEST(SpatialHashGridTest, NearestAndKNearestMatchBruteForce) {
+    Points points = makePoints(1000, 11);
+    const int n = static_cast<int>(points.x.size());
+    SpatialHashGrid grid(8.0);
+    grid.build(points.x.data(), points.y.data(), points.z.data(), n);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> anywhere(-800.0, 800.0);
+    for (int q = 0; q < 100; ++q) {
+        double px = anywhere(rng), py = anywhere(rng), pz = anywhere(rng) * 0.05;
+        std::vector<std::pair<double, int>> sorted;
+        for (int i = 0; i < n; ++i) sorted.emplace_back(points.distance2(i, px, py, pz), i);
+        std::sort(sorted.begin(), sorted.end());
+
+        EXPECT_EQ(grid.nearest(px, py, pz), sorted[0].second);
+        std::vector<int> expected;
+        for (int i = 0; i < 7; ++i) expected.push_back(sorted[i].second);
+        EXPECT_EQ(grid.kNearest(px, py, pz, 7), expected);
+    }
+
+    // The outlier is found from far away, and a small search radius rejects it.
+    EXPECT_EQ(grid.nearest(2.0e5, -3.0e4, 0.0), n - 1);
+    EXPECT_EQ(grid.nearest(2.0e5, -3.0e4, 0.0, 100.0), -1);
+    EXPECT_EQ(static_cast<int>(grid.kNearest(0, 0, 0, n + 10).size()), n);
+}
+
+TEST(SpatialHashGridTest, PlanarPickingAndEmptyGrid) {
+    SpatialHashGrid grid(20.0);
+    EXPECT_EQ(grid.nearest(0, 0, 0), -1);
+    EXPECT_TRUE(grid.kNearest(0, 0, 0, 3).empty());
+    EXPECT_TRUE(grid.queryRadius(0, 0, 0, 100).empty());
+
+    std::vector<double> x = {100, 108, 300, -40};
+    std::vector<double> y = {100, 100, 50, -40};
+    grid.build(x.data(), y.data(), nullptr, 4);
+    EXPECT_EQ(grid.nearest(103, 101, 0, 10), 0);
+    EXPECT_EQ(grid.nearest(105, 101, 0, 10), 1);
+    EXPECT_EQ(grid.nearest(200, 200, 0, 10), -1);
+    EXPECT_EQ(grid.nearest(-39.5, -41, 0, 10), 3) << "Negative coordinates";
+    EXPECT_EQ(grid.queryRadius(104, 100, 0, 4), (std::vector<int>{0, 1}));
+
+    grid.clear();
+    EXPECT_EQ(grid.size(), 0);
+    EXPECT_EQ(grid.nearest(100, 100, 0), -1);
+}
@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+#include "SpringSet.h"
+#include <cmath>
+#include <random>
+
+namespace {
+    ParticleState makeBodies(int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> position(-100.0, 100.0);
+        std::uniform_real_distribution<double> mass(0.5, 4.0);
+        ParticleState state;
+        for (int i = 0; i < count; ++i) state.add(position(rng), position(rng), position(rng), mass(rng), 0.0);
+        return state;
+    }
+
+    /// Springs in random order and orientation, including parallel ones.
+    SpringSet makeSprings(int bodies, int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> body(0, bodies - 1);
+        std::uniform_real_distribution<double> value(1.0, 50.0);
+        SpringSet springs;
+        for (int s = 0; s < count; ++s) springs.add(body(rng), body(rng), value(rng), value(rng) * 0.1);
+        springs.add(3, 7, 10.0, 1.0);
+        springs.add(7, 3, 10.0, 1.0);
+        return springs;
+    }
+}
+
+TEST(SpringSetTest, MatchesPairwiseHookesLaw) {
+    ParticleState state = makeBodies(200, 1);
+    SpringSet springs = makeSprings(200, 1000, 2);
+
+    // Reference: the straightforward per-spring loop, before any reordering.
+    std::vector<double> ax(state.size(), 0.0), ay(state.size(), 0.0), az(state.size(), 0.0);
+    for (int s = 0; s < springs.size(); ++s) {
+        int a = springs.indexA()[s], b = springs.indexB()[s];
+        double dx = state.x[b] - state.x[a], dy = state.y[b] - state.y[a], dz = state.z[b] - state.z[a];
+        double d = std::sqrt(dx * dx + dy * dy + dz * dz);
+        double f = springs.stiffness()[s] * (d - springs.restLength()[s]) / d;
+        ax[a] += f * dx / state.mass[a];
+        ay[a] += f * dy / state.mass[a];
+        az[a] += f * dz / state.mass[a];
+        ax[b] -= f * dx / state.mass[b];
+        ay[b] -= f * dy / state.mass[b];
+        az[b] -= f * dz / state.mass[b];
+    }
+
+    springs.accumulate(state, nullptr);
+    for (int i = 0; i < state.size(); ++i) {
+        EXPECT_NEAR(state.ax[i], ax[i], 1e-9 * (1 + std::abs(ax[i])));
+        EXPECT_NEAR(state.ay[i], ay[i], 1e-9 * (1 + std::abs(ay[i])));
+        EXPECT_NEAR(state.az[i], az[i], 1e-9 * (1 + std::abs(az[i])));
+    }
+
+    // Canonical order: indexA < indexB, sorted for locality.
+    for (int s = 0; s < springs.size(); ++s) {
+        EXPECT_LT(springs.indexA()[s], springs.indexB()[s]);
+        if (s > 0) {
+            EXPECT_LE(springs.indexA()[s - 1], springs.indexA()[s]);
+        }
+    }
+}
+
+TEST(SpringSetTest, WorkerPoolGivesIdenticalResults) {
+    ParticleState serial = makeBodies(3000, 4);
+    ParticleState parallel = serial;
+    SpringSet springs = makeSprings(3000, 20000, 5);
+
+    springs.accumulate(serial, nullptr);
+    WorkerPool pool(3);
+    springs.accumulate(parallel, &pool);
+
+    EXPECT_EQ(serial.ax, parallel.ax);
+    EXPECT_EQ(serial.ay, parallel.ay);
+    EXPECT_EQ(serial.az, parallel.az);
+}
+
+TEST(SpringSetTest, IgnoresDegenerateSprings) {
+    ParticleState state;
+    state.add(1.0, 2.0, 3.0, 1.0, 0.0);
+    state.add(1.0, 2.0, 3.0, 1.0, 0.0);
+    state.add(5.0, 2.0, 3.0, 0.0, 0.0); // Massless and unconnected.
+
+    SpringSet springs;
+    springs.add(0, 0, 1.0, 1.0);
+    springs.add(-1, 1, 1.0, 1.0);
+    EXPECT_EQ(springs.size(), 0);
+
+    springs.add(1, 0, 1.0, 1.0); // Coincident endpoints.
+    springs.accumulate(state, nullptr);
+    for (int i = 0; i < state.size(); ++i) {
+        EXPECT_EQ(state.ax[i], 0.0);
+        EXPECT_EQ(state.ay[i], 0.0);
+        EXPECT_EQ(state.az[i], 0.0);
+    }
+
+    // Springs added after a pass (and a new body) are picked up.
+    state.add(1.0, 2.0, 13.0, 2.0, 0.0);
+    springs.add(3, 0, 4.0, 0.5);
+    springs.accumulate(state, nullptr);
+    EXPECT_DOUBLE_EQ(state.az[0], 0.5 * 6.0);
+    EXPECT_DOUBLE_EQ(state.az[3], -0.5 * 6.0 / 2.0);
+}
+
+TEST(SpringSetTest, RemoveBodyMatchesRebuiltSet) {
+    ParticleState state = makeBodies(50, 7);
+    SpringSet springs = makeSprings(50, 300, 8);
+    ParticleState before = state;
+    springs.accumulate(before, nullptr);
+
+    // Reference: the same springs added again without body 3, with body 49 renamed to 3.
+    SpringSet expected;
+    for (int s = 0; s < springs.size(); ++s) {
+        int a = springs.indexA()[s], b = springs.indexB()[s];
+        if (a == 3 || b == 3) continue;
+        expected.add(a == 49 ? 3 : a, b == 49 ? 3 : b, springs.restLength()[s], springs.stiffness()[s]);
+    }
+
+    const int moved = state.swapRemove(3);
+    EXPECT_EQ(moved, 49);
+    springs.removeBody(3, moved);
+    ASSERT_EQ(springs.size(), expected.size());
+
+    ParticleState actual = state, reference = state;
+    springs.accumulate(actual, nullptr);
+    expected.accumulate(reference, nullptr);
+    EXPECT_EQ(springs.indexA(), expected.indexA());
+    EXPECT_EQ(springs.indexB(), expected.indexB());
+    for (int i = 0; i < state.size(); ++i) {
+        EXPECT_DOUBLE_EQ(actual.ax[i], reference.ax[i]);
+        EXPECT_DOUBLE_EQ(actual.az[i], reference.az[i]);
+    }
+}
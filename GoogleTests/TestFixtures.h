@@ -17,6 +17,7 @@
 #include "gtest/gtest.h"
 #include "nlohmann/json.hpp"
 #include "RandomUtilities.h"
+#include "SimdKernels.h"
 
 using json = nlohmann::json;
 
@@ -258,4 +259,22 @@ protected:
     })");
 };
 
+/**
+ * @brief Restores the detected SIMD level after a test forces another one.
+ */
+class SimdKernelsFixture : public ::testing::Test {
+protected:
+    void TearDown() override {
+        SimdKernels::setLevel(SimdKernels::detectedLevel());
+    }
+
+    /// @brief Levels supported by this CPU, scalar first.
+    static std::vector<SimdKernels::Level> supportedLevels() {
+        std::vector<SimdKernels::Level> levels;
+        for (auto level: {SimdKernels::Level::Scalar, SimdKernels::Level::SSE41, SimdKernels::Level::AVX2})
+            if (level <= SimdKernels::detectedLevel()) levels.push_back(level);
+        return levels;
+    }
+};
+
 #endif // TESTFIXTURES_H
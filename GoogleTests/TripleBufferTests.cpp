@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include "TripleBuffer.h"
+#include <thread>
+#include <vector>
+
+TEST(TripleBufferTest, ConsumerSeesOnlyTheNewestValue) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.fetch()) << "Nothing published yet";
+
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    buffer.writeBuffer() = 2;
+    buffer.publish();
+
+    ASSERT_TRUE(buffer.fetch());
+    EXPECT_EQ(buffer.readBuffer(), 2);
+    EXPECT_FALSE(buffer.fetch()) << "The same value is not delivered twice";
+    EXPECT_EQ(buffer.readBuffer(), 2);
+
+    buffer.writeBuffer() = 3;
+    buffer.publish();
+    ASSERT_TRUE(buffer.fetch());
+    EXPECT_EQ(buffer.readBuffer(), 3);
+}
+
+TEST(TripleBufferTest, ProducerNeverOverwritesTheReadSlot) {
+    TripleBuffer<int> buffer;
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    ASSERT_TRUE(buffer.fetch());
+
+    for (int i = 2; i < 10; ++i) {
+        buffer.writeBuffer() = i;
+        buffer.publish();
+        EXPECT_EQ(buffer.readBuffer(), 1);
+    }
+    ASSERT_TRUE(buffer.fetch());
+    EXPECT_EQ(buffer.readBuffer(), 9);
+}
+
+TEST(TripleBufferTest, ConcurrentValuesAreCompleteAndInOrder) {
+    TripleBuffer<std::vector<int> > buffer;
+    const int rounds = 20000;
+
+    std::thread producer([&] {
+        for (int round = 1; round <= rounds; ++round) {
+            buffer.writeBuffer().assign(64, round);
+            buffer.publish();
+        }
+    });
+
+    int last = 0;
+    while (last < rounds) {
+        if (!buffer.fetch()) continue;
+        const auto &value = buffer.readBuffer();
+        ASSERT_EQ(value.size(), 64u);
+        for (int v: value) ASSERT_EQ(v, value.front()) << "Torn read";
+        ASSERT_GT(value.front(), last) << "Values arrive in publish order";
+        last = value.front();
+    }
+    producer.join();
+}
@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "WorkerPool.h"
+#include <atomic>
+#include <vector>
+
+TEST(WorkerPoolTest, EveryIndexIsVisitedOnce) {
+    WorkerPool pool(4);
+    EXPECT_EQ(pool.threadCount(), 4);
+
+    for (int count: {0, 1, 3, 4, 5, 1000}) {
+        std::vector<int> hits(count, 0);
+        std::vector<int> owner(count, -1);
+        pool.parallelFor(count, [&](int begin, int end, int worker) {
+            ASSERT_GE(worker, 0);
+            ASSERT_LT(worker, pool.threadCount());
+            for (int i = begin; i < end; ++i) {
+                ++hits[i];
+                owner[i] = worker;
+            }
+        });
+        for (int i = 0; i < count; ++i) {
+            EXPECT_EQ(hits[i], 1) << "count " << count << ", index " << i;
+            if (i > 0) {
+                EXPECT_LE(owner[i - 1], owner[i]) << "Blocks are contiguous and ordered by worker";
+            }
+        }
+    }
+}
+
+TEST(WorkerPoolTest, PartitionIsStableAcrossCalls) {
+    WorkerPool pool(3);
+    std::vector<int> first(100), again(100);
+    pool.parallelFor(100, [&](int begin, int end, int worker) {
+        for (int i = begin; i < end; ++i) first[i] = worker;
+    });
+    for (int round = 0; round < 200; ++round) {
+        pool.parallelFor(100, [&](int begin, int end, int worker) {
+            for (int i = begin; i < end; ++i) again[i] = worker;
+        });
+        ASSERT_EQ(first, again);
+    }
+}
+
+TEST(WorkerPoolTest, SingleThreadRunsInline) {
+    WorkerPool pool(1);
+    EXPECT_EQ(pool.threadCount(), 1);
+
+    std::atomic<int> calls{0};
+    pool.parallelFor(10, [&](int begin, int end, int worker) {
+        EXPECT_EQ(begin, 0);
+        EXPECT_EQ(end, 10);
+        EXPECT_EQ(worker, 0);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 1);
+}
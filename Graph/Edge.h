@@ -9,29 +9,30 @@
  * @class Edge
  * @brief Represents a connection (edge) between two vertices in a graph.
  * @tparam T The template parameter (templating for compatibility with Graph class).
+ * @tparam W The weight type (int by default; float/double for real distances).
  * @note This edge is conceptually undirected, since connects() checks both directions.
  */
-template<typename T>
+template<typename T, typename W = int>
 class Edge {
 public:
     int from; ///< The index of the starting vertex.
     int to; ///< The index of the ending vertex.
-    int weight; ///< The weight of the edge (e.g., distance).
+    W weight; ///< The weight of the edge (e.g., distance).
     /**
              * @brief Default constructor. Initializes an inactive edge.
              */
-    Edge() : from(-1), to(-1), weight(0) {
+    Edge() : from(-1), to(-1), weight(W{}) {
     }
 
     /**
              * @brief Sets the weight of the edge.
              * @param w The new weight.
              */
-    void changeWeight(int w) { weight = w; }
+    void changeWeight(W w) { weight = w; }
     /**
-     * @return The int value of the weight.
+     * @return The value of the weight.
      */
-    int getWeight() { return weight; }
+    W getWeight() { return weight; }
     /**
              * @brief Connects two vertices.
              * @param u The index of the first vertex.
@@ -57,7 +58,7 @@ public:
     void disconnect() {
         from = -1;
         to = -1;
-        weight = 0;
+        weight = W{};
     }
 
     /**
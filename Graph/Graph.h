@@ -16,21 +16,34 @@
  * This class provides the core storage (vertices, edges) and a common
  * interface that concrete classes (GraphList, GraphMatrix) must implement.
  * @tparam T The type of data stored in the vertices.
+ * @tparam W The edge weight type (int by default; float/double for real distances).
  */
-template<typename T>
+template<typename T, typename W = int>
 class Graph {
 protected:
     std::vector<Vertex<T> > vertices; ///< The list of all vertices in the graph.
-    std::vector<Edge<T> > edges; ///< The list of all edges in the graph.
+    std::vector<Edge<T, W> > edges; ///< The list of all edges in the graph.
 public:
+    using weight_type = W; ///< The edge weight type.
+
     /**
      * @brief Default virtual destructor.
      */
     virtual ~Graph() = default;
 
     std::vector<Vertex<T>>& getVertices() { return vertices; }
-    std::vector<Edge<T>>& getEdges() { return edges; }
+    std::vector<Edge<T, W>>& getEdges() { return edges; }
+    /// @brief Read-only access to the vertices (used by queries on snapshots).
+    const std::vector<Vertex<T>>& getVertices() const { return vertices; }
+    /// @brief Read-only access to the edges (used by queries on snapshots).
+    const std::vector<Edge<T, W>>& getEdges() const { return edges; }
+
 
+    /**
+     * @brief Returns the number of vertex slots (soft-deleted vertices included).
+     * Internal indices used by adjacency structures are in [0, vertexCount()).
+     */
+    int vertexCount() const { return static_cast<int>(vertices.size()); }
 
     int findIndexById(int id) const{
         for (int i = 0; i < vertices.size(); ++i)
@@ -53,7 +66,7 @@ public:
              * @param tId The public ID of the 'to' vertex.
              * @param weight The weight of the edge (default is 1).
              */
-    virtual void addEdge(int fId, int tId, int weight = 1) = 0;
+    virtual void addEdge(int fId, int tId, W weight = 1) = 0;
     /**
              * @brief Pure virtual method to remove a vertex.
              * @param id The public ID of the vertex to remove.
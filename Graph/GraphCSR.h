@@ -0,0 +1,110 @@
+#ifndef GRAPH_CSR_H
+#define GRAPH_CSR_H
+#include <span>
+#include <utility>
+#include <vector>
+#include "Graph.h"
+/**
+ * @file GraphCSR.h
+ * @brief Defines the GraphCSR class, a read-only compressed sparse row
+ * representation of a graph.
+ */
+
+/**
+ * @class GraphCSR
+ * @brief An immutable graph stored as one contiguous adjacency array plus row offsets.
+ *
+ * Built from any Graph (List or Matrix). The neighbors of vertex u occupy
+ * `adjacency[offsets[u] .. offsets[u + 1])`, so a traversal touches a single
+ * contiguous block of memory per vertex. Use it for query-heavy workloads
+ * (e.g., repeated pathfinding on a graph that does not change).
+ *
+ * @tparam T The type of data stored in the vertices.
+ * @tparam W The edge weight type (int by default).
+ * @note Edges are undirected, so each active edge is stored once per direction,
+ *       in the same order as GraphList::adjacencyList.
+ */
+template<typename T, typename W = int>
+class GraphCSR {
+private:
+    std::vector<Vertex<T> > vertices; ///< Copy of the source vertices.
+    std::vector<int> offsets; ///< Row offsets; size is vertexCount() + 1.
+    std::vector<std::pair<int, W> > adjacency; ///< Pairs (neighborIndex, weight) for all rows.
+
+public:
+    using weight_type = W; ///< The edge weight type.
+
+    /**
+     * @brief Default constructor. Creates an empty graph.
+     */
+    GraphCSR() = default;
+
+    /**
+     * @brief Builds the CSR representation from an existing graph.
+     * @param g The source graph (GraphList or GraphMatrix).
+     */
+    explicit GraphCSR(const Graph<T, W> &g) { build(g); }
+
+    /**
+     * @brief Rebuilds the CSR arrays from the active edges of a graph.
+     * @param g The source graph.
+     * @note Runs in O(V + E) with two passes over the edges.
+     */
+    void build(const Graph<T, W> &g) {
+        vertices = g.getVertices();
+        int n = static_cast<int>(vertices.size());
+        offsets.assign(n + 1, 0);
+
+        for (const auto &edge: g.getEdges()) {
+            if (!edge.isActive()) continue;
+            offsets[edge.from + 1]++;
+            offsets[edge.to + 1]++;
+        }
+        for (int i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+
+        adjacency.resize(offsets[n]);
+        std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        for (const auto &edge: g.getEdges()) {
+            if (!edge.isActive()) continue;
+            adjacency[cursor[edge.from]++] = {edge.to, edge.weight};
+            adjacency[cursor[edge.to]++] = {edge.from, edge.weight};
+        }
+    }
+
+    /**
+     * @brief Returns the number of vertex slots.
+     */
+    int vertexCount() const { return static_cast<int>(vertices.size()); }
+
+    /**
+     * @brief Returns the number of stored adjacency entries (2 per undirected edge).
+     */
+    int adjacencySize() const { return static_cast<int>(adjacency.size()); }
+
+    /**
+     * @brief Read-only access to the vertices.
+     */
+    const std::vector<Vertex<T> > &getVertices() const { return vertices; }
+
+    /**
+     * @brief Finds the internal index of a vertex by its public ID.
+     * @param id The public ID of the vertex.
+     * @return The index, or -1 if not found.
+     */
+    int findIndexById(int id) const {
+        for (int i = 0; i < static_cast<int>(vertices.size()); ++i)
+            if (vertices[i].getId() == id) return i;
+        return -1;
+    }
+
+    /**
+     * @brief Returns the neighbors of a vertex as a contiguous span.
+     * @param u The internal index of the vertex.
+     * @return A span of (neighborIndex, weight) pairs.
+     */
+    std::span<const std::pair<int, W> > neighbors(int u) const {
+        return {adjacency.data() + offsets[u], adjacency.data() + offsets[u + 1]};
+    }
+};
+
+#endif //GRAPH_CSR_H
@@ -0,0 +1,40 @@
+#ifndef GRAPH_CONCEPTS_H
+#define GRAPH_CONCEPTS_H
+#include <concepts>
+#include <ranges>
+/**
+ * @file GraphConcepts.h
+ * @brief Defines the compile-time interface shared by all graph representations.
+ */
+
+/**
+ * @concept AdjacencyGraph
+ * @brief A graph that exposes its adjacency as a range of (neighborIndex, weight) pairs.
+ *
+ * GraphList, GraphMatrix and GraphCSR all satisfy this concept, so the algorithms
+ * in GraphTraversal.h are written once and instantiated per representation
+ * without any virtual calls in the inner loops.
+ *
+ * Requirements:
+ * - `g.vertexCount()` returns the number of vertex slots (including soft-deleted ones).
+ * - `g.findIndexById(id)` maps a public ID to an internal index (-1 if absent).
+ * - `g.neighbors(u)` returns a forward range of pair-like (v, w) elements.
+ * - `g.getVertices()` gives access to the vertex data.
+ * - `G::weight_type` names the edge weight type (int, float or double).
+ */
+template<typename G>
+concept AdjacencyGraph = requires(const G &g, int u) {
+    typename G::weight_type;
+    { g.vertexCount() } -> std::convertible_to<int>;
+    { g.findIndexById(u) } -> std::convertible_to<int>;
+    { g.neighbors(u) } -> std::ranges::forward_range;
+    g.getVertices();
+};
+
+/**
+ * @brief The edge weight type of an AdjacencyGraph.
+ */
+template<AdjacencyGraph G>
+using graph_weight_t = typename G::weight_type;
+
+#endif //GRAPH_CONCEPTS_H
@@ -11,16 +11,23 @@
  * @class GraphList
  * @brief A concrete implementation of the Graph interface using an adjacency list.
  * @tparam T The type of data stored in the vertices.
+ * @tparam W The edge weight type (int by default).
  * @note For undirected graphs, each edge is stored twice: once for each direction.
  *       That is, if there is an edge between vertex A and B, both A's and B's adjacency lists
  *       will contain the other vertex.
  * @see Graph
  */
-template<typename T>
-class GraphList : public Graph<T> {
+template<typename T, typename W = int>
+class GraphList : public Graph<T, W> {
 public:
     ///< Each entry adjacencyList[i] stores pairs (neighborIndex, weight).
-    std::vector<std::vector<std::pair<int, int> > > adjacencyList;
+    std::vector<std::vector<std::pair<int, W> > > adjacencyList;
+    /**
+         * @brief Returns the neighbors of a vertex (see AdjacencyGraph in GraphConcepts.h).
+         * @param u The internal index of the vertex.
+         * @return A reference to the (neighborIndex, weight) pairs of vertex u.
+         */
+    const std::vector<std::pair<int, W> > &neighbors(int u) const { return adjacencyList[u]; }
     /**
          * @brief Constructs the adjacency list from the current set of vertices and edges.
          *
@@ -48,13 +55,13 @@ public:
              * @param tId The public ID of the 'to' vertex.
              * @param weight The weight of the edge (default is 1).
              */
-    void addEdge(int fId, int tId, int weight = 1) override {
+    void addEdge(int fId, int tId, W weight = 1) override {
         int f = this->findIndexById(fId);
         int t = this->findIndexById(tId);
         if (f == -1 || t == -1) return;
         if (this->edgeExists(fId, tId)) return;
 
-        Edge<T> edge;
+        Edge<T, W> edge;
         edge.connect(f, t);
         edge.weight = weight;
         this->edges.push_back(edge);
@@ -1,5 +1,6 @@
 #ifndef GRAPH_MATRIX_H
 #define GRAPH_MATRIX_H
+#include <iterator>
 #include "Graph.h"
 /**
  * @file GraphMatrix.h
@@ -7,13 +8,84 @@
  * using an adjacency matrix.
  */
 
+/**
+ * @class MatrixNeighborRange
+ * @brief A lightweight forward range over the non-zero entries of one matrix row.
+ *
+ * Yields (neighborIndex, weight) pairs, so matrix rows can be traversed with the
+ * same code as adjacency lists (see AdjacencyGraph in GraphConcepts.h).
+ * @tparam W The edge weight type.
+ */
+template<typename W>
+class MatrixNeighborRange {
+public:
+    /**
+     * @brief Iterator that skips zero (absent) entries of the row.
+     */
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<int, W>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        iterator() = default;
+
+        iterator(const W *first, const W *cur, const W *last) : first(first), cur(cur), last(last) {
+            skipAbsent();
+        }
+
+        value_type operator*() const { return {static_cast<int>(cur - first), *cur}; }
+
+        iterator &operator++() {
+            ++cur;
+            skipAbsent();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator &other) const { return cur == other.cur; }
+
+    private:
+        const W *first = nullptr; ///< Start of the row (column 0).
+        const W *cur = nullptr; ///< Current column.
+        const W *last = nullptr; ///< One past the last column.
+
+        void skipAbsent() {
+            while (cur != last && *cur == W{}) ++cur;
+        }
+    };
+
+    MatrixNeighborRange() = default;
+
+    /**
+     * @param row The matrix row to iterate over.
+     */
+    explicit MatrixNeighborRange(const std::vector<W> &row) : first(row.data()), last(row.data() + row.size()) {
+    }
+
+    iterator begin() const { return iterator(first, first, last); }
+    iterator end() const { return iterator(first, last, last); }
+
+private:
+    const W *first = nullptr; ///< Start of the row.
+    const W *last = nullptr; ///< One past the end of the row.
+};
+
 /**
  * @class GraphMatrix
  * @brief A concrete implementation of the Graph interface using an adjacency matrix.
  * @tparam T The type of data stored in the vertices.
+ * @tparam W The edge weight type (int by default). A zero entry means "no edge".
  */
-template<typename T>
-class GraphMatrix : public Graph<T> {
+template<typename T, typename W = int>
+class GraphMatrix : public Graph<T, W> {
 public:
     /**
             * @brief Default constructor.
@@ -25,19 +97,25 @@ public:
      * @param eds Vector of edges to add.
      * @see Graph
      */
-    GraphMatrix(const std::vector<Vertex<T>>& verts, const std::vector<Edge<T>>& eds) {
+    GraphMatrix(const std::vector<Vertex<T>>& verts, const std::vector<Edge<T, W>>& eds) {
         this->vertices = verts;
         this->edges = eds;
         constructAdjacency();
     }
     ///< The adjacency matrix. Index [row][col] stores the edge weight.
-    std::vector<std::vector<int> > adjacencyMatrix;
+    std::vector<std::vector<W> > adjacencyMatrix;
+    /**
+     * @brief Returns the neighbors of a vertex (see AdjacencyGraph in GraphConcepts.h).
+     * @param u The internal index of the vertex.
+     * @return A range over the non-zero entries of row u.
+     */
+    MatrixNeighborRange<W> neighbors(int u) const { return MatrixNeighborRange<W>(adjacencyMatrix[u]); }
     /**
             * @brief Rebuilds the adjacency matrix from the internal edges vector.
             */
     void constructAdjacency() override {
         int n = this->vertices.size();
-        adjacencyMatrix.assign(n, std::vector<int>(n, 0));
+        adjacencyMatrix.assign(n, std::vector<W>(n, W{}));
         for (auto &edge: this->edges) {
             if (edge.isActive()) {
                 adjacencyMatrix[edge.from][edge.to] = edge.weight;
@@ -51,13 +129,13 @@ public:
              * @param tId The public ID of the 'to' vertex.
              * @param weight The weight of the edge (default is 1).
              */
-    void addEdge(int fId, int tId, int weight = 1) override {
+    void addEdge(int fId, int tId, W weight = 1) override {
         int f = this->findIndexById(fId);
         int t = this->findIndexById(tId);
         if (f == -1 || t == -1) return;
         if (this->edgeExists(fId, tId)) return;
 
-        Edge<T> edge;
+        Edge<T, W> edge;
         edge.connect(f, t);
         edge.weight = weight;
         this->edges.push_back(edge);
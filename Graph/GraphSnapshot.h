@@ -0,0 +1,98 @@
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+/**
+ * @file GraphSnapshot.h
+ * @brief Defines the GraphSnapshotStore class, which publishes immutable,
+ * versioned copies of a graph for concurrent read-only queries.
+ */
+
+/**
+ * @struct GraphSnapshot
+ * @brief An immutable copy of a graph taken at a specific version.
+ * @tparam GraphType The concrete graph type (e.g., GraphList<CelestialObject*>).
+ */
+template<typename GraphType>
+struct GraphSnapshot {
+    std::uint64_t version = 0; ///< Monotonic version number of the snapshot (0 = empty graph).
+    GraphType graph; ///< Copy of the vertices, edges and adjacency structure.
+};
+
+/**
+ * @class GraphSnapshotStore
+ * @brief Single-writer, multi-reader store of versioned graph snapshots.
+ *
+ * The writer keeps editing its own mutable graph and calls publish() at
+ * consistent points (e.g., after a dialog edit or a physics tick). publish()
+ * copies the graph into a new immutable GraphSnapshot and swaps it in atomically.
+ * Readers call acquire() from any thread and run queries on the returned snapshot
+ * without locks; later edits never touch it.
+ *
+ * A snapshot is reclaimed when the last reader holding it releases its
+ * std::shared_ptr, so a long-running query keeps its version alive while new
+ * versions are published.
+ *
+ * @tparam GraphType The concrete graph type (e.g., GraphList<CelestialObject*>).
+ *
+ * @code
+ * GraphSnapshotStore<GraphList<std::string>> store;
+ * store.publish(graph);                       // writer (GUI thread)
+ * auto snap = store.acquire();                // reader (worker thread)
+ * DijkstraPathList<std::string> solver;
+ * auto path = solver.findShortestPath(snap->graph, 0, 5);
+ * @endcode
+ */
+template<typename GraphType>
+class GraphSnapshotStore {
+private:
+    std::atomic<std::shared_ptr<const GraphSnapshot<GraphType> > > current; ///< The latest published snapshot.
+    std::uint64_t lastVersion = 0; ///< Version of the latest snapshot (guarded by writerMutex).
+    std::mutex writerMutex; ///< Serializes publishers so versions stay monotonic.
+
+public:
+    /**
+     * @brief Constructs the store with an empty snapshot at version 0.
+     */
+    GraphSnapshotStore() : current(std::make_shared<const GraphSnapshot<GraphType> >()) {
+    }
+
+    GraphSnapshotStore(const GraphSnapshotStore &) = delete;
+
+    GraphSnapshotStore &operator=(const GraphSnapshotStore &) = delete;
+
+    /**
+     * @brief Copies the graph into a new immutable snapshot and makes it current.
+     * @param graph The writer's mutable graph.
+     * @return The version number assigned to the new snapshot.
+     * @note Cost is O(V + E) for a list graph and O(V^2) for a matrix graph.
+     */
+    std::uint64_t publish(const GraphType &graph) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        auto snapshot = std::make_shared<GraphSnapshot<GraphType> >();
+        snapshot->version = ++lastVersion;
+        snapshot->graph = graph;
+        current.store(std::move(snapshot), std::memory_order_release);
+        return lastVersion;
+    }
+
+    /**
+     * @brief Returns the latest published snapshot.
+     * Safe to call from any thread while the writer publishes.
+     * @return A shared pointer that keeps the snapshot alive while it is held.
+     */
+    std::shared_ptr<const GraphSnapshot<GraphType> > acquire() const {
+        return current.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns the version of the latest published snapshot.
+     */
+    std::uint64_t version() const {
+        return acquire()->version;
+    }
+};
+
+#endif //GRAPH_SNAPSHOT_H
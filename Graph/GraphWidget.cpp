@@ -38,9 +38,34 @@ void GraphWidget::setGraph(const std::vector<W_Vertex> &v, const std::vector<W_E
                            const std::vector<CelestialObject *> *objects) {
     vertices = v;
     edges = e;
-    this->celestialObjectsPtr = objects;
+    if (objects != celestialObjectsPtr || (objects && objects->size() != planetOrbitObjects)) {
+        this->celestialObjectsPtr = objects;
+        refreshPlanetOrbits();
+    }
+
+    std::vector<double> xs, ys;
+    pickIds.clear();
+    for (const auto &vertex: vertices) {
+        if (vertex.id < 0) continue;
+        xs.push_back(vertex.x);
+        ys.push_back(vertex.y);
+        pickIds.push_back(vertex.id);
+    }
+    pickGrid.build(xs.data(), ys.data(), nullptr, static_cast<int>(pickIds.size()));
     update();
 }
+
+void GraphWidget::refreshPlanetOrbits() {
+    planetOrbits.clear();
+    planetOrbitObjects = celestialObjectsPtr ? celestialObjectsPtr->size() : 0;
+    if (celestialObjectsPtr) planetOrbits.build(*celestialObjectsPtr);
+}
+
+int GraphWidget::vertexAt(const QPointF &point) const {
+    int hit = pickGrid.nearest(point.x(), point.y(), 0.0, PICK_RADIUS);
+    return hit >= 0 ? pickIds[hit] : -1;
+}
+
 void GraphWidget::mouseDoubleClickEvent(QMouseEvent *event) {
     if (event->button() == Qt::LeftButton) {
         QPoint clickPt = event->position().toPoint();
@@ -69,11 +94,11 @@ void GraphWidget::mouseDoubleClickEvent(QMouseEvent *event) {
                     if (scaleFactor > 40.0) scaleFactor = 40.0;
 
                     QPointF screenCenter(width() / 2.0, height() / 2.0);
+                    planetOrbits.propagate(QDateTime::currentMSecsSinceEpoch() / 1000.0);
 
                     for (size_t i = 0; i < system->getPlanets().size(); ++i) {
-                        Planet *planet = system->getPlanets()[i];
-
-                        QPointF localOffset = calculatePlanetOffset(planet, orbitStart, scaleFactor);
+                        QPointF localOffset = calculatePlanetOffset(detailedVertexId, static_cast<int>(i),
+                                                                    orbitStart, scaleFactor);
 
                         QPointF screenOffset(localOffset.x() * painterScale, localOffset.y() * painterScale);
                         QPointF planetPos = screenCenter + screenOffset;
@@ -91,15 +116,10 @@ void GraphWidget::mouseDoubleClickEvent(QMouseEvent *event) {
                 }
             }
         } else {
-            for (size_t i = 0; i < vertices.size(); ++i) {
-                const auto &vertex = vertices[i];
-                if (vertex.id < 0) continue;
-                int dx = clickPt.x() - vertex.x;
-                int dy = clickPt.y() - vertex.y;
-                if (dx * dx + dy * dy <= 10 * 10) {
-                    emit vertexDoubleClicked(vertex.id);
-                    return;
-                }
+            int id = vertexAt(clickPt);
+            if (id >= 0) {
+                emit vertexDoubleClicked(id);
+                return;
             }
         }
     }
@@ -120,21 +140,12 @@ void GraphWidget::resetPlanetZoom() {
 void GraphWidget::mousePressEvent(QMouseEvent *event) {
     if (event->button() == Qt::LeftButton) {
         QPoint clickPt = event->position().toPoint();
-        bool clickedOnVertex = false;
-        for (size_t i = 0; i < vertices.size(); ++i) {
-            const auto &vertex = vertices[i];
-            if (vertex.id < 0) continue;
-            int dx = clickPt.x() - vertex.x;
-            int dy = clickPt.y() - vertex.y;
-            if (dx * dx + dy * dy <= 10 * 10) {
-                emit vertexClicked(vertex.id);
-                clickedOnVertex = true;
-                return;
-            }
-        }
-        if (!clickedOnVertex) {
-            emit backgroundClicked();
+        int id = vertexAt(clickPt);
+        if (id >= 0) {
+            emit vertexClicked(id);
+            return;
         }
+        emit backgroundClicked();
     }
     QWidget::mousePressEvent(event);
 }
@@ -554,10 +565,11 @@ void GraphWidget::paintEvent(QPaintEvent *event) {
                 if (scaleFactor < 0.1) scaleFactor = 0.1;
                 if (scaleFactor > 40.0) scaleFactor = 40.0;
 
+                planetOrbits.propagate(QDateTime::currentMSecsSinceEpoch() / 1000.0);
                 for (size_t i = 0; i < system->getPlanets().size(); ++i) {
                     Planet *planet = system->getPlanets()[i];
 
-                    QPointF offset = calculatePlanetOffset(planet, orbitStart, scaleFactor);
+                    QPointF offset = calculatePlanetOffset(detailedVertexId, static_cast<int>(i), orbitStart, scaleFactor);
                     QPointF planetCenter(center.x() + offset.x(), center.y() + offset.y());
 
                     double orbitRadiusPx = std::sqrt(offset.x()*offset.x() + offset.y()*offset.y());
@@ -595,7 +607,7 @@ void GraphWidget::paintEvent(QPaintEvent *event) {
 
             QPointF midPoint = (p1 + p2) / 2.0;
             painter.setPen(Qt::yellow);
-            painter.drawText(midPoint, QString::number(edge.weight));
+            painter.drawText(midPoint, QString::number(edge.weight, 'f', 1));
             painter.setPen(QPen(Qt::white, 1, Qt::DashLine));
         }
 
@@ -747,12 +759,15 @@ double GraphWidget::calculateOrbitStart(StarSystem *system, double starRadius) {
     return starRadius + maxPlanetRadius + 12.0;
 }
 
-QPointF GraphWidget::calculatePlanetOffset(const Planet *planet, double orbitStart, double scaleFactor) const {
-    double orbitRadiusBase = orbitStart + (planet->getOrbit() * scaleFactor);
-    double time = QDateTime::currentMSecsSinceEpoch() / 1000.0;
-    double angularSpeed = 1.0 / std::sqrt(planet->getOrbit() + 1.0);
-    double angle = time * angularSpeed * 0.5;
-
-    return QPointF(orbitRadiusBase * std::cos(angle),
-                   orbitRadiusBase * std::sin(angle));
+QPointF GraphWidget::calculatePlanetOffset(int objectIndex, int planetIndex, double orbitStart,
+                                           double scaleFactor) const {
+    if (planetIndex >= planetOrbits.planetCount(objectIndex)) return QPointF(orbitStart, 0.0);
+    const int p = planetOrbits.firstPlanet(objectIndex) + planetIndex;
+    const double a = planetOrbits.semiMajorAxis()[p];
+    double orbitRadiusBase = orbitStart + (a * scaleFactor);
+    if (a <= 0.0) return QPointF(orbitRadiusBase, 0.0);
+
+    // The 2D view looks down on the orbit plane.
+    return QPointF(orbitRadiusBase * planetOrbits.u()[p] / a,
+                   orbitRadiusBase * planetOrbits.v()[p] / a);
 }
@@ -3,6 +3,8 @@
 #include "CelestialObject.h"
 #include "StarSystem.h"
 #include "Nebula.h"
+#include "SpatialHashGrid.h"
+#include "PlanetOrbitPropagator.h"
 #include <QtWidgets/QWidget>
 #include <vector>
 #include <QTimer>
@@ -19,7 +21,7 @@
 struct W_Edge {
     int from; ///< The index of the 'from' vertex.
     int to; ///< The index of the 'to' vertex.
-    int weight; ///< The weight of the edge.
+    double weight; ///< The weight of the edge (real distance).
 };
 
 /**
@@ -95,6 +97,13 @@ public:
     void setShowAxialTilt(bool show);
 
     int getDetailedPlanetIndex() const;
+
+    /**
+     * @brief Re-reads the planet orbits after planets were added, removed or edited.
+     *
+     * setGraph() only does this when the object vector itself changes.
+     */
+    void refreshPlanetOrbits();
 signals:
     /**
      * @brief Qt Signal: Emitted when a user double-clicks on a vertex.
@@ -137,6 +146,17 @@ private:
     ///< Qt Timer used to drive animations in detail mode (e.g., planet orbits).
     QTimer *animationTimer = nullptr;
     std::unordered_set<int> highlightedIds;
+    ///< Click distance (pixels) within which a vertex counts as hit.
+    static constexpr double PICK_RADIUS = 10.0;
+    ///< Screen positions of the drawn vertices, rebuilt in setGraph() for O(1) picking.
+    SpatialHashGrid pickGrid{2 * PICK_RADIUS};
+    ///< Vertex id of every point in pickGrid.
+    std::vector<int> pickIds;
+
+    /**
+     * @brief Returns the id of the vertex closest to a screen point, or -1 if none is within PICK_RADIUS.
+     */
+    int vertexAt(const QPointF &point) const;
     std::vector<BackgroundStar> stars;
 
     void generateBackgroundStars();
@@ -145,7 +165,19 @@ private:
     int detailedPlanetIndex = -1;
     double calculateOrbitStart(StarSystem* system, double starRadius);
 
-    QPointF calculatePlanetOffset(const Planet* planet, double orbitStart, double scaleFactor) const;
+    ///< Orbits of all planets in the galaxy, propagated to the current time on every paint.
+    PlanetOrbitPropagator planetOrbits;
+    ///< Number of objects planetOrbits was built from.
+    std::size_t planetOrbitObjects = 0;
+
+    /**
+     * @brief Returns the drawing offset of a planet from its star.
+     * @param objectIndex Galaxy index of the star system.
+     * @param planetIndex Index of the planet within the system.
+     * @param orbitStart Radius of an orbit of 0 AU.
+     * @param scaleFactor Pixels per AU.
+     */
+    QPointF calculatePlanetOffset(int objectIndex, int planetIndex, double orbitStart, double scaleFactor) const;
 
     bool showAxialTilt = false;
 };
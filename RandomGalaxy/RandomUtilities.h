@@ -3,6 +3,7 @@
 #include <fstream>
 #include <iostream>
 #include <random>
+#include <sstream>
 #include <QColor>
 /**
  * @file RandomUtilities.h
@@ -122,6 +123,29 @@ public:
      */
     std::mt19937& getEngine() { return gen; }
 
+    /**
+     * @brief Returns the full engine state as text, e.g. to store it in a checkpoint.
+     * @return The state in std::mt19937's stream format.
+     */
+    std::string saveState() const {
+        std::ostringstream out;
+        out << gen;
+        return out.str();
+    }
+
+    /**
+     * @brief Continues the random sequence from a state returned by saveState().
+     * @param state The saved state.
+     * @return False (and the engine unchanged) if the state cannot be parsed.
+     */
+    bool restoreState(const std::string& state) {
+        std::istringstream in(state);
+        std::mt19937 restored;
+        if (!(in >> restored)) return false;
+        gen = restored;
+        return true;
+    }
+
 
 
 };
@@ -1,6 +1,10 @@
 #include <iostream>
 #include <chrono>
+#include <random>
+#include <cmath>
 #include <string>
+#include <algorithm>
+#include <thread>
 
 #include "GraphList.h"
 #include "BFSList.h"
@@ -9,6 +13,188 @@
 #include "DFSMatrix.h"
 #include "DijkstraMatrix.h"
 #include "DijkstraList.h"
+#include "FloydWarshallMatrix.h"
+#include "SimdKernels.h"
+#include "BarnesHutTree.h"
+#include "MultilevelLayout.h"
+
+/**
+ * @brief Times the blocked Floyd–Warshall on a dense random graph at every SIMD level the CPU supports.
+ */
+void runAllPairsTest() {
+    const int N = 1000;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> weight(1.0, 100.0);
+    std::bernoulli_distribution hasEdge(0.3);
+
+    std::vector<Vertex<int> > vertices(N);
+    std::vector<Edge<int, double> > edges;
+    for (int i = 0; i < N; ++i) {
+        vertices[i].setId(i);
+        vertices[i].setData(i);
+        for (int j = i + 1; j < N; ++j) {
+            if (!hasEdge(rng)) continue;
+            Edge<int, double> edge;
+            edge.connect(i, j);
+            edge.weight = weight(rng);
+            edges.push_back(edge);
+        }
+    }
+    GraphMatrix<int, double> dense(vertices, edges);
+
+    std::cout << "\n==================================================" << std::endl;
+    std::cout << "     ALL-PAIRS (Floyd-Warshall, " << N << " vertices)     " << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    const SimdKernels::Level detected = SimdKernels::detectedLevel();
+    for (auto level: {SimdKernels::Level::Scalar, SimdKernels::Level::SSE41, SimdKernels::Level::AVX2}) {
+        if (level > detected) break;
+        SimdKernels::setLevel(level);
+        auto start = std::chrono::high_resolution_clock::now();
+        AllPairsDistances<double> table = floydWarshall(dense);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "APSP (" << SimdKernels::levelName(level) << "): "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms"
+                << " (d[0][N-1] = " << table.at(0, N - 1) << ")\n";
+    }
+    SimdKernels::setLevel(detected);
+    std::cout << "==================================================" << std::endl;
+}
+
+/**
+ * @brief Times one Barnes–Hut gravity evaluation (tree build + walk) for a large body count
+ * and compares it with the direct O(N^2) sum on a smaller sample.
+ */
+void runNBodyTest() {
+    const int N = 100000;
+    const int DIRECT_N = 5000;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> radius(100.0, 2500.0);
+    std::uniform_real_distribution<double> angle(0.0, 2 * M_PI);
+    std::uniform_real_distribution<double> height(-50.0, 50.0);
+    std::uniform_real_distribution<double> mass(0.1, 1.0);
+
+    std::vector<double> x(N), y(N), z(N), m(N), ax(N), ay(N), az(N);
+    for (int i = 0; i < N; ++i) {
+        double r = radius(rng), a = angle(rng);
+        x[i] = r * std::cos(a);
+        y[i] = height(rng);
+        z[i] = r * std::sin(a);
+        m[i] = mass(rng);
+    }
+
+    std::cout << "\n==================================================" << std::endl;
+    std::cout << "        N-BODY GRAVITY (Barnes-Hut, theta 0.5)    " << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    BarnesHutTree tree;
+    const SimdKernels::Level detected = SimdKernels::detectedLevel();
+    for (auto level: {SimdKernels::Level::Scalar, SimdKernels::Level::AVX2}) {
+        if (level > detected) break;
+        SimdKernels::setLevel(level);
+        for (int n: {DIRECT_N, N}) {
+            auto start = std::chrono::high_resolution_clock::now();
+            tree.build(x.data(), y.data(), z.data(), m.data(), n);
+            tree.computeAccelerations(1.0, 0.5, 1.0, ax.data(), ay.data(), az.data());
+            auto end = std::chrono::high_resolution_clock::now();
+            std::cout << "Barnes-Hut (" << n << " bodies, " << SimdKernels::levelName(level) << "): "
+                    << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int rep = 0; rep < 100; ++rep)
+            SimdKernels::centralGravity(x.data(), y.data(), z.data(), ax.data(), ay.data(), az.data(), N,
+                                        0.0, 0.0, 0.0, 1.3e5, 100.0);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "Central gravity x100 (" << N << " bodies, " << SimdKernels::levelName(level) << "): "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
+    }
+    SimdKernels::setLevel(detected);
+
+    tree.build(x.data(), y.data(), z.data(), m.data(), N);
+    const int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= hardwareThreads; threads *= 2) {
+        WorkerPool pool(threads);
+        auto start = std::chrono::high_resolution_clock::now();
+        tree.computeAccelerations(1.0, 0.5, 1.0, ax.data(), ay.data(), az.data(), &pool);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "Barnes-Hut walk (" << N << " bodies, " << threads << " threads): "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    double sink = 0;
+    for (int i = 0; i < DIRECT_N; ++i) {
+        for (int j = 0; j < DIRECT_N; ++j) {
+            double dx = x[j] - x[i], dy = y[j] - y[i], dz = z[j] - z[i];
+            double r2 = dx * dx + dy * dy + dz * dz + 1.0;
+            sink += m[j] * dx / (r2 * std::sqrt(r2));
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto directMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    double scale = static_cast<double>(N) / DIRECT_N;
+    std::cout << "Direct sum (" << DIRECT_N << " bodies): " << directMs << " ms"
+            << " (~" << static_cast<long long>(directMs * scale * scale) << " ms at " << N << ", checksum " << sink << ")\n";
+    std::cout << "==================================================" << std::endl;
+}
+
+/**
+ * @brief Times the force-directed start layout on a galaxy-shaped graph (random tree,
+ * edge lengths 500..2250) from a scrambled start, single-level and multilevel, at 1, 2, 4, ... threads.
+ */
+void runLayoutTest() {
+    const int N = 50000;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<int> from, to;
+    std::vector<double> rest;
+    for (int i = 0; i < N - 1; ++i) {
+        from.push_back(i);
+        to.push_back(i + 1 + static_cast<int>(unit(rng) * (N - 1 - i)));
+        rest.push_back(5 * (100 + unit(rng) * 350));
+    }
+    std::vector<double> startX(N), startY(N), startZ(N, 0.0);
+    for (int i = 0; i < N; ++i) {
+        startX[i] = (unit(rng) - 0.5) * 2000;
+        startY[i] = (unit(rng) - 0.5) * 2000;
+    }
+
+    std::cout << "\n==================================================" << std::endl;
+    std::cout << "          FORCE-DIRECTED LAYOUT (planar)          " << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    ForceDirectedLayout::Options options;
+    options.planar = true;
+    const int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= hardwareThreads; threads *= 2) {
+        WorkerPool pool(threads);
+        ForceDirectedLayout layout(&pool);
+        std::vector<double> x = startX, y = startY, z = startZ;
+        auto start = std::chrono::high_resolution_clock::now();
+        layout.setGraph(N, from, to, rest);
+        int iterations = layout.run(x.data(), y.data(), z.data(), options);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "Layout (" << N << " vertices, " << threads << " threads): "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+                << iterations << " iterations\n";
+    }
+    for (int threads = 1; threads <= hardwareThreads; threads *= 2) {
+        WorkerPool pool(threads);
+        MultilevelLayout layout(&pool);
+        std::vector<double> x = startX, y = startY, z = startZ;
+        MultilevelLayout::Options multilevelOptions;
+        multilevelOptions.layout = options;
+        auto start = std::chrono::high_resolution_clock::now();
+        layout.setGraph(N, from, to, rest);
+        int iterations = layout.run(x.data(), y.data(), z.data(), multilevelOptions);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "Multilevel layout (" << N << " vertices, " << threads << " threads): "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+                << iterations << " iterations on " << layout.levelCount() << " levels\n";
+    }
+    std::cout << "==================================================" << std::endl;
+}
 
 void runPerformanceTest() {
     GraphList<std::string> gList;
@@ -81,6 +267,10 @@ void runPerformanceTest() {
     end = std::chrono::high_resolution_clock::now();
     std::cout << "Dijkstra (Matrix): " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
     std::cout << "==================================================" << std::endl;
+
+    runAllPairsTest();
+    runNBodyTest();
+    runLayoutTest();
 }
 
 /**
@@ -0,0 +1,229 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GalaxyFactory.h"
+#include "GalaxyPhysicsController.h"
+#include "BlackHoleGravityField.h"
+#include "BarnesHutGravityField.h"
+#include "PhysicsCheckpoint.h"
+#include "Star.h"
+
+/**
+ * @file SimulationRunner.cpp
+ * @brief Headless physics run for benchmarks and regression checks on machines without a display.
+ *
+ * Builds a galaxy from a fixed seed, places it like GalaxyView3D does (disk of radius
+ * 500..2400 around the central black hole, circular velocities), runs a fixed number
+ * of GalaxyPhysicsController steps on the particle backend and prints steps per second,
+ * the relative energy drift and a position checksum. Same seed and options give the
+ * same checksum for a given thread count, so it can be compared between builds.
+ *
+ * @code
+ * SimulationRunner --bodies 20000 --steps 500 --threads 4
+ * SimulationRunner --data RandomGalaxy/CelestialObjects.json --seed 7 --max-drift 1e-3
+ * SimulationRunner --bodies 2000 --steps 1000 --exact-potential 5000 --max-drift 1e-4
+ * SimulationRunner --data RandomGalaxy/CelestialObjects.json --seed 7 --block-levels 6
+ * SimulationRunner --bodies 20000 --steps 500 --orbit-lod 0.05
+ * SimulationRunner --bodies 20000 --steps 5000 --diagnostics steps.csv
+ * SimulationRunner --bodies 1000000 --steps 100 --save-checkpoint run.chk
+ * SimulationRunner --bodies 1000000 --steps 100 --resume run.chk --save-checkpoint run.chk
+ * @endcode
+ */
+
+namespace {
+    struct RunnerOptions {
+        std::string dataPath;   ///< JSON for GalaxyFactory; empty = synthetic stars.
+        int bodies = 10000;     ///< Synthetic star count.
+        int steps = 1000;
+        double stepSize = 1.0 / 60.0;
+        unsigned seed = 42;
+        int threads = 0;
+        double theta = 0.5;
+        double maxDrift = -1;   ///< Fail (exit code 1) above this relative drift; < 0 = never.
+        int exactPotential = 0; ///< Sum the n-body potential over all pairs up to this many bodies; tree above.
+        int blockLevels = 0;    ///< Block timestep levels below --dt; 0 = one shared step.
+        double orbitLod = 0;    ///< Perturbation tolerance of analytic orbits; 0 = integrate every body.
+        std::string diagnosticsPath; ///< CSV file receiving a StepDiagnostics per step; empty = none.
+        std::string resumePath; ///< Checkpoint to continue from; same options and seed as the saving run.
+        std::string savePath;   ///< Checkpoint written after the last step.
+    };
+
+    void printUsage() {
+        std::cout << "Usage: SimulationRunner [--data <json>] [--bodies N] [--steps N] [--dt S]\n"
+                  << "                        [--seed N] [--threads N] [--theta T] [--max-drift D]\n"
+                  << "                        [--exact-potential MAX_BODIES]\n"
+                  << "                        [--block-levels N] [--orbit-lod TOLERANCE]\n"
+                  << "                        [--diagnostics <csv>] [--resume <checkpoint>]\n"
+                  << "                        [--save-checkpoint <checkpoint>]\n";
+    }
+
+    bool parseArguments(int argc, char *argv[], RunnerOptions &options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) return false;
+            std::string value = argv[++i];
+            if (arg == "--data") options.dataPath = value;
+            else if (arg == "--bodies") options.bodies = std::atoi(value.c_str());
+            else if (arg == "--steps") options.steps = std::atoi(value.c_str());
+            else if (arg == "--dt") options.stepSize = std::atof(value.c_str());
+            else if (arg == "--seed") options.seed = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+            else if (arg == "--threads") options.threads = std::atoi(value.c_str());
+            else if (arg == "--theta") options.theta = std::atof(value.c_str());
+            else if (arg == "--max-drift") options.maxDrift = std::atof(value.c_str());
+            else if (arg == "--exact-potential") options.exactPotential = std::atoi(value.c_str());
+            else if (arg == "--block-levels") options.blockLevels = std::atoi(value.c_str());
+            else if (arg == "--orbit-lod") options.orbitLod = std::atof(value.c_str());
+            else if (arg == "--diagnostics") options.diagnosticsPath = value;
+            else if (arg == "--resume") options.resumePath = value;
+            else if (arg == "--save-checkpoint") options.savePath = value;
+            else return false;
+        }
+        return options.bodies > 0 && options.steps >= 0 && options.stepSize > 0 && options.blockLevels >= 0 &&
+               options.orbitLod >= 0;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    RunnerOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    const double massScale = 1.0e-7;
+    const double blackHoleMass = 1.3e12 * massScale;
+    RandomGenerator rng(options.seed);
+    const std::string generationState = rng.saveState();
+
+    // Objects to simulate; the galaxy owns them in --data mode, `stars` otherwise.
+    Galaxy<GraphList<CelestialObject *, double>> galaxy;
+    std::vector<std::unique_ptr<Star>> stars;
+    std::vector<CelestialObject *> objects;
+    if (!options.dataPath.empty()) {
+        std::ifstream file(options.dataPath);
+        if (!file.is_open()) {
+            std::cerr << "Cannot open JSON file: " << options.dataPath << std::endl;
+            return 2;
+        }
+        nlohmann::json data;
+        try {
+            file >> data;
+        } catch (const std::exception &e) {
+            std::cerr << "JSON parsing error: " << e.what() << std::endl;
+            return 2;
+        }
+        GalaxyFactory::populateGalaxy(galaxy, data, rng);
+        objects = galaxy.getObject();
+    } else {
+        for (int i = 0; i < options.bodies; ++i) {
+            stars.push_back(std::make_unique<Star>("Star " + std::to_string(i), rng.getDouble(33300, 16650000),
+                                                   5778, Star::starType::Main_sequence_Star));
+            objects.push_back(stars.back().get());
+        }
+    }
+
+    GalaxyPhysicsController controller(nullptr, PhysicsBackend::Particles, options.threads);
+    BlackHoleGravityField blackHole(blackHoleMass);
+    BarnesHutGravityField nBody(massScale, options.theta);
+    nBody.setExactPotential(static_cast<int>(objects.size()) <= options.exactPotential);
+    controller.addGravityField(&blackHole);
+    controller.addGravityField(&nBody);
+    if (options.blockLevels > 0) {
+        BlockTimestepIntegrator::Options blockOptions;
+        blockOptions.maxLevel = options.blockLevels;
+        controller.setBlockTimesteps(true, blockOptions);
+    }
+    if (options.orbitLod > 0) {
+        OrbitLodScheduler::Options lodOptions;
+        lodOptions.maxPerturbation = options.orbitLod;
+        controller.setOrbitLod(&blackHole, lodOptions);
+    }
+
+    std::vector<std::unique_ptr<CelestialBodyToRigidWrapper>> wrappers;
+    for (CelestialObject *object: objects) {
+        double radius = rng.getDouble(500, 2400);
+        double angle = rng.getDouble(0, 2 * M_PI);
+        double x = radius * std::cos(angle);
+        double y = rng.getDouble(-50.0, 50.0);
+        double z = radius * std::sin(angle);
+        double v = std::sqrt(blackHoleMass / radius);
+
+        wrappers.push_back(std::make_unique<CelestialBodyToRigidWrapper>(object));
+        wrappers.back()->setPosition(x, y, z);
+        wrappers.back()->setVelocity(-std::sin(angle) * v, 0, std::cos(angle) * v);
+        controller.addCelestialBody(wrappers.back().get());
+    }
+
+    double simulationTime = 0;
+    if (!options.resumePath.empty()) {
+        auto resumeStart = std::chrono::steady_clock::now();
+        PhysicsCheckpoint checkpoint;
+        if (!checkpoint.load(options.resumePath) || !checkpoint.restore(controller, &blackHole) ||
+            !rng.restoreState(checkpoint.rngState())) {
+            std::cerr << "Cannot resume: " << checkpoint.errorString() << std::endl;
+            return 2;
+        }
+        if (!checkpoint.generationState().empty() && checkpoint.generationState() != generationState) {
+            std::cerr << "Cannot resume: " << options.resumePath << " was saved from another --seed" << std::endl;
+            return 2;
+        }
+        simulationTime = checkpoint.simulationTime();
+        std::cout << "Resumed at:      t = " << simulationTime << " in "
+                  << std::chrono::duration<double>(std::chrono::steady_clock::now() - resumeStart).count() * 1000
+                  << " ms\n";
+    }
+
+    const double initialEnergy = controller.computeTotalEnergy();
+    if (!options.diagnosticsPath.empty()) {
+        PhysicsDiagnostics::Options diagnosticsOptions;
+        diagnosticsOptions.csvPath = options.diagnosticsPath;
+        controller.enableDiagnostics(diagnosticsOptions);
+        if (controller.getDiagnostics()->csvFailed()) {
+            std::cerr << "Cannot write " << options.diagnosticsPath << std::endl;
+            return 1;
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < options.steps; ++s) controller.simulateStep(options.stepSize);
+    auto end = std::chrono::steady_clock::now();
+    const double finalEnergy = controller.computeTotalEnergy();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double drift = initialEnergy != 0 ? std::abs((finalEnergy - initialEnergy) / initialEnergy) : 0.0;
+    const ParticleState &state = controller.getState();
+    double checksum = 0;
+    for (int i = 0; i < state.size(); ++i) checksum += state.x[i] + 2 * state.y[i] + 3 * state.z[i];
+
+    std::cout << "Bodies:          " << state.size() << "\n"
+              << "Threads:         " << controller.getThreadCount() << "\n"
+              << "Steps:           " << options.steps << " x " << options.stepSize << " s\n"
+              << "Wall time:       " << seconds << " s\n"
+              << "Steps/second:    " << (seconds > 0 ? options.steps / seconds : 0.0) << "\n"
+              << "Energy:          " << initialEnergy << " -> " << finalEnergy << "\n"
+              << "Relative drift:  " << drift << "\n"
+              << "Analytic bodies: " << (controller.getOrbitLod() ? controller.getOrbitLod()->analyticCount() : 0)
+              << "\n"
+              << "Checksum:        " << std::hexfloat << checksum << std::defaultfloat << std::endl;
+
+    if (!options.savePath.empty()) {
+        std::string error;
+        simulationTime += options.steps * options.stepSize;
+        if (!PhysicsCheckpoint::save(options.savePath, controller, &blackHole, rng.saveState(), generationState,
+                                     simulationTime, &error)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+    }
+
+    if (options.maxDrift >= 0 && drift > options.maxDrift) {
+        std::cerr << "Energy drift " << drift << " exceeds " << options.maxDrift << std::endl;
+        return 1;
+    }
+    return 0;
+}